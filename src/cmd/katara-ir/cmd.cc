@@ -71,6 +71,40 @@ void GenerateFlagSets(InterpretOptions& interpret_options, DebugOptions& debug_o
   flag_sets.interpret_flags.Add<bool>("sanitize",
                                       "If true, performs dynamic checks during interpretation.",
                                       interpret_options.sanitize);
+  flag_sets.interpret_flags.Add<int64_t>(
+      "quarantine_size",
+      "Maximum number of freed bytes kept in quarantine to detect use after free when sanitizing.",
+      interpret_options.quarantine_size);
+  flag_sets.interpret_flags.Add<bool>(
+      "slab_heap", "If true, serves small heap allocations from size class slabs.",
+      interpret_options.slab_heap);
+  flag_sets.interpret_flags.Add<bool>(
+      "bytecode", "If true, compiles the program to register-based bytecode before interpretation.",
+      interpret_options.bytecode);
+  flag_sets.interpret_flags.Add<bool>(
+      "profile",
+      "If true, prints instruction, block, and function execution counts after interpretation. "
+      "Profiling always uses the non-bytecode interpreter.",
+      interpret_options.profile);
+  flag_sets.interpret_flags.Add<std::filesystem::path>(
+      "profile_graph_path",
+      "If set, writes the call graph weighted by execution counts in DOT format to the given "
+      "path. Implies -profile.",
+      interpret_options.profile_graph_path);
+  flag_sets.interpret_flags.Add<bool>(
+      "tiered",
+      "If true, compiles hot functions to x86_64 machine code during interpretation. Tiered "
+      "interpretation ignores heap flags and takes precedence over -bytecode.",
+      interpret_options.tiered);
+  flag_sets.interpret_flags.Add<int64_t>(
+      "tier_up_threshold",
+      "Number of calls and loop iterations after which -tiered compiles a function.",
+      interpret_options.tier_up_threshold);
+  flag_sets.interpret_flags.Add<bool>(
+      "linear_scan",
+      "If true, -tiered allocates registers by linear scan instead of graph coloring, which "
+      "compiles large functions faster.",
+      interpret_options.linear_scan_register_allocation);
   flag_sets.debug_flags = flag_sets.check_flags.CreateChild();
   flag_sets.debug_flags.Add<bool>("sanitize",
                                   "If true, performs dynamic checks during interpretation.",
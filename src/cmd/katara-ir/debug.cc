@@ -123,8 +123,8 @@ void HandlePrintCommand(std::vector<std::string> args, ir_interpreter::Debugger&
     *ctx->stdout() << db.stack().ToDebuggerString();
 
   } else if (args.at(1) == "heap") {
-    if (!db.heap().sanitizes()) {
-      *ctx->stderr() << "Cannot print heap when sanitizing is not turned on.\n";
+    if (!db.heap().sanitizes() && db.heap().backend() != ir_interpreter::HeapBackend::kSlab) {
+      *ctx->stderr() << "Cannot print heap when neither sanitizing nor slab heap is turned on.\n";
       return;
     }
     *ctx->stdout() << db.heap().ToDebuggerString();
@@ -158,11 +158,12 @@ void HandlePrintCommand(std::vector<std::string> args, ir_interpreter::Debugger&
     }
     std::string value_num_str = args.at(1).substr(1);
     ir::value_num_t value_num = std::stoll(value_num_str);
-    auto it = db.stack().current_frame()->computed_values().find(value_num);
-    if (it == db.stack().current_frame()->computed_values().end()) {
+    const ir_interpreter::StackFrame* frame = db.stack().current_frame();
+    if (!frame->HasComputedValue(value_num)) {
       *ctx->stderr() << "%" << value_num << " has no value.\n";
     } else {
-      *ctx->stdout() << "%" << value_num << " = " << it->second->RefStringWithType() << "\n";
+      *ctx->stdout() << "%" << value_num << " = "
+                     << frame->GetComputedValue(value_num).RefStringWithType() << "\n";
     }
 
   } else if (args.at(1).starts_with("0x")) {
@@ -9,16 +9,31 @@
 #ifndef katara_ir_interpret_h
 #define katara_ir_interpret_h
 
+#include <cstdint>
 #include <filesystem>
 
 #include "src/cmd/context.h"
 #include "src/cmd/katara-ir/error_codes.h"
+#include "src/ir/interpreter/heap.h"
+#include "src/x86_64/jit/tiered_interpreter.h"
 
 namespace cmd {
 namespace katara_ir {
 
 struct InterpretOptions {
   bool sanitize = false;
+  int64_t quarantine_size = ir_interpreter::HeapOptions::kDefaultQuarantineSize;
+  bool slab_heap = false;
+  bool bytecode = false;
+  // If true, prints execution counts to stderr after interpretation.
+  bool profile = false;
+  // If not empty, writes the profiled call graph in DOT format to the given path.
+  std::filesystem::path profile_graph_path;
+  // If true, compiles hot functions to x86_64 machine code during interpretation.
+  bool tiered = false;
+  int64_t tier_up_threshold = x86_64_jit::TieringOptions::kDefaultTierUpThreshold;
+  // If true, -tiered compilation allocates registers by linear scan.
+  bool linear_scan_register_allocation = false;
 };
 
 ErrorCode Interpret(std::filesystem::path path, InterpretOptions& interpret_options, Context* ctx);
@@ -19,7 +19,11 @@
 #include "src/ir/info/func_call_graph.h"
 #include "src/ir/info/func_live_ranges.h"
 #include "src/ir/info/interference_graph.h"
+#include "src/ir/optimizers/constant_propagation_optimizer.h"
 #include "src/ir/optimizers/func_call_graph_optimizer.h"
+#include "src/ir/optimizers/inlining_optimizer.h"
+#include "src/ir/optimizers/loop_optimizer.h"
+#include "src/ir/optimizers/value_numbering_optimizer.h"
 #include "src/ir/representation/func.h"
 #include "src/ir/representation/num_types.h"
 #include "src/ir/serialization/print.h"
@@ -77,8 +81,10 @@ struct ProgramWithRuntime {
 };
 
 std::variant<ProgramWithRuntime, ErrorCode> BuildIrProgram(
-    std::vector<std::filesystem::path>& paths, DebugHandler& debug_handler, Context* ctx) {
-  std::variant<LoadResult, ErrorCode> load_result_or_error = Load(paths, debug_handler, ctx);
+    std::vector<std::filesystem::path>& paths, LoadOptions& load_options,
+    DebugHandler& debug_handler, Context* ctx) {
+  std::variant<LoadResult, ErrorCode> load_result_or_error =
+      Load(paths, load_options, debug_handler, ctx);
   if (std::holds_alternative<ErrorCode>(load_result_or_error)) {
     return std::get<ErrorCode>(load_result_or_error);
   }
@@ -158,7 +164,11 @@ void LowerIrExtProgram(ir::Program* program, lang::runtime::RuntimeFuncs& runtim
 }
 
 void OptimizeIrProgram(ir::Program* program, DebugHandler& debug_handler, Context* ctx) {
+  ir_optimizers::InlineFuncCallsInProgram(program);
   ir_optimizers::RemoveUnusedFunctions(program);
+  ir_optimizers::PropagateConstantsInProgram(program);
+  ir_optimizers::EliminateRedundantComputationsInProgram(program);
+  ir_optimizers::OptimizeLoopsInProgram(program);
   if (debug_handler.GenerateDebugInfo()) {
     GenerateIrDebugInfo(program, "optimized", debug_handler);
   }
@@ -181,7 +191,7 @@ std::variant<std::unique_ptr<ir::Program>, ErrorCode> Build(
     std::vector<std::filesystem::path>& paths, BuildOptions& options, DebugHandler& debug_handler,
     Context* ctx) {
   std::variant<ProgramWithRuntime, ErrorCode> program_or_error =
-      BuildIrProgram(paths, debug_handler, ctx);
+      BuildIrProgram(paths, options.load_options, debug_handler, ctx);
   if (std::holds_alternative<ErrorCode>(program_or_error)) {
     return std::get<ErrorCode>(program_or_error);
   }
@@ -17,6 +17,7 @@
 #include "src/cmd/context.h"
 #include "src/cmd/katara/debug.h"
 #include "src/cmd/katara/error_codes.h"
+#include "src/cmd/katara/load.h"
 #include "src/ir/representation/program.h"
 #include "src/x86_64/program.h"
 
@@ -26,6 +27,10 @@ namespace katara {
 struct BuildOptions {
   bool optimize_ir_ext = true;
   bool optimize_ir = true;
+  // If true, x86_64 code generation allocates registers by linear scan instead of interference
+  // graph coloring.
+  bool linear_scan_register_allocation = false;
+  LoadOptions load_options = {};
 };
 
 std::variant<std::unique_ptr<ir::Program>, ErrorCode> Build(
@@ -86,14 +86,66 @@ void GenerateFlagSets(DebugConfig& debug_config, BuildOptions& build_options,
   flag_sets.build_flags.Add<bool>(
       "optimize_ir", "If true, optimizes the program based on the intermediate representation.",
       build_options.optimize_ir);
+  flag_sets.build_flags.Add<bool>(
+      "concurrent_load",
+      "If true, parses and type checks the packages in the import graph concurrently.",
+      build_options.load_options.concurrent_load);
+  flag_sets.build_flags.Add<std::filesystem::path>(
+      "summary_cache",
+      "If not empty, caches summaries of type checked packages in the directory and loads "
+      "unchanged packages from them.",
+      build_options.load_options.summary_cache_path);
 
   flag_sets.doc_flags = flag_sets.debug_flags.CreateChild();
+  flag_sets.doc_flags.Add<bool>(
+      "concurrent_load",
+      "If true, parses and type checks the packages in the import graph concurrently.",
+      build_options.load_options.concurrent_load);
   flag_sets.interpret_flags = flag_sets.build_flags.CreateChild();
   flag_sets.interpret_flags.Add<bool>("sanitize",
                                       "If true, performs dynamic checks during interpretation.",
                                       interpret_options.sanitize);
+  flag_sets.interpret_flags.Add<int64_t>(
+      "quarantine_size",
+      "Maximum number of freed bytes kept in quarantine to detect use after free when sanitizing.",
+      interpret_options.quarantine_size);
+  flag_sets.interpret_flags.Add<bool>(
+      "slab_heap", "If true, serves small heap allocations from size class slabs.",
+      interpret_options.slab_heap);
+  flag_sets.interpret_flags.Add<bool>(
+      "bytecode", "If true, compiles the program to register-based bytecode before interpretation.",
+      interpret_options.bytecode);
+  flag_sets.interpret_flags.Add<bool>(
+      "profile",
+      "If true, prints instruction, block, and function execution counts after interpretation. "
+      "Profiling always uses the non-bytecode interpreter.",
+      interpret_options.profile);
+  flag_sets.interpret_flags.Add<std::filesystem::path>(
+      "profile_graph_path",
+      "If set, writes the call graph weighted by execution counts in DOT format to the given "
+      "path. Implies -profile.",
+      interpret_options.profile_graph_path);
+  flag_sets.interpret_flags.Add<bool>(
+      "tiered",
+      "If true, compiles hot functions to x86_64 machine code during interpretation. Tiered "
+      "interpretation ignores heap flags and takes precedence over -bytecode.",
+      interpret_options.tiered);
+  flag_sets.interpret_flags.Add<int64_t>(
+      "tier_up_threshold",
+      "Number of calls and loop iterations after which -tiered compiles a function.",
+      interpret_options.tier_up_threshold);
+  flag_sets.interpret_flags.Add<bool>(
+      "linear_scan",
+      "If true, -tiered allocates registers by linear scan instead of graph coloring, which "
+      "compiles large functions faster.",
+      build_options.linear_scan_register_allocation);
 
   flag_sets.run_flags = flag_sets.build_flags.CreateChild();
+  flag_sets.run_flags.Add<bool>(
+      "linear_scan",
+      "If true, allocates registers by linear scan instead of graph coloring, which compiles "
+      "large functions faster.",
+      build_options.linear_scan_register_allocation);
 }
 
 std::vector<std::filesystem::path> ArgsToPaths(std::vector<std::string>& args) {
@@ -212,7 +264,7 @@ ErrorCode Execute(std::vector<std::string> args, Context* ctx) {
       flag_sets.doc_flags.Parse(args, ctx->stderr());
       std::vector<std::filesystem::path> paths = ArgsToPaths(args);
       DebugHandler debug_handler(debug_config, ctx);
-      return Doc(paths, debug_handler, ctx);
+      return Doc(paths, build_options.load_options, debug_handler, ctx);
     }
     case Command::kInterpret: {
       flag_sets.interpret_flags.Parse(args, ctx->stderr());
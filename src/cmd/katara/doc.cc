@@ -17,9 +17,10 @@
 namespace cmd {
 namespace katara {
 
-ErrorCode Doc(std::vector<std::filesystem::path>& paths, DebugHandler& debug_handler,
-              Context* ctx) {
-  std::variant<LoadResult, ErrorCode> load_result_or_error = Load(paths, debug_handler, ctx);
+ErrorCode Doc(std::vector<std::filesystem::path>& paths, LoadOptions& load_options,
+              DebugHandler& debug_handler, Context* ctx) {
+  std::variant<LoadResult, ErrorCode> load_result_or_error =
+      Load(paths, load_options, debug_handler, ctx);
   if (std::holds_alternative<ErrorCode>(load_result_or_error)) {
     return std::get<ErrorCode>(load_result_or_error);
   }
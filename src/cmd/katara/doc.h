@@ -15,11 +15,13 @@
 #include "src/cmd/context.h"
 #include "src/cmd/katara/debug.h"
 #include "src/cmd/katara/error_codes.h"
+#include "src/cmd/katara/load.h"
 
 namespace cmd {
 namespace katara {
 
-ErrorCode Doc(std::vector<std::filesystem::path>& paths, DebugHandler& debug_handler, Context* ctx);
+ErrorCode Doc(std::vector<std::filesystem::path>& paths, LoadOptions& load_options,
+              DebugHandler& debug_handler, Context* ctx);
 
 }
 }  // namespace cmd
@@ -9,8 +9,10 @@
 #include "interpret.h"
 
 #include "src/cmd/katara/build.h"
+#include "src/ir/interpreter/bytecode_interpreter.h"
 #include "src/ir/interpreter/interpreter.h"
 #include "src/ir/representation/program.h"
+#include "src/x86_64/jit/tiered_interpreter.h"
 
 namespace cmd {
 namespace katara {
@@ -26,8 +28,40 @@ ErrorCode Interpret(std::vector<std::filesystem::path>& paths, BuildOptions& bui
   std::unique_ptr<ir::Program> ir_program =
       std::get<std::unique_ptr<ir::Program>>(std::move(ir_program_or_error));
 
-  ir_interpreter::Interpreter interpreter(ir_program.get(), interpret_options.sanitize);
+  ir_interpreter::HeapOptions heap_options{
+      .sanitize = interpret_options.sanitize,
+      .quarantine_size = interpret_options.quarantine_size,
+      .backend = interpret_options.slab_heap ? ir_interpreter::HeapBackend::kSlab
+                                             : ir_interpreter::HeapBackend::kSystem,
+  };
+  bool profile = interpret_options.profile || !interpret_options.profile_graph_path.empty();
+  if (interpret_options.tiered && !profile) {
+    x86_64_jit::TieredInterpreter interpreter(
+        ir_program.get(),
+        x86_64_jit::TieringOptions{
+            .tier_up_threshold = interpret_options.tier_up_threshold,
+            .linear_scan_register_allocation = build_options.linear_scan_register_allocation,
+        });
+    interpreter.Run();
+    return ErrorCode(interpreter.exit_code());
+  }
+  if (interpret_options.bytecode && !profile) {
+    ir_interpreter::BytecodeInterpreter interpreter(ir_program.get(), heap_options);
+    interpreter.Run();
+    return ErrorCode(interpreter.exit_code());
+  }
+  ir_interpreter::Interpreter interpreter(ir_program.get(), heap_options);
+  if (profile) {
+    interpreter.EnableProfiling();
+  }
   interpreter.Run();
+  if (profile) {
+    *ctx->stderr() << interpreter.profile()->ToString();
+    if (!interpret_options.profile_graph_path.empty()) {
+      ctx->filesystem()->WriteContentsOfFile(interpret_options.profile_graph_path,
+                                             interpreter.profile()->ToCallGraph().ToDotFormat());
+    }
+  }
   return ErrorCode(interpreter.exit_code());
 }
 
@@ -9,6 +9,7 @@
 #ifndef katara_interpret_h
 #define katara_interpret_h
 
+#include <cstdint>
 #include <filesystem>
 #include <vector>
 
@@ -16,12 +17,24 @@
 #include "src/cmd/katara/build.h"
 #include "src/cmd/katara/debug.h"
 #include "src/cmd/katara/error_codes.h"
+#include "src/ir/interpreter/heap.h"
+#include "src/x86_64/jit/tiered_interpreter.h"
 
 namespace cmd {
 namespace katara {
 
 struct InterpretOptions {
   bool sanitize = false;
+  int64_t quarantine_size = ir_interpreter::HeapOptions::kDefaultQuarantineSize;
+  bool slab_heap = false;
+  bool bytecode = false;
+  // If true, prints execution counts to stderr after interpretation.
+  bool profile = false;
+  // If not empty, writes the profiled call graph in DOT format to the given path.
+  std::filesystem::path profile_graph_path = {};
+  // If true, compiles hot functions to x86_64 machine code during interpretation.
+  bool tiered = false;
+  int64_t tier_up_threshold = x86_64_jit::TieringOptions::kDefaultTierUpThreshold;
 };
 
 ErrorCode Interpret(std::vector<std::filesystem::path>& paths, BuildOptions& build_options,
@@ -111,6 +111,81 @@ INSTANTIATE_TEST_SUITE_P(InterpretTestInstance, InterpretTest,
                                      InterpretOptions{
                                          .sanitize = true,
                                      },
+                             },
+                             Options{
+                                 .build_options =
+                                     BuildOptions{
+                                         .optimize_ir_ext = false,
+                                         .optimize_ir = false,
+                                     },
+                                 .interpret_options =
+                                     InterpretOptions{
+                                         .sanitize = false,
+                                         .bytecode = true,
+                                     },
+                             },
+                             Options{
+                                 .build_options =
+                                     BuildOptions{
+                                         .optimize_ir_ext = true,
+                                         .optimize_ir = true,
+                                     },
+                                 .interpret_options =
+                                     InterpretOptions{
+                                         .sanitize = false,
+                                         .bytecode = true,
+                                     },
+                             },
+                             Options{
+                                 .build_options =
+                                     BuildOptions{
+                                         .optimize_ir_ext = true,
+                                         .optimize_ir = true,
+                                     },
+                                 .interpret_options =
+                                     InterpretOptions{
+                                         .sanitize = false,
+                                         .slab_heap = true,
+                                     },
+                             },
+                             Options{
+                                 .build_options =
+                                     BuildOptions{
+                                         .optimize_ir_ext = true,
+                                         .optimize_ir = true,
+                                     },
+                                 .interpret_options =
+                                     InterpretOptions{
+                                         .sanitize = true,
+                                         .slab_heap = true,
+                                     },
+                             },
+                             Options{
+                                 .build_options =
+                                     BuildOptions{
+                                         .optimize_ir_ext = true,
+                                         .optimize_ir = true,
+                                     },
+                                 .interpret_options =
+                                     InterpretOptions{
+                                         .sanitize = false,
+                                         .tiered = true,
+                                         .tier_up_threshold = 1,
+                                     },
+                             },
+                             Options{
+                                 .build_options =
+                                     BuildOptions{
+                                         .optimize_ir_ext = true,
+                                         .optimize_ir = true,
+                                         .linear_scan_register_allocation = true,
+                                     },
+                                 .interpret_options =
+                                     InterpretOptions{
+                                         .sanitize = false,
+                                         .tiered = true,
+                                         .tier_up_threshold = 1,
+                                     },
                              }),
                          [](const testing::TestParamInfo<Options>& info) {
                            std::string name;
@@ -125,6 +200,22 @@ INSTANTIATE_TEST_SUITE_P(InterpretTestInstance, InterpretTest,
                              if (!name.empty()) name += "_";
                              name += "Sanitize";
                            }
+                           if (info.param.interpret_options.slab_heap) {
+                             if (!name.empty()) name += "_";
+                             name += "SlabHeap";
+                           }
+                           if (info.param.interpret_options.bytecode) {
+                             if (!name.empty()) name += "_";
+                             name += "Bytecode";
+                           }
+                           if (info.param.interpret_options.tiered) {
+                             if (!name.empty()) name += "_";
+                             name += "Tiered";
+                           }
+                           if (info.param.build_options.linear_scan_register_allocation) {
+                             if (!name.empty()) name += "_";
+                             name += "LinearScan";
+                           }
                            return (!name.empty()) ? name : "NoOptions";
                          });
 
@@ -182,5 +273,42 @@ func main() int64 {
   EXPECT_EQ(result, 127);
 }
 
+TEST(InterpretProfilingTest, WritesProfile) {
+  TestContext ctx;
+  ctx.filesystem()->WriteContentsOfFile("test.kat", R"kat(
+package main
+
+func square(x int) int {
+  return x * x
+}
+
+func main() int {
+  var sum int
+  for i := 0; i < 4; i++ {
+    sum += square(i)
+  }
+  return sum
+}
+  )kat");
+
+  std::vector<std::filesystem::path> paths{"test.kat"};
+  // The IR optimizer would inline square, so the profile could not report calls to it.
+  BuildOptions build_options{
+      .optimize_ir = false,
+  };
+  InterpretOptions interpret_options{
+      .profile_graph_path = "profile.dot",
+  };
+  ErrorCode result = Interpret(paths, build_options, interpret_options,
+                               DebugHandler::WithDebugEnabledButOutputDisabled(), &ctx);
+
+  EXPECT_EQ(result, 14);
+  EXPECT_NE(ctx.errors().find("Profile ("), std::string::npos);
+  EXPECT_NE(ctx.errors().find("square: 4 calls"), std::string::npos);
+  EXPECT_TRUE(ctx.filesystem()->Exists("profile.dot"));
+  EXPECT_NE(ctx.filesystem()->ReadContentsOfFile("profile.dot").find("[label = \"4\"]"),
+            std::string::npos);
+}
+
 }  // namespace katara
 }  // namespace cmd
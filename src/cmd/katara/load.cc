@@ -86,6 +86,9 @@ void GenerateDebugInfo(std::unique_ptr<lang::packages::PackageManager>& pkg_mana
   }
 
   for (lang::packages::Package* pkg : arg_pkgs) {
+    if (pkg->ast_package() == nullptr) {
+      continue;
+    }
     for (auto [name, ast_file] : pkg->ast_package()->files()) {
       common::graph::Graph ast_graph = lang::ast::NodeToTree(pkg_manager->file_set(), ast_file);
 
@@ -103,7 +106,8 @@ void GenerateDebugInfo(std::unique_ptr<lang::packages::PackageManager>& pkg_mana
 }  // namespace
 
 std::variant<LoadResult, ErrorCode> Load(std::vector<std::filesystem::path>& paths,
-                                         DebugHandler& debug_handler, Context* ctx) {
+                                         LoadOptions& options, DebugHandler& debug_handler,
+                                         Context* ctx) {
   std::variant<ArgsKind, ErrorCode> args_kind_or_error = FindArgsKind(paths, ctx);
   if (std::holds_alternative<ErrorCode>(args_kind_or_error)) {
     return std::get<ErrorCode>(args_kind_or_error);
@@ -111,6 +115,10 @@ std::variant<LoadResult, ErrorCode> Load(std::vector<std::filesystem::path>& pat
   ArgsKind args_kind = std::get<ArgsKind>(args_kind_or_error);
   auto pkg_manager = std::make_unique<lang::packages::PackageManager>(
       ctx->filesystem(), kStdLibPath, ctx->filesystem()->CurrentPath());
+  if (options.concurrent_load) {
+    pkg_manager->set_load_mode(lang::packages::PackageManager::LoadMode::kConcurrent);
+  }
+  pkg_manager->set_summary_cache_path(options.summary_cache_path);
   lang::packages::Package* main_pkg = nullptr;
   std::vector<lang::packages::Package*> arg_pkgs;
   switch (args_kind) {
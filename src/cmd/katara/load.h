@@ -22,13 +22,21 @@
 namespace cmd {
 namespace katara {
 
+struct LoadOptions {
+  // If true, packages in the import graph get parsed and type checked concurrently.
+  bool concurrent_load = false;
+  // If not empty, summaries of type checked packages get cached in and loaded from the directory.
+  std::filesystem::path summary_cache_path;
+};
+
 struct LoadResult {
   std::unique_ptr<lang::packages::PackageManager> pkg_manager;
   std::vector<lang::packages::Package*> arg_pkgs;
 };
 
 std::variant<LoadResult, ErrorCode> Load(std::vector<std::filesystem::path>& paths,
-                                         DebugHandler& debug_handler, Context* ctx);
+                                         LoadOptions& options, DebugHandler& debug_handler,
+                                         Context* ctx);
 
 }  // namespace katara
 }  // namespace cmd
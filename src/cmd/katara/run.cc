@@ -13,6 +13,8 @@
 #include <variant>
 
 #include "src/cmd/katara/build.h"
+#include "src/common/data/data_view.h"
+#include "src/common/memory/code_space.h"
 #include "src/common/memory/memory.h"
 #include "src/ir/analyzers/interference_graph_builder.h"
 #include "src/ir/analyzers/live_range_analyzer.h"
@@ -23,11 +25,13 @@
 #include "src/ir/representation/program.h"
 #include "src/x86_64/ir_translator/ir_translator.h"
 #include "src/x86_64/machine_code/linker.h"
+#include "src/x86_64/peephole_optimizer.h"
 
 namespace cmd {
 namespace katara {
 
-using ::common::memory::Memory;
+using ::common::data::DataView;
+using ::common::memory::CodeSpace;
 using ::common::memory::Permissions;
 
 namespace {
@@ -51,53 +55,58 @@ void GenerateX86_64DebugInfo(
         translation_results.ir_to_x86_64_func_nums.at(ir_func_num);
     const x86_64::Func* x86_64_func =
         translation_results.program->DefinedFuncWithNumber(x86_64_func_num);
-    const ir_info::InterferenceGraph& func_interference_graph =
-        interference_graphs.at(func->number());
     const ir_info::InterferenceGraphColors& func_interference_graph_colors =
         translation_results.interference_graph_colors.at(func->number());
 
     debug_handler.WriteToDebugFile(x86_64_func->ToString(), subdir_name, "x86_64.asm.txt");
-    debug_handler.WriteToDebugFile(
-        func_interference_graph.ToGraph(&func_interference_graph_colors).ToDotFormat(), subdir_name,
-        "x86_64.interference_graph.dot");
+    // Linear scan register allocation does not build interference graphs.
+    if (auto it = interference_graphs.find(func->number()); it != interference_graphs.end()) {
+      const ir_info::InterferenceGraph& func_interference_graph = it->second;
+      debug_handler.WriteToDebugFile(
+          func_interference_graph.ToGraph(&func_interference_graph_colors).ToDotFormat(),
+          subdir_name, "x86_64.interference_graph.dot");
+    }
     debug_handler.WriteToDebugFile(func_interference_graph_colors.ToString(), subdir_name,
                                    "x86_64.colors.txt");
   }
 }
 
 std::unique_ptr<x86_64::Program> BuildX86_64Program(ir::Program* ir_program,
+                                                    BuildOptions& options,
                                                     DebugHandler& debug_handler) {
+  const bool linear_scan = options.linear_scan_register_allocation;
   std::unordered_map<ir::func_num_t, const ir_info::FuncLiveRanges> live_ranges;
   std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraph> interference_graphs;
   for (auto& func : ir_program->funcs()) {
     const ir_info::FuncLiveRanges func_live_ranges =
         ir_analyzers::FindLiveRangesForFunc(func.get());
-    const ir_info::InterferenceGraph func_interference_graph =
-        ir_analyzers::BuildInterferenceGraphForFunc(func.get(), func_live_ranges);
+    if (!linear_scan) {
+      const ir_info::InterferenceGraph func_interference_graph =
+          ir_analyzers::BuildInterferenceGraphForFunc(func.get(), func_live_ranges);
+      interference_graphs.insert({func->number(), func_interference_graph});
+    }
 
     live_ranges.insert({func->number(), func_live_ranges});
-    interference_graphs.insert({func->number(), func_interference_graph});
   }
   for (auto& func : ir_program->funcs()) {
     ir_processors::ResolvePhisInFunc(func.get());
   }
 
   ir_to_x86_64_translator::TranslationResults translation_results =
-      ir_to_x86_64_translator::Translate(ir_program, live_ranges, interference_graphs,
-                                         debug_handler.GenerateDebugInfo());
+      linear_scan ? ir_to_x86_64_translator::TranslateWithLinearScan(
+                        ir_program, live_ranges, debug_handler.GenerateDebugInfo())
+                  : ir_to_x86_64_translator::Translate(ir_program, live_ranges, interference_graphs,
+                                                       debug_handler.GenerateDebugInfo());
+  const x86_64::PeepholeStats peephole_stats =
+      x86_64::OptimizeProgramWithPeepholes(translation_results.program.get());
   if (debug_handler.GenerateDebugInfo()) {
     GenerateX86_64DebugInfo(ir_program, interference_graphs, translation_results, debug_handler);
+    debug_handler.WriteToDebugFile(peephole_stats.ToString(), /* subdir_name= */ "",
+                                   "x86_64.peephole_stats.txt");
   }
   return std::move(translation_results.program);
 }
 
-void* MallocJump(int size) {
-  void* p = malloc(size);
-  return p;
-}
-
-void FreeJump(void* ptr) { free(ptr); }
-
 }  // namespace
 
 ErrorCode Run(std::vector<std::filesystem::path>& paths, BuildOptions& options,
@@ -110,30 +119,32 @@ ErrorCode Run(std::vector<std::filesystem::path>& paths, BuildOptions& options,
   std::unique_ptr<ir::Program> ir_program =
       std::get<std::unique_ptr<ir::Program>>(std::move(ir_program_or_error));
   std::unique_ptr<x86_64::Program> x86_64_program =
-      BuildX86_64Program(ir_program.get(), debug_handler);
+      BuildX86_64Program(ir_program.get(), options, debug_handler);
 
+  CodeSpace code_space;
+  DataView stubs = code_space.AllocateChunk(x86_64::Linker::kMallocAndFreeStubsSize);
+  x86_64::Linker::EncodeMallocAndFreeStubs(stubs);
+  code_space.ChangePermissions(stubs, Permissions::kExecute);
   x86_64::Linker linker;
-  linker.AddFuncAddr(x86_64_program->declared_funcs().at("malloc"), (uint8_t*)&MallocJump);
-  linker.AddFuncAddr(x86_64_program->declared_funcs().at("free"), (uint8_t*)&FreeJump);
+  linker.AddMallocAndFreeStubs(x86_64_program->declared_funcs().at("malloc"),
+                               x86_64_program->declared_funcs().at("free"), stubs);
 
-  Memory memory(common::memory::kPageSize, Permissions::kWrite);
-  int64_t program_size = x86_64_program->Encode(linker, memory.data());
+  DataView code = x86_64_program->Encode(linker, code_space);
   linker.ApplyPatches();
 
-  memory.ChangePermissions(Permissions::kRead);
+  code_space.ChangePermissions(code, Permissions::kRead);
   if (debug_handler.GenerateDebugInfo()) {
     std::ostringstream buffer;
-    for (int64_t j = 0; j < program_size; j++) {
-      buffer << std::hex << std::setfill('0') << std::setw(2) << (unsigned short)memory.data()[j]
-             << " ";
-      if (j % 8 == 7 && j != program_size - 1) {
+    for (int64_t j = 0; j < code.size(); j++) {
+      buffer << std::hex << std::setfill('0') << std::setw(2) << (unsigned short)code[j] << " ";
+      if (j % 8 == 7 && j != code.size() - 1) {
         buffer << "\n";
       }
     }
     debug_handler.WriteToDebugFile(buffer.str(), /* subdir_name= */ "", "x86_64.hex.txt");
   }
 
-  memory.ChangePermissions(Permissions::kExecute);
+  code_space.ChangePermissions(code, Permissions::kExecute);
   x86_64::Func* x86_64_main_func = x86_64_program->DefinedFuncWithName("main");
   int (*main_func)(void) = (int (*)(void))(linker.func_addrs().at(x86_64_main_func->func_num()));
   return ErrorCode(main_func());
@@ -15,6 +15,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <variant>
 
 namespace common::atomics {
@@ -155,6 +156,72 @@ std::optional<Int> ToU64(std::string_view str, Int::Base base = 0);
 
 constexpr Int::CompareOp Flipped(Int::CompareOp op);
 
+// Maps each IntType to the fixed-width integer type representing it.
+template <IntType type>
+struct IntTypeTraits;
+template <>
+struct IntTypeTraits<IntType::kI8> {
+  typedef int8_t raw_t;
+};
+template <>
+struct IntTypeTraits<IntType::kI16> {
+  typedef int16_t raw_t;
+};
+template <>
+struct IntTypeTraits<IntType::kI32> {
+  typedef int32_t raw_t;
+};
+template <>
+struct IntTypeTraits<IntType::kI64> {
+  typedef int64_t raw_t;
+};
+template <>
+struct IntTypeTraits<IntType::kU8> {
+  typedef uint8_t raw_t;
+};
+template <>
+struct IntTypeTraits<IntType::kU16> {
+  typedef uint16_t raw_t;
+};
+template <>
+struct IntTypeTraits<IntType::kU32> {
+  typedef uint32_t raw_t;
+};
+template <>
+struct IntTypeTraits<IntType::kU64> {
+  typedef uint64_t raw_t;
+};
+
+template <IntType type>
+using raw_int_t = typename IntTypeTraits<type>::raw_t;
+
+// Type-specialized counterparts of the Int operations, operating on raw fixed-width integers.
+// They produce the same results as the Int operations but avoid dispatching on Int's variant,
+// which makes them suitable for hot paths, such as interpretation and constant folding, where the
+// IntType is known up front.
+template <IntType type>
+constexpr raw_int_t<type> Compute(Int::UnaryOp op, raw_int_t<type> a);
+template <IntType type>
+constexpr bool Compare(raw_int_t<type> a, Int::CompareOp op, raw_int_t<type> b);
+template <IntType type>
+constexpr raw_int_t<type> Compute(raw_int_t<type> a, Int::BinaryOp op, raw_int_t<type> b);
+template <IntType type>
+constexpr raw_int_t<type> Shift(raw_int_t<type> a, Int::ShiftOp op, uint64_t b);
+
+// Calls f with a std::integral_constant<IntType, type>, turning a runtime IntType into a compile
+// time one.
+template <typename F>
+constexpr auto VisitIntType(IntType type, F f);
+
+// Dispatch once on a runtime IntType to the type-specialized operations above. Operands and
+// results are held as int64_t, the way Int::AsInt64 represents them.
+constexpr int64_t ComputeAsInt64(IntType type, Int::UnaryOp op, int64_t a);
+constexpr bool CompareAsInt64(IntType type, int64_t a, Int::CompareOp op, int64_t b);
+constexpr int64_t ComputeAsInt64(IntType type, int64_t a, Int::BinaryOp op, int64_t b);
+constexpr int64_t ShiftAsInt64(IntType type, int64_t a, Int::ShiftOp op, uint64_t b);
+// Returns the Int of the given type held as int64_t, the inverse of Int::AsInt64.
+constexpr Int IntFromInt64(IntType type, int64_t value);
+
 std::optional<Int::UnaryOp> ToIntUnaryOp(std::string_view str);
 std::string ToString(Int::UnaryOp op);
 
@@ -504,6 +571,131 @@ constexpr Int::CompareOp Flipped(Int::CompareOp op) {
   }
 }
 
+template <IntType type>
+constexpr raw_int_t<type> Compute(Int::UnaryOp op, raw_int_t<type> a) {
+  switch (op) {
+    case Int::UnaryOp::kNeg:
+      return static_cast<raw_int_t<type>>(-a);
+    case Int::UnaryOp::kNot:
+      return static_cast<raw_int_t<type>>(~a);
+  }
+}
+
+template <IntType type>
+constexpr bool Compare(raw_int_t<type> a, Int::CompareOp op, raw_int_t<type> b) {
+  switch (op) {
+    case Int::CompareOp::kEq:
+      return a == b;
+    case Int::CompareOp::kNeq:
+      return a != b;
+    case Int::CompareOp::kLss:
+      return a < b;
+    case Int::CompareOp::kLeq:
+      return a <= b;
+    case Int::CompareOp::kGeq:
+      return a >= b;
+    case Int::CompareOp::kGtr:
+      return a > b;
+  }
+}
+
+template <IntType type>
+constexpr raw_int_t<type> Compute(raw_int_t<type> a, Int::BinaryOp op, raw_int_t<type> b) {
+  typedef raw_int_t<type> T;
+  switch (op) {
+    case Int::BinaryOp::kAdd:
+      return static_cast<T>(a + b);
+    case Int::BinaryOp::kSub:
+      return static_cast<T>(a - b);
+    case Int::BinaryOp::kMul:
+      return static_cast<T>(a * b);
+    case Int::BinaryOp::kDiv:
+      return static_cast<T>(a / b);
+    case Int::BinaryOp::kRem:
+      return static_cast<T>(a % b);
+    case Int::BinaryOp::kAnd:
+      return static_cast<T>(a & b);
+    case Int::BinaryOp::kOr:
+      return static_cast<T>(a | b);
+    case Int::BinaryOp::kXor:
+      return static_cast<T>(a ^ b);
+    case Int::BinaryOp::kAndNot:
+      return static_cast<T>(a & ~b);
+  }
+}
+
+template <IntType type>
+constexpr raw_int_t<type> Shift(raw_int_t<type> a, Int::ShiftOp op, uint64_t b) {
+  switch (op) {
+    case Int::ShiftOp::kLeft:
+      return static_cast<raw_int_t<type>>(a << b);
+    case Int::ShiftOp::kRight:
+      return static_cast<raw_int_t<type>>(a >> b);
+  }
+}
+
+template <typename F>
+constexpr auto VisitIntType(IntType type, F f) {
+  switch (type) {
+    case IntType::kI8:
+      return f(std::integral_constant<IntType, IntType::kI8>{});
+    case IntType::kI16:
+      return f(std::integral_constant<IntType, IntType::kI16>{});
+    case IntType::kI32:
+      return f(std::integral_constant<IntType, IntType::kI32>{});
+    case IntType::kI64:
+      return f(std::integral_constant<IntType, IntType::kI64>{});
+    case IntType::kU8:
+      return f(std::integral_constant<IntType, IntType::kU8>{});
+    case IntType::kU16:
+      return f(std::integral_constant<IntType, IntType::kU16>{});
+    case IntType::kU32:
+      return f(std::integral_constant<IntType, IntType::kU32>{});
+    case IntType::kU64:
+      return f(std::integral_constant<IntType, IntType::kU64>{});
+  }
+}
+
+constexpr int64_t ComputeAsInt64(IntType type, Int::UnaryOp op, int64_t a) {
+  return VisitIntType(type, [=](auto t) {
+    constexpr IntType kType = decltype(t)::value;
+    typedef raw_int_t<kType> T;
+    return static_cast<int64_t>(Compute<kType>(op, static_cast<T>(a)));
+  });
+}
+
+constexpr bool CompareAsInt64(IntType type, int64_t a, Int::CompareOp op, int64_t b) {
+  return VisitIntType(type, [=](auto t) {
+    constexpr IntType kType = decltype(t)::value;
+    typedef raw_int_t<kType> T;
+    return Compare<kType>(static_cast<T>(a), op, static_cast<T>(b));
+  });
+}
+
+constexpr int64_t ComputeAsInt64(IntType type, int64_t a, Int::BinaryOp op, int64_t b) {
+  return VisitIntType(type, [=](auto t) {
+    constexpr IntType kType = decltype(t)::value;
+    typedef raw_int_t<kType> T;
+    return static_cast<int64_t>(Compute<kType>(static_cast<T>(a), op, static_cast<T>(b)));
+  });
+}
+
+constexpr int64_t ShiftAsInt64(IntType type, int64_t a, Int::ShiftOp op, uint64_t b) {
+  return VisitIntType(type, [=](auto t) {
+    constexpr IntType kType = decltype(t)::value;
+    typedef raw_int_t<kType> T;
+    return static_cast<int64_t>(Shift<kType>(static_cast<T>(a), op, b));
+  });
+}
+
+constexpr Int IntFromInt64(IntType type, int64_t value) {
+  return VisitIntType(type, [=](auto t) {
+    constexpr IntType kType = decltype(t)::value;
+    typedef raw_int_t<kType> T;
+    return Int(static_cast<T>(value));
+  });
+}
+
 }  // namespace common::atomics
 
 #endif /* common_atomics_h */
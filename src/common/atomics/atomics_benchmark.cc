@@ -0,0 +1,117 @@
+//
+//  atomics_benchmark.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "src/common/atomics/atomics.h"
+
+namespace common::atomics {
+namespace {
+
+constexpr std::array<Int::BinaryOp, 5> kBinaryOps{
+    Int::BinaryOp::kAdd, Int::BinaryOp::kSub, Int::BinaryOp::kMul,
+    Int::BinaryOp::kXor, Int::BinaryOp::kAnd,
+};
+
+std::vector<int64_t> Operands() {
+  std::vector<int64_t> operands;
+  for (int64_t i = 0; i < 1024; i++) {
+    operands.push_back(i * 7919 + 13);
+  }
+  return operands;
+}
+
+IntType IntTypeArg(const benchmark::State& state) { return IntType(state.range(0)); }
+
+void BM_IntCompute(benchmark::State& state) {
+  IntType type = IntTypeArg(state);
+  std::vector<Int> operands;
+  for (int64_t operand : Operands()) {
+    operands.push_back(Int(operand).ConvertTo(type));
+  }
+  for (auto _ : state) {
+    Int result = Int(int64_t{0}).ConvertTo(type);
+    for (std::size_t i = 0; i < operands.size(); i++) {
+      result = Int::Compute(result, kBinaryOps[i % kBinaryOps.size()], operands[i]);
+    }
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * operands.size());
+}
+
+void BM_ComputeAsInt64(benchmark::State& state) {
+  IntType type = IntTypeArg(state);
+  std::vector<int64_t> operands;
+  for (int64_t operand : Operands()) {
+    operands.push_back(Int(operand).ConvertTo(type).AsInt64());
+  }
+  for (auto _ : state) {
+    int64_t result = 0;
+    for (std::size_t i = 0; i < operands.size(); i++) {
+      result = ComputeAsInt64(type, result, kBinaryOps[i % kBinaryOps.size()], operands[i]);
+    }
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * operands.size());
+}
+
+void BM_ComputeI64(benchmark::State& state) {
+  std::vector<int64_t> operands = Operands();
+  for (auto _ : state) {
+    int64_t result = 0;
+    for (std::size_t i = 0; i < operands.size(); i++) {
+      result = Compute<IntType::kI64>(result, kBinaryOps[i % kBinaryOps.size()], operands[i]);
+    }
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * operands.size());
+}
+
+void BM_IntCompare(benchmark::State& state) {
+  IntType type = IntTypeArg(state);
+  std::vector<Int> operands;
+  for (int64_t operand : Operands()) {
+    operands.push_back(Int(operand).ConvertTo(type));
+  }
+  for (auto _ : state) {
+    int64_t count = 0;
+    for (std::size_t i = 1; i < operands.size(); i++) {
+      count += Int::Compare(operands[i - 1], Int::CompareOp::kLss, operands[i]);
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * (operands.size() - 1));
+}
+
+void BM_CompareAsInt64(benchmark::State& state) {
+  IntType type = IntTypeArg(state);
+  std::vector<int64_t> operands;
+  for (int64_t operand : Operands()) {
+    operands.push_back(Int(operand).ConvertTo(type).AsInt64());
+  }
+  for (auto _ : state) {
+    int64_t count = 0;
+    for (std::size_t i = 1; i < operands.size(); i++) {
+      count += CompareAsInt64(type, operands[i - 1], Int::CompareOp::kLss, operands[i]);
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * (operands.size() - 1));
+}
+
+BENCHMARK(BM_IntCompute)->Arg(int64_t(IntType::kI64))->Arg(int64_t(IntType::kU8));
+BENCHMARK(BM_ComputeAsInt64)->Arg(int64_t(IntType::kI64))->Arg(int64_t(IntType::kU8));
+BENCHMARK(BM_ComputeI64);
+BENCHMARK(BM_IntCompare)->Arg(int64_t(IntType::kI64))->Arg(int64_t(IntType::kU8));
+BENCHMARK(BM_CompareAsInt64)->Arg(int64_t(IntType::kI64))->Arg(int64_t(IntType::kU8));
+
+}  // namespace
+}  // namespace common::atomics
@@ -900,4 +900,80 @@ TEST(ToU64Test, RejectsOverflow) {
   EXPECT_EQ(ToU64("+0x10000000000000000"), std::nullopt);
 }
 
+TEST(TypedIntTest, MatchesIntForBinaryOps) {
+  EXPECT_EQ((Compute<IntType::kI8>(100, Int::BinaryOp::kAdd, 100)), int8_t{-56});
+  EXPECT_EQ((Compute<IntType::kU8>(3, Int::BinaryOp::kSub, 5)), uint8_t{254});
+  EXPECT_EQ((Compute<IntType::kI32>(-7, Int::BinaryOp::kDiv, 2)), int32_t{-3});
+  EXPECT_EQ((Compute<IntType::kI64>(-7, Int::BinaryOp::kRem, 2)), int64_t{-1});
+  EXPECT_EQ((Compute<IntType::kU16>(0xff0f, Int::BinaryOp::kAndNot, 0x00ff)), uint16_t{0xff00});
+
+  for (IntType type : {IntType::kI8, IntType::kI16, IntType::kI32, IntType::kI64, IntType::kU8,
+                       IntType::kU16, IntType::kU32, IntType::kU64}) {
+    for (int64_t a : std::array<int64_t, 5>{0, 1, 7, 42, 100}) {
+      for (int64_t b : std::array<int64_t, 4>{1, 3, 5, 99}) {
+        Int int_a = Int(a).ConvertTo(type);
+        Int int_b = Int(b).ConvertTo(type);
+        for (Int::BinaryOp op : {Int::BinaryOp::kAdd, Int::BinaryOp::kSub, Int::BinaryOp::kMul,
+                                 Int::BinaryOp::kDiv, Int::BinaryOp::kRem, Int::BinaryOp::kAnd,
+                                 Int::BinaryOp::kOr, Int::BinaryOp::kXor,
+                                 Int::BinaryOp::kAndNot}) {
+          EXPECT_EQ(ComputeAsInt64(type, int_a.AsInt64(), op, int_b.AsInt64()),
+                    Int::Compute(int_a, op, int_b).AsInt64());
+        }
+        for (Int::CompareOp op : {Int::CompareOp::kEq, Int::CompareOp::kNeq, Int::CompareOp::kLss,
+                                  Int::CompareOp::kLeq, Int::CompareOp::kGeq,
+                                  Int::CompareOp::kGtr}) {
+          EXPECT_EQ(CompareAsInt64(type, int_a.AsInt64(), op, int_b.AsInt64()),
+                    Int::Compare(int_a, op, int_b));
+        }
+      }
+    }
+  }
+}
+
+TEST(TypedIntTest, MatchesIntForUnaryOps) {
+  EXPECT_EQ((Compute<IntType::kI16>(Int::UnaryOp::kNeg, 42)), int16_t{-42});
+  EXPECT_EQ((Compute<IntType::kU32>(Int::UnaryOp::kNot, 0)), uint32_t{0xffffffff});
+
+  for (IntType type : {IntType::kI8, IntType::kI16, IntType::kI32, IntType::kI64}) {
+    for (int64_t a : std::array<int64_t, 5>{-100, -1, 0, 1, 100}) {
+      Int int_a = Int(a).ConvertTo(type);
+      for (Int::UnaryOp op : {Int::UnaryOp::kNeg, Int::UnaryOp::kNot}) {
+        EXPECT_EQ(ComputeAsInt64(type, op, int_a.AsInt64()), Int::Compute(op, int_a).AsInt64());
+      }
+    }
+  }
+}
+
+TEST(TypedIntTest, MatchesIntForShifts) {
+  EXPECT_EQ((Shift<IntType::kU8>(0x81, Int::ShiftOp::kLeft, 1)), uint8_t{0x02});
+  EXPECT_EQ((Shift<IntType::kI8>(-128, Int::ShiftOp::kRight, 7)), int8_t{-1});
+  EXPECT_EQ((Shift<IntType::kU8>(0x80, Int::ShiftOp::kRight, 7)), uint8_t{1});
+
+  for (IntType type : {IntType::kI8, IntType::kI16, IntType::kI32, IntType::kI64, IntType::kU8,
+                       IntType::kU16, IntType::kU32, IntType::kU64}) {
+    for (int64_t a : std::array<int64_t, 4>{0, 1, 42, 127}) {
+      Int int_a = Int(a).ConvertTo(type);
+      for (uint8_t b : std::array<uint8_t, 4>{0, 1, 3, 7}) {
+        for (Int::ShiftOp op : {Int::ShiftOp::kLeft, Int::ShiftOp::kRight}) {
+          EXPECT_EQ(ShiftAsInt64(type, int_a.AsInt64(), op, b),
+                    Int::Shift(int_a, op, Int(b)).AsInt64());
+        }
+      }
+    }
+  }
+}
+
+TEST(TypedIntTest, ConvertsFromInt64) {
+  for (IntType type : {IntType::kI8, IntType::kI16, IntType::kI32, IntType::kI64, IntType::kU8,
+                       IntType::kU16, IntType::kU32, IntType::kU64}) {
+    for (int64_t a : std::array<int64_t, 5>{0, 1, 42, -1, -128}) {
+      Int int_a = Int(a).ConvertTo(type);
+      Int result = IntFromInt64(type, int_a.AsInt64());
+      EXPECT_EQ(result.type(), type);
+      EXPECT_TRUE(Int::Compare(result, Int::CompareOp::kEq, int_a));
+    }
+  }
+}
+
 }  // namespace common::atomics
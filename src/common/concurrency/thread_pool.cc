@@ -0,0 +1,72 @@
+//
+//  thread_pool.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace common::concurrency {
+
+int64_t ThreadPool::DefaultThreadCount() {
+  return std::max(int64_t{1}, int64_t(std::thread::hardware_concurrency()));
+}
+
+ThreadPool::ThreadPool(int64_t thread_count) {
+  thread_count = std::max(int64_t{1}, thread_count);
+  workers_.reserve(thread_count);
+  for (int64_t i = 0; i < thread_count; i++) {
+    workers_.emplace_back(&ThreadPool::RunWorker, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  Wait();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    shutting_down_ = true;
+  }
+  task_available_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Schedule(std::function<void()> task) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+    unfinished_task_count_++;
+  }
+  task_available_.notify_one();
+}
+
+void ThreadPool::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  all_tasks_done_.wait(lock, [this] { return unfinished_task_count_ == 0; });
+}
+
+void ThreadPool::RunWorker() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    task_available_.wait(lock, [this] { return shutting_down_ || !tasks_.empty(); });
+    if (tasks_.empty()) {
+      return;
+    }
+    std::function<void()> task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    task();
+    lock.lock();
+    if (--unfinished_task_count_ == 0) {
+      all_tasks_done_.notify_all();
+    }
+  }
+}
+
+}  // namespace common::concurrency
@@ -0,0 +1,54 @@
+//
+//  thread_pool.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef common_concurrency_thread_pool_h
+#define common_concurrency_thread_pool_h
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace common::concurrency {
+
+// Runs scheduled tasks on a fixed number of worker threads. Tasks may schedule further tasks.
+class ThreadPool {
+ public:
+  // Returns the number of threads the hardware can run concurrently, but at least one.
+  static int64_t DefaultThreadCount();
+
+  explicit ThreadPool(int64_t thread_count = DefaultThreadCount());
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  int64_t thread_count() const { return int64_t(workers_.size()); }
+
+  void Schedule(std::function<void()> task);
+  // Blocks until all scheduled tasks, including tasks scheduled by other tasks, have completed.
+  void Wait();
+
+ private:
+  void RunWorker();
+
+  std::mutex mutex_;
+  std::condition_variable task_available_;
+  std::condition_variable all_tasks_done_;
+  std::deque<std::function<void()>> tasks_;
+  int64_t unfinished_task_count_ = 0;
+  bool shutting_down_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace common::concurrency
+
+#endif /* common_concurrency_thread_pool_h */
@@ -0,0 +1,56 @@
+//
+//  thread_pool_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/common/concurrency/thread_pool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "gtest/gtest.h"
+
+namespace common::concurrency {
+
+TEST(ThreadPoolTest, RunsAllTasksBeforeWaitReturns) {
+  ThreadPool pool(/*thread_count=*/4);
+  std::atomic<int64_t> sum = 0;
+  for (int64_t i = 1; i <= 100; i++) {
+    pool.Schedule([&sum, i] { sum += i; });
+  }
+  pool.Wait();
+  EXPECT_EQ(sum, 5050);
+}
+
+TEST(ThreadPoolTest, WaitsForTasksScheduledByTasks) {
+  ThreadPool pool(/*thread_count=*/2);
+  std::atomic<int64_t> count = 0;
+  std::function<void(int64_t)> schedule_tree = [&](int64_t depth) {
+    count++;
+    if (depth == 0) {
+      return;
+    }
+    pool.Schedule([&, depth] { schedule_tree(depth - 1); });
+    pool.Schedule([&, depth] { schedule_tree(depth - 1); });
+  };
+  pool.Schedule([&] { schedule_tree(5); });
+  pool.Wait();
+  EXPECT_EQ(count, 63);
+}
+
+TEST(ThreadPoolTest, CanBeReusedAfterWait) {
+  ThreadPool pool(/*thread_count=*/1);
+  int64_t value = 0;
+  pool.Schedule([&value] { value = 1; });
+  pool.Wait();
+  EXPECT_EQ(value, 1);
+  pool.Schedule([&value] { value = 2; });
+  pool.Wait();
+  EXPECT_EQ(value, 2);
+}
+
+}  // namespace common::concurrency
@@ -0,0 +1,135 @@
+//
+//  bit_vector.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "bit_vector.h"
+
+#include <sstream>
+
+#include "src/common/logging/logging.h"
+
+namespace common::data {
+
+using ::common::logging::fail;
+
+BitVector::BitVector(int64_t size, bool value)
+    : size_(size), words_((size + kBitsPerWord - 1) / kBitsPerWord, value ? ~uint64_t{0} : 0) {
+  if (size < 0) {
+    fail("size is negative");
+  }
+  ClearUnusedBits();
+}
+
+bool BitVector::Get(int64_t index) const {
+  CheckIndex(index);
+  return (words_[index / kBitsPerWord] >> (index % kBitsPerWord)) & 1;
+}
+
+void BitVector::Set(int64_t index) {
+  CheckIndex(index);
+  words_[index / kBitsPerWord] |= uint64_t{1} << (index % kBitsPerWord);
+}
+
+void BitVector::Reset(int64_t index) {
+  CheckIndex(index);
+  words_[index / kBitsPerWord] &= ~(uint64_t{1} << (index % kBitsPerWord));
+}
+
+void BitVector::SetAll() {
+  for (uint64_t& word : words_) {
+    word = ~uint64_t{0};
+  }
+  ClearUnusedBits();
+}
+
+void BitVector::ResetAll() {
+  for (uint64_t& word : words_) {
+    word = 0;
+  }
+}
+
+int64_t BitVector::Count() const {
+  int64_t count = 0;
+  for (uint64_t word : words_) {
+    count += std::popcount(word);
+  }
+  return count;
+}
+
+bool BitVector::IsEmpty() const {
+  for (uint64_t word : words_) {
+    if (word != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool BitVector::UnionWith(const BitVector& other) {
+  CheckSize(other);
+  uint64_t changed = 0;
+  for (std::size_t i = 0; i < words_.size(); i++) {
+    uint64_t old_word = words_[i];
+    words_[i] |= other.words_[i];
+    changed |= old_word ^ words_[i];
+  }
+  return changed != 0;
+}
+
+bool BitVector::IntersectWith(const BitVector& other) {
+  CheckSize(other);
+  uint64_t changed = 0;
+  for (std::size_t i = 0; i < words_.size(); i++) {
+    uint64_t old_word = words_[i];
+    words_[i] &= other.words_[i];
+    changed |= old_word ^ words_[i];
+  }
+  return changed != 0;
+}
+
+void BitVector::Subtract(const BitVector& other) {
+  CheckSize(other);
+  for (std::size_t i = 0; i < words_.size(); i++) {
+    words_[i] &= ~other.words_[i];
+  }
+}
+
+std::string BitVector::ToString() const {
+  std::stringstream ss;
+  ss << "{";
+  bool first = true;
+  ForEachSetBit([&](int64_t index) {
+    if (!first) {
+      ss << ", ";
+    }
+    first = false;
+    ss << index;
+  });
+  ss << "}";
+  return ss.str();
+}
+
+void BitVector::CheckIndex(int64_t index) const {
+  if (index < 0 || index >= size_) {
+    fail("index is out of bounds, size: " + std::to_string(size_) +
+         ", index: " + std::to_string(index));
+  }
+}
+
+void BitVector::CheckSize(const BitVector& other) const {
+  if (size_ != other.size_) {
+    fail("bit vectors have different sizes");
+  }
+}
+
+void BitVector::ClearUnusedBits() {
+  if (size_ % kBitsPerWord != 0) {
+    words_.back() &= (uint64_t{1} << (size_ % kBitsPerWord)) - 1;
+  }
+}
+
+}  // namespace common::data
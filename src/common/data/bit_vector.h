@@ -0,0 +1,70 @@
+//
+//  bit_vector.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef common_bit_vector_h
+#define common_bit_vector_h
+
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace common::data {
+
+// A fixed size set of bits, stored densely in 64 bit words. Set operations work a word at a time,
+// which makes this the preferred representation for sets over densely numbered elements.
+class BitVector {
+ public:
+  BitVector() : size_(0) {}
+  explicit BitVector(int64_t size, bool value = false);
+
+  int64_t size() const { return size_; }
+
+  bool Get(int64_t index) const;
+  void Set(int64_t index);
+  void Reset(int64_t index);
+  void SetAll();
+  void ResetAll();
+
+  // Returns the number of set bits.
+  int64_t Count() const;
+  bool IsEmpty() const;
+
+  // The following operations require both bit vectors to have the same size. UnionWith and
+  // IntersectWith return whether any bit in this bit vector changed.
+  bool UnionWith(const BitVector& other);
+  bool IntersectWith(const BitVector& other);
+  void Subtract(const BitVector& other);
+
+  template <typename F>
+  void ForEachSetBit(F f) const {
+    for (std::size_t i = 0; i < words_.size(); i++) {
+      for (uint64_t word = words_[i]; word != 0; word &= word - 1) {
+        f(int64_t(i * kBitsPerWord + std::countr_zero(word)));
+      }
+    }
+  }
+
+  bool operator==(const BitVector& that) const = default;
+
+  std::string ToString() const;
+
+ private:
+  static constexpr int64_t kBitsPerWord = 64;
+
+  void CheckIndex(int64_t index) const;
+  void CheckSize(const BitVector& other) const;
+  void ClearUnusedBits();
+
+  int64_t size_;
+  std::vector<uint64_t> words_;
+};
+
+}  // namespace common::data
+
+#endif /* common_bit_vector_h */
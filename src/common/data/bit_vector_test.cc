@@ -0,0 +1,91 @@
+//
+//  bit_vector_test.cc
+//  Katara-tests
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/common/data/bit_vector.h"
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace common::data {
+
+using ::testing::ElementsAre;
+
+TEST(BitVectorTest, SetsAndResetsBits) {
+  BitVector bits(130);
+  EXPECT_EQ(bits.size(), 130);
+  EXPECT_TRUE(bits.IsEmpty());
+
+  bits.Set(0);
+  bits.Set(64);
+  bits.Set(129);
+  EXPECT_TRUE(bits.Get(0));
+  EXPECT_FALSE(bits.Get(1));
+  EXPECT_TRUE(bits.Get(64));
+  EXPECT_TRUE(bits.Get(129));
+  EXPECT_EQ(bits.Count(), 3);
+
+  bits.Reset(64);
+  EXPECT_FALSE(bits.Get(64));
+  EXPECT_EQ(bits.Count(), 2);
+  EXPECT_EQ(bits.ToString(), "{0, 129}");
+}
+
+TEST(BitVectorTest, SetAllOnlySetsBitsWithinSize) {
+  BitVector bits(70, /*value=*/true);
+  EXPECT_EQ(bits.Count(), 70);
+
+  bits.ResetAll();
+  EXPECT_TRUE(bits.IsEmpty());
+
+  bits.SetAll();
+  EXPECT_EQ(bits.Count(), 70);
+}
+
+TEST(BitVectorTest, CombinesBitVectors) {
+  BitVector bits_a(100);
+  BitVector bits_b(100);
+  bits_a.Set(3);
+  bits_a.Set(70);
+  bits_b.Set(70);
+  bits_b.Set(99);
+
+  BitVector union_bits = bits_a;
+  EXPECT_TRUE(union_bits.UnionWith(bits_b));
+  EXPECT_FALSE(union_bits.UnionWith(bits_b));
+  EXPECT_EQ(union_bits.ToString(), "{3, 70, 99}");
+
+  BitVector intersection_bits = bits_a;
+  EXPECT_TRUE(intersection_bits.IntersectWith(bits_b));
+  EXPECT_FALSE(intersection_bits.IntersectWith(bits_b));
+  EXPECT_EQ(intersection_bits.ToString(), "{70}");
+
+  BitVector difference_bits = bits_a;
+  difference_bits.Subtract(bits_b);
+  EXPECT_EQ(difference_bits.ToString(), "{3}");
+
+  EXPECT_NE(bits_a, bits_b);
+  bits_b.Reset(99);
+  bits_b.Set(3);
+  EXPECT_EQ(bits_a, bits_b);
+}
+
+TEST(BitVectorTest, IteratesOverSetBits) {
+  BitVector bits(200);
+  bits.Set(1);
+  bits.Set(63);
+  bits.Set(64);
+  bits.Set(199);
+
+  std::vector<int64_t> indices;
+  bits.ForEachSetBit([&](int64_t index) { indices.push_back(index); });
+  EXPECT_THAT(indices, ElementsAre(1, 63, 64, 199));
+}
+
+}  // namespace common::data
@@ -113,6 +113,11 @@ void WriteEdgeForDot(std::stringstream& ss, const Edge& edge, bool is_directed)
   ss << (is_directed ? "->" : "--");
   ss << "n";
   WriteEscapedNumberForDot(ss, edge.target_number());
+  if (!edge.label().empty()) {
+    ss << " [label = \"";
+    WriteEscapedStringForDot(ss, edge.label(), 'n');
+    ss << "\"]";
+  }
 }
 
 }  // namespace
@@ -162,6 +167,9 @@ std::string Graph::ToVCGFormat() const {
       ss << "solid";
     else
       ss << "none";
+    if (!edge.label().empty()) {
+      ss << " label: " << std::quoted(edge.label());
+    }
     ss << "}\n";
   }
 
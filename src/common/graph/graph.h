@@ -65,15 +65,17 @@ class NodeBuilder {
 
 class Edge {
  public:
-  Edge(node_num_t source_number, node_num_t target_number)
-      : source_number_(source_number), target_number_(target_number) {}
+  Edge(node_num_t source_number, node_num_t target_number, std::string label = "")
+      : source_number_(source_number), target_number_(target_number), label_(label) {}
 
   node_num_t source_number() const { return source_number_; }
   node_num_t target_number() const { return target_number_; }
+  std::string label() const { return label_; }
 
  private:
   node_num_t source_number_;
   node_num_t target_number_;
+  std::string label_;
 };
 
 class Graph {
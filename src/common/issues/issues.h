@@ -100,6 +100,12 @@ class IssueTracker {
     issues_.push_back(Issue(kind, positions, message));
   }
 
+  // Appends the issues of the other issue tracker to the issues of this issue tracker.
+  void Merge(IssueTracker&& other) {
+    issues_.insert(issues_.end(), other.issues_.begin(), other.issues_.end());
+    other.issues_.clear();
+  }
+
   void PrintIssues(Format format, std::ostream* out) const {
     for (auto& issue : issues_) {
       switch (format) {
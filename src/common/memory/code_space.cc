@@ -0,0 +1,110 @@
+//
+//  code_space.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "code_space.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+
+#include "src/common/logging/logging.h"
+
+namespace common::memory {
+
+using ::common::logging::fail;
+
+namespace {
+
+int64_t RoundUpToPageSize(int64_t size) { return (size + kPageSize - 1) / kPageSize * kPageSize; }
+
+}  // namespace
+
+CodeSpace::CodeSpace(int64_t reserved_size)
+    : reservation_(RoundUpToPageSize(reserved_size), Permissions::kNone) {}
+
+data::DataView CodeSpace::AllocateChunk(int64_t size) {
+  if (size <= 0) {
+    fail("CodeSpace chunk size has to be positive");
+  }
+  int64_t chunk_size = RoundUpToPageSize(size);
+  if (committed_size_ + chunk_size > reserved_size()) {
+    fail("CodeSpace exhausted its reserved memory");
+  }
+  uint8_t* base = reservation_.data().base() + committed_size_;
+  if (mprotect(base, chunk_size, Permissions::kWrite) != 0) {
+    fail("mprotect failed");
+  }
+  chunks_.push_back(Chunk{
+      .offset = committed_size_,
+      .size = chunk_size,
+      .permissions = Permissions::kWrite,
+  });
+  committed_size_ += chunk_size;
+  return data::DataView(base, chunk_size);
+}
+
+void CodeSpace::ShrinkLastChunk(int64_t used_size) {
+  if (chunks_.empty()) {
+    fail("CodeSpace has no chunk to shrink");
+  }
+  Chunk& chunk = chunks_.back();
+  int64_t new_size = RoundUpToPageSize(used_size);
+  if (new_size > chunk.size) {
+    fail("CodeSpace can not grow chunk by shrinking it");
+  } else if (new_size == chunk.size) {
+    return;
+  }
+  uint8_t* unused_base = reservation_.data().base() + chunk.offset + new_size;
+  int64_t unused_size = chunk.size - new_size;
+  if (madvise(unused_base, unused_size, MADV_DONTNEED) != 0 ||
+      mprotect(unused_base, unused_size, Permissions::kNone) != 0) {
+    fail("releasing unused CodeSpace pages failed");
+  }
+  committed_size_ -= unused_size;
+  if (new_size == 0) {
+    chunks_.pop_back();
+  } else {
+    chunk.size = new_size;
+  }
+}
+
+void CodeSpace::ChangePermissions(data::DataView view, Permissions permissions) {
+  if ((permissions & Permissions::kExecute) && permissions != Permissions::kExecute) {
+    // Chunks are never writable and executable at the same time.
+    fail("Invalid permissions");
+  }
+  Chunk& chunk = FindChunk(view);
+  if (chunk.permissions == permissions) {
+    return;
+  }
+  if (mprotect(reservation_.data().base() + chunk.offset, chunk.size, permissions) != 0) {
+    fail("mprotect failed");
+  }
+  chunk.permissions = permissions;
+}
+
+Permissions CodeSpace::PermissionsOfChunk(data::DataView view) const {
+  return FindChunk(view).permissions;
+}
+
+CodeSpace::Chunk& CodeSpace::FindChunk(data::DataView view) {
+  return const_cast<Chunk&>(static_cast<const CodeSpace*>(this)->FindChunk(view));
+}
+
+const CodeSpace::Chunk& CodeSpace::FindChunk(data::DataView view) const {
+  int64_t offset = view.base() - reservation_.data().base();
+  auto it = std::lower_bound(
+      chunks_.begin(), chunks_.end(), offset,
+      [](const Chunk& chunk, int64_t chunk_offset) { return chunk.offset < chunk_offset; });
+  if (it == chunks_.end() || it->offset != offset) {
+    fail("view does not start at a CodeSpace chunk");
+  }
+  return *it;
+}
+
+}  // namespace common::memory
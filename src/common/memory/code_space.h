@@ -0,0 +1,67 @@
+//
+//  code_space.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef common_code_space_h
+#define common_code_space_h
+
+#include <cstdint>
+#include <vector>
+
+#include "src/common/data/data_view.h"
+#include "src/common/memory/memory.h"
+
+namespace common::memory {
+
+// Reserves a large contiguous address range for generated machine code and hands out page aligned
+// chunks of it. Pages only become accessible when they are part of a chunk. Each chunk has its own
+// permissions, such that code can be executable in one chunk while another chunk is still being
+// written.
+//
+// Since all chunks lie within the reserved range, code in one chunk can reference code in any other
+// chunk with 32 bit relative offsets as long as the reserved size does not exceed 2 GiB.
+class CodeSpace {
+ public:
+  static constexpr int64_t kDefaultReservedSize = int64_t{1} << 30;
+
+  explicit CodeSpace(int64_t reserved_size = kDefaultReservedSize);
+  CodeSpace(CodeSpace&&) = default;
+  CodeSpace(CodeSpace&) = delete;
+  CodeSpace& operator=(CodeSpace&&) = default;
+  CodeSpace& operator=(CodeSpace&) = delete;
+
+  int64_t reserved_size() const { return reservation_.data().size(); }
+  int64_t committed_size() const { return committed_size_; }
+  int64_t chunk_count() const { return int64_t(chunks_.size()); }
+
+  // Returns a writable chunk of at least the given size following all previously allocated chunks.
+  data::DataView AllocateChunk(int64_t size);
+  // Returns the pages at the end of the last allocated chunk that are not needed to hold the given
+  // number of bytes. The freed pages get used by the next allocated chunk.
+  void ShrinkLastChunk(int64_t used_size);
+  // Changes the permissions of the chunk starting at the base of the given view.
+  void ChangePermissions(data::DataView chunk, Permissions permissions);
+  Permissions PermissionsOfChunk(data::DataView chunk) const;
+
+ private:
+  struct Chunk {
+    int64_t offset;
+    int64_t size;
+    Permissions permissions;
+  };
+
+  Chunk& FindChunk(data::DataView chunk);
+  const Chunk& FindChunk(data::DataView chunk) const;
+
+  Memory reservation_;
+  int64_t committed_size_ = 0;
+  std::vector<Chunk> chunks_;
+};
+
+}  // namespace common::memory
+
+#endif /* common_code_space_h */
@@ -0,0 +1,85 @@
+//
+//  code_space_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/common/memory/code_space.h"
+
+#include "gtest/gtest.h"
+#include "src/common/memory/memory.h"
+
+namespace common::memory {
+
+TEST(CodeSpaceTest, AllocatesContiguousPageAlignedChunks) {
+  CodeSpace code_space(/*reserved_size=*/kPageSize * 16);
+  EXPECT_EQ(code_space.reserved_size(), kPageSize * 16);
+  EXPECT_EQ(code_space.committed_size(), 0);
+
+  data::DataView chunk_a = code_space.AllocateChunk(10);
+  data::DataView chunk_b = code_space.AllocateChunk(kPageSize + 1);
+
+  EXPECT_EQ(chunk_a.size(), kPageSize);
+  EXPECT_EQ(chunk_b.size(), kPageSize * 2);
+  EXPECT_EQ(chunk_b.base(), chunk_a.base() + kPageSize);
+  EXPECT_EQ(code_space.committed_size(), kPageSize * 3);
+  EXPECT_EQ(code_space.chunk_count(), 2);
+
+  chunk_a[0] = 42;
+  chunk_b[kPageSize * 2 - 1] = 123;
+  EXPECT_EQ(chunk_a[0], 42);
+  EXPECT_EQ(chunk_b[kPageSize * 2 - 1], 123);
+}
+
+TEST(CodeSpaceTest, ShrinkingLastChunkReusesPages) {
+  CodeSpace code_space(/*reserved_size=*/kPageSize * 16);
+
+  data::DataView chunk_a = code_space.AllocateChunk(kPageSize * 8);
+  chunk_a[kPageSize + 7] = 1;
+  code_space.ShrinkLastChunk(kPageSize + 8);
+  EXPECT_EQ(code_space.committed_size(), kPageSize * 2);
+  EXPECT_EQ(chunk_a[kPageSize + 7], 1);
+
+  data::DataView chunk_b = code_space.AllocateChunk(kPageSize);
+  EXPECT_EQ(chunk_b.base(), chunk_a.base() + kPageSize * 2);
+  EXPECT_EQ(chunk_b[0], 0);
+}
+
+TEST(CodeSpaceTest, ChangesPermissionsPerChunk) {
+  CodeSpace code_space(/*reserved_size=*/kPageSize * 16);
+
+  data::DataView chunk_a = code_space.AllocateChunk(kPageSize);
+  data::DataView chunk_b = code_space.AllocateChunk(kPageSize);
+  EXPECT_EQ(code_space.PermissionsOfChunk(chunk_a), Permissions::kWrite);
+
+  chunk_a[0] = 0xc3;  // ret
+  code_space.ChangePermissions(chunk_a, Permissions::kExecute);
+  EXPECT_EQ(code_space.PermissionsOfChunk(chunk_a), Permissions::kExecute);
+  EXPECT_EQ(code_space.PermissionsOfChunk(chunk_b), Permissions::kWrite);
+
+  chunk_b[0] = 0xc3;
+  ((void (*)(void))chunk_a.base())();
+
+  code_space.ChangePermissions(chunk_b, Permissions::kRead);
+  EXPECT_EQ(chunk_b[0], 0xc3);
+}
+
+TEST(CodeSpaceTest, FailsToMixWriteAndExecutePermissions) {
+  CodeSpace code_space(/*reserved_size=*/kPageSize * 16);
+  data::DataView chunk = code_space.AllocateChunk(kPageSize);
+
+  EXPECT_DEATH(code_space.ChangePermissions(
+                   chunk, Permissions(Permissions::kWrite | Permissions::kExecute)),
+               "Invalid permissions");
+}
+
+TEST(CodeSpaceTest, FailsWhenReservationIsExhausted) {
+  CodeSpace code_space(/*reserved_size=*/kPageSize * 2);
+  code_space.AllocateChunk(kPageSize);
+
+  EXPECT_DEATH(code_space.AllocateChunk(kPageSize * 2), "CodeSpace exhausted");
+}
+
+}  // namespace common::memory
@@ -0,0 +1,535 @@
+//
+//  coalescing_graph_colorer.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "coalescing_graph_colorer.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "src/ir/analyzers/dominator_tree_builder.h"
+#include "src/ir/analyzers/loop_nest_builder.h"
+#include "src/ir/info/loop_nest.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/instrs.h"
+#include "src/ir/representation/values.h"
+
+namespace ir_analyzers {
+namespace {
+
+using ::ir_info::color_t;
+
+// Loop depths beyond this do not increase weights further, which keeps weights finite.
+constexpr int64_t kMaxWeightedLoopDepth = 8;
+
+double WeightForLoopDepth(int64_t loop_depth) {
+  double weight = 1.0;
+  for (int64_t i = 0; i < std::min(loop_depth, kMaxWeightedLoopDepth); i++) {
+    weight *= 10.0;
+  }
+  return weight;
+}
+
+class IteratedCoalescing {
+ public:
+  IteratedCoalescing(const ir::Func* func, const ir_info::InterferenceGraph& graph,
+                     const ir_info::InterferenceGraphColors& preferred_colors,
+                     color_t register_color_count);
+
+  ir_info::InterferenceGraphColors Run();
+
+ private:
+  typedef int64_t node_t;
+  typedef int64_t move_t;
+
+  enum class NodeState {
+    kSimplify,
+    kFreeze,
+    kSpill,
+    kCoalesced,
+    kSelected,
+    kColored,
+  };
+
+  enum class MoveState {
+    kWorklist,
+    kActive,
+    kCoalesced,
+    kConstrained,
+    kFrozen,
+  };
+
+  struct Move {
+    node_t a;
+    node_t b;
+    MoveState state;
+  };
+
+  void Build(const ir::Func* func, const ir_info::InterferenceGraph& graph);
+  void AddMove(ir::value_num_t value_a, ir::value_num_t value_b, double weight,
+               std::map<std::pair<node_t, node_t>, double>& move_weights);
+  void AddEdge(node_t a, node_t b);
+  void MakeWorklists();
+
+  std::vector<node_t> Adjacent(node_t n) const;
+  std::vector<move_t> NodeMoves(node_t n) const;
+  bool MoveRelated(node_t n) const { return !NodeMoves(n).empty(); }
+  node_t GetAlias(node_t n) const;
+  void SetState(node_t n, NodeState state);
+
+  void Simplify();
+  void DecrementDegree(node_t n);
+  void EnableMoves(node_t n);
+  void Coalesce();
+  void AddWorklist(node_t n);
+  bool HaveConflictingPreferredColors(node_t u, node_t v) const;
+  bool Conservative(node_t u, node_t v) const;
+  void Combine(node_t u, node_t v);
+  void Freeze();
+  void FreezeMoves(node_t u);
+  void SelectSpill();
+  void AssignColors();
+
+  const color_t k_;
+
+  std::vector<ir::value_num_t> values_;
+  std::unordered_map<ir::value_num_t, node_t> nodes_;
+
+  std::vector<std::unordered_set<node_t>> adjacent_;
+  std::vector<int64_t> degrees_;
+  std::vector<double> spill_costs_;
+  std::vector<color_t> preferred_colors_;
+  std::vector<NodeState> states_;
+  std::vector<node_t> aliases_;
+  std::vector<color_t> colors_;
+
+  // Move numbers are ordered by descending weight, such that heavier moves get coalesced first.
+  std::vector<Move> moves_;
+  std::vector<std::vector<move_t>> node_moves_;
+
+  std::set<node_t> simplify_worklist_;
+  std::set<node_t> freeze_worklist_;
+  std::set<node_t> spill_worklist_;
+  std::set<move_t> move_worklist_;
+  std::vector<node_t> select_stack_;
+};
+
+IteratedCoalescing::IteratedCoalescing(const ir::Func* func,
+                                       const ir_info::InterferenceGraph& graph,
+                                       const ir_info::InterferenceGraphColors& preferred_colors,
+                                       color_t register_color_count)
+    : k_(register_color_count) {
+  values_.assign(graph.values().begin(), graph.values().end());
+  std::sort(values_.begin(), values_.end());
+  const std::size_t n = values_.size();
+  for (std::size_t i = 0; i < n; i++) {
+    nodes_.insert({values_.at(i), node_t(i)});
+  }
+  adjacent_.resize(n);
+  degrees_.resize(n, 0);
+  spill_costs_.resize(n, 0.0);
+  preferred_colors_.resize(n, ir_info::kNoColor);
+  states_.resize(n, NodeState::kSimplify);
+  aliases_.resize(n);
+  colors_.resize(n, ir_info::kNoColor);
+  node_moves_.resize(n);
+  for (std::size_t i = 0; i < n; i++) {
+    aliases_.at(i) = node_t(i);
+    preferred_colors_.at(i) = preferred_colors.GetColor(values_.at(i));
+  }
+
+  Build(func, graph);
+}
+
+void IteratedCoalescing::Build(const ir::Func* func, const ir_info::InterferenceGraph& graph) {
+  for (ir::value_num_t value : values_) {
+    for (ir::value_num_t neighbor : graph.GetNeighbors(value)) {
+      if (value < neighbor) {
+        AddEdge(nodes_.at(value), nodes_.at(neighbor));
+      }
+    }
+  }
+
+  std::unordered_map<ir::block_num_t, int64_t> loop_depths;
+  if (func->entry_block() != nullptr) {
+    const ir_info::LoopNest loop_nest = BuildLoopNestForFunc(func, BuildDominatorTreeForFunc(func));
+    for (auto& block : func->blocks()) {
+      loop_depths[block->number()] = loop_nest.LoopDepthOf(block->number());
+    }
+  }
+  std::map<std::pair<node_t, node_t>, double> move_weights;
+  for (auto& block : func->blocks()) {
+    const double weight = WeightForLoopDepth(loop_depths[block->number()]);
+    for (auto& instr : block->instrs()) {
+      for (auto& defined_value : instr->DefinedValues()) {
+        if (auto it = nodes_.find(defined_value->number()); it != nodes_.end()) {
+          spill_costs_.at(it->second) += weight;
+        }
+      }
+      for (auto& used_value : instr->UsedValues()) {
+        if (used_value->kind() != ir::Value::Kind::kComputed) {
+          continue;
+        }
+        auto used_computed = static_cast<ir::Computed*>(used_value.get());
+        if (auto it = nodes_.find(used_computed->number()); it != nodes_.end()) {
+          spill_costs_.at(it->second) += weight;
+        }
+      }
+
+      if (instr->instr_kind() == ir::InstrKind::kMov) {
+        auto mov_instr = static_cast<ir::MovInstr*>(instr.get());
+        if (mov_instr->origin()->kind() == ir::Value::Kind::kComputed) {
+          auto origin = static_cast<ir::Computed*>(mov_instr->origin().get());
+          AddMove(mov_instr->result()->number(), origin->number(), weight, move_weights);
+        }
+      } else if (instr->instr_kind() == ir::InstrKind::kPhi) {
+        auto phi_instr = static_cast<ir::PhiInstr*>(instr.get());
+        for (auto& arg : phi_instr->args()) {
+          if (arg->value()->kind() != ir::Value::Kind::kComputed) {
+            continue;
+          }
+          auto origin = static_cast<ir::Computed*>(arg->value().get());
+          double parent_weight = WeightForLoopDepth(loop_depths[arg->origin()]);
+          AddMove(phi_instr->result()->number(), origin->number(), parent_weight, move_weights);
+        }
+      }
+    }
+  }
+
+  std::vector<std::pair<std::pair<node_t, node_t>, double>> sorted_moves(move_weights.begin(),
+                                                                         move_weights.end());
+  std::stable_sort(sorted_moves.begin(), sorted_moves.end(),
+                   [](const auto& a, const auto& b) { return a.second > b.second; });
+  for (auto& [nodes, weight] : sorted_moves) {
+    move_t move = move_t(moves_.size());
+    moves_.push_back(Move{.a = nodes.first, .b = nodes.second, .state = MoveState::kWorklist});
+    node_moves_.at(nodes.first).push_back(move);
+    node_moves_.at(nodes.second).push_back(move);
+    move_worklist_.insert(move);
+  }
+}
+
+void IteratedCoalescing::AddMove(ir::value_num_t value_a, ir::value_num_t value_b, double weight,
+                                 std::map<std::pair<node_t, node_t>, double>& move_weights) {
+  auto it_a = nodes_.find(value_a);
+  auto it_b = nodes_.find(value_b);
+  if (it_a == nodes_.end() || it_b == nodes_.end() || it_a->second == it_b->second) {
+    return;
+  }
+  node_t a = std::min(it_a->second, it_b->second);
+  node_t b = std::max(it_a->second, it_b->second);
+  move_weights[{a, b}] += weight;
+}
+
+void IteratedCoalescing::AddEdge(node_t a, node_t b) {
+  if (a == b || adjacent_.at(a).contains(b)) {
+    return;
+  }
+  adjacent_.at(a).insert(b);
+  adjacent_.at(b).insert(a);
+  degrees_.at(a)++;
+  degrees_.at(b)++;
+}
+
+void IteratedCoalescing::MakeWorklists() {
+  for (node_t n = 0; n < node_t(values_.size()); n++) {
+    if (degrees_.at(n) >= k_) {
+      SetState(n, NodeState::kSpill);
+    } else if (MoveRelated(n)) {
+      SetState(n, NodeState::kFreeze);
+    } else {
+      SetState(n, NodeState::kSimplify);
+    }
+  }
+}
+
+std::vector<IteratedCoalescing::node_t> IteratedCoalescing::Adjacent(node_t n) const {
+  std::vector<node_t> adjacent;
+  for (node_t m : adjacent_.at(n)) {
+    if (states_.at(m) != NodeState::kSelected && states_.at(m) != NodeState::kCoalesced) {
+      adjacent.push_back(m);
+    }
+  }
+  std::sort(adjacent.begin(), adjacent.end());
+  return adjacent;
+}
+
+std::vector<IteratedCoalescing::move_t> IteratedCoalescing::NodeMoves(node_t n) const {
+  std::vector<move_t> moves;
+  for (move_t move : node_moves_.at(n)) {
+    MoveState state = moves_.at(move).state;
+    if (state == MoveState::kWorklist || state == MoveState::kActive) {
+      moves.push_back(move);
+    }
+  }
+  return moves;
+}
+
+IteratedCoalescing::node_t IteratedCoalescing::GetAlias(node_t n) const {
+  while (states_.at(n) == NodeState::kCoalesced) {
+    n = aliases_.at(n);
+  }
+  return n;
+}
+
+void IteratedCoalescing::SetState(node_t n, NodeState state) {
+  switch (states_.at(n)) {
+    case NodeState::kSimplify:
+      simplify_worklist_.erase(n);
+      break;
+    case NodeState::kFreeze:
+      freeze_worklist_.erase(n);
+      break;
+    case NodeState::kSpill:
+      spill_worklist_.erase(n);
+      break;
+    default:
+      break;
+  }
+  states_.at(n) = state;
+  switch (state) {
+    case NodeState::kSimplify:
+      simplify_worklist_.insert(n);
+      break;
+    case NodeState::kFreeze:
+      freeze_worklist_.insert(n);
+      break;
+    case NodeState::kSpill:
+      spill_worklist_.insert(n);
+      break;
+    default:
+      break;
+  }
+}
+
+ir_info::InterferenceGraphColors IteratedCoalescing::Run() {
+  MakeWorklists();
+  while (!simplify_worklist_.empty() || !move_worklist_.empty() || !freeze_worklist_.empty() ||
+         !spill_worklist_.empty()) {
+    if (!simplify_worklist_.empty()) {
+      Simplify();
+    } else if (!move_worklist_.empty()) {
+      Coalesce();
+    } else if (!freeze_worklist_.empty()) {
+      Freeze();
+    } else {
+      SelectSpill();
+    }
+  }
+  AssignColors();
+
+  ir_info::InterferenceGraphColors colors;
+  for (node_t n = 0; n < node_t(values_.size()); n++) {
+    colors.SetColor(values_.at(n), colors_.at(GetAlias(n)));
+  }
+  return colors;
+}
+
+void IteratedCoalescing::Simplify() {
+  node_t n = *simplify_worklist_.begin();
+  SetState(n, NodeState::kSelected);
+  select_stack_.push_back(n);
+  for (node_t m : Adjacent(n)) {
+    DecrementDegree(m);
+  }
+}
+
+void IteratedCoalescing::DecrementDegree(node_t n) {
+  int64_t degree = degrees_.at(n)--;
+  if (degree != k_) {
+    return;
+  }
+  EnableMoves(n);
+  for (node_t m : Adjacent(n)) {
+    EnableMoves(m);
+  }
+  if (states_.at(n) != NodeState::kSpill) {
+    return;
+  }
+  SetState(n, MoveRelated(n) ? NodeState::kFreeze : NodeState::kSimplify);
+}
+
+void IteratedCoalescing::EnableMoves(node_t n) {
+  for (move_t move : NodeMoves(n)) {
+    if (moves_.at(move).state == MoveState::kActive) {
+      moves_.at(move).state = MoveState::kWorklist;
+      move_worklist_.insert(move);
+    }
+  }
+}
+
+void IteratedCoalescing::Coalesce() {
+  move_t move = *move_worklist_.begin();
+  move_worklist_.erase(move_worklist_.begin());
+  node_t u = GetAlias(moves_.at(move).a);
+  node_t v = GetAlias(moves_.at(move).b);
+  if (u == v) {
+    moves_.at(move).state = MoveState::kCoalesced;
+    AddWorklist(u);
+  } else if (adjacent_.at(u).contains(v) || HaveConflictingPreferredColors(u, v)) {
+    moves_.at(move).state = MoveState::kConstrained;
+    AddWorklist(u);
+    AddWorklist(v);
+  } else if (Conservative(u, v)) {
+    moves_.at(move).state = MoveState::kCoalesced;
+    Combine(u, v);
+    AddWorklist(u);
+  } else {
+    moves_.at(move).state = MoveState::kActive;
+  }
+}
+
+void IteratedCoalescing::AddWorklist(node_t n) {
+  if (states_.at(n) == NodeState::kFreeze && !MoveRelated(n) && degrees_.at(n) < k_) {
+    SetState(n, NodeState::kSimplify);
+  }
+}
+
+bool IteratedCoalescing::HaveConflictingPreferredColors(node_t u, node_t v) const {
+  color_t preferred_u = preferred_colors_.at(u);
+  color_t preferred_v = preferred_colors_.at(v);
+  return preferred_u != ir_info::kNoColor && preferred_v != ir_info::kNoColor &&
+         preferred_u != preferred_v;
+}
+
+bool IteratedCoalescing::Conservative(node_t u, node_t v) const {
+  // Briggs: the combined node has fewer than k neighbors of significant degree.
+  std::vector<node_t> adjacent_u = Adjacent(u);
+  std::vector<node_t> adjacent_v = Adjacent(v);
+  std::vector<node_t> adjacent;
+  std::set_union(adjacent_u.begin(), adjacent_u.end(), adjacent_v.begin(), adjacent_v.end(),
+                 std::back_inserter(adjacent));
+  int64_t significant_count = 0;
+  for (node_t n : adjacent) {
+    if (degrees_.at(n) >= k_) {
+      significant_count++;
+    }
+  }
+  return significant_count < k_;
+}
+
+void IteratedCoalescing::Combine(node_t u, node_t v) {
+  SetState(v, NodeState::kCoalesced);
+  aliases_.at(v) = u;
+  node_moves_.at(u).insert(node_moves_.at(u).end(), node_moves_.at(v).begin(),
+                           node_moves_.at(v).end());
+  spill_costs_.at(u) += spill_costs_.at(v);
+  if (preferred_colors_.at(u) == ir_info::kNoColor) {
+    preferred_colors_.at(u) = preferred_colors_.at(v);
+  }
+  EnableMoves(v);
+  for (node_t t : Adjacent(v)) {
+    AddEdge(t, u);
+    DecrementDegree(t);
+  }
+  if (degrees_.at(u) >= k_ && states_.at(u) == NodeState::kFreeze) {
+    SetState(u, NodeState::kSpill);
+  }
+}
+
+void IteratedCoalescing::Freeze() {
+  node_t u = *freeze_worklist_.begin();
+  SetState(u, NodeState::kSimplify);
+  FreezeMoves(u);
+}
+
+void IteratedCoalescing::FreezeMoves(node_t u) {
+  for (move_t move : NodeMoves(u)) {
+    node_t x = moves_.at(move).a;
+    node_t y = moves_.at(move).b;
+    node_t v = (GetAlias(y) == GetAlias(u)) ? GetAlias(x) : GetAlias(y);
+    if (moves_.at(move).state == MoveState::kWorklist) {
+      move_worklist_.erase(move);
+    }
+    moves_.at(move).state = MoveState::kFrozen;
+    if (states_.at(v) == NodeState::kFreeze && !MoveRelated(v) && degrees_.at(v) < k_) {
+      SetState(v, NodeState::kSimplify);
+    }
+  }
+}
+
+void IteratedCoalescing::SelectSpill() {
+  // Spill the node that is cheapest to spill relative to how much it constrains other nodes.
+  node_t best = *spill_worklist_.begin();
+  for (node_t n : spill_worklist_) {
+    if (spill_costs_.at(n) * double(degrees_.at(best)) <
+        spill_costs_.at(best) * double(degrees_.at(n))) {
+      best = n;
+    }
+  }
+  SetState(best, NodeState::kSimplify);
+  FreezeMoves(best);
+}
+
+void IteratedCoalescing::AssignColors() {
+  while (!select_stack_.empty()) {
+    node_t n = select_stack_.back();
+    select_stack_.pop_back();
+
+    // Colors preferred by neighbors that are not colored yet are reserved for them, such that
+    // e.g. func args colored late still end up in their arg registers.
+    std::unordered_set<color_t> neighbor_colors;
+    std::unordered_set<color_t> reserved_colors;
+    for (node_t w : adjacent_.at(n)) {
+      node_t alias = GetAlias(w);
+      if (states_.at(alias) == NodeState::kColored) {
+        neighbor_colors.insert(colors_.at(alias));
+      } else if (preferred_colors_.at(alias) != ir_info::kNoColor) {
+        reserved_colors.insert(preferred_colors_.at(alias));
+      }
+    }
+    auto is_free = [&](color_t color) {
+      return color != ir_info::kNoColor && !neighbor_colors.contains(color) &&
+             !reserved_colors.contains(color);
+    };
+
+    color_t color = ir_info::kNoColor;
+    if (color_t preferred = preferred_colors_.at(n);
+        preferred != ir_info::kNoColor && !neighbor_colors.contains(preferred)) {
+      color = preferred;
+    }
+    // Biased coloring: pick the color of a move partner, so the move becomes a no-op.
+    for (move_t move : node_moves_.at(n)) {
+      if (color != ir_info::kNoColor) {
+        break;
+      }
+      node_t partner = GetAlias(moves_.at(move).a);
+      if (partner == n) {
+        partner = GetAlias(moves_.at(move).b);
+      }
+      if (states_.at(partner) == NodeState::kColored && colors_.at(partner) < k_ &&
+          is_free(colors_.at(partner))) {
+        color = colors_.at(partner);
+      }
+    }
+    // Use the lowest free register or otherwise the lowest free stack color.
+    for (color_t c = 0; color == ir_info::kNoColor; c++) {
+      if (is_free(c) || (c >= k_ && !neighbor_colors.contains(c))) {
+        color = c;
+      }
+    }
+    colors_.at(n) = color;
+    states_.at(n) = NodeState::kColored;
+  }
+}
+
+}  // namespace
+
+const ir_info::InterferenceGraphColors ColorInterferenceGraphWithCoalescing(
+    const ir::Func* func, const ir_info::InterferenceGraph& graph,
+    const ir_info::InterferenceGraphColors& preferred_colors,
+    ir_info::color_t register_color_count) {
+  return IteratedCoalescing(func, graph, preferred_colors, register_color_count).Run();
+}
+
+}  // namespace ir_analyzers
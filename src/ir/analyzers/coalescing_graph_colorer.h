@@ -0,0 +1,34 @@
+//
+//  coalescing_graph_colorer.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_analyzers_coalescing_graph_colorer_h
+#define ir_analyzers_coalescing_graph_colorer_h
+
+#include "src/ir/info/interference_graph.h"
+#include "src/ir/representation/func.h"
+
+namespace ir_analyzers {
+
+// Colors the interference graph of the function with iterated register coalescing (George and
+// Appel). Values related by mov or phi instructions get coalesced if that keeps the graph
+// colorable with register_color_count colors (Briggs' conservative test), which turns the moves
+// into no-ops. Moves and spill costs are weighted by loop depth, such that moves in loops get
+// coalesced first and values used in loops get spilled last.
+//
+// Colors below register_color_count are registers. Values that do not fit into registers receive
+// the lowest color from register_color_count upwards not used by any of their neighbors.
+// Preferred colors are honored where possible: nodes avoid colors preferred by their uncolored
+// neighbors and moves between nodes with different preferred colors do not get coalesced.
+const ir_info::InterferenceGraphColors ColorInterferenceGraphWithCoalescing(
+    const ir::Func* func, const ir_info::InterferenceGraph& graph,
+    const ir_info::InterferenceGraphColors& preferred_colors,
+    ir_info::color_t register_color_count);
+
+}  // namespace ir_analyzers
+
+#endif /* ir_analyzers_coalescing_graph_colorer_h */
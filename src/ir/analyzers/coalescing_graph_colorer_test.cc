@@ -0,0 +1,137 @@
+//
+//  coalescing_graph_colorer_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/analyzers/coalescing_graph_colorer.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "src/ir/analyzers/interference_graph_builder.h"
+#include "src/ir/analyzers/live_range_analyzer.h"
+#include "src/ir/info/func_live_ranges.h"
+#include "src/ir/info/interference_graph.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+
+namespace ir_analyzers {
+namespace {
+
+using ::ir_info::InterferenceGraphColors;
+
+InterferenceGraphColors ColorFunc(const ir::Func* func,
+                                  const InterferenceGraphColors& preferred_colors,
+                                  ir_info::color_t register_color_count) {
+  const ir_info::FuncLiveRanges live_ranges = FindLiveRangesForFunc(func);
+  const ir_info::InterferenceGraph graph = BuildInterferenceGraphForFunc(func, live_ranges);
+  return ColorInterferenceGraphWithCoalescing(func, graph, preferred_colors,
+                                              register_color_count);
+}
+
+TEST(ColorInterferenceGraphWithCoalescingTest, CoalescesMoves) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f(%0:i64) => (i64) {
+{0}
+  %1:i64 = iadd %0, #1:i64
+  %2:i64 = mov %1
+  %3:i64 = mov %2
+  %4:i64 = iadd %3, %0
+  ret %4
+}
+)ir");
+
+  const InterferenceGraphColors colors =
+      ColorFunc(program->GetFunc(0), InterferenceGraphColors(), /*register_color_count=*/14);
+
+  EXPECT_EQ(colors.GetColor(1), colors.GetColor(2));
+  EXPECT_EQ(colors.GetColor(2), colors.GetColor(3));
+  EXPECT_NE(colors.GetColor(0), colors.GetColor(3));
+}
+
+TEST(ColorInterferenceGraphWithCoalescingTest, DoesNotCoalesceInterferingValues) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f(%0:i64) => (i64) {
+{0}
+  %1:i64 = mov %0
+  %2:i64 = iadd %1, %0
+  ret %2
+}
+)ir");
+
+  const InterferenceGraphColors colors =
+      ColorFunc(program->GetFunc(0), InterferenceGraphColors(), /*register_color_count=*/14);
+
+  EXPECT_NE(colors.GetColor(0), colors.GetColor(1));
+}
+
+TEST(ColorInterferenceGraphWithCoalescingTest, SpillsValuesOutsideLoopsFirst) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f(%0:i64, %1:i64) => (i64) {
+{0}
+  jmp {1}
+{1}
+  %2:i64 = iadd %1, #1:i64
+  %3:b = ilss %2, #10:i64
+  jcc %3, {1}, {2}
+{2}
+  %4:i64 = iadd %0, #1:i64
+  ret %4
+}
+)ir");
+
+  const InterferenceGraphColors colors =
+      ColorFunc(program->GetFunc(0), InterferenceGraphColors(), /*register_color_count=*/2);
+
+  EXPECT_GE(colors.GetColor(0), 2);
+  EXPECT_LT(colors.GetColor(1), 2);
+  EXPECT_LT(colors.GetColor(2), 2);
+  EXPECT_LT(colors.GetColor(3), 2);
+}
+
+TEST(ColorInterferenceGraphWithCoalescingTest, PrefersPreferredColors) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f(%0:i64, %1:i64) => (i64) {
+{0}
+  %2:i64 = iadd %0, %1
+  ret %2
+}
+)ir");
+  InterferenceGraphColors preferred_colors;
+  preferred_colors.SetColor(0, 5);
+  preferred_colors.SetColor(1, 4);
+  preferred_colors.SetColor(2, 0);
+
+  const InterferenceGraphColors colors =
+      ColorFunc(program->GetFunc(0), preferred_colors, /*register_color_count=*/14);
+
+  EXPECT_EQ(colors.GetColor(0), 5);
+  EXPECT_EQ(colors.GetColor(1), 4);
+  EXPECT_EQ(colors.GetColor(2), 0);
+}
+
+TEST(ColorInterferenceGraphWithCoalescingTest, DoesNotCoalesceValuesWithDifferentPreferredColors) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f(%0:i64) => (i64) {
+{0}
+  %1:i64 = mov %0
+  ret %1
+}
+)ir");
+  InterferenceGraphColors preferred_colors;
+  preferred_colors.SetColor(0, 5);
+  preferred_colors.SetColor(1, 0);
+
+  const InterferenceGraphColors colors =
+      ColorFunc(program->GetFunc(0), preferred_colors, /*register_color_count=*/14);
+
+  EXPECT_EQ(colors.GetColor(0), 5);
+  EXPECT_EQ(colors.GetColor(1), 0);
+}
+
+}  // namespace
+}  // namespace ir_analyzers
@@ -0,0 +1,159 @@
+//
+//  dataflow_solver.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "dataflow_solver.h"
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+#include "src/common/logging/logging.h"
+
+namespace ir_analyzers {
+
+using ::common::data::BitVector;
+using ::common::logging::fail;
+
+namespace {
+
+std::vector<ir::block_num_t> SortedBlockNums(const std::unordered_set<ir::block_num_t>& bnums) {
+  std::vector<ir::block_num_t> sorted(bnums.begin(), bnums.end());
+  std::sort(sorted.begin(), sorted.end());
+  return sorted;
+}
+
+}  // namespace
+
+BitVector DataflowProblem::BoundarySet(const ir::Func* func) const {
+  return BitVector(func->computed_count());
+}
+
+const BitVector& DataflowResults::EntrySetOf(ir::block_num_t bnum) const {
+  return block_sets_.at(bnum).entry_set;
+}
+
+const BitVector& DataflowResults::ExitSetOf(ir::block_num_t bnum) const {
+  return block_sets_.at(bnum).exit_set;
+}
+
+std::vector<const ir::Block*> GetBlocksInReversePostorder(const ir::Func* func) {
+  std::vector<const ir::Block*> postorder;
+  postorder.reserve(func->blocks().size());
+  std::unordered_set<ir::block_num_t> visited;
+  if (func->entry_block() != nullptr) {
+    // Each stack entry holds a block and its children that have not been visited yet.
+    std::vector<std::pair<const ir::Block*, std::vector<ir::block_num_t>>> stack;
+    visited.insert(func->entry_block_num());
+    stack.push_back({func->entry_block(), SortedBlockNums(func->entry_block()->children())});
+    while (!stack.empty()) {
+      auto& [block, children] = stack.back();
+      if (children.empty()) {
+        postorder.push_back(block);
+        stack.pop_back();
+        continue;
+      }
+      // Visit children in ascending order of their block numbers.
+      ir::block_num_t child_num = children.front();
+      children.erase(children.begin());
+      if (!visited.insert(child_num).second) {
+        continue;
+      }
+      const ir::Block* child = func->GetBlock(child_num);
+      stack.push_back({child, SortedBlockNums(child->children())});
+    }
+  }
+  std::vector<const ir::Block*> order(postorder.rbegin(), postorder.rend());
+  for (auto& block : func->blocks()) {
+    if (!visited.contains(block->number())) {
+      order.push_back(block.get());
+    }
+  }
+  return order;
+}
+
+DataflowResults SolveDataflowProblem(const ir::Func* func, const DataflowProblem& problem) {
+  const bool forward = problem.direction() == DataflowDirection::kForward;
+  const bool is_union = problem.meet() == DataflowMeet::kUnion;
+  const int64_t set_size = func->computed_count();
+
+  std::vector<const ir::Block*> order = GetBlocksInReversePostorder(func);
+  if (!forward) {
+    std::reverse(order.begin(), order.end());
+  }
+  std::unordered_map<ir::block_num_t, int64_t> order_indices;
+  for (std::size_t i = 0; i < order.size(); i++) {
+    order_indices.insert({order.at(i)->number(), int64_t(i)});
+  }
+
+  const BitVector boundary_set = problem.BoundarySet(func);
+  if (boundary_set.size() != set_size) {
+    fail("dataflow boundary set has unexpected size");
+  }
+  const BitVector initial_set(set_size, /*value=*/!is_union);
+
+  DataflowResults results;
+  for (const ir::Block* block : order) {
+    results.block_sets_.insert({block->number(), DataflowResults::BlockSets{
+                                                     .entry_set = initial_set,
+                                                     .exit_set = initial_set,
+                                                 }});
+  }
+
+  BitVector pending(int64_t(order.size()), /*value=*/true);
+  BitVector output(set_size);
+  while (!pending.IsEmpty()) {
+    for (std::size_t i = 0; i < order.size(); i++) {
+      if (!pending.Get(i)) {
+        continue;
+      }
+      pending.Reset(i);
+      const ir::Block* block = order.at(i);
+      DataflowResults::BlockSets& block_sets = results.block_sets_.at(block->number());
+      BitVector& input = forward ? block_sets.entry_set : block_sets.exit_set;
+      const std::unordered_set<ir::block_num_t>& preds =
+          forward ? block->parents() : block->children();
+
+      // Meet the outputs of all predecessors in the direction of the problem.
+      bool has_boundary = forward ? block->number() == func->entry_block_num() : preds.empty();
+      if (has_boundary) {
+        input = boundary_set;
+      } else {
+        input = initial_set;
+      }
+      for (ir::block_num_t pred_num : preds) {
+        const ir::Block* pred = func->GetBlock(pred_num);
+        const DataflowResults::BlockSets& pred_sets = results.block_sets_.at(pred_num);
+        const BitVector& pred_output = forward ? pred_sets.exit_set : pred_sets.entry_set;
+        const ir::Block* parent = forward ? pred : block;
+        const ir::Block* child = forward ? block : pred;
+        if (is_union) {
+          input.UnionWith(pred_output);
+          problem.TransferEdge(parent, child, input);
+        } else {
+          BitVector edge_set = pred_output;
+          problem.TransferEdge(parent, child, edge_set);
+          input.IntersectWith(edge_set);
+        }
+      }
+
+      problem.Transfer(block, input, output);
+      results.transfer_count_++;
+      BitVector& old_output = forward ? block_sets.exit_set : block_sets.entry_set;
+      if (output == old_output) {
+        continue;
+      }
+      std::swap(old_output, output);
+      for (ir::block_num_t succ_num : forward ? block->children() : block->parents()) {
+        pending.Set(order_indices.at(succ_num));
+      }
+    }
+  }
+  return results;
+}
+
+}  // namespace ir_analyzers
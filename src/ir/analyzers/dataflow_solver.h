@@ -0,0 +1,90 @@
+//
+//  dataflow_solver.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_analyzers_dataflow_solver_h
+#define ir_analyzers_dataflow_solver_h
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "src/common/data/bit_vector.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/num_types.h"
+
+namespace ir_analyzers {
+
+enum class DataflowDirection {
+  kForward,
+  kBackward,
+};
+
+enum class DataflowMeet {
+  kUnion,
+  kIntersection,
+};
+
+// Describes a dataflow problem over sets of values of a function, represented as bit vectors
+// indexed by value_num_t.
+class DataflowProblem {
+ public:
+  virtual ~DataflowProblem() = default;
+
+  virtual DataflowDirection direction() const = 0;
+  virtual DataflowMeet meet() const { return DataflowMeet::kUnion; }
+
+  // Returns the set flowing into blocks without predecessors in the direction of the problem, that
+  // is the entry set of the entry block for forward problems and the exit set of blocks without
+  // children for backward problems. Empty by default.
+  virtual common::data::BitVector BoundarySet(const ir::Func* func) const;
+
+  // Computes the set at the end of the block in the direction of the problem from the set at its
+  // start, i.e. the exit set from the entry set for forward problems and vice versa. The output has
+  // the size of the input but arbitrary contents and has to be overwritten.
+  virtual void Transfer(const ir::Block* block, const common::data::BitVector& input,
+                        common::data::BitVector& output) const = 0;
+
+  // Adds values that flow along the control flow edge from parent to child, independent of the
+  // sets of either block, e.g. values inherited by phi instructions. Does nothing by default.
+  virtual void TransferEdge(const ir::Block* /*parent*/, const ir::Block* /*child*/,
+                            common::data::BitVector& /*set*/) const {}
+};
+
+class DataflowResults {
+ public:
+  const common::data::BitVector& EntrySetOf(ir::block_num_t bnum) const;
+  const common::data::BitVector& ExitSetOf(ir::block_num_t bnum) const;
+
+  // Returns how often transfer functions were applied until the solution became stable.
+  int64_t transfer_count() const { return transfer_count_; }
+
+ private:
+  struct BlockSets {
+    common::data::BitVector entry_set;
+    common::data::BitVector exit_set;
+  };
+
+  std::unordered_map<ir::block_num_t, BlockSets> block_sets_;
+  int64_t transfer_count_ = 0;
+
+  friend DataflowResults SolveDataflowProblem(const ir::Func* func,
+                                              const DataflowProblem& problem);
+};
+
+// Returns the blocks of the function in reverse postorder of a depth first search from the entry
+// block, followed by all unreachable blocks.
+std::vector<const ir::Block*> GetBlocksInReversePostorder(const ir::Func* func);
+
+// Solves the dataflow problem with a worklist that visits blocks in reverse postorder for forward
+// problems and in postorder for backward problems.
+DataflowResults SolveDataflowProblem(const ir::Func* func, const DataflowProblem& problem);
+
+}  // namespace ir_analyzers
+
+#endif /* ir_analyzers_dataflow_solver_h */
@@ -0,0 +1,144 @@
+//
+//  dataflow_solver_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/analyzers/dataflow_solver.h"
+
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/common/data/bit_vector.h"
+#include "src/ir/analyzers/live_range_analyzer.h"
+#include "src/ir/info/func_live_ranges.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/num_types.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+
+namespace ir_analyzers {
+namespace {
+
+using ::common::data::BitVector;
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+
+constexpr char kLoopProgram[] = R"ir(
+@0 f(%0:i64) => (i64) {
+{0}
+  jmp {1}
+{1}
+  %1:i64 = phi %0{0}, %3{2}
+  %2:b = ilss %1, #10:i64
+  jcc %2, {2}, {3}
+{2}
+  %3:i64 = iadd %1, #1:i64
+  jmp {1}
+{3}
+  ret %1
+}
+)ir";
+
+constexpr char kDiamondProgram[] = R"ir(
+@0 f(%0:b, %1:i64) => (i64) {
+{0}
+  %2:i64 = iadd %1, #1:i64
+  jcc %0, {1}, {2}
+{1}
+  %3:i64 = iadd %2, #2:i64
+  jmp {3}
+{2}
+  %4:i64 = iadd %2, #3:i64
+  jmp {3}
+{3}
+  %5:i64 = phi %3{1}, %4{2}
+  ret %5
+}
+)ir";
+
+std::vector<ir::block_num_t> BlockNums(const std::vector<const ir::Block*>& blocks) {
+  std::vector<ir::block_num_t> bnums;
+  for (const ir::Block* block : blocks) {
+    bnums.push_back(block->number());
+  }
+  return bnums;
+}
+
+// Values are available at a point if they are defined on all paths from the function entry.
+class AvailableValuesProblem : public DataflowProblem {
+ public:
+  DataflowDirection direction() const override { return DataflowDirection::kForward; }
+  DataflowMeet meet() const override { return DataflowMeet::kIntersection; }
+
+  BitVector BoundarySet(const ir::Func* func) const override {
+    BitVector boundary_set(func->computed_count());
+    for (auto& arg : func->args()) {
+      boundary_set.Set(arg->number());
+    }
+    return boundary_set;
+  }
+
+  void Transfer(const ir::Block* block, const BitVector& input, BitVector& output) const override {
+    output = input;
+    for (auto& instr : block->instrs()) {
+      for (auto& defined_value : instr->DefinedValues()) {
+        output.Set(defined_value->number());
+      }
+    }
+  }
+};
+
+TEST(GetBlocksInReversePostorderTest, OrdersLoop) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(kLoopProgram);
+
+  EXPECT_THAT(BlockNums(GetBlocksInReversePostorder(program->GetFunc(0))),
+              ElementsAre(0, 1, 3, 2));
+}
+
+TEST(GetBlocksInReversePostorderTest, OrdersDiamond) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(kDiamondProgram);
+
+  EXPECT_THAT(BlockNums(GetBlocksInReversePostorder(program->GetFunc(0))),
+              ElementsAre(0, 2, 1, 3));
+}
+
+TEST(SolveDataflowProblemTest, SolvesAvailableValuesInDiamond) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(kDiamondProgram);
+  const ir::Func* func = program->GetFunc(0);
+
+  DataflowResults results = SolveDataflowProblem(func, AvailableValuesProblem());
+
+  EXPECT_EQ(results.EntrySetOf(0).ToString(), "{0, 1}");
+  EXPECT_EQ(results.ExitSetOf(0).ToString(), "{0, 1, 2}");
+  EXPECT_EQ(results.ExitSetOf(1).ToString(), "{0, 1, 2, 3}");
+  EXPECT_EQ(results.ExitSetOf(2).ToString(), "{0, 1, 2, 4}");
+  EXPECT_EQ(results.EntrySetOf(3).ToString(), "{0, 1, 2}");
+  EXPECT_EQ(results.ExitSetOf(3).ToString(), "{0, 1, 2, 5}");
+  EXPECT_EQ(results.transfer_count(), 4);
+}
+
+TEST(FindLiveRangesForFuncTest, PropagatesLivenessAroundLoop) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(kLoopProgram);
+  const ir::Func* func = program->GetFunc(0);
+
+  const ir_info::FuncLiveRanges live_ranges = FindLiveRangesForFunc(func);
+
+  // Phi results stay live up to the parent blocks, where phi resolution defines them.
+  EXPECT_THAT(live_ranges.GetBlockLiveRanges(0).GetEntrySet(), UnorderedElementsAre(0, 1));
+  EXPECT_THAT(live_ranges.GetBlockLiveRanges(0).GetExitSet(), UnorderedElementsAre(0, 1));
+  EXPECT_THAT(live_ranges.GetBlockLiveRanges(1).GetEntrySet(), UnorderedElementsAre(1));
+  EXPECT_THAT(live_ranges.GetBlockLiveRanges(1).GetExitSet(), UnorderedElementsAre(1));
+  EXPECT_THAT(live_ranges.GetBlockLiveRanges(2).GetEntrySet(), UnorderedElementsAre(1));
+  EXPECT_THAT(live_ranges.GetBlockLiveRanges(2).GetExitSet(), UnorderedElementsAre(1, 3));
+  EXPECT_THAT(live_ranges.GetBlockLiveRanges(3).GetEntrySet(), UnorderedElementsAre(1));
+  EXPECT_THAT(live_ranges.GetBlockLiveRanges(3).GetExitSet(), UnorderedElementsAre());
+}
+
+}  // namespace
+}  // namespace ir_analyzers
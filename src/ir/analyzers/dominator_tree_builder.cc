@@ -0,0 +1,184 @@
+//
+//  dominator_tree_builder.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "dominator_tree_builder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "src/common/logging/logging.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/num_types.h"
+
+namespace ir_analyzers {
+namespace {
+
+using ::common::logging::fail;
+using ::ir_info::DominatorTree;
+
+const std::unordered_set<ir::block_num_t>& Successors(const ir::Block* block,
+                                                      DominatorTree::Kind kind) {
+  return (kind == DominatorTree::Kind::kDominators) ? block->children() : block->parents();
+}
+
+const std::unordered_set<ir::block_num_t>& Predecessors(const ir::Block* block,
+                                                        DominatorTree::Kind kind) {
+  return (kind == DominatorTree::Kind::kDominators) ? block->parents() : block->children();
+}
+
+const DominatorTree BuildTree(const ir::Func* func, DominatorTree::Kind kind) {
+  const int64_t block_count = func->block_count();
+  std::vector<const ir::Block*> blocks(block_count, nullptr);
+  for (auto& block : func->blocks()) {
+    blocks.at(block->number()) = block.get();
+  }
+
+  std::vector<ir::block_num_t> roots;
+  if (kind == DominatorTree::Kind::kDominators) {
+    if (func->entry_block_num() == ir::kNoBlockNum) {
+      fail("can not determine dominator tree without entry block");
+    }
+    roots.push_back(func->entry_block_num());
+  } else {
+    for (auto& block : func->blocks()) {
+      if (block->children().empty()) {
+        roots.push_back(block->number());
+      }
+    }
+    std::sort(roots.begin(), roots.end());
+  }
+
+  // All roots get immediately dominated by a virtual root, such that the post-dominator forest can
+  // be handled like a tree. The virtual root uses the first number past all block numbers.
+  const ir::block_num_t virtual_root = block_count;
+  std::vector<bool> is_root(block_count, false);
+  for (ir::block_num_t root : roots) {
+    is_root.at(root) = true;
+  }
+
+  // Number the blocks in postorder of a depth first search from the virtual root. Unreachable
+  // blocks keep number -1.
+  std::vector<int64_t> postorder_nums(block_count + 1, -1);
+  std::vector<ir::block_num_t> postorder;
+  postorder.reserve(block_count + 1);
+  std::vector<bool> seen(block_count, false);
+  std::vector<std::pair<ir::block_num_t, std::unordered_set<ir::block_num_t>::const_iterator>>
+      stack;
+  for (ir::block_num_t root : roots) {
+    if (seen.at(root)) {
+      continue;
+    }
+    seen.at(root) = true;
+    stack.push_back({root, Successors(blocks.at(root), kind).begin()});
+    while (!stack.empty()) {
+      ir::block_num_t bnum = stack.back().first;
+      auto& it = stack.back().second;
+      if (it == Successors(blocks.at(bnum), kind).end()) {
+        postorder_nums.at(bnum) = int64_t(postorder.size());
+        postorder.push_back(bnum);
+        stack.pop_back();
+        continue;
+      }
+      ir::block_num_t successor = *it;
+      ++it;
+      if (!seen.at(successor)) {
+        seen.at(successor) = true;
+        stack.push_back({successor, Successors(blocks.at(successor), kind).begin()});
+      }
+    }
+  }
+  postorder_nums.at(virtual_root) = int64_t(postorder.size());
+  postorder.push_back(virtual_root);
+
+  // Iterate over the blocks in reverse postorder until the immediate dominators are stable.
+  // kNoBlockNum marks blocks without a known immediate dominator yet.
+  std::vector<ir::block_num_t> idoms(block_count + 1, ir::kNoBlockNum);
+  idoms.at(virtual_root) = virtual_root;
+  auto intersect = [&](ir::block_num_t a, ir::block_num_t b) {
+    while (a != b) {
+      while (postorder_nums.at(a) < postorder_nums.at(b)) {
+        a = idoms.at(a);
+      }
+      while (postorder_nums.at(b) < postorder_nums.at(a)) {
+        b = idoms.at(b);
+      }
+    }
+    return a;
+  };
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (auto it = std::next(postorder.rbegin()); it != postorder.rend(); ++it) {
+      ir::block_num_t bnum = *it;
+      ir::block_num_t new_idom = ir::kNoBlockNum;
+      auto add_predecessor = [&](ir::block_num_t predecessor) {
+        if (idoms.at(predecessor) == ir::kNoBlockNum) {
+          return;
+        }
+        new_idom = (new_idom == ir::kNoBlockNum) ? predecessor : intersect(predecessor, new_idom);
+      };
+      if (is_root.at(bnum)) {
+        add_predecessor(virtual_root);
+      }
+      for (ir::block_num_t predecessor : Predecessors(blocks.at(bnum), kind)) {
+        add_predecessor(predecessor);
+      }
+      if (idoms.at(bnum) != new_idom) {
+        idoms.at(bnum) = new_idom;
+        changed = true;
+      }
+    }
+  }
+
+  DominatorTree tree(kind, block_count);
+  for (ir::block_num_t bnum : postorder) {
+    if (bnum == virtual_root) {
+      continue;
+    }
+    ir::block_num_t idom = idoms.at(bnum);
+    tree.SetImmediateDominator(bnum, (idom != virtual_root) ? idom : ir::kNoBlockNum);
+  }
+  tree.Finalize();
+  return tree;
+}
+
+}  // namespace
+
+const DominatorTree BuildDominatorTreeForFunc(const ir::Func* func) {
+  return BuildTree(func, DominatorTree::Kind::kDominators);
+}
+
+const DominatorTree BuildPostDominatorTreeForFunc(const ir::Func* func) {
+  return BuildTree(func, DominatorTree::Kind::kPostDominators);
+}
+
+const ir_info::DominanceFrontiers BuildDominanceFrontiersForFunc(const ir::Func* func,
+                                                                 const DominatorTree& tree) {
+  ir_info::DominanceFrontiers frontiers(func->block_count());
+  for (ir::block_num_t bnum : tree.blocks_in_preorder()) {
+    // Walk up from each predecessor until reaching the immediate dominator of the block. All blocks
+    // on the way dominate a predecessor but not the block itself. For roots, the walk ends at the
+    // (virtual) root.
+    ir::block_num_t idom = tree.ImmediateDominatorOf(bnum);
+    for (ir::block_num_t predecessor : Predecessors(func->GetBlock(bnum), tree.kind())) {
+      if (!tree.Contains(predecessor)) {
+        continue;
+      }
+      for (ir::block_num_t runner = predecessor; runner != idom && runner != ir::kNoBlockNum;
+           runner = tree.ImmediateDominatorOf(runner)) {
+        frontiers.AddToDominanceFrontier(runner, bnum);
+      }
+    }
+  }
+  return frontiers;
+}
+
+}  // namespace ir_analyzers
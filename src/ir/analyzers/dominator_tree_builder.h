@@ -0,0 +1,30 @@
+//
+//  dominator_tree_builder.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_analyzers_dominator_tree_builder_h
+#define ir_analyzers_dominator_tree_builder_h
+
+#include "src/ir/info/dominator_tree.h"
+#include "src/ir/representation/func.h"
+
+namespace ir_analyzers {
+
+// Finds immediate dominators with the iterative algorithm by Cooper, Harvey and Kennedy, which only
+// needs dense arrays indexed by block number and converges in few passes over the reverse
+// postorder for the control flow graphs the front end produces.
+const ir_info::DominatorTree BuildDominatorTreeForFunc(const ir::Func* func);
+const ir_info::DominatorTree BuildPostDominatorTreeForFunc(const ir::Func* func);
+
+// Computes dominance frontiers from the given tree. For a post-dominator tree, this yields the
+// reverse dominance frontiers.
+const ir_info::DominanceFrontiers BuildDominanceFrontiersForFunc(
+    const ir::Func* func, const ir_info::DominatorTree& tree);
+
+}  // namespace ir_analyzers
+
+#endif /* ir_analyzers_dominator_tree_builder_h */
@@ -0,0 +1,150 @@
+//
+//  dominator_tree_builder_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/analyzers/dominator_tree_builder.h"
+
+#include <memory>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/ir/info/dominator_tree.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/num_types.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+
+namespace ir_analyzers {
+namespace {
+
+using ::ir_info::DominanceFrontiers;
+using ::ir_info::DominatorTree;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+constexpr char kLoopWithDiamondProgram[] = R"ir(
+@0 f(%0:b, %1:b) => () {
+{0}
+  jmp {1}
+{1}
+  jcc %0, {2}, {5}
+{2}
+  jcc %1, {3}, {4}
+{3}
+  jmp {4}
+{4}
+  jmp {1}
+{5}
+  ret
+}
+)ir";
+
+TEST(BuildDominatorTreeForFuncTest, FindsImmediateDominators) {
+  std::unique_ptr<ir::Program> program =
+      ir_serialization::ParseProgramOrDie(kLoopWithDiamondProgram);
+  const DominatorTree tree = BuildDominatorTreeForFunc(program->GetFunc(0));
+
+  EXPECT_THAT(tree.roots(), ElementsAre(0));
+  EXPECT_EQ(tree.ImmediateDominatorOf(0), ir::kNoBlockNum);
+  EXPECT_EQ(tree.ImmediateDominatorOf(1), 0);
+  EXPECT_EQ(tree.ImmediateDominatorOf(2), 1);
+  EXPECT_EQ(tree.ImmediateDominatorOf(3), 2);
+  EXPECT_EQ(tree.ImmediateDominatorOf(4), 2);
+  EXPECT_EQ(tree.ImmediateDominatorOf(5), 1);
+  EXPECT_THAT(tree.ImmediateDomineesOf(1), ElementsAre(2, 5));
+  EXPECT_THAT(tree.blocks_in_preorder(), ElementsAre(0, 1, 2, 3, 4, 5));
+
+  EXPECT_TRUE(tree.Dominates(1, 4));
+  EXPECT_TRUE(tree.Dominates(4, 4));
+  EXPECT_FALSE(tree.StrictlyDominates(4, 4));
+  EXPECT_FALSE(tree.Dominates(3, 4));
+  EXPECT_FALSE(tree.Dominates(5, 2));
+}
+
+TEST(BuildDominatorTreeForFuncTest, ExcludesUnreachableBlocks) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f() => () {
+{0}
+  jmp {2}
+{1}
+  jmp {2}
+{2}
+  ret
+}
+)ir");
+  const DominatorTree tree = BuildDominatorTreeForFunc(program->GetFunc(0));
+
+  EXPECT_FALSE(tree.Contains(1));
+  EXPECT_FALSE(tree.Dominates(1, 2));
+  EXPECT_EQ(tree.ImmediateDominatorOf(2), 0);
+}
+
+TEST(BuildPostDominatorTreeForFuncTest, FindsImmediatePostDominators) {
+  std::unique_ptr<ir::Program> program =
+      ir_serialization::ParseProgramOrDie(kLoopWithDiamondProgram);
+  const DominatorTree tree = BuildPostDominatorTreeForFunc(program->GetFunc(0));
+
+  EXPECT_EQ(tree.kind(), DominatorTree::Kind::kPostDominators);
+  EXPECT_THAT(tree.roots(), ElementsAre(5));
+  EXPECT_EQ(tree.ImmediateDominatorOf(5), ir::kNoBlockNum);
+  EXPECT_EQ(tree.ImmediateDominatorOf(1), 5);
+  EXPECT_EQ(tree.ImmediateDominatorOf(0), 1);
+  EXPECT_EQ(tree.ImmediateDominatorOf(4), 1);
+  EXPECT_EQ(tree.ImmediateDominatorOf(3), 4);
+  EXPECT_EQ(tree.ImmediateDominatorOf(2), 4);
+}
+
+TEST(BuildPostDominatorTreeForFuncTest, HandlesMultipleExits) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f(%0:b) => () {
+{0}
+  jcc %0, {1}, {2}
+{1}
+  ret
+{2}
+  ret
+}
+)ir");
+  const DominatorTree tree = BuildPostDominatorTreeForFunc(program->GetFunc(0));
+
+  EXPECT_THAT(tree.roots(), ElementsAre(0, 1, 2));
+  EXPECT_EQ(tree.ImmediateDominatorOf(0), ir::kNoBlockNum);
+  EXPECT_FALSE(tree.Dominates(1, 0));
+  EXPECT_FALSE(tree.Dominates(2, 0));
+}
+
+TEST(BuildDominanceFrontiersForFuncTest, FindsDominanceFrontiers) {
+  std::unique_ptr<ir::Program> program =
+      ir_serialization::ParseProgramOrDie(kLoopWithDiamondProgram);
+  const ir::Func* func = program->GetFunc(0);
+  const DominanceFrontiers frontiers =
+      BuildDominanceFrontiersForFunc(func, BuildDominatorTreeForFunc(func));
+
+  EXPECT_THAT(frontiers.DominanceFrontierOf(0), IsEmpty());
+  EXPECT_THAT(frontiers.DominanceFrontierOf(1), ElementsAre(1));
+  EXPECT_THAT(frontiers.DominanceFrontierOf(2), ElementsAre(1));
+  EXPECT_THAT(frontiers.DominanceFrontierOf(3), ElementsAre(4));
+  EXPECT_THAT(frontiers.DominanceFrontierOf(4), ElementsAre(1));
+  EXPECT_THAT(frontiers.DominanceFrontierOf(5), IsEmpty());
+}
+
+TEST(BuildDominanceFrontiersForFuncTest, FindsReverseDominanceFrontiers) {
+  std::unique_ptr<ir::Program> program =
+      ir_serialization::ParseProgramOrDie(kLoopWithDiamondProgram);
+  const ir::Func* func = program->GetFunc(0);
+  const DominanceFrontiers frontiers =
+      BuildDominanceFrontiersForFunc(func, BuildPostDominatorTreeForFunc(func));
+
+  // Blocks 2 and 3 are control dependent on the branches in blocks 1 and 2 respectively.
+  EXPECT_THAT(frontiers.DominanceFrontierOf(2), ElementsAre(1));
+  EXPECT_THAT(frontiers.DominanceFrontierOf(3), ElementsAre(2));
+  EXPECT_THAT(frontiers.DominanceFrontierOf(4), ElementsAre(1));
+  EXPECT_THAT(frontiers.DominanceFrontierOf(5), IsEmpty());
+}
+
+}  // namespace
+}  // namespace ir_analyzers
@@ -0,0 +1,93 @@
+//
+//  func_analysis_manager.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "func_analysis_manager.h"
+
+#include <utility>
+
+#include "src/ir/analyzers/dominator_tree_builder.h"
+#include "src/ir/analyzers/loop_nest_builder.h"
+
+namespace ir_analyzers {
+
+const ir_info::DominatorTree& FuncAnalysisManager::GetDominatorTree(const ir::Func* func) {
+  return GetOrBuild(func, FuncAnalysis::kDominatorTree, AnalysesFor(func).dominator_tree,
+                    [func] { return BuildDominatorTreeForFunc(func); });
+}
+
+const ir_info::DominatorTree& FuncAnalysisManager::GetPostDominatorTree(const ir::Func* func) {
+  return GetOrBuild(func, FuncAnalysis::kPostDominatorTree, AnalysesFor(func).post_dominator_tree,
+                    [func] { return BuildPostDominatorTreeForFunc(func); });
+}
+
+const ir_info::DominanceFrontiers& FuncAnalysisManager::GetDominanceFrontiers(
+    const ir::Func* func) {
+  return GetOrBuild(func, FuncAnalysis::kDominanceFrontiers, AnalysesFor(func).dominance_frontiers,
+                    [this, func] {
+                      return BuildDominanceFrontiersForFunc(func, GetDominatorTree(func));
+                    });
+}
+
+const ir_info::LoopNest& FuncAnalysisManager::GetLoopNest(const ir::Func* func) {
+  return GetOrBuild(func, FuncAnalysis::kLoopNest, AnalysesFor(func).loop_nest,
+                    [this, func] { return BuildLoopNestForFunc(func, GetDominatorTree(func)); });
+}
+
+void FuncAnalysisManager::Invalidate(const ir::Func* func, std::string_view pass_name,
+                                     const PreservedFuncAnalyses& preserved) {
+  auto it = funcs_.find(func->number());
+  if (it == funcs_.end() || it->second.func != func) {
+    return;
+  }
+  FuncAnalyses& analyses = it->second;
+  int64_t invalidation_count = 0;
+  auto invalidate = [&]<typename T>(FuncAnalysis analysis, CachedAnalysis<T>& cached) {
+    if (cached.result == nullptr) {
+      return;
+    } else if (preserved.IsPreserved(analysis)) {
+      cached.cfg_version = func->cfg_version();
+    } else {
+      cached.result.reset();
+      invalidation_count++;
+    }
+  };
+  invalidate(FuncAnalysis::kDominatorTree, analyses.dominator_tree);
+  invalidate(FuncAnalysis::kPostDominatorTree, analyses.post_dominator_tree);
+  invalidate(FuncAnalysis::kDominanceFrontiers, analyses.dominance_frontiers);
+  invalidate(FuncAnalysis::kLoopNest, analyses.loop_nest);
+  if (invalidation_count > 0) {
+    auto count_it = invalidation_counts_.find(pass_name);
+    if (count_it == invalidation_counts_.end()) {
+      count_it = invalidation_counts_.emplace(std::string(pass_name), 0).first;
+    }
+    count_it->second += invalidation_count;
+  }
+}
+
+FuncAnalysisManager::FuncAnalyses& FuncAnalysisManager::AnalysesFor(const ir::Func* func) {
+  FuncAnalyses& analyses = funcs_[func->number()];
+  if (analyses.func != func) {
+    // The function number got reused by a different function.
+    analyses = FuncAnalyses{.func = func};
+  }
+  return analyses;
+}
+
+template <typename T, typename Builder>
+const T& FuncAnalysisManager::GetOrBuild(const ir::Func* func, FuncAnalysis analysis,
+                                         CachedAnalysis<T>& cached, Builder build) {
+  if (cached.result == nullptr || cached.cfg_version != func->cfg_version()) {
+    // Builders may request other analyses, which does not affect the cache entry for this one.
+    cached.result = std::make_unique<T>(build());
+    cached.cfg_version = func->cfg_version();
+    computation_counts_[static_cast<int>(analysis)]++;
+  }
+  return *cached.result;
+}
+
+}  // namespace ir_analyzers
@@ -0,0 +1,111 @@
+//
+//  func_analysis_manager.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_analyzers_func_analysis_manager_h
+#define ir_analyzers_func_analysis_manager_h
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "src/ir/info/dominator_tree.h"
+#include "src/ir/info/loop_nest.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/num_types.h"
+
+namespace ir_analyzers {
+
+enum class FuncAnalysis {
+  kDominatorTree,
+  kPostDominatorTree,
+  kDominanceFrontiers,
+  kLoopNest,
+};
+constexpr int kFuncAnalysisCount = 4;
+
+// The set of analyses a pass left intact when it modified a function.
+class PreservedFuncAnalyses {
+ public:
+  static PreservedFuncAnalyses None() { return PreservedFuncAnalyses(); }
+  static PreservedFuncAnalyses All() {
+    return PreservedFuncAnalyses((1 << kFuncAnalysisCount) - 1);
+  }
+
+  PreservedFuncAnalyses& Preserve(FuncAnalysis analysis) {
+    bits_ |= Bit(analysis);
+    return *this;
+  }
+  bool IsPreserved(FuncAnalysis analysis) const { return (bits_ & Bit(analysis)) != 0; }
+
+ private:
+  explicit PreservedFuncAnalyses(int bits = 0) : bits_(bits) {}
+
+  static int Bit(FuncAnalysis analysis) { return 1 << static_cast<int>(analysis); }
+
+  int bits_;
+};
+
+// Caches control flow analyses per function, such that passes can share them instead of
+// recomputing them. Results get computed on first request and stay valid until a pass invalidates
+// them. As a safety net, results also get recomputed if the control flow graph of the function
+// changed since they were computed and no pass declared them preserved.
+//
+// References returned by the getters are valid until the next call to Invalidate or Clear.
+class FuncAnalysisManager {
+ public:
+  const ir_info::DominatorTree& GetDominatorTree(const ir::Func* func);
+  const ir_info::DominatorTree& GetPostDominatorTree(const ir::Func* func);
+  const ir_info::DominanceFrontiers& GetDominanceFrontiers(const ir::Func* func);
+  const ir_info::LoopNest& GetLoopNest(const ir::Func* func);
+
+  // Drops all cached analyses of the function that the pass did not preserve. Preserved analyses
+  // remain valid even if the pass changed the control flow graph.
+  void Invalidate(const ir::Func* func, std::string_view pass_name,
+                  const PreservedFuncAnalyses& preserved);
+  void Clear() { funcs_.clear(); }
+
+  // Returns how often the analysis was computed, across all functions.
+  int64_t computation_count(FuncAnalysis analysis) const {
+    return computation_counts_[static_cast<int>(analysis)];
+  }
+  // Returns how many cached analyses each pass invalidated, keyed by pass name.
+  const std::map<std::string, int64_t, std::less<>>& invalidation_counts() const {
+    return invalidation_counts_;
+  }
+
+ private:
+  template <typename T>
+  struct CachedAnalysis {
+    std::unique_ptr<T> result;
+    int64_t cfg_version = 0;
+  };
+  struct FuncAnalyses {
+    const ir::Func* func = nullptr;
+    CachedAnalysis<ir_info::DominatorTree> dominator_tree;
+    CachedAnalysis<ir_info::DominatorTree> post_dominator_tree;
+    CachedAnalysis<ir_info::DominanceFrontiers> dominance_frontiers;
+    CachedAnalysis<ir_info::LoopNest> loop_nest;
+  };
+
+  FuncAnalyses& AnalysesFor(const ir::Func* func);
+  template <typename T, typename Builder>
+  const T& GetOrBuild(const ir::Func* func, FuncAnalysis analysis, CachedAnalysis<T>& cached,
+                      Builder build);
+
+  std::unordered_map<ir::func_num_t, FuncAnalyses> funcs_;
+  int64_t computation_counts_[kFuncAnalysisCount] = {};
+  std::map<std::string, int64_t, std::less<>> invalidation_counts_;
+};
+
+}  // namespace ir_analyzers
+
+#endif /* ir_analyzers_func_analysis_manager_h */
@@ -0,0 +1,109 @@
+//
+//  func_analysis_manager_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/analyzers/func_analysis_manager.h"
+
+#include <memory>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/ir/info/dominator_tree.h"
+#include "src/ir/info/loop_nest.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+
+namespace ir_analyzers {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Pair;
+
+constexpr char kLoopProgram[] = R"ir(
+@0 f(%0:b) => () {
+{0}
+  jmp {1}
+{1}
+  jcc %0, {2}, {3}
+{2}
+  jmp {1}
+{3}
+  ret
+}
+)ir";
+
+TEST(FuncAnalysisManagerTest, CachesAnalyses) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(kLoopProgram);
+  const ir::Func* func = program->GetFunc(0);
+  FuncAnalysisManager manager;
+
+  const ir_info::LoopNest& loop_nest = manager.GetLoopNest(func);
+  EXPECT_EQ(loop_nest.LoopDepthOf(2), 1);
+  EXPECT_EQ(&manager.GetLoopNest(func), &loop_nest);
+  EXPECT_EQ(manager.GetDominatorTree(func).ImmediateDominatorOf(3), 1);
+  EXPECT_THAT(manager.GetDominanceFrontiers(func).DominanceFrontierOf(2), ElementsAre(1));
+
+  EXPECT_EQ(manager.computation_count(FuncAnalysis::kDominatorTree), 1);
+  EXPECT_EQ(manager.computation_count(FuncAnalysis::kDominanceFrontiers), 1);
+  EXPECT_EQ(manager.computation_count(FuncAnalysis::kLoopNest), 1);
+  EXPECT_EQ(manager.computation_count(FuncAnalysis::kPostDominatorTree), 0);
+}
+
+TEST(FuncAnalysisManagerTest, RecomputesAnalysesAfterControlFlowChanges) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(kLoopProgram);
+  ir::Func* func = program->GetFunc(0);
+  FuncAnalysisManager manager;
+
+  EXPECT_EQ(manager.GetLoopNest(func).loops().size(), 1);
+  func->RemoveControlFlow(2, 1);
+  EXPECT_THAT(manager.GetLoopNest(func).loops(), IsEmpty());
+  EXPECT_EQ(manager.computation_count(FuncAnalysis::kLoopNest), 2);
+}
+
+TEST(FuncAnalysisManagerTest, InvalidatesAnalysesNotPreservedByPass) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f(%0:b) => () {
+{0}
+  jmp {1}
+{1}
+  jcc %0, {2}, {3}
+{2}
+  jmp {1}
+{3}
+  ret
+{4}
+  jmp {3}
+}
+)ir");
+  ir::Func* func = program->GetFunc(0);
+  FuncAnalysisManager manager;
+
+  EXPECT_TRUE(manager.GetPostDominatorTree(func).Contains(4));
+  manager.GetDominatorTree(func);
+  manager.GetLoopNest(func);
+
+  // Removing an unreachable block does not affect analyses of the reachable blocks.
+  func->RemoveBlock(4);
+  manager.Invalidate(func, "remove_unreachable_blocks",
+                     PreservedFuncAnalyses::None()
+                         .Preserve(FuncAnalysis::kDominatorTree)
+                         .Preserve(FuncAnalysis::kLoopNest));
+
+  EXPECT_EQ(manager.GetLoopNest(func).LoopDepthOf(2), 1);
+  EXPECT_EQ(manager.GetDominatorTree(func).ImmediateDominatorOf(3), 1);
+  EXPECT_FALSE(manager.GetPostDominatorTree(func).Contains(4));
+
+  EXPECT_EQ(manager.computation_count(FuncAnalysis::kDominatorTree), 1);
+  EXPECT_EQ(manager.computation_count(FuncAnalysis::kLoopNest), 1);
+  EXPECT_EQ(manager.computation_count(FuncAnalysis::kPostDominatorTree), 2);
+  EXPECT_THAT(manager.invalidation_counts(), ElementsAre(Pair("remove_unreachable_blocks", 1)));
+}
+
+}  // namespace
+}  // namespace ir_analyzers
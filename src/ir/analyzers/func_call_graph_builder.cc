@@ -23,6 +23,9 @@ void AddDynamicCalleesFromValues(const auto& values,
       continue;
     }
     ir::FuncConstant* func_constant = static_cast<ir::FuncConstant*>(value.get());
+    if (func_constant->value() == ir::kNoFuncNum) {
+      continue;
+    }
     dynamic_callees.insert(func_constant->value());
   }
 }
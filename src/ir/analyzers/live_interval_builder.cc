@@ -0,0 +1,89 @@
+//
+//  live_interval_builder.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "live_interval_builder.h"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "src/ir/analyzers/dataflow_solver.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/instrs.h"
+#include "src/ir/representation/values.h"
+
+namespace ir_analyzers {
+
+using ::ir_info::live_pos_t;
+
+const ir_info::FuncLiveIntervals BuildLiveIntervalsForFunc(
+    const ir::Func* func, const ir_info::FuncLiveRanges& func_live_ranges) {
+  std::unordered_map<ir::value_num_t, ir_info::LiveInterval> intervals;
+  auto add_range = [&intervals](ir::value_num_t value, live_pos_t start, live_pos_t end) {
+    auto it = intervals.find(value);
+    if (it == intervals.end()) {
+      it = intervals.emplace(value, ir_info::LiveInterval(value)).first;
+    }
+    it->second.AddRange(start, end);
+  };
+
+  live_pos_t block_start = 0;
+  for (const ir::Block* block : GetBlocksInReversePostorder(func)) {
+    const ir_info::BlockLiveRanges& block_live_ranges =
+        func_live_ranges.GetBlockLiveRanges(block->number());
+    const live_pos_t block_end = block_start + 2 * live_pos_t(block->instrs().size());
+
+    // Phi instructions neither define nor use values here: their results are live from the block
+    // entry and their arguments are live until the exits of the parent blocks.
+    const std::unordered_set<ir::value_num_t> entry_set = block_live_ranges.GetEntrySet();
+    std::map<ir::value_num_t, live_pos_t> range_starts;
+    std::unordered_map<ir::value_num_t, live_pos_t> range_ends;
+    for (ir::value_num_t value : entry_set) {
+      range_starts.insert({value, block_start});
+    }
+    live_pos_t pos = block_start;
+    for (auto& instr : block->instrs()) {
+      if (instr->instr_kind() != ir::InstrKind::kPhi) {
+        for (auto& used_value : instr->UsedValues()) {
+          if (used_value->kind() != ir::Value::Kind::kComputed) {
+            continue;
+          }
+          range_ends[static_cast<ir::Computed*>(used_value.get())->number()] = pos + 1;
+        }
+        for (auto& defined_value : instr->DefinedValues()) {
+          range_starts.insert({defined_value->number(), pos + 1});
+        }
+      }
+      pos += 2;
+    }
+    for (ir::value_num_t value : block_live_ranges.GetExitSet()) {
+      range_ends[value] = block_end;
+    }
+
+    for (auto [value, start] : range_starts) {
+      live_pos_t end = start + 1;
+      if (auto it = range_ends.find(value); it != range_ends.end()) {
+        end = std::max(end, it->second);
+      }
+      add_range(value, start, end);
+    }
+    block_start = block_end;
+  }
+
+  ir_info::FuncLiveIntervals func_live_intervals;
+  for (auto& [value, interval] : intervals) {
+    func_live_intervals.AddInterval(std::move(interval));
+  }
+  func_live_intervals.SortIntervals();
+  return func_live_intervals;
+}
+
+}  // namespace ir_analyzers
@@ -0,0 +1,25 @@
+//
+//  live_interval_builder.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_analyzers_live_interval_builder_h
+#define ir_analyzers_live_interval_builder_h
+
+#include "src/ir/info/func_live_ranges.h"
+#include "src/ir/info/live_intervals.h"
+#include "src/ir/representation/func.h"
+
+namespace ir_analyzers {
+
+// Linearizes the blocks of the function in reverse postorder and converts the live ranges of each
+// block to positions in that order.
+const ir_info::FuncLiveIntervals BuildLiveIntervalsForFunc(
+    const ir::Func* func, const ir_info::FuncLiveRanges& func_live_ranges);
+
+}  // namespace ir_analyzers
+
+#endif /* ir_analyzers_live_interval_builder_h */
@@ -0,0 +1,232 @@
+//
+//  live_interval_colorer.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "live_interval_colorer.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace ir_analyzers {
+namespace {
+
+using ::ir_info::color_t;
+using ::ir_info::live_pos_t;
+using ::ir_info::LiveInterval;
+
+constexpr live_pos_t kMaxLivePos = std::numeric_limits<live_pos_t>::max();
+
+class LinearScan {
+ public:
+  LinearScan(const ir_info::FuncLiveIntervals& func_live_intervals,
+             const ir_info::InterferenceGraphColors& preferred_colors,
+             color_t register_color_count)
+      : preferred_colors_(preferred_colors), register_color_count_(register_color_count) {
+    unhandled_.reserve(func_live_intervals.intervals().size());
+    for (const LiveInterval& interval : func_live_intervals.intervals()) {
+      unhandled_.push_back(Assignment{.interval = &interval, .color = ir_info::kNoColor});
+    }
+    // Among intervals starting at the same position, those with preferred colors go first, such
+    // that function arguments get their argument registers.
+    std::stable_sort(unhandled_.begin(), unhandled_.end(),
+                     [&](const Assignment& a, const Assignment& b) {
+                       if (a.interval->start() != b.interval->start()) {
+                         return a.interval->start() < b.interval->start();
+                       }
+                       return HasPreferredColor(a) && !HasPreferredColor(b);
+                     });
+  }
+
+  ir_info::InterferenceGraphColors Run();
+
+ private:
+  struct Assignment {
+    const LiveInterval* interval;
+    color_t color;
+    // Intervals assigned their preferred color, such as function arguments in their argument
+    // registers, never get evicted from their register.
+    bool fixed = false;
+  };
+
+  bool HasPreferredColor(const Assignment& assignment) const {
+    return preferred_colors_.GetColor(assignment.interval->value()) != ir_info::kNoColor;
+  }
+
+  void AdvanceTo(live_pos_t pos);
+  bool TryAssignFreeRegister(Assignment* current);
+  void AssignBlockedRegister(Assignment* current);
+  void AssignSpillSlots();
+
+  const ir_info::InterferenceGraphColors& preferred_colors_;
+  const color_t register_color_count_;
+
+  std::vector<Assignment> unhandled_;
+  // Intervals with registers that cover or do not cover the current position, respectively.
+  std::vector<Assignment*> active_;
+  std::vector<Assignment*> inactive_;
+  std::vector<Assignment*> spilled_;
+};
+
+ir_info::InterferenceGraphColors LinearScan::Run() {
+  for (Assignment& current : unhandled_) {
+    AdvanceTo(current.interval->start());
+    if (!TryAssignFreeRegister(&current)) {
+      AssignBlockedRegister(&current);
+    }
+    if (current.color != ir_info::kNoColor) {
+      active_.push_back(&current);
+    }
+  }
+  AssignSpillSlots();
+
+  ir_info::InterferenceGraphColors colors;
+  for (const Assignment& assignment : unhandled_) {
+    colors.SetColor(assignment.interval->value(), assignment.color);
+  }
+  return colors;
+}
+
+void LinearScan::AdvanceTo(live_pos_t pos) {
+  std::vector<Assignment*> active;
+  std::vector<Assignment*> inactive;
+  for (std::vector<Assignment*>* list : {&active_, &inactive_}) {
+    for (Assignment* assignment : *list) {
+      if (assignment->color == ir_info::kNoColor || assignment->interval->end() <= pos) {
+        continue;
+      } else if (assignment->interval->Covers(pos)) {
+        active.push_back(assignment);
+      } else {
+        inactive.push_back(assignment);
+      }
+    }
+  }
+  active_ = std::move(active);
+  inactive_ = std::move(inactive);
+}
+
+bool LinearScan::TryAssignFreeRegister(Assignment* current) {
+  std::vector<live_pos_t> free_until(register_color_count_, kMaxLivePos);
+  for (Assignment* assignment : active_) {
+    free_until.at(assignment->color) = 0;
+  }
+  for (Assignment* assignment : inactive_) {
+    live_pos_t intersection = assignment->interval->FirstIntersectionWith(*current->interval);
+    if (intersection != ir_info::kNoLivePos) {
+      free_until.at(assignment->color) = std::min(free_until.at(assignment->color), intersection);
+    }
+  }
+
+  const live_pos_t end = current->interval->end();
+  color_t preferred_color = preferred_colors_.GetColor(current->interval->value());
+  if (0 <= preferred_color && preferred_color < register_color_count_ &&
+      free_until.at(preferred_color) >= end) {
+    current->color = preferred_color;
+    current->fixed = true;
+    return true;
+  }
+  // Pick the register that stays free the longest, such that registers that become blocked soon
+  // remain available for intervals that fit into the gap.
+  color_t best_color = 0;
+  for (color_t color = 1; color < register_color_count_; color++) {
+    if (free_until.at(color) > free_until.at(best_color)) {
+      best_color = color;
+    }
+  }
+  if (register_color_count_ == 0 || free_until.at(best_color) < end) {
+    return false;
+  }
+  current->color = best_color;
+  return true;
+}
+
+void LinearScan::AssignBlockedRegister(Assignment* current) {
+  // For each register, find how far the intervals intersecting the current interval extend, and
+  // whether any of them is fixed to the register.
+  std::vector<live_pos_t> blocked_until(register_color_count_, 0);
+  std::vector<bool> fixed(register_color_count_, false);
+  for (Assignment* assignment : active_) {
+    blocked_until.at(assignment->color) =
+        std::max(blocked_until.at(assignment->color), assignment->interval->end());
+    fixed.at(assignment->color) = fixed.at(assignment->color) || assignment->fixed;
+  }
+  for (Assignment* assignment : inactive_) {
+    if (assignment->interval->FirstIntersectionWith(*current->interval) != ir_info::kNoLivePos) {
+      blocked_until.at(assignment->color) =
+          std::max(blocked_until.at(assignment->color), assignment->interval->end());
+      fixed.at(assignment->color) = fixed.at(assignment->color) || assignment->fixed;
+    }
+  }
+  color_t best_color = ir_info::kNoColor;
+  live_pos_t best_blocked_until = current->interval->end();
+  for (color_t color = 0; color < register_color_count_; color++) {
+    if (!fixed.at(color) && blocked_until.at(color) > best_blocked_until) {
+      best_color = color;
+      best_blocked_until = blocked_until.at(color);
+    }
+  }
+  if (best_color == ir_info::kNoColor) {
+    spilled_.push_back(current);
+    return;
+  }
+
+  // Spill all intervals holding the register while the current interval is live. They get
+  // removed from the active and inactive lists with the next call to AdvanceTo.
+  for (std::vector<Assignment*>* list : {&active_, &inactive_}) {
+    for (Assignment* assignment : *list) {
+      if (assignment->color != best_color) {
+        continue;
+      }
+      if (list == &inactive_ &&
+          assignment->interval->FirstIntersectionWith(*current->interval) == ir_info::kNoLivePos) {
+        continue;
+      }
+      assignment->color = ir_info::kNoColor;
+      spilled_.push_back(assignment);
+    }
+  }
+  current->color = best_color;
+}
+
+void LinearScan::AssignSpillSlots() {
+  std::sort(spilled_.begin(), spilled_.end(), [](Assignment* a, Assignment* b) {
+    return a->interval->start() < b->interval->start();
+  });
+  // Each spill slot holds the intervals assigned to it that might still intersect later ones.
+  std::vector<std::vector<Assignment*>> slots;
+  for (Assignment* current : spilled_) {
+    const live_pos_t start = current->interval->start();
+    std::size_t slot_index = 0;
+    for (; slot_index < slots.size(); slot_index++) {
+      std::vector<Assignment*>& slot = slots.at(slot_index);
+      std::erase_if(slot, [start](Assignment* a) { return a->interval->end() <= start; });
+      if (std::none_of(slot.begin(), slot.end(), [current](Assignment* a) {
+            return a->interval->FirstIntersectionWith(*current->interval) != ir_info::kNoLivePos;
+          })) {
+        break;
+      }
+    }
+    if (slot_index == slots.size()) {
+      slots.emplace_back();
+    }
+    slots.at(slot_index).push_back(current);
+    current->color = register_color_count_ + color_t(slot_index);
+  }
+}
+
+}  // namespace
+
+const ir_info::InterferenceGraphColors ColorLiveIntervals(
+    const ir_info::FuncLiveIntervals& func_live_intervals,
+    const ir_info::InterferenceGraphColors& preferred_colors,
+    ir_info::color_t register_color_count) {
+  return LinearScan(func_live_intervals, preferred_colors, register_color_count).Run();
+}
+
+}  // namespace ir_analyzers
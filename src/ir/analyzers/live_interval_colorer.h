@@ -0,0 +1,31 @@
+//
+//  live_interval_colorer.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_analyzers_live_interval_colorer_h
+#define ir_analyzers_live_interval_colorer_h
+
+#include "src/ir/info/interference_graph.h"
+#include "src/ir/info/live_intervals.h"
+
+namespace ir_analyzers {
+
+// Colors live intervals with a linear scan that uses lifetime holes. Colors below
+// register_color_count are assumed to be registers. If no register is available for the whole of
+// an interval, either it or the intervals blocking the register that end furthest get spilled.
+// Intervals that received their preferred color never get spilled, since function arguments have
+// to stay in the registers they get passed in.
+// Spilled intervals receive colors from register_color_count upwards, which get reused by spilled
+// intervals that do not intersect.
+const ir_info::InterferenceGraphColors ColorLiveIntervals(
+    const ir_info::FuncLiveIntervals& func_live_intervals,
+    const ir_info::InterferenceGraphColors& preferred_colors,
+    ir_info::color_t register_color_count);
+
+}  // namespace ir_analyzers
+
+#endif /* ir_analyzers_live_interval_colorer_h */
@@ -0,0 +1,212 @@
+//
+//  live_interval_colorer_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/analyzers/live_interval_colorer.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/ir/analyzers/live_interval_builder.h"
+#include "src/ir/analyzers/live_range_analyzer.h"
+#include "src/ir/info/func_live_ranges.h"
+#include "src/ir/info/interference_graph.h"
+#include "src/ir/info/live_intervals.h"
+#include "src/ir/representation/num_types.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+
+namespace ir_analyzers {
+namespace {
+
+using ::ir_info::FuncLiveIntervals;
+using ::ir_info::InterferenceGraphColors;
+using ::ir_info::LiveInterval;
+
+LiveInterval MakeInterval(ir::value_num_t value,
+                          std::vector<std::pair<ir_info::live_pos_t, ir_info::live_pos_t>> ranges) {
+  LiveInterval interval(value);
+  for (auto [start, end] : ranges) {
+    interval.AddRange(start, end);
+  }
+  return interval;
+}
+
+TEST(BuildLiveIntervalsForFuncTest, BuildsIntervalsWithLifetimeHoles) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f(%0:b, %1:i64) => (i64) {
+{0}
+  %2:i64 = iadd %1, #1:i64
+  jcc %0, {1}, {2}
+{1}
+  %3:i64 = iadd %2, #2:i64
+  jmp {3}
+{2}
+  %4:i64 = iadd %2, #3:i64
+  jmp {3}
+{3}
+  %5:i64 = phi %3{1}, %4{2}
+  ret %5
+}
+)ir");
+  const ir::Func* func = program->GetFunc(0);
+  const ir_info::FuncLiveRanges live_ranges = FindLiveRangesForFunc(func);
+
+  // Blocks are ordered {0}, {2}, {1}, {3}.
+  const FuncLiveIntervals live_intervals = BuildLiveIntervalsForFunc(func, live_ranges);
+
+  EXPECT_EQ(live_intervals.ToString(),
+            "%0: [0, 3)\n"
+            "%1: [0, 1)\n"
+            "%5: [0, 15)\n"
+            "%2: [1, 5) [8, 9)\n"
+            "%4: [5, 8)\n"
+            "%3: [9, 12)\n");
+}
+
+TEST(LiveIntervalTest, FindsIntersections) {
+  LiveInterval interval_a = MakeInterval(0, {{0, 2}, {6, 8}});
+  LiveInterval interval_b = MakeInterval(1, {{2, 6}});
+  LiveInterval interval_c = MakeInterval(2, {{4, 7}});
+
+  EXPECT_TRUE(interval_a.Covers(1));
+  EXPECT_FALSE(interval_a.Covers(2));
+  EXPECT_TRUE(interval_a.Covers(6));
+  EXPECT_FALSE(interval_a.Covers(8));
+  EXPECT_EQ(interval_a.FirstIntersectionWith(interval_b), ir_info::kNoLivePos);
+  EXPECT_EQ(interval_a.FirstIntersectionWith(interval_c), 6);
+  EXPECT_EQ(interval_c.FirstIntersectionWith(interval_b), 4);
+}
+
+TEST(ColorLiveIntervalsTest, ReusesRegistersInLifetimeHoles) {
+  FuncLiveIntervals live_intervals;
+  live_intervals.AddInterval(MakeInterval(0, {{0, 2}, {6, 8}}));
+  live_intervals.AddInterval(MakeInterval(1, {{2, 6}}));
+  live_intervals.SortIntervals();
+
+  const InterferenceGraphColors colors =
+      ColorLiveIntervals(live_intervals, InterferenceGraphColors(), /*register_color_count=*/1);
+
+  EXPECT_EQ(colors.GetColor(0), 0);
+  EXPECT_EQ(colors.GetColor(1), 0);
+}
+
+TEST(ColorLiveIntervalsTest, SpillsIntervalEndingFurthest) {
+  FuncLiveIntervals live_intervals;
+  live_intervals.AddInterval(MakeInterval(0, {{0, 10}}));
+  live_intervals.AddInterval(MakeInterval(1, {{1, 3}}));
+  live_intervals.AddInterval(MakeInterval(2, {{4, 6}}));
+  live_intervals.SortIntervals();
+
+  const InterferenceGraphColors colors =
+      ColorLiveIntervals(live_intervals, InterferenceGraphColors(), /*register_color_count=*/1);
+
+  EXPECT_EQ(colors.GetColor(0), 1);
+  EXPECT_EQ(colors.GetColor(1), 0);
+  EXPECT_EQ(colors.GetColor(2), 0);
+}
+
+TEST(ColorLiveIntervalsTest, ReusesSpillSlots) {
+  FuncLiveIntervals live_intervals;
+  live_intervals.AddInterval(MakeInterval(0, {{0, 2}}));
+  live_intervals.AddInterval(MakeInterval(1, {{1, 3}}));
+  live_intervals.AddInterval(MakeInterval(2, {{2, 4}}));
+  live_intervals.AddInterval(MakeInterval(3, {{3, 5}}));
+  live_intervals.SortIntervals();
+
+  const InterferenceGraphColors colors =
+      ColorLiveIntervals(live_intervals, InterferenceGraphColors(), /*register_color_count=*/0);
+
+  EXPECT_EQ(colors.GetColor(0), 0);
+  EXPECT_EQ(colors.GetColor(1), 1);
+  EXPECT_EQ(colors.GetColor(2), 0);
+  EXPECT_EQ(colors.GetColor(3), 1);
+}
+
+TEST(ColorLiveIntervalsTest, PrefersPreferredColors) {
+  FuncLiveIntervals live_intervals;
+  live_intervals.AddInterval(MakeInterval(0, {{0, 4}}));
+  live_intervals.AddInterval(MakeInterval(1, {{0, 4}}));
+  live_intervals.AddInterval(MakeInterval(2, {{2, 6}}));
+  live_intervals.SortIntervals();
+  InterferenceGraphColors preferred_colors;
+  preferred_colors.SetColor(1, 0);
+  preferred_colors.SetColor(2, 0);
+
+  const InterferenceGraphColors colors =
+      ColorLiveIntervals(live_intervals, preferred_colors, /*register_color_count=*/3);
+
+  EXPECT_EQ(colors.GetColor(0), 1);
+  EXPECT_EQ(colors.GetColor(1), 0);
+  EXPECT_NE(colors.GetColor(2), 0);
+  EXPECT_NE(colors.GetColor(2), 1);
+}
+
+TEST(ColorLiveIntervalsTest, NeverSpillsIntervalsWithPreferredColors) {
+  // %1 to %16 are live at the same time as the argument %0, which is used last.
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f(%0:i64) => (i64) {
+{0}
+  %1:i64 = mov #1:i64
+  %2:i64 = iadd %1, #1:i64
+  %3:i64 = iadd %2, #1:i64
+  %4:i64 = iadd %3, #1:i64
+  %5:i64 = iadd %4, #1:i64
+  %6:i64 = iadd %5, #1:i64
+  %7:i64 = iadd %6, #1:i64
+  %8:i64 = iadd %7, #1:i64
+  %9:i64 = iadd %8, #1:i64
+  %10:i64 = iadd %9, #1:i64
+  %11:i64 = iadd %10, #1:i64
+  %12:i64 = iadd %11, #1:i64
+  %13:i64 = iadd %12, #1:i64
+  %14:i64 = iadd %13, #1:i64
+  %15:i64 = iadd %14, #1:i64
+  %16:i64 = iadd %15, #1:i64
+  %17:i64 = iadd %1, %2
+  %18:i64 = iadd %17, %3
+  %19:i64 = iadd %18, %4
+  %20:i64 = iadd %19, %5
+  %21:i64 = iadd %20, %6
+  %22:i64 = iadd %21, %7
+  %23:i64 = iadd %22, %8
+  %24:i64 = iadd %23, %9
+  %25:i64 = iadd %24, %10
+  %26:i64 = iadd %25, %11
+  %27:i64 = iadd %26, %12
+  %28:i64 = iadd %27, %13
+  %29:i64 = iadd %28, %14
+  %30:i64 = iadd %29, %15
+  %31:i64 = iadd %30, %16
+  %32:i64 = iadd %31, %0
+  ret %32
+}
+)ir");
+  const ir::Func* func = program->GetFunc(0);
+  const ir_info::FuncLiveRanges live_ranges = FindLiveRangesForFunc(func);
+  const FuncLiveIntervals live_intervals = BuildLiveIntervalsForFunc(func, live_ranges);
+  InterferenceGraphColors preferred_colors;
+  preferred_colors.SetColor(0, 5);
+
+  const InterferenceGraphColors colors =
+      ColorLiveIntervals(live_intervals, preferred_colors, /*register_color_count=*/14);
+
+  EXPECT_EQ(colors.GetColor(0), 5);
+  int spilled_count = 0;
+  for (ir::value_num_t value = 1; value <= 16; value++) {
+    EXPECT_NE(colors.GetColor(value), 5) << "%" << value;
+    if (colors.GetColor(value) >= 14) {
+      spilled_count++;
+    }
+  }
+  EXPECT_GE(spilled_count, 3);
+}
+
+}  // namespace
+}  // namespace ir_analyzers
@@ -8,14 +8,85 @@
 
 #include "live_range_analyzer.h"
 
+#include <unordered_map>
+#include <utility>
+
+#include "src/common/data/bit_vector.h"
+#include "src/ir/analyzers/dataflow_solver.h"
 #include "src/ir/representation/instrs.h"
 #include "src/ir/representation/values.h"
 
 namespace ir_analyzers {
 namespace {
 
-void BacktraceBlock(const ir::Func* func, const ir::Block* block,
-                    ir_info::BlockLiveRanges& live_ranges) {
+using ::common::data::BitVector;
+
+// Liveness of values is a backward problem: a value is live at the entry of a block if the block
+// uses it before any definition, or if it is live at the exit of the block and not defined in it.
+// Values used by phi instructions are live at the exit of the parent blocks they get inherited
+// from. Phi instructions themselves do not define values, such that their results stay live up to
+// the parent blocks, where phi resolution defines them.
+class LivenessProblem : public DataflowProblem {
+ public:
+  LivenessProblem(const ir::Func* func);
+
+  DataflowDirection direction() const override { return DataflowDirection::kBackward; }
+
+  void Transfer(const ir::Block* block, const BitVector& input, BitVector& output) const override;
+  void TransferEdge(const ir::Block* parent, const ir::Block* child,
+                    BitVector& set) const override;
+
+ private:
+  struct BlockInfo {
+    BitVector defined_values;
+    BitVector upward_exposed_uses;
+  };
+
+  std::unordered_map<ir::block_num_t, BlockInfo> block_infos_;
+};
+
+LivenessProblem::LivenessProblem(const ir::Func* func) {
+  for (auto& block : func->blocks()) {
+    BlockInfo info{
+        .defined_values = BitVector(func->computed_count()),
+        .upward_exposed_uses = BitVector(func->computed_count()),
+    };
+    block->ForEachNonPhiInstrReverse([&info](ir::Instr* instr) {
+      for (auto& defined_value : instr->DefinedValues()) {
+        info.defined_values.Set(defined_value->number());
+        info.upward_exposed_uses.Reset(defined_value->number());
+      }
+      for (auto& used_value : instr->UsedValues()) {
+        if (used_value->kind() != ir::Value::Kind::kComputed) {
+          continue;
+        }
+        info.upward_exposed_uses.Set(static_cast<ir::Computed*>(used_value.get())->number());
+      }
+    });
+    block_infos_.insert({block->number(), std::move(info)});
+  }
+}
+
+void LivenessProblem::Transfer(const ir::Block* block, const BitVector& input,
+                               BitVector& output) const {
+  const BlockInfo& info = block_infos_.at(block->number());
+  output = input;
+  output.Subtract(info.defined_values);
+  output.UnionWith(info.upward_exposed_uses);
+}
+
+void LivenessProblem::TransferEdge(const ir::Block* parent, const ir::Block* child,
+                                   BitVector& set) const {
+  child->ForEachPhiInstr([&](ir::PhiInstr* instr) {
+    ir::Value* value = instr->ValueInheritedFromBlock(parent->number()).get();
+    if (value->kind() != ir::Value::Kind::kComputed) {
+      return;
+    }
+    set.Set(static_cast<ir::Computed*>(value)->number());
+  });
+}
+
+void BacktraceBlock(const ir::Block* block, ir_info::BlockLiveRanges& live_ranges) {
   // Backtrace through instructions in block
   // Add value defintions and uses (outside phi instructions)
   block->ForEachNonPhiInstrReverse([&live_ranges](ir::Instr* instr) {
@@ -31,60 +102,23 @@ void BacktraceBlock(const ir::Func* func, const ir::Block* block,
       live_ranges.AddValueUse(used_computed->number(), instr);
     }
   });
-
-  // Include values used in phi instructions of children
-  for (ir::block_num_t child_num : block->children()) {
-    func->GetBlock(child_num)->ForEachPhiInstr([&](ir::PhiInstr* instr) {
-      ir::Value* value = instr->ValueInheritedFromBlock(block->number()).get();
-      if (value->kind() != ir::Value::Kind::kComputed) {
-        return;
-      }
-      auto computed = static_cast<ir::Computed*>(value);
-      live_ranges.PropagateBackwardsFromExitSet(computed->number());
-    });
-  }
 }
 
 }  // namespace
 
 const ir_info::FuncLiveRanges FindLiveRangesForFunc(const ir::Func* func) {
   ir_info::FuncLiveRanges func_live_ranges(func);
-  std::unordered_set<ir::block_num_t> queue;
+  DataflowResults liveness = SolveDataflowProblem(func, LivenessProblem(func));
 
   for (auto& block : func->blocks()) {
     ir_info::BlockLiveRanges& block_live_ranges =
         func_live_ranges.GetBlockLiveRanges(block->number());
 
-    BacktraceBlock(func, block.get(), block_live_ranges);
-
-    if (!block_live_ranges.GetEntrySet().empty()) {
-      queue.insert(block->number());
-    }
-  }
-
-  while (!queue.empty()) {
-    auto it = queue.begin();
-    ir::block_num_t bnum = *it;
-    queue.erase(it);
+    BacktraceBlock(block.get(), block_live_ranges);
 
-    ir_info::BlockLiveRanges& block_live_ranges = func_live_ranges.GetBlockLiveRanges(bnum);
-
-    for (ir::block_num_t parent_num : func->GetBlock(bnum)->parents()) {
-      ir_info::BlockLiveRanges& parent_live_ranges =
-          func_live_ranges.GetBlockLiveRanges(parent_num);
-
-      size_t old_entry_set_size = parent_live_ranges.GetEntrySet().size();
-
-      for (ir::value_num_t value : block_live_ranges.GetEntrySet()) {
-        parent_live_ranges.PropagateBackwardsFromExitSet(value);
-      }
-
-      size_t new_entry_set_size = parent_live_ranges.GetEntrySet().size();
-
-      if (old_entry_set_size < new_entry_set_size) {
-        queue.insert(parent_num);
-      }
-    }
+    liveness.ExitSetOf(block->number()).ForEachSetBit([&](int64_t value) {
+      block_live_ranges.PropagateBackwardsFromExitSet(ir::value_num_t(value));
+    });
   }
 
   return func_live_ranges;
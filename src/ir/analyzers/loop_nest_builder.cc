@@ -0,0 +1,82 @@
+//
+//  loop_nest_builder.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "loop_nest_builder.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "src/common/logging/logging.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/num_types.h"
+
+namespace ir_analyzers {
+
+using ::common::logging::fail;
+
+const ir_info::LoopNest BuildLoopNestForFunc(const ir::Func* func,
+                                             const ir_info::DominatorTree& dominator_tree) {
+  if (dominator_tree.kind() != ir_info::DominatorTree::Kind::kDominators) {
+    fail("attempted to build loop nest from post-dominator tree");
+  }
+  ir_info::LoopNest loop_nest(func->block_count());
+
+  // Headers of enclosing loops dominate the headers of nested loops, so visiting headers in
+  // preorder of the dominator tree adds each loop after the loops containing it.
+  std::vector<ir::block_num_t> loop_marks(func->block_count(), ir::kNoBlockNum);
+  for (ir::block_num_t header : dominator_tree.blocks_in_preorder()) {
+    std::vector<ir::block_num_t> latches;
+    for (ir::block_num_t parent : func->GetBlock(header)->parents()) {
+      if (dominator_tree.Dominates(header, parent)) {
+        latches.push_back(parent);
+      }
+    }
+    if (latches.empty()) {
+      continue;
+    }
+    std::sort(latches.begin(), latches.end());
+
+    // The loop consists of the header and all blocks that reach a latch without passing the header.
+    std::vector<ir::block_num_t> blocks{header};
+    loop_marks.at(header) = header;
+    std::vector<ir::block_num_t> worklist(latches.begin(), latches.end());
+    while (!worklist.empty()) {
+      ir::block_num_t bnum = worklist.back();
+      worklist.pop_back();
+      if (loop_marks.at(bnum) == header) {
+        continue;
+      }
+      loop_marks.at(bnum) = header;
+      blocks.push_back(bnum);
+      for (ir::block_num_t parent : func->GetBlock(bnum)->parents()) {
+        if (loop_marks.at(parent) != header && dominator_tree.Contains(parent)) {
+          worklist.push_back(parent);
+        }
+      }
+    }
+    std::sort(blocks.begin(), blocks.end());
+
+    std::vector<ir::block_num_t> exits;
+    for (ir::block_num_t bnum : blocks) {
+      for (ir::block_num_t child : func->GetBlock(bnum)->children()) {
+        if (loop_marks.at(child) != header) {
+          exits.push_back(child);
+        }
+      }
+    }
+    std::sort(exits.begin(), exits.end());
+    exits.erase(std::unique(exits.begin(), exits.end()), exits.end());
+
+    loop_nest.AddLoop(header, std::move(latches), std::move(blocks), std::move(exits),
+                      loop_nest.LoopOf(header));
+  }
+  return loop_nest;
+}
+
+}  // namespace ir_analyzers
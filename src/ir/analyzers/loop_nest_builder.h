@@ -0,0 +1,25 @@
+//
+//  loop_nest_builder.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_analyzers_loop_nest_builder_h
+#define ir_analyzers_loop_nest_builder_h
+
+#include "src/ir/info/dominator_tree.h"
+#include "src/ir/info/loop_nest.h"
+#include "src/ir/representation/func.h"
+
+namespace ir_analyzers {
+
+// Finds natural loops from back edges, i.e. edges to blocks dominating their source, and nests them
+// by containment. Unreachable blocks are never part of a loop.
+const ir_info::LoopNest BuildLoopNestForFunc(const ir::Func* func,
+                                             const ir_info::DominatorTree& dominator_tree);
+
+}  // namespace ir_analyzers
+
+#endif /* ir_analyzers_loop_nest_builder_h */
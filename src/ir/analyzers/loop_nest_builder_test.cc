@@ -0,0 +1,124 @@
+//
+//  loop_nest_builder_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/analyzers/loop_nest_builder.h"
+
+#include <memory>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/ir/analyzers/dominator_tree_builder.h"
+#include "src/ir/info/loop_nest.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+
+namespace ir_analyzers {
+namespace {
+
+using ::ir_info::Loop;
+using ::ir_info::LoopNest;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+LoopNest BuildLoopNest(const ir::Func* func) {
+  return BuildLoopNestForFunc(func, BuildDominatorTreeForFunc(func));
+}
+
+TEST(BuildLoopNestForFuncTest, FindsNoLoopsWithoutBackEdges) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f(%0:b) => () {
+{0}
+  jcc %0, {1}, {2}
+{1}
+  jmp {2}
+{2}
+  ret
+}
+)ir");
+  const LoopNest loop_nest = BuildLoopNest(program->GetFunc(0));
+
+  EXPECT_THAT(loop_nest.loops(), IsEmpty());
+  EXPECT_EQ(loop_nest.LoopOf(1), nullptr);
+  EXPECT_EQ(loop_nest.LoopDepthOf(1), 0);
+}
+
+TEST(BuildLoopNestForFuncTest, FindsNestedLoops) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f(%0:b, %1:b) => () {
+{0}
+  jmp {1}
+{1}
+  jcc %0, {2}, {5}
+{2}
+  jcc %1, {3}, {4}
+{3}
+  jmp {2}
+{4}
+  jmp {1}
+{5}
+  ret
+}
+)ir");
+  const LoopNest loop_nest = BuildLoopNest(program->GetFunc(0));
+
+  ASSERT_EQ(loop_nest.loops().size(), 2);
+  Loop* outer_loop = loop_nest.LoopWithHeader(1);
+  Loop* inner_loop = loop_nest.LoopWithHeader(2);
+  ASSERT_NE(outer_loop, nullptr);
+  ASSERT_NE(inner_loop, nullptr);
+  EXPECT_THAT(loop_nest.top_level_loops(), ElementsAre(outer_loop));
+
+  EXPECT_THAT(outer_loop->latches(), ElementsAre(4));
+  EXPECT_THAT(outer_loop->blocks(), ElementsAre(1, 2, 3, 4));
+  EXPECT_THAT(outer_loop->exits(), ElementsAre(5));
+  EXPECT_EQ(outer_loop->parent(), nullptr);
+  EXPECT_THAT(outer_loop->children(), ElementsAre(inner_loop));
+  EXPECT_EQ(outer_loop->depth(), 1);
+
+  EXPECT_THAT(inner_loop->latches(), ElementsAre(3));
+  EXPECT_THAT(inner_loop->blocks(), ElementsAre(2, 3));
+  EXPECT_THAT(inner_loop->exits(), ElementsAre(4));
+  EXPECT_EQ(inner_loop->parent(), outer_loop);
+  EXPECT_EQ(inner_loop->depth(), 2);
+
+  EXPECT_EQ(loop_nest.LoopOf(0), nullptr);
+  EXPECT_EQ(loop_nest.LoopOf(1), outer_loop);
+  EXPECT_EQ(loop_nest.LoopOf(3), inner_loop);
+  EXPECT_EQ(loop_nest.LoopOf(4), outer_loop);
+  EXPECT_EQ(loop_nest.LoopDepthOf(3), 2);
+  EXPECT_EQ(loop_nest.LoopDepthOf(5), 0);
+}
+
+TEST(BuildLoopNestForFuncTest, MergesBackEdgesToSameHeader) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 f(%0:b, %1:b) => () {
+{0}
+  jmp {1}
+{1}
+  jcc %0, {2}, {3}
+{2}
+  jcc %1, {1}, {4}
+{3}
+  jmp {1}
+{4}
+  ret
+}
+)ir");
+  const LoopNest loop_nest = BuildLoopNest(program->GetFunc(0));
+
+  ASSERT_EQ(loop_nest.loops().size(), 1);
+  const Loop* loop = loop_nest.loops().front().get();
+  EXPECT_EQ(loop->header(), 1);
+  EXPECT_THAT(loop->latches(), ElementsAre(2, 3));
+  EXPECT_THAT(loop->blocks(), ElementsAre(1, 2, 3));
+  EXPECT_THAT(loop->exits(), ElementsAre(4));
+}
+
+}  // namespace
+}  // namespace ir_analyzers
@@ -8,6 +8,7 @@
 
 #include "block_live_ranges.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -97,35 +98,41 @@ std::unordered_set<ir::value_num_t> BlockLiveRanges::GetLiveSet(const ir::Instr*
   return live_set;
 }
 
-bool BlockLiveRanges::InstrsAreOrdered(const ir::Instr* instr_a, const ir::Instr* instr_b) const {
-  std::size_t index_a = 0;
-  std::size_t index_b = 0;
-  for (std::size_t i = 0; i < block_->instrs().size(); i++) {
-    const ir::Instr* instr = block_->instrs().at(i).get();
-    if (instr == instr_a) {
-      index_a = i;
-    }
-    if (instr == instr_b) {
-      index_b = i;
-    }
+int64_t BlockLiveRanges::IndexOfInstr(const ir::Instr* instr) const {
+  const auto& instrs = block_->instrs();
+  auto is_valid = [&](auto it) {
+    return it != instr_indices_.end() && it->second < int64_t(instrs.size()) &&
+           instrs.at(it->second).get() == instr;
+  };
+  if (auto it = instr_indices_.find(instr); is_valid(it)) {
+    return it->second;
   }
+  instr_indices_.clear();
+  for (std::size_t i = 0; i < instrs.size(); i++) {
+    instr_indices_.insert({instrs.at(i).get(), int64_t(i)});
+  }
+  if (auto it = instr_indices_.find(instr); it != instr_indices_.end()) {
+    return it->second;
+  }
+  return -1;
+}
+
+bool BlockLiveRanges::InstrsAreOrdered(const ir::Instr* instr_a, const ir::Instr* instr_b) const {
+  int64_t index_a = std::max(IndexOfInstr(instr_a), int64_t{0});
+  int64_t index_b = std::max(IndexOfInstr(instr_b), int64_t{0});
   return index_a <= index_b;
 }
 
 bool BlockLiveRanges::InstrIsInRange(const ir::Instr* needle_instr, const ValueRange& range) const {
-  std::size_t needle_index = 0;
-  std::size_t range_start = 0;
-  std::size_t range_end = block_->instrs().size();
-  for (std::size_t i = 0; i < block_->instrs().size(); i++) {
-    const ir::Instr* instr = block_->instrs().at(i).get();
-    if (instr == needle_instr) {
-      needle_index = i;
-    }
-    if (instr == range.start_instr_) {
-      range_start = i;
-    }
-    if (instr == range.end_instr_) {
-      range_end = i;
+  int64_t needle_index = std::max(IndexOfInstr(needle_instr), int64_t{0});
+  int64_t range_start = 0;
+  int64_t range_end = int64_t(block_->instrs().size());
+  if (range.start_instr_ != nullptr) {
+    range_start = std::max(IndexOfInstr(range.start_instr_), int64_t{0});
+  }
+  if (range.end_instr_ != nullptr) {
+    if (int64_t index = IndexOfInstr(range.end_instr_); index != -1) {
+      range_end = index;
     }
   }
   return range_start <= needle_index && needle_index <= range_end;
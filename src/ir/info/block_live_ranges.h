@@ -45,11 +45,16 @@ class BlockLiveRanges {
     const ir::Instr* end_instr_;
   };
 
+  // Returns the index of the instr in the block or -1 if the block does not contain it. Indices
+  // get cached and the cache gets rebuilt when it is outdated, since the block can change after
+  // live ranges were computed (e.g. when resolving phis).
+  int64_t IndexOfInstr(const ir::Instr* instr) const;
   bool InstrsAreOrdered(const ir::Instr* instr_a, const ir::Instr* instr_b) const;
   bool InstrIsInRange(const ir::Instr* instr, const ValueRange& range) const;
 
   const ir::Block* block_;
   std::unordered_map<ir::value_num_t, ValueRange> value_ranges_;
+  mutable std::unordered_map<const ir::Instr*, int64_t> instr_indices_;
 };
 
 }  // namespace ir_info
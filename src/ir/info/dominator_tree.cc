@@ -0,0 +1,120 @@
+//
+//  dominator_tree.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "dominator_tree.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include "src/common/logging/logging.h"
+
+namespace ir_info {
+
+using ::common::logging::fail;
+
+DominatorTree::DominatorTree(Kind kind, int64_t block_count)
+    : kind_(kind),
+      idoms_(block_count, kNotInTree),
+      dominees_(block_count),
+      preorder_nums_(block_count, -1),
+      subtree_ends_(block_count, -1) {}
+
+bool DominatorTree::Contains(ir::block_num_t bnum) const {
+  return 0 <= bnum && bnum < ir::block_num_t(idoms_.size()) && idoms_.at(bnum) != kNotInTree;
+}
+
+ir::block_num_t DominatorTree::ImmediateDominatorOf(ir::block_num_t dominee) const {
+  if (!Contains(dominee)) {
+    fail("requested immediate dominator of block not in dominator tree");
+  }
+  return idoms_.at(dominee);
+}
+
+const std::vector<ir::block_num_t>& DominatorTree::ImmediateDomineesOf(
+    ir::block_num_t dominator) const {
+  if (!Contains(dominator)) {
+    fail("requested immediate dominees of block not in dominator tree");
+  }
+  return dominees_.at(dominator);
+}
+
+bool DominatorTree::Dominates(ir::block_num_t dominator, ir::block_num_t dominee) const {
+  if (!Contains(dominator) || !Contains(dominee)) {
+    return false;
+  }
+  int64_t dominee_num = preorder_nums_.at(dominee);
+  return preorder_nums_.at(dominator) <= dominee_num && dominee_num < subtree_ends_.at(dominator);
+}
+
+void DominatorTree::SetImmediateDominator(ir::block_num_t dominee, ir::block_num_t dominator) {
+  idoms_.at(dominee) = dominator;
+}
+
+void DominatorTree::Finalize() {
+  roots_.clear();
+  for (ir::block_num_t bnum = 0; bnum < ir::block_num_t(idoms_.size()); bnum++) {
+    dominees_.at(bnum).clear();
+  }
+  for (ir::block_num_t bnum = 0; bnum < ir::block_num_t(idoms_.size()); bnum++) {
+    ir::block_num_t idom = idoms_.at(bnum);
+    if (idom == kNotInTree) {
+      continue;
+    } else if (idom == ir::kNoBlockNum) {
+      roots_.push_back(bnum);
+    } else {
+      dominees_.at(idom).push_back(bnum);
+    }
+  }
+
+  // Number the blocks in preorder, such that the subtree of each block occupies the range from its
+  // own number to its subtree end.
+  preorder_.clear();
+  std::vector<std::pair<ir::block_num_t, bool>> stack;
+  for (auto it = roots_.rbegin(); it != roots_.rend(); ++it) {
+    stack.push_back({*it, /*visited=*/false});
+  }
+  while (!stack.empty()) {
+    auto [bnum, visited] = stack.back();
+    stack.pop_back();
+    if (visited) {
+      subtree_ends_.at(bnum) = int64_t(preorder_.size());
+      continue;
+    }
+    preorder_nums_.at(bnum) = int64_t(preorder_.size());
+    preorder_.push_back(bnum);
+    stack.push_back({bnum, /*visited=*/true});
+    const std::vector<ir::block_num_t>& dominees = dominees_.at(bnum);
+    for (auto it = dominees.rbegin(); it != dominees.rend(); ++it) {
+      stack.push_back({*it, /*visited=*/false});
+    }
+  }
+}
+
+std::string DominatorTree::ToString() const {
+  std::stringstream ss;
+  ss << (kind_ == Kind::kDominators ? "dominators:" : "post-dominators:");
+  for (ir::block_num_t bnum : preorder_) {
+    ss << "\n{" << bnum << "}";
+    if (idoms_.at(bnum) != ir::kNoBlockNum) {
+      ss << " idom: {" << idoms_.at(bnum) << "}";
+    }
+  }
+  return ss.str();
+}
+
+void DominanceFrontiers::AddToDominanceFrontier(ir::block_num_t bnum,
+                                                ir::block_num_t frontier_bnum) {
+  std::vector<ir::block_num_t>& frontier = frontiers_.at(bnum);
+  auto it = std::lower_bound(frontier.begin(), frontier.end(), frontier_bnum);
+  if (it == frontier.end() || *it != frontier_bnum) {
+    frontier.insert(it, frontier_bnum);
+  }
+}
+
+}  // namespace ir_info
@@ -0,0 +1,91 @@
+//
+//  dominator_tree.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_info_dominator_tree_h
+#define ir_info_dominator_tree_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/ir/representation/num_types.h"
+
+namespace ir_info {
+
+// A dominator or post-dominator tree of a function. All per block data is stored in vectors indexed
+// by block_num_t. Blocks that can not be reached from any root are not part of the tree.
+//
+// The dominator tree has the entry block as its only root. The post-dominator tree is a forest: its
+// roots are the blocks without children and blocks whose paths reach different exits.
+class DominatorTree {
+ public:
+  enum class Kind {
+    kDominators,
+    kPostDominators,
+  };
+
+  DominatorTree(Kind kind, int64_t block_count);
+
+  Kind kind() const { return kind_; }
+  const std::vector<ir::block_num_t>& roots() const { return roots_; }
+  // Returns all blocks in the tree, such that each block comes after its immediate dominator.
+  const std::vector<ir::block_num_t>& blocks_in_preorder() const { return preorder_; }
+
+  bool Contains(ir::block_num_t bnum) const;
+  // Returns the immediate dominator of the block or kNoBlockNum for roots.
+  ir::block_num_t ImmediateDominatorOf(ir::block_num_t dominee) const;
+  const std::vector<ir::block_num_t>& ImmediateDomineesOf(ir::block_num_t dominator) const;
+
+  // Returns if every path from a root to the dominee passes through the dominator. Each block
+  // dominates itself. Runs in constant time.
+  bool Dominates(ir::block_num_t dominator, ir::block_num_t dominee) const;
+  bool StrictlyDominates(ir::block_num_t dominator, ir::block_num_t dominee) const {
+    return dominator != dominee && Dominates(dominator, dominee);
+  }
+
+  // Used by the builder: adds the block to the tree. Roots get kNoBlockNum as immediate dominator.
+  void SetImmediateDominator(ir::block_num_t dominee, ir::block_num_t dominator);
+  // Used by the builder: computes the tree order once all immediate dominators are set.
+  void Finalize();
+
+  std::string ToString() const;
+
+ private:
+  static constexpr ir::block_num_t kNotInTree = -2;
+
+  Kind kind_;
+  std::vector<ir::block_num_t> idoms_;                  // block_num_t -> block_num_t
+  std::vector<std::vector<ir::block_num_t>> dominees_;  // block_num_t -> block_num_t[]
+  std::vector<int64_t> preorder_nums_;                  // block_num_t -> index in preorder_
+  std::vector<int64_t> subtree_ends_;                   // block_num_t -> index in preorder_
+  std::vector<ir::block_num_t> roots_;
+  std::vector<ir::block_num_t> preorder_;
+};
+
+// The dominance frontier of a block contains the blocks where its dominance ends, i.e. blocks that
+// are not strictly dominated by it but have a parent dominated by it. For a post-dominator tree,
+// these are the reverse dominance frontiers, which describe control dependence.
+class DominanceFrontiers {
+ public:
+  explicit DominanceFrontiers(int64_t block_count) : frontiers_(block_count) {}
+
+  // Returns the frontier blocks sorted by block number.
+  const std::vector<ir::block_num_t>& DominanceFrontierOf(ir::block_num_t bnum) const {
+    return frontiers_.at(bnum);
+  }
+
+  // Adds the frontier block, if it is not part of the frontier already.
+  void AddToDominanceFrontier(ir::block_num_t bnum, ir::block_num_t frontier_bnum);
+
+ private:
+  std::vector<std::vector<ir::block_num_t>> frontiers_;  // block_num_t -> block_num_t[]
+};
+
+}  // namespace ir_info
+
+#endif /* ir_info_dominator_tree_h */
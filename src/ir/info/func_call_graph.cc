@@ -16,6 +16,7 @@ std::unordered_set<ir::func_num_t> FuncCallGraph::CalleesOfFunc(ir::func_num_t c
   std::unordered_set<ir::func_num_t> callees;
   for (const auto& func_call : func_calls_) {
     if (func_call->caller() == caller_num) {
+      callees.insert(func_call->callees().begin(), func_call->callees().end());
     }
   }
   return callees;
@@ -155,6 +155,14 @@ std::unordered_set<ir_info::color_t> InterferenceGraphColors::GetColors(
   return colors;
 }
 
+std::unordered_set<ir_info::color_t> InterferenceGraphColors::GetColors() const {
+  std::unordered_set<ir_info::color_t> colors;
+  for (auto [value, color] : colors_) {
+    colors.insert(color);
+  }
+  return colors;
+}
+
 std::string InterferenceGraphColors::ToString() const {
   std::stringstream ss;
   ss << "interference graph colors:";
@@ -45,6 +45,8 @@ class InterferenceGraphColors {
   color_t GetColor(ir::value_num_t value) const;
   std::unordered_set<ir_info::color_t> GetColors(
       const std::unordered_set<ir::value_num_t>& values) const;
+  // Returns the colors of all values.
+  std::unordered_set<ir_info::color_t> GetColors() const;
 
   void SetColor(ir::value_num_t value, color_t color) { colors_.insert({value, color}); }
 
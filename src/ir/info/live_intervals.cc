@@ -0,0 +1,92 @@
+//
+//  live_intervals.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "live_intervals.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include "src/common/logging/logging.h"
+
+namespace ir_info {
+
+using ::common::logging::fail;
+
+void LiveInterval::AddRange(live_pos_t start, live_pos_t end) {
+  if (start >= end) {
+    fail("attempted to add empty live range");
+  }
+  if (ranges_.empty()) {
+    ranges_.push_back(Range{.start = start, .end = end});
+  } else if (ranges_.back().end > start) {
+    fail("attempted to add live range out of order");
+  } else if (ranges_.back().end == start) {
+    ranges_.back().end = end;
+  } else {
+    ranges_.push_back(Range{.start = start, .end = end});
+  }
+}
+
+bool LiveInterval::Covers(live_pos_t pos) const {
+  auto it = std::upper_bound(ranges_.begin(), ranges_.end(), pos,
+                             [](live_pos_t pos, const Range& range) { return pos < range.end; });
+  return it != ranges_.end() && it->start <= pos;
+}
+
+live_pos_t LiveInterval::FirstIntersectionWith(const LiveInterval& other) const {
+  auto it_a = ranges_.begin();
+  auto it_b = other.ranges_.begin();
+  while (it_a != ranges_.end() && it_b != other.ranges_.end()) {
+    live_pos_t start = std::max(it_a->start, it_b->start);
+    if (start < it_a->end && start < it_b->end) {
+      return start;
+    }
+    if (it_a->end <= it_b->end) {
+      ++it_a;
+    } else {
+      ++it_b;
+    }
+  }
+  return kNoLivePos;
+}
+
+std::string LiveInterval::ToString() const {
+  std::stringstream ss;
+  ss << "%" << value_ << ":";
+  for (const Range& range : ranges_) {
+    ss << " [" << range.start << ", " << range.end << ")";
+  }
+  return ss.str();
+}
+
+void FuncLiveIntervals::AddInterval(LiveInterval interval) {
+  if (interval.ranges().empty()) {
+    fail("attempted to add empty live interval");
+  }
+  intervals_.push_back(std::move(interval));
+}
+
+void FuncLiveIntervals::SortIntervals() {
+  std::sort(intervals_.begin(), intervals_.end(), [](const LiveInterval& a, const LiveInterval& b) {
+    if (a.start() != b.start()) {
+      return a.start() < b.start();
+    }
+    return a.value() < b.value();
+  });
+}
+
+std::string FuncLiveIntervals::ToString() const {
+  std::stringstream ss;
+  for (const LiveInterval& interval : intervals_) {
+    ss << interval.ToString() << "\n";
+  }
+  return ss.str();
+}
+
+}  // namespace ir_info
@@ -0,0 +1,71 @@
+//
+//  live_intervals.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_info_live_intervals_h
+#define ir_info_live_intervals_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/ir/representation/num_types.h"
+
+namespace ir_info {
+
+// Positions number the instructions of a function in a linear block order. Each instruction takes
+// two positions: it uses values at the even position and defines values at the odd position.
+typedef int64_t live_pos_t;
+constexpr live_pos_t kNoLivePos = -1;
+
+// The positions at which a value is live, as sorted, disjoint, half open ranges. Gaps between
+// ranges are lifetime holes, in which the location of the value can hold other values.
+class LiveInterval {
+ public:
+  struct Range {
+    live_pos_t start;
+    live_pos_t end;
+  };
+
+  explicit LiveInterval(ir::value_num_t value) : value_(value) {}
+
+  ir::value_num_t value() const { return value_; }
+  const std::vector<Range>& ranges() const { return ranges_; }
+  live_pos_t start() const { return ranges_.front().start; }
+  live_pos_t end() const { return ranges_.back().end; }
+
+  // Adds a range after all existing ranges, merging it with the last range if they touch.
+  void AddRange(live_pos_t start, live_pos_t end);
+
+  bool Covers(live_pos_t pos) const;
+  // Returns the first position covered by both intervals, or kNoLivePos if there is none.
+  live_pos_t FirstIntersectionWith(const LiveInterval& other) const;
+
+  std::string ToString() const;
+
+ private:
+  ir::value_num_t value_;
+  std::vector<Range> ranges_;
+};
+
+class FuncLiveIntervals {
+ public:
+  // Returns the intervals sorted by start position, with ties broken by value number.
+  const std::vector<LiveInterval>& intervals() const { return intervals_; }
+
+  void AddInterval(LiveInterval interval);
+  void SortIntervals();
+
+  std::string ToString() const;
+
+ private:
+  std::vector<LiveInterval> intervals_;
+};
+
+}  // namespace ir_info
+
+#endif /* ir_info_live_intervals_h */
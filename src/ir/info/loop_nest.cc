@@ -0,0 +1,90 @@
+//
+//  loop_nest.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "loop_nest.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include "src/common/logging/logging.h"
+
+namespace ir_info {
+
+using ::common::logging::fail;
+
+Loop::Loop(ir::block_num_t header, std::vector<ir::block_num_t> latches,
+           std::vector<ir::block_num_t> blocks, std::vector<ir::block_num_t> exits, Loop* parent)
+    : header_(header),
+      latches_(std::move(latches)),
+      blocks_(std::move(blocks)),
+      exits_(std::move(exits)),
+      parent_(parent),
+      depth_((parent != nullptr) ? parent->depth() + 1 : 1) {}
+
+bool Loop::Contains(ir::block_num_t bnum) const {
+  return std::binary_search(blocks_.begin(), blocks_.end(), bnum);
+}
+
+std::vector<Loop*> LoopNest::top_level_loops() const {
+  std::vector<Loop*> top_level_loops;
+  for (auto& loop : loops_) {
+    if (loop->parent() == nullptr) {
+      top_level_loops.push_back(loop.get());
+    }
+  }
+  return top_level_loops;
+}
+
+Loop* LoopNest::LoopWithHeader(ir::block_num_t header) const {
+  Loop* loop = LoopOf(header);
+  while (loop != nullptr && loop->header() != header) {
+    loop = loop->parent();
+  }
+  return loop;
+}
+
+int64_t LoopNest::LoopDepthOf(ir::block_num_t bnum) const {
+  Loop* loop = LoopOf(bnum);
+  return (loop != nullptr) ? loop->depth() : 0;
+}
+
+Loop* LoopNest::AddLoop(ir::block_num_t header, std::vector<ir::block_num_t> latches,
+                        std::vector<ir::block_num_t> blocks, std::vector<ir::block_num_t> exits,
+                        Loop* parent) {
+  if (!std::binary_search(blocks.begin(), blocks.end(), header)) {
+    fail("attempted to add loop not containing its header");
+  }
+  if (innermost_loops_.at(header) != parent) {
+    fail("attempted to add loop with inconsistent parent loop");
+  }
+  Loop* loop = loops_.emplace_back(new Loop(header, std::move(latches), std::move(blocks),
+                                            std::move(exits), parent))
+                   .get();
+  if (parent != nullptr) {
+    parent->children_.push_back(loop);
+  }
+  for (ir::block_num_t bnum : loop->blocks()) {
+    innermost_loops_.at(bnum) = loop;
+  }
+  return loop;
+}
+
+std::string LoopNest::ToString() const {
+  std::stringstream ss;
+  ss << "loops:";
+  for (auto& loop : loops_) {
+    ss << "\n" << std::string(2 * (loop->depth() - 1), ' ') << "{" << loop->header() << "}:";
+    for (ir::block_num_t bnum : loop->blocks()) {
+      ss << " {" << bnum << "}";
+    }
+  }
+  return ss.str();
+}
+
+}  // namespace ir_info
@@ -0,0 +1,86 @@
+//
+//  loop_nest.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_info_loop_nest_h
+#define ir_info_loop_nest_h
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/ir/representation/num_types.h"
+
+namespace ir_info {
+
+// A natural loop: the header dominates all blocks of the loop and each latch has a back edge to the
+// header. Back edges to the same header form a single loop.
+class Loop {
+ public:
+  ir::block_num_t header() const { return header_; }
+  // Returns the sources of back edges to the header, sorted by block number.
+  const std::vector<ir::block_num_t>& latches() const { return latches_; }
+  // Returns all blocks of the loop including the header and blocks of nested loops, sorted by block
+  // number.
+  const std::vector<ir::block_num_t>& blocks() const { return blocks_; }
+  // Returns blocks outside the loop with a parent inside the loop, sorted by block number.
+  const std::vector<ir::block_num_t>& exits() const { return exits_; }
+
+  bool Contains(ir::block_num_t bnum) const;
+
+  Loop* parent() const { return parent_; }
+  const std::vector<Loop*>& children() const { return children_; }
+  // Returns the number of loops containing the loop, including itself.
+  int64_t depth() const { return depth_; }
+
+ private:
+  Loop(ir::block_num_t header, std::vector<ir::block_num_t> latches,
+       std::vector<ir::block_num_t> blocks, std::vector<ir::block_num_t> exits, Loop* parent);
+
+  ir::block_num_t header_;
+  std::vector<ir::block_num_t> latches_;
+  std::vector<ir::block_num_t> blocks_;
+  std::vector<ir::block_num_t> exits_;
+  Loop* parent_;
+  std::vector<Loop*> children_;
+  int64_t depth_;
+
+  friend class LoopNest;
+};
+
+// The loop nest forest of a function. Loops are stored such that each loop comes after the loop
+// containing it. Per block data is stored in vectors indexed by block_num_t.
+class LoopNest {
+ public:
+  explicit LoopNest(int64_t block_count) : innermost_loops_(block_count, nullptr) {}
+
+  const std::vector<std::unique_ptr<Loop>>& loops() const { return loops_; }
+  std::vector<Loop*> top_level_loops() const;
+
+  // Returns the innermost loop containing the block or nullptr if the block is not in a loop.
+  Loop* LoopOf(ir::block_num_t bnum) const { return innermost_loops_.at(bnum); }
+  Loop* LoopWithHeader(ir::block_num_t header) const;
+  // Returns the number of loops containing the block.
+  int64_t LoopDepthOf(ir::block_num_t bnum) const;
+
+  // Used by the builder: adds a loop, which has to be contained by the given parent loop and must
+  // not contain any loop added before.
+  Loop* AddLoop(ir::block_num_t header, std::vector<ir::block_num_t> latches,
+                std::vector<ir::block_num_t> blocks, std::vector<ir::block_num_t> exits,
+                Loop* parent);
+
+  std::string ToString() const;
+
+ private:
+  std::vector<std::unique_ptr<Loop>> loops_;
+  std::vector<Loop*> innermost_loops_;  // block_num_t -> Loop*
+};
+
+}  // namespace ir_info
+
+#endif /* ir_info_loop_nest_h */
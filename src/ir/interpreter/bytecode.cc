@@ -0,0 +1,578 @@
+//
+//  bytecode.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "bytecode.h"
+
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+#include "src/common/logging/logging.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/types.h"
+#include "src/ir/representation/values.h"
+
+namespace ir_interpreter {
+
+using ::common::atomics::IntType;
+using ::common::logging::fail;
+
+std::string ToString(Opcode opcode) {
+  switch (opcode) {
+    case Opcode::kMov:
+      return "mov";
+    case Opcode::kBoolToInt:
+      return "bool_to_int";
+    case Opcode::kIntToBool:
+      return "int_to_bool";
+    case Opcode::kIntToInt:
+      return "int_to_int";
+    case Opcode::kIntBinary:
+      return "int_binary";
+    case Opcode::kIntCompare:
+      return "int_compare";
+    case Opcode::kIntShift:
+      return "int_shift";
+    case Opcode::kPointerOffset:
+      return "poff";
+    case Opcode::kNilTestPointer:
+      return "niltest_ptr";
+    case Opcode::kNilTestFunc:
+      return "niltest_func";
+    case Opcode::kMalloc:
+      return "malloc";
+    case Opcode::kLoadBool:
+      return "load_bool";
+    case Opcode::kLoadInt:
+      return "load_int";
+    case Opcode::kStoreBool:
+      return "store_bool";
+    case Opcode::kStoreInt:
+      return "store_int";
+    case Opcode::kFree:
+      return "free";
+    case Opcode::kJump:
+      return "jmp";
+    case Opcode::kJumpCond:
+      return "jcc";
+    case Opcode::kCall:
+      return "call";
+    case Opcode::kReturn:
+      return "ret";
+    case Opcode::kUnsupported:
+      return "unsupported";
+  }
+}
+
+std::string BytecodeFunc::ToString() const {
+  std::stringstream ss;
+  ss << "@" << number() << " registers: " << register_count_
+     << ", constants begin: " << constants_begin_ << ", entry: " << entry_pc_ << "\n";
+  for (pc_t pc = 0; pc < pc_t(instrs_.size()); pc++) {
+    const BytecodeInstr& instr = instrs_.at(pc);
+    ss << std::setw(4) << std::setfill('0') << pc << " "
+       << ::ir_interpreter::ToString(instr.opcode) << " " << instr.a << ", " << instr.b << ", "
+       << instr.c;
+    if (const ir::Instr* origin = origins_.at(pc); origin != nullptr) {
+      ss << " ; " << origin->RefString();
+    }
+    ss << "\n";
+  }
+  return ss.str();
+}
+
+namespace {
+
+int64_t ToRaw(const ir::Constant* constant) {
+  switch (constant->type()->type_kind()) {
+    case ir::TypeKind::kBool:
+      return static_cast<const ir::BoolConstant*>(constant)->value() ? 1 : 0;
+    case ir::TypeKind::kInt:
+      return static_cast<const ir::IntConstant*>(constant)->value().AsInt64();
+    case ir::TypeKind::kPointer:
+      return static_cast<const ir::PointerConstant*>(constant)->value();
+    case ir::TypeKind::kFunc:
+      return static_cast<const ir::FuncConstant*>(constant)->value();
+    default:
+      fail("bytecode compiler does not support constant: " + constant->RefString());
+  }
+}
+
+}  // namespace
+
+class BytecodeCompiler {
+ public:
+  static std::unique_ptr<BytecodeFunc> Compile(const ir::Func* func);
+
+ private:
+  enum class Field {
+    kA,
+    kB,
+    kC,
+  };
+  struct BlockFixup {
+    pc_t pc;
+    Field field;
+    ir::block_num_t block_num;
+  };
+  struct EdgeFixup {
+    pc_t pc;
+    Field field;
+    const ir::Block* origin;
+    const ir::Block* destination;
+  };
+
+  BytecodeCompiler(const ir::Func* func) : func_(func), bytecode_func_(new BytecodeFunc(func)) {}
+
+  void AllocateRegisters();
+  void CompileBlock(const ir::Block* block);
+  void CompileInstr(const ir::Instr* instr);
+  void CompileConversion(const ir::Conversion* instr);
+  void CompileNilTestInstr(const ir::NilTestInstr* instr);
+  void CompileLoadInstr(const ir::LoadInstr* instr);
+  void CompileStoreInstr(const ir::StoreInstr* instr);
+  void CompileJumpInstr(const ir::Block* block, const ir::JumpInstr* instr);
+  void CompileJumpCondInstr(const ir::Block* block, const ir::JumpCondInstr* instr);
+  void CompileCallInstr(const ir::CallInstr* instr);
+  void CompileReturnInstr(const ir::ReturnInstr* instr);
+  void CompileEdgeStubs();
+  void ResolveBlockFixups();
+
+  void EmitPhiMoves(const ir::Block* origin, const ir::Block* destination);
+
+  pc_t Emit(BytecodeInstr instr, const ir::Instr* origin);
+  void SetField(pc_t pc, Field field, reg_num_t value);
+  reg_num_t RegisterFor(const ir::Value* value);
+
+  const ir::Func* func_;
+  std::unique_ptr<BytecodeFunc> bytecode_func_;
+
+  reg_num_t temporaries_begin_ = 0;
+  std::unordered_map<int64_t, reg_num_t> constant_registers_;
+
+  std::unordered_map<ir::block_num_t, pc_t> block_pcs_;
+  std::vector<BlockFixup> block_fixups_;
+  std::vector<EdgeFixup> edge_fixups_;
+};
+
+std::unique_ptr<BytecodeFunc> BytecodeCompiler::Compile(const ir::Func* func) {
+  BytecodeCompiler compiler(func);
+  compiler.AllocateRegisters();
+  for (const auto& arg : func->args()) {
+    compiler.bytecode_func_->arg_registers_.push_back(compiler.RegisterFor(arg.get()));
+  }
+  for (const auto& block : func->blocks()) {
+    compiler.CompileBlock(block.get());
+  }
+  compiler.CompileEdgeStubs();
+  compiler.ResolveBlockFixups();
+  compiler.bytecode_func_->entry_pc_ = compiler.block_pcs_.at(func->entry_block_num());
+  compiler.bytecode_func_->register_count_ =
+      compiler.bytecode_func_->constants_begin_ + compiler.bytecode_func_->constants_.size();
+  return std::move(compiler.bytecode_func_);
+}
+
+void BytecodeCompiler::AllocateRegisters() {
+  // Phis of a block might need to get resolved via temporaries (e.g. when two phis swap their
+  // values), so reserve one temporary per phi of the block with the most phis.
+  reg_num_t max_phi_count = 0;
+  for (const auto& block : func_->blocks()) {
+    reg_num_t phi_count = 0;
+    block->ForEachPhiInstr([&phi_count](ir::PhiInstr*) { phi_count++; });
+    max_phi_count = std::max(max_phi_count, phi_count);
+  }
+  temporaries_begin_ = reg_num_t(func_->computed_count());
+  bytecode_func_->constants_begin_ = temporaries_begin_ + max_phi_count;
+}
+
+void BytecodeCompiler::CompileBlock(const ir::Block* block) {
+  block_pcs_.insert({block->number(), pc_t(bytecode_func_->instrs_.size())});
+  for (const auto& instr : block->instrs()) {
+    switch (instr->instr_kind()) {
+      case ir::InstrKind::kPhi:
+        // Phis get resolved by moves on control flow edges.
+        continue;
+      case ir::InstrKind::kJump:
+        CompileJumpInstr(block, static_cast<const ir::JumpInstr*>(instr.get()));
+        continue;
+      case ir::InstrKind::kJumpCond:
+        CompileJumpCondInstr(block, static_cast<const ir::JumpCondInstr*>(instr.get()));
+        continue;
+      default:
+        CompileInstr(instr.get());
+    }
+  }
+}
+
+void BytecodeCompiler::CompileInstr(const ir::Instr* instr) {
+  switch (instr->instr_kind()) {
+    case ir::InstrKind::kMov: {
+      auto mov = static_cast<const ir::MovInstr*>(instr);
+      Emit(BytecodeInstr{.opcode = Opcode::kMov,
+                         .a = RegisterFor(mov->result().get()),
+                         .b = RegisterFor(mov->origin().get())},
+           instr);
+      return;
+    }
+    case ir::InstrKind::kConversion:
+      CompileConversion(static_cast<const ir::Conversion*>(instr));
+      return;
+    case ir::InstrKind::kIntBinary: {
+      auto binary = static_cast<const ir::IntBinaryInstr*>(instr);
+      Emit(BytecodeInstr{.opcode = Opcode::kIntBinary,
+                         .operation = uint8_t(binary->operation()),
+                         .int_type = static_cast<const ir::IntType*>(binary->result()->type())
+                                         ->int_type(),
+                         .a = RegisterFor(binary->result().get()),
+                         .b = RegisterFor(binary->operand_a().get()),
+                         .c = RegisterFor(binary->operand_b().get())},
+           instr);
+      return;
+    }
+    case ir::InstrKind::kIntCompare: {
+      auto compare = static_cast<const ir::IntCompareInstr*>(instr);
+      Emit(BytecodeInstr{.opcode = Opcode::kIntCompare,
+                         .operation = uint8_t(compare->operation()),
+                         .int_type = static_cast<const ir::IntType*>(compare->operand_a()->type())
+                                         ->int_type(),
+                         .a = RegisterFor(compare->result().get()),
+                         .b = RegisterFor(compare->operand_a().get()),
+                         .c = RegisterFor(compare->operand_b().get())},
+           instr);
+      return;
+    }
+    case ir::InstrKind::kIntShift: {
+      auto shift = static_cast<const ir::IntShiftInstr*>(instr);
+      Emit(BytecodeInstr{
+               .opcode = Opcode::kIntShift,
+               .operation = uint8_t(shift->operation()),
+               .int_type = static_cast<const ir::IntType*>(shift->shifted()->type())->int_type(),
+               .operand_int_type =
+                   static_cast<const ir::IntType*>(shift->offset()->type())->int_type(),
+               .a = RegisterFor(shift->result().get()),
+               .b = RegisterFor(shift->shifted().get()),
+               .c = RegisterFor(shift->offset().get())},
+           instr);
+      return;
+    }
+    case ir::InstrKind::kPointerOffset: {
+      auto pointer_offset = static_cast<const ir::PointerOffsetInstr*>(instr);
+      Emit(BytecodeInstr{.opcode = Opcode::kPointerOffset,
+                         .a = RegisterFor(pointer_offset->result().get()),
+                         .b = RegisterFor(pointer_offset->pointer().get()),
+                         .c = RegisterFor(pointer_offset->offset().get())},
+           instr);
+      return;
+    }
+    case ir::InstrKind::kNilTest:
+      CompileNilTestInstr(static_cast<const ir::NilTestInstr*>(instr));
+      return;
+    case ir::InstrKind::kMalloc: {
+      auto malloc_instr = static_cast<const ir::MallocInstr*>(instr);
+      Emit(BytecodeInstr{.opcode = Opcode::kMalloc,
+                         .a = RegisterFor(malloc_instr->result().get()),
+                         .b = RegisterFor(malloc_instr->size().get())},
+           instr);
+      return;
+    }
+    case ir::InstrKind::kLoad:
+      CompileLoadInstr(static_cast<const ir::LoadInstr*>(instr));
+      return;
+    case ir::InstrKind::kStore:
+      CompileStoreInstr(static_cast<const ir::StoreInstr*>(instr));
+      return;
+    case ir::InstrKind::kFree: {
+      auto free_instr = static_cast<const ir::FreeInstr*>(instr);
+      Emit(BytecodeInstr{.opcode = Opcode::kFree, .a = RegisterFor(free_instr->address().get())},
+           instr);
+      return;
+    }
+    case ir::InstrKind::kCall:
+      CompileCallInstr(static_cast<const ir::CallInstr*>(instr));
+      return;
+    case ir::InstrKind::kReturn:
+      CompileReturnInstr(static_cast<const ir::ReturnInstr*>(instr));
+      return;
+    default:
+      Emit(BytecodeInstr{.opcode = Opcode::kUnsupported}, instr);
+      return;
+  }
+}
+
+void BytecodeCompiler::CompileConversion(const ir::Conversion* instr) {
+  const ir::Type* result_type = instr->result()->type();
+  const ir::Type* operand_type = instr->operand()->type();
+  reg_num_t result = RegisterFor(instr->result().get());
+  reg_num_t operand = RegisterFor(instr->operand().get());
+  if (result_type->type_kind() == ir::TypeKind::kBool &&
+      operand_type->type_kind() == ir::TypeKind::kInt) {
+    Emit(BytecodeInstr{.opcode = Opcode::kIntToBool,
+                       .int_type = static_cast<const ir::IntType*>(operand_type)->int_type(),
+                       .a = result,
+                       .b = operand},
+         instr);
+    return;
+  } else if (result_type->type_kind() == ir::TypeKind::kInt) {
+    IntType result_int_type = static_cast<const ir::IntType*>(result_type)->int_type();
+    if (operand_type->type_kind() == ir::TypeKind::kBool) {
+      Emit(BytecodeInstr{.opcode = Opcode::kBoolToInt,
+                         .int_type = result_int_type,
+                         .a = result,
+                         .b = operand},
+           instr);
+      return;
+    } else if (operand_type->type_kind() == ir::TypeKind::kInt) {
+      Emit(BytecodeInstr{
+               .opcode = Opcode::kIntToInt,
+               .int_type = result_int_type,
+               .operand_int_type = static_cast<const ir::IntType*>(operand_type)->int_type(),
+               .a = result,
+               .b = operand},
+           instr);
+      return;
+    }
+  }
+  Emit(BytecodeInstr{.opcode = Opcode::kUnsupported}, instr);
+}
+
+void BytecodeCompiler::CompileNilTestInstr(const ir::NilTestInstr* instr) {
+  reg_num_t result = RegisterFor(instr->result().get());
+  reg_num_t tested = RegisterFor(instr->tested().get());
+  switch (instr->tested()->type()->type_kind()) {
+    case ir::TypeKind::kPointer:
+      Emit(BytecodeInstr{.opcode = Opcode::kNilTestPointer, .a = result, .b = tested}, instr);
+      return;
+    case ir::TypeKind::kFunc:
+      Emit(BytecodeInstr{.opcode = Opcode::kNilTestFunc, .a = result, .b = tested}, instr);
+      return;
+    default:
+      Emit(BytecodeInstr{.opcode = Opcode::kUnsupported}, instr);
+      return;
+  }
+}
+
+void BytecodeCompiler::CompileLoadInstr(const ir::LoadInstr* instr) {
+  reg_num_t result = RegisterFor(instr->result().get());
+  reg_num_t address = RegisterFor(instr->address().get());
+  const ir::Type* result_type = instr->result()->type();
+  switch (result_type->type_kind()) {
+    case ir::TypeKind::kBool:
+      Emit(BytecodeInstr{.opcode = Opcode::kLoadBool, .a = result, .b = address}, instr);
+      return;
+    case ir::TypeKind::kInt:
+      Emit(BytecodeInstr{.opcode = Opcode::kLoadInt,
+                         .int_type = static_cast<const ir::IntType*>(result_type)->int_type(),
+                         .a = result,
+                         .b = address},
+           instr);
+      return;
+    case ir::TypeKind::kPointer:
+    case ir::TypeKind::kFunc:
+      Emit(BytecodeInstr{
+               .opcode = Opcode::kLoadInt, .int_type = IntType::kI64, .a = result, .b = address},
+           instr);
+      return;
+    default:
+      Emit(BytecodeInstr{.opcode = Opcode::kUnsupported}, instr);
+      return;
+  }
+}
+
+void BytecodeCompiler::CompileStoreInstr(const ir::StoreInstr* instr) {
+  reg_num_t address = RegisterFor(instr->address().get());
+  reg_num_t value = RegisterFor(instr->value().get());
+  const ir::Type* value_type = instr->value()->type();
+  switch (value_type->type_kind()) {
+    case ir::TypeKind::kBool:
+      Emit(BytecodeInstr{.opcode = Opcode::kStoreBool, .a = address, .b = value}, instr);
+      return;
+    case ir::TypeKind::kInt:
+      Emit(BytecodeInstr{.opcode = Opcode::kStoreInt,
+                         .int_type = static_cast<const ir::IntType*>(value_type)->int_type(),
+                         .a = address,
+                         .b = value},
+           instr);
+      return;
+    case ir::TypeKind::kPointer:
+    case ir::TypeKind::kFunc:
+      Emit(BytecodeInstr{
+               .opcode = Opcode::kStoreInt, .int_type = IntType::kI64, .a = address, .b = value},
+           instr);
+      return;
+    default:
+      Emit(BytecodeInstr{.opcode = Opcode::kUnsupported}, instr);
+      return;
+  }
+}
+
+void BytecodeCompiler::CompileJumpInstr(const ir::Block* block, const ir::JumpInstr* instr) {
+  EmitPhiMoves(block, func_->GetBlock(instr->destination()));
+  pc_t pc = Emit(BytecodeInstr{.opcode = Opcode::kJump}, instr);
+  block_fixups_.push_back(
+      BlockFixup{.pc = pc, .field = Field::kA, .block_num = instr->destination()});
+}
+
+void BytecodeCompiler::CompileJumpCondInstr(const ir::Block* block,
+                                            const ir::JumpCondInstr* instr) {
+  pc_t pc = Emit(
+      BytecodeInstr{.opcode = Opcode::kJumpCond, .a = RegisterFor(instr->condition().get())},
+      instr);
+  // Destinations with phis get reached via stubs performing the phi moves for the edge.
+  for (auto [field, destination_num] :
+       std::vector<std::pair<Field, ir::block_num_t>>{{Field::kB, instr->destination_true()},
+                                                      {Field::kC, instr->destination_false()}}) {
+    const ir::Block* destination = func_->GetBlock(destination_num);
+    if (!destination->instrs().empty() &&
+        destination->instrs().front()->instr_kind() == ir::InstrKind::kPhi) {
+      edge_fixups_.push_back(
+          EdgeFixup{.pc = pc, .field = field, .origin = block, .destination = destination});
+    } else {
+      block_fixups_.push_back(BlockFixup{.pc = pc, .field = field, .block_num = destination_num});
+    }
+  }
+}
+
+void BytecodeCompiler::CompileCallInstr(const ir::CallInstr* instr) {
+  reg_num_t pool_offset = reg_num_t(bytecode_func_->operand_pool_.size());
+  for (const auto& arg : instr->args()) {
+    bytecode_func_->operand_pool_.push_back(RegisterFor(arg.get()));
+  }
+  for (const auto& result : instr->results()) {
+    bytecode_func_->operand_pool_.push_back(RegisterFor(result.get()));
+  }
+  Emit(BytecodeInstr{.opcode = Opcode::kCall,
+                     .a = RegisterFor(instr->func().get()),
+                     .b = pool_offset,
+                     .c = reg_num_t(instr->args().size())},
+       instr);
+}
+
+void BytecodeCompiler::CompileReturnInstr(const ir::ReturnInstr* instr) {
+  reg_num_t pool_offset = reg_num_t(bytecode_func_->operand_pool_.size());
+  for (const auto& arg : instr->args()) {
+    bytecode_func_->operand_pool_.push_back(RegisterFor(arg.get()));
+  }
+  Emit(BytecodeInstr{
+           .opcode = Opcode::kReturn, .a = pool_offset, .b = reg_num_t(instr->args().size())},
+       instr);
+}
+
+void BytecodeCompiler::CompileEdgeStubs() {
+  for (const EdgeFixup& fixup : edge_fixups_) {
+    SetField(fixup.pc, fixup.field, pc_t(bytecode_func_->instrs_.size()));
+    EmitPhiMoves(fixup.origin, fixup.destination);
+    pc_t pc = Emit(BytecodeInstr{.opcode = Opcode::kJump}, /*origin=*/nullptr);
+    block_fixups_.push_back(
+        BlockFixup{.pc = pc, .field = Field::kA, .block_num = fixup.destination->number()});
+  }
+}
+
+void BytecodeCompiler::ResolveBlockFixups() {
+  for (const BlockFixup& fixup : block_fixups_) {
+    SetField(fixup.pc, fixup.field, block_pcs_.at(fixup.block_num));
+  }
+}
+
+void BytecodeCompiler::EmitPhiMoves(const ir::Block* origin, const ir::Block* destination) {
+  std::vector<std::pair<reg_num_t, reg_num_t>> moves;  // (result, origin)
+  destination->ForEachPhiInstr([&](ir::PhiInstr* phi) {
+    reg_num_t result = RegisterFor(phi->result().get());
+    reg_num_t value = RegisterFor(phi->ValueInheritedFromBlock(origin->number()).get());
+    if (result != value) {
+      moves.push_back({result, value});
+    }
+  });
+  // All phis read their values before any phi result gets written. If a move would overwrite the
+  // origin of a later move, all values get moved through temporaries instead.
+  bool has_conflict = false;
+  for (std::size_t i = 0; i < moves.size() && !has_conflict; i++) {
+    for (std::size_t j = i + 1; j < moves.size(); j++) {
+      if (moves.at(i).first == moves.at(j).second) {
+        has_conflict = true;
+        break;
+      }
+    }
+  }
+  if (!has_conflict) {
+    for (auto [result, value] : moves) {
+      Emit(BytecodeInstr{.opcode = Opcode::kMov, .a = result, .b = value}, /*origin=*/nullptr);
+    }
+    return;
+  }
+  for (std::size_t i = 0; i < moves.size(); i++) {
+    Emit(BytecodeInstr{.opcode = Opcode::kMov,
+                       .a = temporaries_begin_ + reg_num_t(i),
+                       .b = moves.at(i).second},
+         /*origin=*/nullptr);
+  }
+  for (std::size_t i = 0; i < moves.size(); i++) {
+    Emit(BytecodeInstr{.opcode = Opcode::kMov,
+                       .a = moves.at(i).first,
+                       .b = temporaries_begin_ + reg_num_t(i)},
+         /*origin=*/nullptr);
+  }
+}
+
+pc_t BytecodeCompiler::Emit(BytecodeInstr instr, const ir::Instr* origin) {
+  pc_t pc = pc_t(bytecode_func_->instrs_.size());
+  bytecode_func_->instrs_.push_back(instr);
+  bytecode_func_->origins_.push_back(origin);
+  return pc;
+}
+
+void BytecodeCompiler::SetField(pc_t pc, Field field, reg_num_t value) {
+  BytecodeInstr& instr = bytecode_func_->instrs_.at(pc);
+  switch (field) {
+    case Field::kA:
+      instr.a = value;
+      return;
+    case Field::kB:
+      instr.b = value;
+      return;
+    case Field::kC:
+      instr.c = value;
+      return;
+  }
+}
+
+reg_num_t BytecodeCompiler::RegisterFor(const ir::Value* value) {
+  switch (value->kind()) {
+    case ir::Value::Kind::kComputed:
+      return reg_num_t(static_cast<const ir::Computed*>(value)->number());
+    case ir::Value::Kind::kConstant: {
+      int64_t raw = ToRaw(static_cast<const ir::Constant*>(value));
+      auto it = constant_registers_.find(raw);
+      if (it != constant_registers_.end()) {
+        return it->second;
+      }
+      reg_num_t reg =
+          bytecode_func_->constants_begin_ + reg_num_t(bytecode_func_->constants_.size());
+      bytecode_func_->constants_.push_back(raw);
+      constant_registers_.insert({raw, reg});
+      return reg;
+    }
+    case ir::Value::Kind::kInherited:
+      fail("tried to assign register to inherited value");
+  }
+}
+
+std::unique_ptr<BytecodeProgram> CompileProgram(const ir::Program* program) {
+  auto bytecode_program = std::unique_ptr<BytecodeProgram>(new BytecodeProgram(program));
+  for (const auto& func : program->funcs()) {
+    std::unique_ptr<BytecodeFunc> bytecode_func = BytecodeCompiler::Compile(func.get());
+    if (bytecode_program->funcs_by_num_.size() <= std::size_t(func->number())) {
+      bytecode_program->funcs_by_num_.resize(func->number() + 1, nullptr);
+    }
+    bytecode_program->funcs_by_num_.at(func->number()) = bytecode_func.get();
+    bytecode_program->funcs_.push_back(std::move(bytecode_func));
+  }
+  return bytecode_program;
+}
+
+}  // namespace ir_interpreter
@@ -0,0 +1,141 @@
+//
+//  bytecode.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_interpreter_bytecode_h
+#define ir_interpreter_bytecode_h
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/common/atomics/atomics.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/instrs.h"
+#include "src/ir/representation/num_types.h"
+#include "src/ir/representation/program.h"
+
+namespace ir_interpreter {
+
+// Index of a register slot within a bytecode stack frame. Registers [0, computed_count) hold
+// computed values (indexed by value number), followed by constants and temporaries.
+typedef int32_t reg_num_t;
+
+// Index of an instruction within a bytecode function.
+typedef int32_t pc_t;
+
+// Opcodes of the pre-decoded bytecode. Operand types are resolved during compilation, so every
+// register holds a raw int64_t: bools are 0 or 1, ints are sign or zero extended from their
+// IntType, pointers are addresses, and funcs are func_num_t values.
+//
+// The comments list how the instruction fields a, b, c are used.
+enum class Opcode : uint8_t {
+  kMov,              // a = result, b = origin
+  kBoolToInt,        // a = result, b = operand; int_type = result type
+  kIntToBool,        // a = result, b = operand; int_type = operand type
+  kIntToInt,         // a = result, b = operand; int_type = result type, operand_int_type
+  kIntBinary,        // a = result, b = operand a, c = operand b; operation = Int::BinaryOp
+  kIntCompare,       // a = result, b = operand a, c = operand b; operation = Int::CompareOp
+  kIntShift,         // a = result, b = shifted, c = offset; operation = Int::ShiftOp,
+                     // operand_int_type = offset type
+  kPointerOffset,    // a = result, b = pointer, c = offset
+  kNilTestPointer,   // a = result, b = tested
+  kNilTestFunc,      // a = result, b = tested
+  kMalloc,           // a = result, b = size
+  kLoadBool,         // a = result, b = address
+  kLoadInt,          // a = result, b = address; int_type = loaded type (pointers and funcs: i64)
+  kStoreBool,        // a = address, b = value
+  kStoreInt,         // a = address, b = value; int_type = stored type (pointers and funcs: i64)
+  kFree,             // a = address
+  kJump,             // a = destination pc
+  kJumpCond,         // a = condition, b = destination pc if true, c = destination pc if false
+  kCall,             // a = func, b = operand pool offset, c = arg count; pool holds args, then
+                     // result registers
+  kReturn,           // a = operand pool offset, b = result count; pool holds results
+  kUnsupported,      // fails when executed; origin holds the unsupported instruction
+};
+
+std::string ToString(Opcode opcode);
+
+struct BytecodeInstr {
+  Opcode opcode;
+  uint8_t operation = 0;
+  common::atomics::IntType int_type = common::atomics::IntType::kI64;
+  common::atomics::IntType operand_int_type = common::atomics::IntType::kI64;
+  reg_num_t a = 0;
+  reg_num_t b = 0;
+  reg_num_t c = 0;
+};
+
+class BytecodeFunc {
+ public:
+  const ir::Func* func() const { return func_; }
+  ir::func_num_t number() const { return func_->number(); }
+
+  const std::vector<BytecodeInstr>& instrs() const { return instrs_; }
+  const std::vector<reg_num_t>& operand_pool() const { return operand_pool_; }
+
+  // Returns the IR instruction the bytecode instruction at pc was compiled from or nullptr for
+  // instructions synthesized during compilation, such as phi moves.
+  const ir::Instr* origin(pc_t pc) const { return origins_.at(pc); }
+
+  pc_t entry_pc() const { return entry_pc_; }
+  const std::vector<reg_num_t>& arg_registers() const { return arg_registers_; }
+
+  std::size_t register_count() const { return register_count_; }
+  reg_num_t constants_begin() const { return constants_begin_; }
+  const std::vector<int64_t>& constants() const { return constants_; }
+
+  std::string ToString() const;
+
+ private:
+  BytecodeFunc(const ir::Func* func) : func_(func) {}
+
+  const ir::Func* func_;
+  std::vector<BytecodeInstr> instrs_;
+  std::vector<reg_num_t> operand_pool_;
+  std::vector<const ir::Instr*> origins_;
+  pc_t entry_pc_ = 0;
+  std::vector<reg_num_t> arg_registers_;
+
+  std::size_t register_count_ = 0;
+  reg_num_t constants_begin_ = 0;
+  std::vector<int64_t> constants_;
+
+  friend class BytecodeCompiler;
+};
+
+class BytecodeProgram {
+ public:
+  const ir::Program* program() const { return program_; }
+
+  const std::vector<std::unique_ptr<BytecodeFunc>>& funcs() const { return funcs_; }
+  const BytecodeFunc* GetFunc(ir::func_num_t func_num) const {
+    return (0 <= func_num && std::size_t(func_num) < funcs_by_num_.size())
+               ? funcs_by_num_[func_num]
+               : nullptr;
+  }
+  const BytecodeFunc* entry_func() const { return GetFunc(program_->entry_func_num()); }
+
+ private:
+  BytecodeProgram(const ir::Program* program) : program_(program) {}
+
+  const ir::Program* program_;
+  std::vector<std::unique_ptr<BytecodeFunc>> funcs_;
+  std::vector<const BytecodeFunc*> funcs_by_num_;
+
+  friend std::unique_ptr<BytecodeProgram> CompileProgram(const ir::Program* program);
+};
+
+// Lowers all functions in the program to bytecode. Phi instructions get replaced by moves on the
+// incoming control flow edges.
+std::unique_ptr<BytecodeProgram> CompileProgram(const ir::Program* program);
+
+}  // namespace ir_interpreter
+
+#endif /* ir_interpreter_bytecode_h */
@@ -0,0 +1,325 @@
+//
+//  bytecode_interpreter.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "bytecode_interpreter.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "src/common/atomics/atomics.h"
+#include "src/common/logging/logging.h"
+
+namespace ir_interpreter {
+
+using ::common::atomics::Bool;
+using ::common::atomics::CompareAsInt64;
+using ::common::atomics::ComputeAsInt64;
+using ::common::atomics::Int;
+using ::common::atomics::IntFromInt64;
+using ::common::atomics::IntType;
+using ::common::atomics::ShiftAsInt64;
+using ::common::logging::fail;
+
+BytecodeInterpreter::BytecodeInterpreter(ir::Program* program, HeapOptions heap_options)
+    : program_(program), heap_(heap_options) {
+  if (program_->entry_func_num() == ir::kNoFuncNum) {
+    fail("program has no entry function");
+  }
+  ir::Func* entry_func = program_->entry_func();
+  if (!entry_func->args().empty()) {
+    // TODO: support argc, argv
+    fail("entry function has arguments");
+  } else if (entry_func->result_types().size() != 1) {
+    fail("entry function does not have one result");
+  }
+
+  bytecode_program_ = CompileProgram(program_);
+  PushFrame(bytecode_program_->entry_func());
+}
+
+int64_t BytecodeInterpreter::exit_code() const {
+  if (!HasProgramCompleted()) {
+    fail("program has not terminated");
+  }
+  return exit_code_.value();
+}
+
+void BytecodeInterpreter::PushFrame(const BytecodeFunc* func) {
+  std::size_t registers_begin =
+      frames_.empty() ? 0 : frames_.back().registers_begin + frames_.back().func->register_count();
+  registers_.resize(registers_begin + func->register_count());
+  std::copy(func->constants().begin(), func->constants().end(),
+            registers_.begin() + registers_begin + func->constants_begin());
+  frames_.push_back(Frame{
+      .func = func,
+      .pc = func->entry_pc(),
+      .registers_begin = registers_begin,
+  });
+}
+
+int64_t BytecodeInterpreter::LoadInt(IntType int_type, int64_t address) {
+  switch (int_type) {
+    case IntType::kI8:
+      return heap_.Load<int8_t>(address);
+    case IntType::kI16:
+      return heap_.Load<int16_t>(address);
+    case IntType::kI32:
+      return heap_.Load<int32_t>(address);
+    case IntType::kI64:
+      return heap_.Load<int64_t>(address);
+    case IntType::kU8:
+      return heap_.Load<uint8_t>(address);
+    case IntType::kU16:
+      return heap_.Load<uint16_t>(address);
+    case IntType::kU32:
+      return heap_.Load<uint32_t>(address);
+    case IntType::kU64:
+      return int64_t(heap_.Load<uint64_t>(address));
+  }
+}
+
+void BytecodeInterpreter::StoreInt(IntType int_type, int64_t address, int64_t value) {
+  switch (int_type) {
+    case IntType::kI8:
+      heap_.Store(address, int8_t(value));
+      return;
+    case IntType::kI16:
+      heap_.Store(address, int16_t(value));
+      return;
+    case IntType::kI32:
+      heap_.Store(address, int32_t(value));
+      return;
+    case IntType::kI64:
+      heap_.Store(address, int64_t(value));
+      return;
+    case IntType::kU8:
+      heap_.Store(address, uint8_t(value));
+      return;
+    case IntType::kU16:
+      heap_.Store(address, uint16_t(value));
+      return;
+    case IntType::kU32:
+      heap_.Store(address, uint32_t(value));
+      return;
+    case IntType::kU64:
+      heap_.Store(address, uint64_t(value));
+      return;
+  }
+}
+
+// Threaded dispatch relies on the labels-as-values extension supported by GCC and Clang. Other
+// compilers fall back to a switch based dispatch loop.
+#if defined(__GNUC__)
+#define IR_INTERPRETER_THREADED_DISPATCH 1
+#else
+#define IR_INTERPRETER_THREADED_DISPATCH 0
+#endif
+
+#if IR_INTERPRETER_THREADED_DISPATCH
+#define HANDLER(opcode) handle_##opcode
+#define DISPATCH()     \
+  instr = &instrs[pc]; \
+  goto* code[pc++]
+#else
+#define HANDLER(opcode) case Opcode::opcode
+#define DISPATCH() break
+#endif
+
+#if IR_INTERPRETER_THREADED_DISPATCH
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+void BytecodeInterpreter::Run() {
+  if (HasProgramCompleted()) {
+    return;
+  }
+  const BytecodeFunc* func = frames_.back().func;
+  const BytecodeInstr* instrs = func->instrs().data();
+  const BytecodeInstr* instr = nullptr;
+  const reg_num_t* pool = func->operand_pool().data();
+  int64_t* regs = registers_.data() + frames_.back().registers_begin;
+  pc_t pc = frames_.back().pc;
+
+#if IR_INTERPRETER_THREADED_DISPATCH
+  // Indexed by Opcode.
+  static const void* const kHandlers[] = {
+      &&HANDLER(kMov),           &&HANDLER(kBoolToInt),      &&HANDLER(kIntToBool),
+      &&HANDLER(kIntToInt),      &&HANDLER(kIntBinary),      &&HANDLER(kIntCompare),
+      &&HANDLER(kIntShift),      &&HANDLER(kPointerOffset),  &&HANDLER(kNilTestPointer),
+      &&HANDLER(kNilTestFunc),   &&HANDLER(kMalloc),         &&HANDLER(kLoadBool),
+      &&HANDLER(kLoadInt),       &&HANDLER(kStoreBool),      &&HANDLER(kStoreInt),
+      &&HANDLER(kFree),          &&HANDLER(kJump),           &&HANDLER(kJumpCond),
+      &&HANDLER(kCall),          &&HANDLER(kReturn),         &&HANDLER(kUnsupported),
+  };
+  static_assert(std::size(kHandlers) == std::size_t(Opcode::kUnsupported) + 1);
+  if (threaded_code_.empty()) {
+    for (const auto& bytecode_func : bytecode_program_->funcs()) {
+      if (threaded_code_.size() <= std::size_t(bytecode_func->number())) {
+        threaded_code_.resize(bytecode_func->number() + 1);
+      }
+      std::vector<const void*>& func_code = threaded_code_.at(bytecode_func->number());
+      for (const BytecodeInstr& bytecode_instr : bytecode_func->instrs()) {
+        func_code.push_back(kHandlers[std::size_t(bytecode_instr.opcode)]);
+      }
+    }
+  }
+  const void* const* code = threaded_code_.at(func->number()).data();
+
+  DISPATCH();
+#else
+  while (true) {
+    instr = &instrs[pc++];
+    switch (instr->opcode) {
+#endif
+
+  HANDLER(kMov): {
+    regs[instr->a] = regs[instr->b];
+    DISPATCH();
+  }
+  HANDLER(kBoolToInt): {
+    regs[instr->a] = Bool::ConvertTo(instr->int_type, regs[instr->b] != 0).AsInt64();
+    DISPATCH();
+  }
+  HANDLER(kIntToBool): {
+    regs[instr->a] = regs[instr->b] != 0;
+    DISPATCH();
+  }
+  HANDLER(kIntToInt): {
+    Int operand = IntFromInt64(instr->operand_int_type, regs[instr->b]);
+    if (!operand.CanConvertTo(instr->int_type)) {
+      fail("can not handle conversion instr");
+    }
+    regs[instr->a] = operand.ConvertTo(instr->int_type).AsInt64();
+    DISPATCH();
+  }
+  HANDLER(kIntBinary): {
+    regs[instr->a] = ComputeAsInt64(instr->int_type, regs[instr->b],
+                                    Int::BinaryOp(instr->operation), regs[instr->c]);
+    DISPATCH();
+  }
+  HANDLER(kIntCompare): {
+    regs[instr->a] = CompareAsInt64(instr->int_type, regs[instr->b],
+                                    Int::CompareOp(instr->operation), regs[instr->c]);
+    DISPATCH();
+  }
+  HANDLER(kIntShift): {
+    regs[instr->a] = ShiftAsInt64(instr->int_type, regs[instr->b], Int::ShiftOp(instr->operation),
+                                  uint64_t(regs[instr->c]));
+    DISPATCH();
+  }
+  HANDLER(kPointerOffset): {
+    regs[instr->a] = regs[instr->b] + regs[instr->c];
+    DISPATCH();
+  }
+  HANDLER(kNilTestPointer): {
+    regs[instr->a] = regs[instr->b] == 0;
+    DISPATCH();
+  }
+  HANDLER(kNilTestFunc): {
+    regs[instr->a] = regs[instr->b] == ir::kNoFuncNum;
+    DISPATCH();
+  }
+  HANDLER(kMalloc): {
+    regs[instr->a] = heap_.Malloc(regs[instr->b]);
+    DISPATCH();
+  }
+  HANDLER(kLoadBool): {
+    regs[instr->a] = heap_.Load<bool>(regs[instr->b]);
+    DISPATCH();
+  }
+  HANDLER(kLoadInt): {
+    regs[instr->a] = LoadInt(instr->int_type, regs[instr->b]);
+    DISPATCH();
+  }
+  HANDLER(kStoreBool): {
+    heap_.Store(regs[instr->a], regs[instr->b] != 0);
+    DISPATCH();
+  }
+  HANDLER(kStoreInt): {
+    StoreInt(instr->int_type, regs[instr->a], regs[instr->b]);
+    DISPATCH();
+  }
+  HANDLER(kFree): {
+    heap_.Free(regs[instr->a]);
+    DISPATCH();
+  }
+  HANDLER(kJump): {
+    pc = instr->a;
+    DISPATCH();
+  }
+  HANDLER(kJumpCond): {
+    pc = regs[instr->a] ? instr->b : instr->c;
+    DISPATCH();
+  }
+  HANDLER(kCall): {
+    const BytecodeFunc* callee = bytecode_program_->GetFunc(regs[instr->a]);
+    if (callee == nullptr) {
+      fail("attempted to call function that does not exist");
+    }
+    frames_.back().pc = pc;
+    PushFrame(callee);
+    int64_t* caller_regs = registers_.data() + frames_.at(frames_.size() - 2).registers_begin;
+    int64_t* callee_regs = registers_.data() + frames_.back().registers_begin;
+    for (reg_num_t i = 0; i < instr->c; i++) {
+      callee_regs[callee->arg_registers().at(i)] = caller_regs[pool[instr->b + i]];
+    }
+    func = callee;
+    instrs = func->instrs().data();
+    pool = func->operand_pool().data();
+    regs = callee_regs;
+    pc = func->entry_pc();
+#if IR_INTERPRETER_THREADED_DISPATCH
+    code = threaded_code_.at(func->number()).data();
+#endif
+    DISPATCH();
+  }
+  HANDLER(kReturn): {
+    if (frames_.size() == 1) {
+      exit_code_ = regs[pool[instr->a]];
+      frames_.back().pc = pc;
+      return;
+    }
+    Frame& caller = frames_.at(frames_.size() - 2);
+    const BytecodeInstr& call_instr = caller.func->instrs().at(caller.pc - 1);
+    const reg_num_t* result_regs = caller.func->operand_pool().data() + call_instr.b + call_instr.c;
+    int64_t* caller_regs = registers_.data() + caller.registers_begin;
+    for (reg_num_t i = 0; i < instr->b; i++) {
+      caller_regs[result_regs[i]] = regs[pool[instr->a + i]];
+    }
+    registers_.resize(frames_.back().registers_begin);
+    frames_.pop_back();
+    func = caller.func;
+    instrs = func->instrs().data();
+    pool = func->operand_pool().data();
+    regs = caller_regs;
+    pc = caller.pc;
+#if IR_INTERPRETER_THREADED_DISPATCH
+    code = threaded_code_.at(func->number()).data();
+#endif
+    DISPATCH();
+  }
+  HANDLER(kUnsupported): {
+    fail("interpreter does not support instruction: " + func->origin(pc - 1)->RefString());
+  }
+
+#if !IR_INTERPRETER_THREADED_DISPATCH
+    }
+  }
+#endif
+}
+
+#if IR_INTERPRETER_THREADED_DISPATCH
+#pragma GCC diagnostic pop
+#endif
+
+#undef DISPATCH
+#undef HANDLER
+#undef IR_INTERPRETER_THREADED_DISPATCH
+
+}  // namespace ir_interpreter
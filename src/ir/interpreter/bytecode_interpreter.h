@@ -0,0 +1,70 @@
+//
+//  bytecode_interpreter.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_interpreter_bytecode_interpreter_h
+#define ir_interpreter_bytecode_interpreter_h
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "src/ir/interpreter/bytecode.h"
+#include "src/ir/interpreter/heap.h"
+#include "src/ir/representation/program.h"
+
+namespace ir_interpreter {
+
+// Interprets a program after compiling it to bytecode (see bytecode.h). All stack frames share
+// one contiguous register file of raw values, so interpretation does not allocate per
+// instruction. Where the compiler supports it, Run uses direct threaded dispatch: each
+// instruction is pre-resolved to the address of its handler, and every handler jumps straight to
+// the next one. Unlike the Interpreter, the BytecodeInterpreter can not be stepped through with
+// the Debugger.
+class BytecodeInterpreter {
+ public:
+  BytecodeInterpreter(ir::Program* program, bool sanitize)
+      : BytecodeInterpreter(program, HeapOptions{.sanitize = sanitize}) {}
+  BytecodeInterpreter(ir::Program* program, HeapOptions heap_options);
+
+  ir::Program* program() const { return program_; }
+  const BytecodeProgram* bytecode_program() const { return bytecode_program_.get(); }
+
+  int64_t exit_code() const;
+
+  void Run();
+
+ private:
+  struct Frame {
+    const BytecodeFunc* func;
+    pc_t pc;
+    std::size_t registers_begin;
+  };
+
+  bool HasProgramCompleted() const { return exit_code_.has_value(); }
+
+  void PushFrame(const BytecodeFunc* func);
+
+  int64_t LoadInt(common::atomics::IntType int_type, int64_t address);
+  void StoreInt(common::atomics::IntType int_type, int64_t address, int64_t value);
+
+  ir::Program* program_;
+  std::unique_ptr<BytecodeProgram> bytecode_program_;
+  // Handler addresses for each bytecode instruction, indexed by func number and pc. Only used with
+  // threaded dispatch, see Run.
+  std::vector<std::vector<const void*>> threaded_code_;
+
+  std::optional<int64_t> exit_code_;
+  std::vector<Frame> frames_;
+  std::vector<int64_t> registers_;
+  Heap heap_;
+};
+
+}  // namespace ir_interpreter
+
+#endif /* ir_interpreter_bytecode_interpreter_h */
@@ -0,0 +1,152 @@
+//
+//  bytecode_interpreter_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/interpreter/bytecode_interpreter.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/ir/check/check_test_util.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+
+struct BytecodeInterpreterTestParams {
+  std::string program;
+  int64_t expected_exit_code;
+};
+
+class BytecodeInterpreterTest : public testing::TestWithParam<BytecodeInterpreterTestParams> {};
+
+INSTANTIATE_TEST_SUITE_P(BytecodeInterpreterTestInstance, BytecodeInterpreterTest,
+                         testing::Values(
+                             BytecodeInterpreterTestParams{
+                                 .program =
+                                     R"ir(
+@0 main() => (i64) {
+  {0}
+    ret #123:i64
+}
+)ir",
+                                 .expected_exit_code = 123,
+                             },
+                             BytecodeInterpreterTestParams{
+                                 .program =
+                                     R"ir(
+@0 main() => (i64) {
+  {0}
+    jmp {1}
+  {1}
+    %0:i64 = phi %3{2}, #0{0}
+    %1:i64 = phi %4{2}, #0{0}
+    %2:b = ilss %0, #10:i64
+    jcc %2, {2}, {3}
+  {2}
+    %3:i64 = iadd %0, #1:i64
+    %4:i64 = iadd %0, %1
+    jmp {1}
+  {3}
+    ret %1
+}
+)ir",
+                                 .expected_exit_code = 45,
+                             },
+                             BytecodeInterpreterTestParams{
+                                 .program =
+                                     R"ir(
+@0 main() => (i64) {
+  {0}
+    %0:i64 = call @1, #10:i64
+    ret %0
+}
+
+@1 fib(%0:i64) => (i64) {
+  {0}
+    %1:b = ilss %0, #2:i64
+    jcc %1, {1}, {2}
+  {1}
+    ret #1:i64
+  {2}
+    %2:i64 = isub %0, #1:i64
+    %3:i64 = call @1, %2
+    %4:i64 = isub %0, #2:i64
+    %5:i64 = call @1, %4
+    %6:i64 = iadd %3, %5
+    ret %6
+}
+
+)ir",
+                                 .expected_exit_code = 89,
+                             },
+                             BytecodeInterpreterTestParams{
+                                 .program =
+                                     R"ir(
+@0 main() => (i64) {
+  {0}
+    jmp {1}
+  {1}
+    %0:i64 = phi #1{0}, %1{2}
+    %1:i64 = phi #2{0}, %0{2}
+    %2:i64 = phi #0{0}, %3{2}
+    %4:b = ilss %2, #3:i64
+    jcc %4, {2}, {3}
+  {2}
+    %3:i64 = iadd %2, #1:i64
+    jmp {1}
+  {3}
+    %5:i64 = imul %0, #10:i64
+    %6:i64 = iadd %5, %1
+    ret %6
+}
+)ir",
+                                 .expected_exit_code = 21,
+                             },
+                             BytecodeInterpreterTestParams{
+                                 .program =
+                                     R"ir(
+@0 main() => (i64) {
+  {0}
+    %0:ptr = malloc #16:i64
+    %1:ptr = poff %0, #8:i64
+    store %0, #250:u8
+    store %1, #-3:i32
+    %2:u8 = load %0
+    %3:u8 = iadd %2, #10:u8
+    %4:i32 = load %1
+    %5:i32 = ishl %4, #2:u8
+    free %0
+    %6:i64 = conv %3
+    %7:i64 = conv %5
+    %8:i64 = iadd %6, %7
+    ret %8
+}
+)ir",
+                                 .expected_exit_code = -8,
+                             }));
+
+TEST_P(BytecodeInterpreterTest, InterpretsCorrectlyWithoutSanityCheck) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(GetParam().program);
+  program->set_entry_func_num(0);
+
+  ir_check::CheckProgramOrDie(program.get());
+  ir_interpreter::BytecodeInterpreter interpreter(program.get(), /*sanitize=*/false);
+  interpreter.Run();
+
+  EXPECT_EQ(interpreter.exit_code(), GetParam().expected_exit_code);
+}
+
+TEST_P(BytecodeInterpreterTest, InterpretsCorrectlyWithSanityCheck) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(GetParam().program);
+  program->set_entry_func_num(0);
+
+  ir_check::CheckProgramOrDie(program.get());
+  ir_interpreter::BytecodeInterpreter interpreter(program.get(), /*sanitize=*/true);
+  interpreter.Run();
+
+  EXPECT_EQ(interpreter.exit_code(), GetParam().expected_exit_code);
+}
@@ -0,0 +1,134 @@
+//
+//  bytecode_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/interpreter/bytecode.h"
+
+#include <memory>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/ir/check/check_test_util.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+
+namespace ir_interpreter {
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(BytecodeTest, AssignsRegistersToComputedValuesAndConstants) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 main() => (i64) {
+  {0}
+    %0:i64 = iadd #1:i64, #2:i64
+    %1:i64 = iadd %0, #1:i64
+    ret %1
+}
+)ir");
+  program->set_entry_func_num(0);
+  ir_check::CheckProgramOrDie(program.get());
+
+  std::unique_ptr<BytecodeProgram> bytecode_program = CompileProgram(program.get());
+  const BytecodeFunc* func = bytecode_program->GetFunc(0);
+  ASSERT_NE(func, nullptr);
+  EXPECT_EQ(func->constants_begin(), 2);
+  EXPECT_THAT(func->constants(), ElementsAre(1, 2));
+  EXPECT_EQ(func->register_count(), 4);
+
+  ASSERT_EQ(func->instrs().size(), 3);
+  EXPECT_EQ(func->instrs().at(0).opcode, Opcode::kIntBinary);
+  EXPECT_EQ(func->instrs().at(0).a, 0);
+  EXPECT_EQ(func->instrs().at(0).b, 2);
+  EXPECT_EQ(func->instrs().at(0).c, 3);
+  EXPECT_EQ(func->instrs().at(1).opcode, Opcode::kIntBinary);
+  EXPECT_EQ(func->instrs().at(1).a, 1);
+  EXPECT_EQ(func->instrs().at(1).b, 0);
+  EXPECT_EQ(func->instrs().at(1).c, 2);
+  EXPECT_EQ(func->instrs().at(2).opcode, Opcode::kReturn);
+  EXPECT_THAT(func->operand_pool(), ElementsAre(1));
+}
+
+TEST(BytecodeTest, ResolvesPhisWithMovesOnEdges) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 main() => (i64) {
+  {0}
+    jmp {1}
+  {1}
+    %0:i64 = phi #0{0}, %2{1}
+    %1:b = ilss %0, #10:i64
+    %2:i64 = iadd %0, #1:i64
+    jcc %1, {1}, {2}
+  {2}
+    ret %0
+}
+)ir");
+  program->set_entry_func_num(0);
+  ir_check::CheckProgramOrDie(program.get());
+
+  std::unique_ptr<BytecodeProgram> bytecode_program = CompileProgram(program.get());
+  const BytecodeFunc* func = bytecode_program->GetFunc(0);
+  ASSERT_NE(func, nullptr);
+  ASSERT_EQ(func->instrs().size(), 8);
+  // {0}: mov %0, #0; jmp {1}
+  EXPECT_EQ(func->instrs().at(0).opcode, Opcode::kMov);
+  EXPECT_EQ(func->instrs().at(0).a, 0);
+  EXPECT_EQ(func->instrs().at(1).opcode, Opcode::kJump);
+  EXPECT_EQ(func->instrs().at(1).a, 2);
+  // {1}: ilss; iadd; jcc (true destination is an edge stub)
+  EXPECT_EQ(func->instrs().at(4).opcode, Opcode::kJumpCond);
+  EXPECT_EQ(func->instrs().at(4).b, 6);
+  EXPECT_EQ(func->instrs().at(4).c, 5);
+  // {2}: ret %0
+  EXPECT_EQ(func->instrs().at(5).opcode, Opcode::kReturn);
+  // edge stub {1} -> {1}: mov %0, %2; jmp {1}
+  EXPECT_EQ(func->instrs().at(6).opcode, Opcode::kMov);
+  EXPECT_EQ(func->instrs().at(6).a, 0);
+  EXPECT_EQ(func->instrs().at(6).b, 2);
+  EXPECT_EQ(func->origin(6), nullptr);
+  EXPECT_EQ(func->instrs().at(7).opcode, Opcode::kJump);
+  EXPECT_EQ(func->instrs().at(7).a, 2);
+}
+
+TEST(BytecodeTest, ResolvesSwappingPhisWithTemporaries) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 main() => (i64) {
+  {0}
+    jmp {1}
+  {1}
+    %0:i64 = phi #1{0}, %1{1}
+    %1:i64 = phi #2{0}, %0{1}
+    %2:b = ilss %0, %1
+    jcc %2, {1}, {2}
+  {2}
+    ret %0
+}
+)ir");
+  program->set_entry_func_num(0);
+  ir_check::CheckProgramOrDie(program.get());
+
+  std::unique_ptr<BytecodeProgram> bytecode_program = CompileProgram(program.get());
+  const BytecodeFunc* func = bytecode_program->GetFunc(0);
+  ASSERT_NE(func, nullptr);
+  EXPECT_EQ(func->constants_begin(), 5);
+  EXPECT_EQ(func->register_count(), 7);
+
+  // edge stub {1} -> {1}: mov t0, %1; mov t1, %0; mov %0, t0; mov %1, t1; jmp {1}
+  ASSERT_EQ(func->instrs().size(), 11);
+  EXPECT_EQ(func->instrs().at(6).a, 3);
+  EXPECT_EQ(func->instrs().at(6).b, 1);
+  EXPECT_EQ(func->instrs().at(7).a, 4);
+  EXPECT_EQ(func->instrs().at(7).b, 0);
+  EXPECT_EQ(func->instrs().at(8).a, 0);
+  EXPECT_EQ(func->instrs().at(8).b, 3);
+  EXPECT_EQ(func->instrs().at(9).a, 1);
+  EXPECT_EQ(func->instrs().at(9).b, 4);
+  EXPECT_EQ(func->instrs().at(10).opcode, Opcode::kJump);
+}
+
+}  // namespace
+}  // namespace ir_interpreter
@@ -31,6 +31,7 @@ class Debugger final : public Interpreter {
   };
 
   Debugger(ir::Program* program, bool sanitize) : Interpreter(program, sanitize) {}
+  Debugger(ir::Program* program, HeapOptions heap_options) : Interpreter(program, heap_options) {}
   ~Debugger() override { PauseAndAwait(); }
 
   ExecutionState execution_state() const;
@@ -39,12 +39,12 @@ void ExecutionPoint::AdvanceToNextBlock(ir::Block* next_block) {
   next_instr_index_ = 0;
 }
 
-void ExecutionPoint::AdvanceToFuncExit(std::vector<std::shared_ptr<ir::Constant>> results) {
+void ExecutionPoint::AdvanceToFuncExit(std::vector<TaggedValue> results) {
   next_instr_index_ = current_block_->instrs().size();
-  results_ = results;
+  results_ = std::move(results);
 }
 
-const std::vector<std::shared_ptr<ir::Constant>>& ExecutionPoint::results() const {
+const std::vector<TaggedValue>& ExecutionPoint::results() const {
   if (!is_at_func_exit()) {
     fail("results are not defined at current execution point");
   }
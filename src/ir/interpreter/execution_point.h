@@ -9,6 +9,7 @@
 #include <memory>
 #include <vector>
 
+#include "src/ir/interpreter/tagged_value.h"
 #include "src/ir/representation/block.h"
 #include "src/ir/representation/func.h"
 #include "src/ir/representation/instrs.h"
@@ -29,15 +30,15 @@ class ExecutionPoint {
   ir::Block* current_block() const { return current_block_; }
   std::size_t next_instr_index() const { return next_instr_index_; }
   ir::Instr* next_instr() const;
-  const std::vector<std::shared_ptr<ir::Constant>>& results() const;
+  const std::vector<TaggedValue>& results() const;
 
   void AdvanceToNextInstr();
   void AdvanceToNextBlock(ir::Block* next_block);
-  void AdvanceToFuncExit(std::vector<std::shared_ptr<ir::Constant>> results);
+  void AdvanceToFuncExit(std::vector<TaggedValue> results);
 
  private:
   ExecutionPoint(ir::Block* previous_block, ir::Block* current_block, std::size_t next_instr_index,
-                 std::vector<std::shared_ptr<ir::Constant>> results)
+                 std::vector<TaggedValue> results)
       : previous_block_(previous_block),
         current_block_(current_block),
         next_instr_index_(next_instr_index),
@@ -46,7 +47,7 @@ class ExecutionPoint {
   ir::Block* previous_block_;
   ir::Block* current_block_;
   std::size_t next_instr_index_;
-  std::vector<std::shared_ptr<ir::Constant>> results_;
+  std::vector<TaggedValue> results_;
 };
 
 }  // namespace ir_interpreter
@@ -11,6 +11,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "src/ir/check/check_test_util.h"
+#include "src/ir/interpreter/tagged_value.h"
 #include "src/ir/representation/block.h"
 #include "src/ir/representation/func.h"
 #include "src/ir/representation/instrs.h"
@@ -95,8 +96,7 @@ TEST(ExeuctionPointTest, AdvancesCorrectly) {
   EXPECT_EQ(exec_point.current_block(), block_d);
   EXPECT_EQ(exec_point.next_instr(), block_d->instrs().at(0).get());
 
-  exec_point.AdvanceToFuncExit(
-      std::vector<std::shared_ptr<ir::Constant>>{ir::ToIntConstant(Int(int64_t{55}))});
+  exec_point.AdvanceToFuncExit({ir_interpreter::TaggedValue::ForInt(Int(int64_t{55}))});
 
   EXPECT_FALSE(exec_point.is_at_block_entry());
   EXPECT_TRUE(exec_point.is_at_func_exit());
@@ -104,6 +104,5 @@ TEST(ExeuctionPointTest, AdvancesCorrectly) {
   EXPECT_EQ(exec_point.current_block(), block_d);
   EXPECT_EQ(exec_point.next_instr(), nullptr);
   ASSERT_THAT(exec_point.results(), SizeIs(1));
-  EXPECT_TRUE(
-      ir::IsEqual(exec_point.results().at(0).get(), ir::ToIntConstant(Int(int64_t{55})).get()));
+  EXPECT_EQ(exec_point.results().at(0), ir_interpreter::TaggedValue::ForInt(Int(int64_t{55})));
 }
@@ -9,7 +9,9 @@
 #include "heap.h"
 
 #include <algorithm>
+#include <cstring>
 #include <iomanip>
+#include <iterator>
 #include <sstream>
 
 #include "src/common/logging/logging.h"
@@ -18,13 +20,48 @@ namespace ir_interpreter {
 
 using ::common::logging::fail;
 
+namespace {
+
+constexpr uint8_t kPoisonByte = 0xfd;
+
+// Returns the entry with the greatest key that is less than or equal to the given address, or
+// end() if there is none.
+template <typename T>
+typename std::map<int64_t, T>::iterator FindAtOrBefore(std::map<int64_t, T>& ranges,
+                                                       int64_t address) {
+  auto it = ranges.upper_bound(address);
+  if (it == ranges.begin()) {
+    return ranges.end();
+  }
+  return std::prev(it);
+}
+
+template <typename T>
+typename std::map<int64_t, T>::const_iterator FindAtOrBefore(const std::map<int64_t, T>& ranges,
+                                                             int64_t address) {
+  auto it = ranges.upper_bound(address);
+  if (it == ranges.begin()) {
+    return ranges.end();
+  }
+  return std::prev(it);
+}
+
+}  // namespace
+
+Heap::Heap(HeapOptions options)
+    : sanitize_(options.sanitize), quarantine_size_(options.quarantine_size) {
+  if (options.backend == HeapBackend::kSlab) {
+    slab_allocator_ = std::make_unique<SlabAllocator>();
+  }
+}
+
 Heap::~Heap() {
   if (sanitize_) {
     if (!allocated_.empty()) {
       fail("not all memory was freed");
     }
-    for (MemoryRange range : freed_) {
-      free((void*)(range.address));
+    for (auto& [address, range] : freed_) {
+      Release(address);
     }
   }
 }
@@ -35,9 +72,10 @@ int64_t Heap::Malloc(int64_t size) {
       fail("attempted malloc with non-positive size");
     }
   }
-  int64_t address = int64_t(malloc(size));
+  int64_t address = Allocate(size);
   if (sanitize_) {
-    allocated_.push_back(std::make_unique<Memory>(MemoryRange{.address = address, .size = size}));
+    allocated_.emplace(address,
+                       std::make_unique<Memory>(MemoryRange{.address = address, .size = size}));
   }
   return address;
 }
@@ -47,15 +85,43 @@ void Heap::Free(int64_t address) {
     CheckCanBeFreed(address);
   }
   if (!sanitize_) {
-    free((void*)(address));
+    Release(address);
   }
   if (sanitize_) {
-    auto it = std::find_if(
-        allocated_.begin(), allocated_.end(),
-        [address](std::unique_ptr<Memory>& memory) { return memory->range.address == address; });
-    MemoryRange range = (*it)->range;
+    auto it = allocated_.find(address);
+    MemoryRange range = it->second->range();
     allocated_.erase(it);
-    freed_.push_back(range);
+    Quarantine(range);
+  }
+}
+
+int64_t Heap::Allocate(int64_t size) {
+  if (slab_allocator_ != nullptr) {
+    return slab_allocator_->Allocate(size);
+  }
+  return int64_t(malloc(size));
+}
+
+void Heap::Release(int64_t address) {
+  if (slab_allocator_ != nullptr) {
+    slab_allocator_->Free(address);
+  } else {
+    free((void*)(address));
+  }
+}
+
+void Heap::Quarantine(MemoryRange range) {
+  // Poison the memory, such that stale reads through pointers bypassing the heap are noticeable.
+  memset((void*)(range.address), kPoisonByte, range.size);
+  freed_.emplace(range.address, range);
+  quarantine_.push_back(range);
+  quarantined_bytes_ += range.size;
+  while (quarantined_bytes_ > quarantine_size_) {
+    MemoryRange released = quarantine_.front();
+    quarantine_.pop_front();
+    quarantined_bytes_ -= released.size;
+    freed_.erase(released.address);
+    Release(released.address);
   }
 }
 
@@ -86,73 +152,115 @@ Heap::Memory* Heap::CheckExists(MemoryRange range) {
   if (0 <= range.address && range.address < 100) {
     fail("attempted to access memory at or near 0x0");
   }
-  for (auto& memory : allocated_) {
-    if (IsContained(/*contained=*/range, /*container=*/memory->range)) {
-      return memory.get();
-    } else if (Overlap(range, memory->range)) {
+  int64_t range_end = range.address + range.size;
+  if (auto it = FindAtOrBefore(allocated_, range.address); it != allocated_.end()) {
+    Memory* memory = it->second.get();
+    if (IsContained(/*contained=*/range, /*container=*/memory->range())) {
+      return memory;
+    } else if (Overlap(range, memory->range())) {
       fail("attempted to access memory range that only partially overlaps allocated memory");
     }
   }
-  for (MemoryRange& freed_range : freed_) {
-    if (Overlap(range, freed_range)) {
-      fail("attempted to access memory range that was freed");
-    }
+  if (auto it = allocated_.upper_bound(range.address);
+      it != allocated_.end() && it->first < range_end) {
+    fail("attempted to access memory range that only partially overlaps allocated memory");
+  }
+  if (auto it = FindAtOrBefore(freed_, range.address);
+      it != freed_.end() && Overlap(range, it->second)) {
+    fail("attempted to access memory range that was freed");
+  }
+  if (auto it = freed_.upper_bound(range.address); it != freed_.end() && it->first < range_end) {
+    fail("attempted to access memory range that was freed");
   }
   fail("attempted to access memory range that doesn't exist");
 }
 
 void Heap::CheckWasInitialized(Memory* memory, MemoryRange range) {
-  int64_t range_index_begin = range.address - memory->range.address;
+  int64_t range_index_begin = range.address - memory->range().address;
   int64_t range_index_end = range_index_begin + range.size;
-  for (int64_t i = range_index_begin; i < range_index_end; i++) {
-    if (memory->initialization.at(i) == false) {
-      fail("attempted to read uninitialized memory");
-    }
+  if (!memory->IsInitialized(range_index_begin, range_index_end)) {
+    fail("attempted to read uninitialized memory");
   }
 }
 
 void Heap::CheckCanBeFreed(int64_t address) {
-  for (auto& memory : allocated_) {
-    if (memory->range.address == address) {
+  if (auto it = FindAtOrBefore(allocated_, address); it != allocated_.end()) {
+    if (it->first == address) {
       return;
-    } else if (IsContained(address, memory->range)) {
+    } else if (IsContained(address, it->second->range())) {
       fail("address to be freed does not point to start of allocated block");
     }
   }
-  for (MemoryRange& range : freed_) {
-    if (range.address == address) {
-      fail("memory was already freed");
-    }
+  if (freed_.contains(address)) {
+    fail("memory was already freed");
   }
   fail("memory was never allocated");
 }
 
 void Heap::MarkAsInitialized(Memory* memory, MemoryRange range) {
-  int64_t range_index_begin = range.address - memory->range.address;
+  int64_t range_index_begin = range.address - memory->range().address;
   int64_t range_index_end = range_index_begin + range.size;
-  for (int64_t i = range_index_begin; i < range_index_end; i++) {
-    memory->initialization.at(i) = true;
+  memory->MarkAsInitialized(range_index_begin, range_index_end);
+}
+
+uint64_t Heap::Memory::MaskForBits(int64_t bit_begin, int64_t bit_end) {
+  int64_t width = bit_end - bit_begin;
+  uint64_t mask = (width == kBitsPerWord) ? ~uint64_t{0} : ((uint64_t{1} << width) - 1);
+  return mask << bit_begin;
+}
+
+bool Heap::Memory::IsInitialized(int64_t index) const {
+  return (initialization_.at(index / kBitsPerWord) >> (index % kBitsPerWord)) & 1;
+}
+
+bool Heap::Memory::IsInitialized(int64_t index_begin, int64_t index_end) const {
+  for (int64_t word_begin = index_begin; word_begin < index_end;) {
+    int64_t word_index = word_begin / kBitsPerWord;
+    int64_t word_end = std::min(index_end, (word_index + 1) * kBitsPerWord);
+    uint64_t mask = MaskForBits(word_begin % kBitsPerWord, word_end - word_index * kBitsPerWord);
+    if ((initialization_.at(word_index) & mask) != mask) {
+      return false;
+    }
+    word_begin = word_end;
+  }
+  return true;
+}
+
+void Heap::Memory::MarkAsInitialized(int64_t index_begin, int64_t index_end) {
+  for (int64_t word_begin = index_begin; word_begin < index_end;) {
+    int64_t word_index = word_begin / kBitsPerWord;
+    int64_t word_end = std::min(index_end, (word_index + 1) * kBitsPerWord);
+    initialization_.at(word_index) |=
+        MaskForBits(word_begin % kBitsPerWord, word_end - word_index * kBitsPerWord);
+    word_begin = word_end;
   }
 }
 
 std::string Heap::ToDebuggerString() const {
-  if (!sanitize_) {
-    fail("requested debugger string of heap without santization turned on");
+  if (!sanitize_ && slab_allocator_ == nullptr) {
+    fail("requested debugger string of heap without santization or slab backend turned on");
   }
   std::stringstream ss;
+  if (slab_allocator_ != nullptr) {
+    ss << slab_allocator_->ToDebuggerString();
+  }
+  if (!sanitize_) {
+    return ss.str();
+  }
   if (allocated_.empty()) {
     ss << "No allocated heap memory\n";
   } else {
     ss << "Allocated heap memory:\n";
-    for (const auto& allocated : allocated_) {
+    for (const auto& [address, allocated] : allocated_) {
       ss << ToDebuggerString(allocated.get());
     }
   }
   if (freed_.empty()) {
     ss << "No freed heap memory\n";
   } else {
-    ss << "Freed heap memory:\n";
-    for (const auto& freed : freed_) {
+    ss << "Freed heap memory (" << std::dec << quarantined_bytes_ << " of " << quarantine_size_
+       << " quarantine bytes used):\n";
+    for (const auto& [address, freed] : freed_) {
       int64_t memory_size = freed.size;
       int64_t memory_begin_address = freed.address;
       int64_t memory_end_address = memory_begin_address + memory_size;
@@ -168,16 +276,13 @@ std::string Heap::ToDebuggerString(int64_t address) const {
   if (!sanitize_) {
     fail("requested debugger string of heap without santization turned on");
   }
-  for (const auto& allocated : allocated_) {
-    if (!IsContained(address, allocated->range)) {
-      continue;
-    }
-    return ToDebuggerString(allocated.get());
+  if (auto it = FindAtOrBefore(allocated_, address);
+      it != allocated_.end() && IsContained(address, it->second->range())) {
+    return ToDebuggerString(it->second.get());
   }
-  for (const auto& freed : freed_) {
-    if (!IsContained(address, freed)) {
-      continue;
-    }
+  if (auto it = FindAtOrBefore(freed_, address);
+      it != freed_.end() && IsContained(address, it->second)) {
+    const MemoryRange& freed = it->second;
     int64_t memory_size = freed.size;
     int64_t memory_begin_address = freed.address;
     int64_t memory_end_address = memory_begin_address + memory_size;
@@ -193,9 +298,9 @@ std::string Heap::ToDebuggerString(int64_t address) const {
   return ss.str();
 }
 
-std::string Heap::ToDebuggerString(Memory* memory) const {
-  int64_t memory_size = memory->range.size;
-  int64_t memory_begin_address = memory->range.address;
+std::string Heap::ToDebuggerString(const Memory* memory) const {
+  int64_t memory_size = memory->range().size;
+  int64_t memory_begin_address = memory->range().address;
   int64_t memory_end_address = memory_begin_address + memory_size;
   std::stringstream ss;
   if (memory_size > 1) {
@@ -212,7 +317,7 @@ std::string Heap::ToDebuggerString(Memory* memory) const {
 
     for (int64_t byte_addr = line_begin_address; byte_addr < line_end_address; byte_addr++) {
       int64_t byte_index = byte_addr - memory_begin_address;
-      if (!memory->initialization.at(byte_index)) {
+      if (!memory->IsInitialized(byte_index)) {
         ss << "??";
       } else {
         uint8_t byte = *(uint8_t*)(byte_addr);
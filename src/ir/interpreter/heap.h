@@ -10,17 +10,50 @@
 #define ir_interpreter_heap_h
 
 #include <cstdint>
+#include <deque>
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "src/ir/interpreter/slab_allocator.h"
+
 namespace ir_interpreter {
 
+enum class HeapBackend {
+  // Forwards every allocation to malloc and free.
+  kSystem,
+  // Serves small allocations from a SlabAllocator.
+  kSlab,
+};
+
+struct HeapOptions {
+  // Matches the default quarantine size of AddressSanitizer.
+  static constexpr int64_t kDefaultQuarantineSize = int64_t{256} << 20;
+
+  // If true, detects invalid memory accesses, double frees, and memory leaks.
+  bool sanitize = false;
+  // Maximum number of freed bytes kept in quarantine when sanitizing. Freed memory stays
+  // quarantined (and accesses to it get reported as use after free) until more recently freed
+  // memory pushes it out, at which point it gets released to the system.
+  int64_t quarantine_size = kDefaultQuarantineSize;
+  HeapBackend backend = HeapBackend::kSystem;
+};
+
 class Heap {
  public:
-  Heap(bool sanitize) : sanitize_(sanitize) {}
+  Heap(bool sanitize) : Heap(HeapOptions{.sanitize = sanitize}) {}
+  Heap(HeapOptions options);
   ~Heap();
 
   bool sanitizes() const { return sanitize_; }
+  HeapBackend backend() const {
+    return slab_allocator_ != nullptr ? HeapBackend::kSlab : HeapBackend::kSystem;
+  }
+  // Returns the slab allocator backing the heap, or nullptr if the system backend is used.
+  const SlabAllocator* slab_allocator() const { return slab_allocator_.get(); }
+  int64_t quarantine_size() const { return quarantine_size_; }
+  int64_t quarantined_bytes() const { return quarantined_bytes_; }
 
   int64_t Malloc(int64_t size);
   void Free(int64_t address);
@@ -54,6 +87,8 @@ class Heap {
     }
   }
 
+  // Returns the statistics of the slab allocator, if used, and the allocated and freed memory, if
+  // sanitization is turned on. Requires at least one of them.
   std::string ToDebuggerString() const;
   std::string ToDebuggerString(int64_t address) const;
 
@@ -62,11 +97,26 @@ class Heap {
     int64_t address;
     int64_t size;
   };
-  struct Memory {
-    Memory(MemoryRange r) : range(r), initialization(r.size, false) {}
 
-    MemoryRange range;
-    std::vector<bool> initialization;
+  // Allocated memory with a shadow bitmap that tracks which bytes were initialized.
+  class Memory {
+   public:
+    Memory(MemoryRange range)
+        : range_(range), initialization_((range.size + kBitsPerWord - 1) / kBitsPerWord, 0) {}
+
+    MemoryRange range() const { return range_; }
+
+    bool IsInitialized(int64_t index) const;
+    bool IsInitialized(int64_t index_begin, int64_t index_end) const;
+    void MarkAsInitialized(int64_t index_begin, int64_t index_end);
+
+   private:
+    static constexpr int64_t kBitsPerWord = 64;
+
+    static uint64_t MaskForBits(int64_t bit_begin, int64_t bit_end);
+
+    MemoryRange range_;
+    std::vector<uint64_t> initialization_;
   };
 
   static bool IsContained(int64_t address, MemoryRange container);
@@ -79,11 +129,25 @@ class Heap {
 
   void MarkAsInitialized(Memory* memory, MemoryRange range);
 
-  std::string ToDebuggerString(Memory* memory) const;
+  // Obtain and return memory from the selected backend.
+  int64_t Allocate(int64_t size);
+  void Release(int64_t address);
+
+  void Quarantine(MemoryRange range);
+
+  std::string ToDebuggerString(const Memory* memory) const;
 
   bool sanitize_;
-  std::vector<std::unique_ptr<Memory>> allocated_;
-  std::vector<MemoryRange> freed_;
+  std::unique_ptr<SlabAllocator> slab_allocator_;
+  // Both maps are ordered by start address. Ranges within each map never overlap, which allows
+  // finding the range containing an address in O(log n).
+  std::map<int64_t, std::unique_ptr<Memory>> allocated_;
+  std::map<int64_t, MemoryRange> freed_;
+
+  int64_t quarantine_size_;
+  int64_t quarantined_bytes_ = 0;
+  // Freed ranges in the order they were freed. Contains the same ranges as freed_.
+  std::deque<MemoryRange> quarantine_;
 };
 
 }  // namespace ir_interpreter
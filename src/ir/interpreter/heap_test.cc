@@ -8,6 +8,9 @@
 
 #include "src/ir/interpreter/heap.h"
 
+#include <string>
+#include <vector>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -169,6 +172,28 @@ TEST(HeapDeathTest, CatchesStoreToPartiallyAllocatedMemory) {
       "attempted to access memory range that only partially overlaps allocated memory");
 }
 
+TEST(HeapDeathTest, CatchesLoadFromUninitializedMemoryAcrossBitmapWords) {
+  EXPECT_DEATH(
+      [] {
+        auto heap = ir_interpreter::Heap(/*sanitize=*/true);
+        int64_t addr = heap.Malloc(128);
+        heap.Store<int32_t>(addr + 60, int32_t{42});
+        heap.Store<int16_t>(addr + 64, int16_t{42});
+        heap.Load<int64_t>(addr + 60);
+      }(),
+      "attempted to read uninitialized memory");
+}
+
+TEST(HeapDeathTest, CatchesAccessToMemoryRangeEndingInsideAllocatedMemory) {
+  EXPECT_DEATH(
+      [] {
+        auto heap = ir_interpreter::Heap(/*sanitize=*/true);
+        int64_t addr = heap.Malloc(16);
+        heap.Store<int64_t>(addr - 4, int64_t{42});
+      }(),
+      "attempted to access memory range that only partially overlaps allocated memory");
+}
+
 TEST(HeapTest, SupportsNormalOperation) {
   auto heap = ir_interpreter::Heap(/*sanitize=*/true);
   int64_t addr_a = heap.Malloc(100);
@@ -215,3 +240,124 @@ TEST(HeapTest, SupportsNormalOperation) {
   heap.Free(addr_a);
   heap.Free(addr_c);
 }
+
+TEST(HeapTest, TracksInitializationAcrossBitmapWords) {
+  auto heap = ir_interpreter::Heap(/*sanitize=*/true);
+  int64_t addr = heap.Malloc(200);
+  for (int64_t offset = 0; offset < 200; offset += 8) {
+    heap.Store<int64_t>(addr + offset, offset);
+  }
+  for (int64_t offset = 0; offset < 200; offset += 8) {
+    EXPECT_EQ(heap.Load<int64_t>(addr + offset), offset);
+  }
+  heap.Store<int32_t>(addr + 62, int32_t{-1});
+  EXPECT_EQ(heap.Load<int32_t>(addr + 62), -1);
+  heap.Free(addr);
+}
+
+TEST(HeapTest, HandlesManyAllocations) {
+  auto heap = ir_interpreter::Heap(/*sanitize=*/true);
+  std::vector<int64_t> addresses;
+  for (int64_t i = 0; i < 100000; i++) {
+    int64_t addr = heap.Malloc(24);
+    heap.Store<int64_t>(addr + 8, i);
+    addresses.push_back(addr);
+  }
+  for (int64_t i = 0; i < 100000; i++) {
+    EXPECT_EQ(heap.Load<int64_t>(addresses.at(i) + 8), i);
+  }
+  for (int64_t addr : addresses) {
+    heap.Free(addr);
+  }
+}
+
+TEST(HeapTest, ReleasesMemoryBeyondQuarantineSize) {
+  auto heap = ir_interpreter::Heap(ir_interpreter::HeapOptions{
+      .sanitize = true,
+      .quarantine_size = 48,
+  });
+  EXPECT_EQ(heap.quarantine_size(), 48);
+
+  int64_t addr_a = heap.Malloc(32);
+  int64_t addr_b = heap.Malloc(16);
+  int64_t addr_c = heap.Malloc(8);
+  heap.Free(addr_a);
+  heap.Free(addr_b);
+  EXPECT_EQ(heap.quarantined_bytes(), 48);
+
+  heap.Free(addr_c);
+  EXPECT_EQ(heap.quarantined_bytes(), 24);
+}
+
+TEST(HeapDeathTest, CatchesLoadFromQuarantinedMemory) {
+  EXPECT_DEATH(
+      [] {
+        auto heap = ir_interpreter::Heap(ir_interpreter::HeapOptions{
+            .sanitize = true,
+            .quarantine_size = 16,
+        });
+        int64_t addr_a = heap.Malloc(8);
+        int64_t addr_b = heap.Malloc(8);
+        heap.Store<int64_t>(addr_a, int64_t{42});
+        heap.Free(addr_a);
+        heap.Free(addr_b);
+        heap.Load<int64_t>(addr_a);
+      }(),
+      "attempted to access memory range that was freed");
+}
+
+TEST(HeapTest, SupportsSlabBackend) {
+  auto heap = ir_interpreter::Heap(ir_interpreter::HeapOptions{
+      .sanitize = true,
+      .backend = ir_interpreter::HeapBackend::kSlab,
+  });
+  EXPECT_EQ(heap.backend(), ir_interpreter::HeapBackend::kSlab);
+  ASSERT_NE(heap.slab_allocator(), nullptr);
+
+  int64_t addr_a = heap.Malloc(24);
+  int64_t addr_b = heap.Malloc(1000);
+  heap.Store<int64_t>(addr_a + 16, int64_t{7});
+  heap.Store<int64_t>(addr_b + 992, int64_t{8});
+  EXPECT_EQ(heap.Load<int64_t>(addr_a + 16), 7);
+  EXPECT_EQ(heap.Load<int64_t>(addr_b + 992), 8);
+  EXPECT_EQ(heap.slab_allocator()->stats().allocation_count, 2);
+  EXPECT_EQ(heap.slab_allocator()->stats().bytes, 1024);
+  EXPECT_THAT(heap.ToDebuggerString(),
+              testing::HasSubstr("total: 2 allocs, 0 frees, 1024 bytes, 1024 peak bytes"));
+
+  heap.Free(addr_a);
+  heap.Free(addr_b);
+}
+
+TEST(HeapTest, PrintsSlabStatsWithoutSanitization) {
+  auto heap = ir_interpreter::Heap(ir_interpreter::HeapOptions{
+      .sanitize = false,
+      .backend = ir_interpreter::HeapBackend::kSlab,
+  });
+  int64_t addr_a = heap.Malloc(24);
+  int64_t addr_b = heap.Malloc(24);
+  heap.Free(addr_a);
+
+  std::string debugger_string = heap.ToDebuggerString();
+  EXPECT_THAT(debugger_string,
+              testing::HasSubstr("total: 2 allocs, 1 frees, 24 bytes, 48 peak bytes"));
+  EXPECT_THAT(debugger_string, testing::HasSubstr("  24 bytes: 2 allocs, 1 frees"));
+  EXPECT_THAT(debugger_string, testing::Not(testing::HasSubstr("heap memory")));
+
+  heap.Free(addr_b);
+}
+
+TEST(HeapTest, SlabBackendReleasesQuarantinedMemory) {
+  auto heap = ir_interpreter::Heap(ir_interpreter::HeapOptions{
+      .sanitize = true,
+      .quarantine_size = 0,
+      .backend = ir_interpreter::HeapBackend::kSlab,
+  });
+  int64_t addr_a = heap.Malloc(24);
+  heap.Free(addr_a);
+  EXPECT_EQ(heap.slab_allocator()->stats().bytes, 0);
+
+  int64_t addr_b = heap.Malloc(24);
+  EXPECT_EQ(addr_b, addr_a);
+  heap.Free(addr_b);
+}
@@ -17,7 +17,8 @@ using ::common::atomics::Int;
 using ::common::atomics::IntType;
 using ::common::logging::fail;
 
-Interpreter::Interpreter(ir::Program* program, bool sanitize) : heap_(sanitize), program_(program) {
+Interpreter::Interpreter(ir::Program* program, HeapOptions heap_options)
+    : heap_(heap_options), program_(program) {
   if (program_->entry_func_num() == ir::kNoFuncNum) {
     fail("program has no entry function");
   }
@@ -39,6 +40,20 @@ int64_t Interpreter::exit_code() const {
   return exit_code_.value();
 }
 
+void Interpreter::EnableProfiling() {
+  if (profile_ != nullptr) {
+    fail("profiling is already enabled");
+  }
+  ExecutionPoint& exec_point = stack_.current_frame()->exec_point();
+  if (stack_.depth() != 1 || exec_point.previous_block() != nullptr ||
+      exec_point.next_instr_index() != 0) {
+    fail("attempted to enable profiling after program started running");
+  }
+  profile_ = std::make_unique<Profile>(program_);
+  profile_->RecordFuncEntry(stack_.current_frame()->func());
+  profile_->RecordBlockEntry(exec_point.current_block());
+}
+
 void Interpreter::Run() {
   while (!HasProgramCompleted()) {
     ExecuteStep();
@@ -54,27 +69,30 @@ void Interpreter::ExecuteStep() {
 }
 
 void Interpreter::ExecuteFuncExit() {
-  std::vector<std::shared_ptr<ir::Constant>> results =
-      stack_.current_frame()->exec_point().results();
+  std::vector<TaggedValue> results = stack_.current_frame()->exec_point().results();
   stack_.PopCurrentFrame();
+  if (profile_ != nullptr) {
+    profile_->RecordFuncExit();
+  }
 
   if (stack_.depth() == 0) {
-    ir::IntConstant* result = static_cast<ir::IntConstant*>(results.front().get());
-    exit_code_ = result->value().AsInt64();
+    exit_code_ = results.front().AsInt().AsInt64();
 
   } else {
     auto call_instr =
         static_cast<ir::CallInstr*>(stack_.current_frame()->exec_point().next_instr());
     for (std::size_t i = 0; i < results.size(); i++) {
       ir::value_num_t result_num = call_instr->results().at(i)->number();
-      std::shared_ptr<ir::Constant>& result_value = results.at(i);
-      stack_.current_frame()->computed_values().insert_or_assign(result_num, result_value);
+      stack_.current_frame()->SetComputedValue(result_num, results.at(i));
     }
     stack_.current_frame()->exec_point().AdvanceToNextInstr();
   }
 }
 
 void Interpreter::ExecuteInstr(ir::Instr* instr) {
+  if (profile_ != nullptr) {
+    profile_->RecordInstr(instr);
+  }
   switch (instr->instr_kind()) {
     case ir::InstrKind::kMov:
       ExecuteMovInstr(static_cast<ir::MovInstr*>(instr));
@@ -131,8 +149,8 @@ void Interpreter::ExecuteInstr(ir::Instr* instr) {
 }
 
 void Interpreter::ExecuteMovInstr(ir::MovInstr* instr) {
-  std::shared_ptr<ir::Constant> value = Evaluate(instr->origin());
-  stack_.current_frame()->computed_values().insert_or_assign(instr->result()->number(), value);
+  TaggedValue value = Evaluate(instr->origin());
+  stack_.current_frame()->SetComputedValue(instr->result()->number(), value);
 }
 
 void Interpreter::ExecutePhiInstr(ir::PhiInstr* instr) {
@@ -140,8 +158,8 @@ void Interpreter::ExecutePhiInstr(ir::PhiInstr* instr) {
       stack_.current_frame()->exec_point().previous_block()->number();
   for (const auto& arg : instr->args()) {
     if (arg->origin() == previous_block_num) {
-      std::shared_ptr<ir::Constant> value = Evaluate(arg->value());
-      stack_.current_frame()->computed_values().insert_or_assign(instr->result()->number(), value);
+      TaggedValue value = Evaluate(arg->value());
+      stack_.current_frame()->SetComputedValue(instr->result()->number(), value);
       return;
     }
   }
@@ -157,8 +175,7 @@ void Interpreter::ExecuteConversion(ir::Conversion* instr) {
   if (result_type_kind == ir::TypeKind::kBool && operand_type_kind == ir::TypeKind::kInt) {
     Int operand = EvaluateInt(instr->operand());
     bool result = operand.ConvertToBool();
-    stack_.current_frame()->computed_values().insert_or_assign(result_num,
-                                                               ir::ToBoolConstant(result));
+    stack_.current_frame()->SetComputedValue(result_num, TaggedValue::ForBool(result));
     return;
 
   } else if (result_type_kind == ir::TypeKind::kInt) {
@@ -167,8 +184,7 @@ void Interpreter::ExecuteConversion(ir::Conversion* instr) {
     if (operand_type_kind == ir::TypeKind::kBool) {
       bool operand = EvaluateBool(instr->operand());
       Int result = Bool::ConvertTo(result_int_type, operand);
-      stack_.current_frame()->computed_values().insert_or_assign(result_num,
-                                                                 ir::ToIntConstant(result));
+      stack_.current_frame()->SetComputedValue(result_num, TaggedValue::ForInt(result));
       return;
 
     } else if (operand_type_kind == ir::TypeKind::kInt) {
@@ -177,8 +193,7 @@ void Interpreter::ExecuteConversion(ir::Conversion* instr) {
         fail("can not handle conversion instr");
       }
       Int result = operand.ConvertTo(result_int_type);
-      stack_.current_frame()->computed_values().insert_or_assign(result_num,
-                                                                 ir::ToIntConstant(result));
+      stack_.current_frame()->SetComputedValue(result_num, TaggedValue::ForInt(result));
       return;
     }
   }
@@ -193,8 +208,7 @@ void Interpreter::ExecuteIntBinaryInstr(ir::IntBinaryInstr* instr) {
     fail("can not compute binary instr");
   }
   Int result = Int::Compute(a, instr->operation(), b);
-  stack_.current_frame()->computed_values().insert_or_assign(instr->result()->number(),
-                                                             ir::ToIntConstant(result));
+  stack_.current_frame()->SetComputedValue(instr->result()->number(), TaggedValue::ForInt(result));
 }
 
 void Interpreter::ExecuteIntCompareInstr(ir::IntCompareInstr* instr) {
@@ -204,24 +218,22 @@ void Interpreter::ExecuteIntCompareInstr(ir::IntCompareInstr* instr) {
     fail("can not compute compare instr");
   }
   bool result = Int::Compare(a, instr->operation(), b);
-  stack_.current_frame()->computed_values().insert_or_assign(instr->result()->number(),
-                                                             ir::ToBoolConstant(result));
+  stack_.current_frame()->SetComputedValue(instr->result()->number(), TaggedValue::ForBool(result));
 }
 
 void Interpreter::ExecuteIntShiftInstr(ir::IntShiftInstr* instr) {
   Int shifted = EvaluateInt(instr->shifted());
   Int offset = EvaluateInt(instr->offset());
   Int result = Int::Shift(shifted, instr->operation(), offset);
-  stack_.current_frame()->computed_values().insert_or_assign(instr->result()->number(),
-                                                             ir::ToIntConstant(result));
+  stack_.current_frame()->SetComputedValue(instr->result()->number(), TaggedValue::ForInt(result));
 }
 
 void Interpreter::ExecutePointerOffsetInstr(ir::PointerOffsetInstr* instr) {
   int64_t pointer = EvaluatePointer(instr->pointer());
   int64_t offset = EvaluateInt(instr->offset()).AsInt64();
   int64_t result = pointer + offset;
-  stack_.current_frame()->computed_values().insert_or_assign(instr->result()->number(),
-                                                             ir::ToPointerConstant(result));
+  stack_.current_frame()->SetComputedValue(instr->result()->number(),
+                                           TaggedValue::ForPointer(result));
 }
 
 void Interpreter::ExecuteNilTestInstr(ir::NilTestInstr* instr) {
@@ -235,25 +247,23 @@ void Interpreter::ExecuteNilTestInstr(ir::NilTestInstr* instr) {
         fail("unexpected type for niltest");
     }
   }();
-  stack_.current_frame()->computed_values().insert_or_assign(instr->result()->number(),
-                                                             ir::ToBoolConstant(result));
+  stack_.current_frame()->SetComputedValue(instr->result()->number(), TaggedValue::ForBool(result));
 }
 
 void Interpreter::ExecuteMallocInstr(ir::MallocInstr* instr) {
   int64_t size = EvaluateInt(instr->size()).AsInt64();
   int64_t address = heap_.Malloc(size);
-  stack_.current_frame()->computed_values().insert_or_assign(instr->result()->number(),
-                                                             ir::ToPointerConstant(address));
+  stack_.current_frame()->SetComputedValue(instr->result()->number(),
+                                           TaggedValue::ForPointer(address));
 }
 
 void Interpreter::ExecuteLoadInstr(ir::LoadInstr* instr) {
   int64_t address = EvaluatePointer(instr->address());
   const ir::Type* result_type = instr->result()->type();
-  std::shared_ptr<ir::Constant> result_value = [this, address,
-                                                result_type]() -> std::shared_ptr<ir::Constant> {
+  TaggedValue result_value = [this, address, result_type]() -> TaggedValue {
     switch (result_type->type_kind()) {
       case ir::TypeKind::kBool:
-        return ir::ToBoolConstant(heap_.Load<bool>(address));
+        return TaggedValue::ForBool(heap_.Load<bool>(address));
       case ir::TypeKind::kInt: {
         Int result = [this, address](IntType int_type) {
           switch (int_type) {
@@ -275,18 +285,17 @@ void Interpreter::ExecuteLoadInstr(ir::LoadInstr* instr) {
               return Int(heap_.Load<uint64_t>(address));
           }
         }(static_cast<const ir::IntType*>(result_type)->int_type());
-        return ir::ToIntConstant(result);
+        return TaggedValue::ForInt(result);
       }
       case ir::TypeKind::kPointer:
-        return ir::ToPointerConstant(heap_.Load<int64_t>(address));
+        return TaggedValue::ForPointer(heap_.Load<int64_t>(address));
       case ir::TypeKind::kFunc:
-        return ir::ToFuncConstant(heap_.Load<ir::func_num_t>(address));
+        return TaggedValue::ForFunc(heap_.Load<ir::func_num_t>(address));
       default:
         fail("can not handle type");
     }
   }();
-  stack_.current_frame()->computed_values().insert_or_assign(instr->result()->number(),
-                                                             result_value);
+  stack_.current_frame()->SetComputedValue(instr->result()->number(), result_value);
 }
 
 void Interpreter::ExecuteStoreInstr(ir::StoreInstr* instr) {
@@ -351,54 +360,76 @@ void Interpreter::ExecuteFreeInstr(ir::FreeInstr* instr) {
 
 void Interpreter::ExecuteJumpInstr(ir::JumpInstr* instr) {
   ir::func_num_t next_block_num = instr->destination();
-  ir::Block* next_block = stack_.current_frame()->func()->GetBlock(next_block_num);
+  ir::Func* func = stack_.current_frame()->func();
+  ir::Block* next_block = func->GetBlock(next_block_num);
+  OnBlockTransition(func, stack_.current_frame()->exec_point().current_block(), next_block);
   stack_.current_frame()->exec_point().AdvanceToNextBlock(next_block);
+  if (profile_ != nullptr) {
+    profile_->RecordBlockEntry(next_block);
+  }
 }
 
 void Interpreter::ExecuteJumpCondInstr(ir::JumpCondInstr* instr) {
   bool cond = EvaluateBool(instr->condition());
   ir::func_num_t next_block_num = cond ? instr->destination_true() : instr->destination_false();
-  ir::Block* next_block = stack_.current_frame()->func()->GetBlock(next_block_num);
+  ir::Func* func = stack_.current_frame()->func();
+  ir::Block* next_block = func->GetBlock(next_block_num);
+  OnBlockTransition(func, stack_.current_frame()->exec_point().current_block(), next_block);
   stack_.current_frame()->exec_point().AdvanceToNextBlock(next_block);
+  if (profile_ != nullptr) {
+    profile_->RecordBlockEntry(next_block);
+  }
 }
 
 void Interpreter::ExecuteCallInstr(ir::CallInstr* instr) {
   ir::func_num_t func_num = EvaluateFunc(instr->func());
   ir::Func* func = program_->GetFunc(func_num);
-  std::vector<std::shared_ptr<ir::Constant>> args = Evaluate(instr->args());
+  std::vector<TaggedValue> args = Evaluate(instr->args());
+
+  if (std::vector<TaggedValue> results; InterceptCall(func, args, results)) {
+    for (std::size_t i = 0; i < results.size(); i++) {
+      ir::value_num_t result_num = instr->results().at(i)->number();
+      stack_.current_frame()->SetComputedValue(result_num, results.at(i));
+    }
+    stack_.current_frame()->exec_point().AdvanceToNextInstr();
+    return;
+  }
 
   stack_.PushFrame(func);
+  if (profile_ != nullptr) {
+    profile_->RecordFuncEntry(func);
+    profile_->RecordBlockEntry(func->entry_block());
+  }
   for (std::size_t i = 0; i < args.size(); i++) {
     ir::value_num_t arg_num = func->args().at(i)->number();
-    std::shared_ptr<ir::Constant>& arg_value = args.at(i);
-    stack_.current_frame()->computed_values().insert({arg_num, arg_value});
+    stack_.current_frame()->SetComputedValue(arg_num, args.at(i));
   }
 }
 
 void Interpreter::ExecuteReturnInstr(ir::ReturnInstr* instr) {
-  std::vector<std::shared_ptr<ir::Constant>> results = Evaluate(instr->args());
+  std::vector<TaggedValue> results = Evaluate(instr->args());
   stack_.current_frame()->exec_point().AdvanceToFuncExit(results);
 }
 
 bool Interpreter::EvaluateBool(std::shared_ptr<ir::Value> ir_value) {
-  return static_cast<ir::BoolConstant*>(Evaluate(ir_value).get())->value();
+  return Evaluate(ir_value).AsBool();
 }
 
 Int Interpreter::EvaluateInt(std::shared_ptr<ir::Value> ir_value) {
-  return static_cast<ir::IntConstant*>(Evaluate(ir_value).get())->value();
+  return Evaluate(ir_value).AsInt();
 }
 
 int64_t Interpreter::EvaluatePointer(std::shared_ptr<ir::Value> ir_value) {
-  return static_cast<ir::PointerConstant*>(Evaluate(ir_value).get())->value();
+  return Evaluate(ir_value).AsPointer();
 }
 
 ir::func_num_t Interpreter::EvaluateFunc(std::shared_ptr<ir::Value> ir_value) {
-  return static_cast<ir::FuncConstant*>(Evaluate(ir_value).get())->value();
+  return Evaluate(ir_value).AsFunc();
 }
 
-std::vector<std::shared_ptr<ir::Constant>> Interpreter::Evaluate(
+std::vector<TaggedValue> Interpreter::Evaluate(
     const std::vector<std::shared_ptr<ir::Value>>& ir_values) {
-  std::vector<std::shared_ptr<ir::Constant>> values;
+  std::vector<TaggedValue> values;
   values.reserve(ir_values.size());
   for (auto ir_value : ir_values) {
     values.push_back(Evaluate(ir_value));
@@ -406,13 +437,13 @@ std::vector<std::shared_ptr<ir::Constant>> Interpreter::Evaluate(
   return values;
 }
 
-std::shared_ptr<ir::Constant> Interpreter::Evaluate(std::shared_ptr<ir::Value> ir_value) {
+TaggedValue Interpreter::Evaluate(std::shared_ptr<ir::Value> ir_value) {
   switch (ir_value->kind()) {
     case ir::Value::Kind::kConstant:
-      return std::static_pointer_cast<ir::Constant>(ir_value);
+      return TaggedValue::ForConstant(static_cast<ir::Constant*>(ir_value.get()));
     case ir::Value::Kind::kComputed: {
       auto computed = static_cast<ir::Computed*>(ir_value.get());
-      return stack_.current_frame()->computed_values().at(computed->number());
+      return stack_.current_frame()->GetComputedValue(computed->number());
     }
     case ir::Value::Kind::kInherited:
       fail("tried to evaluate inherited value");
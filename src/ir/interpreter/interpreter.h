@@ -12,7 +12,9 @@
 #include "src/common/atomics/atomics.h"
 #include "src/ir/interpreter/execution_point.h"
 #include "src/ir/interpreter/heap.h"
+#include "src/ir/interpreter/profile.h"
 #include "src/ir/interpreter/stack.h"
+#include "src/ir/interpreter/tagged_value.h"
 #include "src/ir/representation/block.h"
 #include "src/ir/representation/func.h"
 #include "src/ir/representation/instrs.h"
@@ -28,22 +30,40 @@ namespace ir_interpreter {
 
 class Interpreter {
  public:
-  Interpreter(ir::Program* program, bool sanitize);
+  Interpreter(ir::Program* program, bool sanitize)
+      : Interpreter(program, HeapOptions{.sanitize = sanitize}) {}
+  Interpreter(ir::Program* program, HeapOptions heap_options);
   virtual ~Interpreter() = default;
 
   ir::Program* program() const { return program_; }
 
   virtual int64_t exit_code() const;
 
+  // Starts collecting execution counts. Must be called before the program starts running.
+  void EnableProfiling();
+  // Returns the collected execution counts, or nullptr if profiling is not enabled.
+  const Profile* profile() const { return profile_.get(); }
+
   virtual void Run();
 
  protected:
   bool HasProgramCompleted() const { return exit_code_.has_value(); }
   void ExecuteStep();
 
+  // Gets called before the interpreter enters a function through a call instruction. If it
+  // returns true, the call was executed by other means, the results were stored in results, and
+  // the interpreter continues after the call instruction.
+  virtual bool InterceptCall(ir::Func* /*callee*/, const std::vector<TaggedValue>& /*args*/,
+                             std::vector<TaggedValue>& /*results*/) {
+    return false;
+  }
+  // Gets called when execution jumps from one block to another within the given function.
+  virtual void OnBlockTransition(ir::Func* /*func*/, ir::Block* /*from*/, ir::Block* /*to*/) {}
+
   std::optional<int64_t> exit_code_;
   Stack stack_;
   Heap heap_;
+  std::unique_ptr<Profile> profile_;
 
  private:
   std::vector<std::shared_ptr<ir::Constant>> CallFunc(
@@ -77,9 +97,8 @@ class Interpreter {
   int64_t EvaluatePointer(std::shared_ptr<ir::Value> ir_value);
   ir::func_num_t EvaluateFunc(std::shared_ptr<ir::Value> ir_value);
 
-  std::vector<std::shared_ptr<ir::Constant>> Evaluate(
-      const std::vector<std::shared_ptr<ir::Value>>& ir_values);
-  std::shared_ptr<ir::Constant> Evaluate(std::shared_ptr<ir::Value> ir_value);
+  std::vector<TaggedValue> Evaluate(const std::vector<std::shared_ptr<ir::Value>>& ir_values);
+  TaggedValue Evaluate(std::shared_ptr<ir::Value> ir_value);
 
   StackFrame& current_stack_frame();
 
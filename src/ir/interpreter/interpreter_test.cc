@@ -105,3 +105,57 @@ TEST_P(InterpreterTest, InterpretsCorrectlyWithSanityCheck) {
 
   EXPECT_EQ(interpreter.exit_code(), GetParam().expected_exit_code);
 }
+
+TEST(InterpreterProfilingTest, CountsExecutions) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 main() => (i64) {
+  {0}
+    %0:i64 = call @1, #10:i64
+    ret %0
+}
+
+@1 fib(%0:i64) => (i64) {
+  {0}
+    %1:b = ilss %0, #2:i64
+    jcc %1, {1}, {2}
+  {1}
+    ret #1:i64
+  {2}
+    %2:i64 = isub %0, #1:i64
+    %3:i64 = call @1, %2
+    %4:i64 = isub %0, #2:i64
+    %5:i64 = call @1, %4
+    %6:i64 = iadd %3, %5
+    ret %6
+}
+)ir");
+  program->set_entry_func_num(0);
+
+  ir_check::CheckProgramOrDie(program.get());
+  ir_interpreter::Interpreter interpreter(program.get(), /*sanitize=*/false);
+  interpreter.EnableProfiling();
+  interpreter.Run();
+  ASSERT_EQ(interpreter.exit_code(), 89);
+
+  const ir_interpreter::Profile* profile = interpreter.profile();
+  ASSERT_NE(profile, nullptr);
+  EXPECT_EQ(profile->instr_count(), 973);
+  EXPECT_EQ(profile->CallCount(0, 1), 1);
+  EXPECT_EQ(profile->CallCount(1, 1), 176);
+  EXPECT_EQ(profile->BlockCount(1, 0), 177);
+  EXPECT_EQ(profile->BlockCount(1, 1), 89);
+  EXPECT_EQ(profile->BlockCount(1, 2), 88);
+  EXPECT_EQ(profile->InstrCount(program->GetFunc(1)->GetBlock(2)->instrs().front().get()), 88);
+
+  ir_interpreter::Profile::FuncCounts main_counts = profile->GetFuncCounts(0);
+  EXPECT_EQ(main_counts.call_count, 1);
+  EXPECT_EQ(main_counts.exclusive_instr_count, 2);
+  EXPECT_EQ(main_counts.inclusive_instr_count, 973);
+  ir_interpreter::Profile::FuncCounts fib_counts = profile->GetFuncCounts(1);
+  EXPECT_EQ(fib_counts.call_count, 177);
+  EXPECT_EQ(fib_counts.exclusive_instr_count, 971);
+  EXPECT_EQ(fib_counts.inclusive_instr_count, 971);
+
+  EXPECT_THAT(profile->ToString(), testing::HasSubstr("@1 fib -> @1 fib: 176 calls\n"));
+  EXPECT_THAT(profile->ToCallGraph().ToDotFormat(), testing::HasSubstr("n1->n1 [label = \"176\"]"));
+}
@@ -0,0 +1,150 @@
+//
+//  profile.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "profile.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "src/common/logging/logging.h"
+
+namespace ir_interpreter {
+
+using ::common::logging::fail;
+
+int64_t Profile::InstrCount(const ir::Instr* instr) const {
+  auto it = instr_counts_.find(instr);
+  return (it != instr_counts_.end()) ? it->second : 0;
+}
+
+int64_t Profile::BlockCount(ir::func_num_t func_num, ir::block_num_t block_num) const {
+  auto it = block_counts_.find({func_num, block_num});
+  return (it != block_counts_.end()) ? it->second : 0;
+}
+
+Profile::FuncCounts Profile::GetFuncCounts(ir::func_num_t func_num) const {
+  auto it = func_counts_.find(func_num);
+  return (it != func_counts_.end()) ? it->second : FuncCounts{};
+}
+
+int64_t Profile::CallCount(ir::func_num_t caller_num, ir::func_num_t callee_num) const {
+  auto it = call_counts_.find({caller_num, callee_num});
+  return (it != call_counts_.end()) ? it->second : 0;
+}
+
+void Profile::RecordFuncEntry(const ir::Func* func) {
+  if (!active_funcs_.empty()) {
+    call_counts_[{active_funcs_.back().func_num, func->number()}]++;
+  }
+  func_counts_[func->number()].call_count++;
+  active_funcs_.push_back(ActiveFunc{
+      .func_num = func->number(),
+      .instr_count_at_entry = instr_count_,
+  });
+  active_depths_[func->number()]++;
+}
+
+void Profile::RecordFuncExit() {
+  if (active_funcs_.empty()) {
+    fail("recorded function exit without active function");
+  }
+  ActiveFunc active_func = active_funcs_.back();
+  active_funcs_.pop_back();
+  // Only the outermost activation of a recursive function contributes to its inclusive count,
+  // since it already includes the instructions of all inner activations.
+  if (--active_depths_.at(active_func.func_num) == 0) {
+    func_counts_.at(active_func.func_num).inclusive_instr_count +=
+        instr_count_ - active_func.instr_count_at_entry;
+  }
+}
+
+void Profile::RecordBlockEntry(const ir::Block* block) {
+  if (active_funcs_.empty()) {
+    fail("recorded block entry without active function");
+  }
+  block_counts_[{active_funcs_.back().func_num, block->number()}]++;
+}
+
+void Profile::RecordInstr(const ir::Instr* instr) {
+  if (active_funcs_.empty()) {
+    fail("recorded instr without active function");
+  }
+  instr_count_++;
+  instr_counts_[instr]++;
+  func_counts_[active_funcs_.back().func_num].exclusive_instr_count++;
+}
+
+std::string Profile::FuncRefString(ir::func_num_t func_num) const {
+  if (program_->HasFunc(func_num)) {
+    return program_->GetFunc(func_num)->RefString();
+  }
+  return "@" + std::to_string(func_num);
+}
+
+std::string Profile::ToString() const {
+  std::stringstream ss;
+  ss << "Profile (" << instr_count_ << " instrs executed):\n";
+
+  std::vector<std::pair<ir::func_num_t, FuncCounts>> funcs(func_counts_.begin(),
+                                                           func_counts_.end());
+  std::stable_sort(funcs.begin(), funcs.end(), [](const auto& a, const auto& b) {
+    return a.second.inclusive_instr_count > b.second.inclusive_instr_count;
+  });
+  ss << "Funcs by inclusive instrs:\n";
+  for (const auto& [func_num, counts] : funcs) {
+    ss << "  " << FuncRefString(func_num) << ": " << counts.call_count << " calls, "
+       << counts.exclusive_instr_count << " exclusive instrs, " << counts.inclusive_instr_count
+       << " inclusive instrs\n";
+  }
+
+  if (!call_counts_.empty()) {
+    ss << "Call edges:\n";
+    for (const auto& [edge, count] : call_counts_) {
+      ss << "  " << FuncRefString(edge.first) << " -> " << FuncRefString(edge.second) << ": "
+         << count << " calls\n";
+    }
+  }
+
+  ss << "Blocks and instrs:\n";
+  for (const std::unique_ptr<ir::Func>& func : program_->funcs()) {
+    if (!func_counts_.contains(func->number())) {
+      continue;
+    }
+    ss << func->RefString() << ":\n";
+    for (const std::unique_ptr<ir::Block>& block : func->blocks()) {
+      int64_t block_count = BlockCount(func->number(), block->number());
+      if (block_count == 0) {
+        continue;
+      }
+      ss << "  " << block->RefString() << ": " << block_count << "\n";
+      for (const std::unique_ptr<ir::Instr>& instr : block->instrs()) {
+        ss << std::setw(12) << InstrCount(instr.get()) << "  " << instr->RefString() << "\n";
+      }
+    }
+  }
+  return ss.str();
+}
+
+common::graph::Graph Profile::ToCallGraph() const {
+  common::graph::Graph graph(/*is_directed=*/true);
+  for (const auto& [func_num, counts] : func_counts_) {
+    std::stringstream ss;
+    ss << "calls: " << counts.call_count << "\n";
+    ss << "exclusive instrs: " << counts.exclusive_instr_count << "\n";
+    ss << "inclusive instrs: " << counts.inclusive_instr_count;
+    graph.nodes().push_back(
+        common::graph::NodeBuilder(func_num, FuncRefString(func_num)).SetText(ss.str()).Build());
+  }
+  for (const auto& [edge, count] : call_counts_) {
+    graph.edges().push_back(common::graph::Edge(edge.first, edge.second, std::to_string(count)));
+  }
+  return graph;
+}
+
+}  // namespace ir_interpreter
@@ -0,0 +1,82 @@
+//
+//  profile.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_interpreter_profile_h
+#define ir_interpreter_profile_h
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "src/common/graph/graph.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/instrs.h"
+#include "src/ir/representation/num_types.h"
+#include "src/ir/representation/program.h"
+
+namespace ir_interpreter {
+
+// Execution counts collected while interpreting a program. The interpreter reports function
+// entries and exits, block entries, and executed instructions; the profile attributes them to the
+// currently executing function.
+class Profile {
+ public:
+  struct FuncCounts {
+    int64_t call_count = 0;
+    // Instructions executed in the function itself.
+    int64_t exclusive_instr_count = 0;
+    // Instructions executed in the function and all functions it called. Recursive calls are only
+    // counted once.
+    int64_t inclusive_instr_count = 0;
+  };
+
+  Profile(const ir::Program* program) : program_(program) {}
+
+  int64_t instr_count() const { return instr_count_; }
+  int64_t InstrCount(const ir::Instr* instr) const;
+  int64_t BlockCount(ir::func_num_t func_num, ir::block_num_t block_num) const;
+  FuncCounts GetFuncCounts(ir::func_num_t func_num) const;
+  int64_t CallCount(ir::func_num_t caller_num, ir::func_num_t callee_num) const;
+
+  void RecordFuncEntry(const ir::Func* func);
+  void RecordFuncExit();
+  void RecordBlockEntry(const ir::Block* block);
+  void RecordInstr(const ir::Instr* instr);
+
+  std::string ToString() const;
+  common::graph::Graph ToCallGraph() const;
+
+ private:
+  struct ActiveFunc {
+    ir::func_num_t func_num;
+    int64_t instr_count_at_entry;
+  };
+
+  std::string FuncRefString(ir::func_num_t func_num) const;
+
+  const ir::Program* program_;
+
+  int64_t instr_count_ = 0;
+  std::unordered_map<const ir::Instr*, int64_t> instr_counts_;
+  std::map<std::pair<ir::func_num_t, ir::block_num_t>, int64_t> block_counts_;
+  std::map<ir::func_num_t, FuncCounts> func_counts_;
+  std::map<std::pair<ir::func_num_t, ir::func_num_t>, int64_t> call_counts_;
+
+  // Functions currently on the call stack, innermost last.
+  std::vector<ActiveFunc> active_funcs_;
+  // Number of activations of each function on the call stack.
+  std::unordered_map<ir::func_num_t, int64_t> active_depths_;
+};
+
+}  // namespace ir_interpreter
+
+#endif /* ir_interpreter_profile_h */
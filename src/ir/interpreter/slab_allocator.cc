@@ -0,0 +1,128 @@
+//
+//  slab_allocator.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "slab_allocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+#include "src/common/logging/logging.h"
+
+namespace ir_interpreter {
+
+using ::common::logging::fail;
+
+SlabAllocator::~SlabAllocator() {
+  for (auto& [slab_address, size_class_index] : slabs_) {
+    free((void*)(slab_address));
+  }
+  for (auto& [address, size] : large_allocations_) {
+    free((void*)(address));
+  }
+}
+
+std::size_t SlabAllocator::SizeClassIndexFor(int64_t size) {
+  auto it = std::lower_bound(kSizeClasses.begin(), kSizeClasses.end(), size);
+  return std::size_t(it - kSizeClasses.begin());
+}
+
+int64_t SlabAllocator::Allocate(int64_t size) {
+  std::size_t size_class_index = SizeClassIndexFor(size);
+  if (size_class_index == kNoSizeClass) {
+    int64_t address = int64_t(malloc(size));
+    if (address == 0) {
+      fail("malloc failed");
+    }
+    large_allocations_.emplace(address, size);
+    RecordAllocation(stats_, size);
+    return address;
+  }
+  SizeClass& size_class = size_classes_.at(size_class_index);
+  if (size_class.free_list == nullptr) {
+    AllocateSlab(size_class_index);
+  }
+  FreeObject* object = size_class.free_list;
+  size_class.free_list = object->next;
+  RecordAllocation(size_class.stats, kSizeClasses.at(size_class_index));
+  RecordAllocation(stats_, kSizeClasses.at(size_class_index));
+  return int64_t(object);
+}
+
+void SlabAllocator::Free(int64_t address) {
+  int64_t slab_address = address & ~(kSlabSize - 1);
+  if (auto it = slabs_.find(slab_address); it != slabs_.end()) {
+    std::size_t size_class_index = it->second;
+    SizeClass& size_class = size_classes_.at(size_class_index);
+    FreeObject* object = (FreeObject*)(address);
+    object->next = size_class.free_list;
+    size_class.free_list = object;
+    RecordFree(size_class.stats, kSizeClasses.at(size_class_index));
+    RecordFree(stats_, kSizeClasses.at(size_class_index));
+    return;
+  }
+  auto it = large_allocations_.find(address);
+  if (it == large_allocations_.end()) {
+    fail("attempted to free memory not allocated by slab allocator");
+  }
+  RecordFree(stats_, it->second);
+  large_allocations_.erase(it);
+  free((void*)(address));
+}
+
+void SlabAllocator::AllocateSlab(std::size_t size_class_index) {
+  // Slabs are aligned to their size, such that Free can find the slab containing an address by
+  // masking off the lower bits.
+  int64_t slab_address = int64_t(aligned_alloc(kSlabSize, kSlabSize));
+  if (slab_address == 0) {
+    fail("aligned_alloc failed");
+  }
+  slabs_.emplace(slab_address, size_class_index);
+
+  SizeClass& size_class = size_classes_.at(size_class_index);
+  int64_t object_size = kSizeClasses.at(size_class_index);
+  int64_t object_count = kSlabSize / object_size;
+  // Link objects in reverse, such that allocations hand out increasing addresses.
+  for (int64_t i = object_count - 1; i >= 0; i--) {
+    FreeObject* object = (FreeObject*)(slab_address + i * object_size);
+    object->next = size_class.free_list;
+    size_class.free_list = object;
+  }
+}
+
+void SlabAllocator::RecordAllocation(Stats& stats, int64_t size) {
+  stats.allocation_count++;
+  stats.bytes += size;
+  stats.peak_bytes = std::max(stats.peak_bytes, stats.bytes);
+}
+
+void SlabAllocator::RecordFree(Stats& stats, int64_t size) {
+  stats.free_count++;
+  stats.bytes -= size;
+}
+
+std::string SlabAllocator::ToDebuggerString() const {
+  std::stringstream ss;
+  ss << "Slab allocator (" << slabs_.size() << " slabs, " << large_allocations_.size()
+     << " large allocations):\n";
+  ss << "     total: " << stats_.allocation_count << " allocs, " << stats_.free_count
+     << " frees, " << stats_.bytes << " bytes, " << stats_.peak_bytes << " peak bytes\n";
+  for (std::size_t i = 0; i < kSizeClasses.size(); i++) {
+    const Stats& stats = size_classes_.at(i).stats;
+    if (stats.allocation_count == 0) {
+      continue;
+    }
+    ss << std::setw(4) << kSizeClasses.at(i) << " bytes: " << stats.allocation_count << " allocs, "
+       << stats.free_count << " frees, " << stats.bytes << " bytes, " << stats.peak_bytes
+       << " peak bytes\n";
+  }
+  return ss.str();
+}
+
+}  // namespace ir_interpreter
@@ -0,0 +1,79 @@
+//
+//  slab_allocator.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_interpreter_slab_allocator_h
+#define ir_interpreter_slab_allocator_h
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace ir_interpreter {
+
+// Serves small allocations from slabs holding objects of a fixed size class. Freed objects are
+// kept on a free list per size class and reused by later allocations of the same class. This
+// suits the many small, fixed size allocations made by interpreted programs (e.g. shared pointer
+// control blocks). Allocations larger than the largest size class are forwarded to malloc.
+class SlabAllocator {
+ public:
+  static constexpr std::array<int64_t, 10> kSizeClasses{8, 16, 24, 32, 48, 64, 96, 128, 192, 256};
+  static constexpr int64_t kSlabSize = int64_t{64} << 10;
+
+  struct Stats {
+    int64_t allocation_count = 0;
+    int64_t free_count = 0;
+    // Bytes in use, with slab allocations rounded up to their size class.
+    int64_t bytes = 0;
+    int64_t peak_bytes = 0;
+  };
+
+  SlabAllocator() = default;
+  ~SlabAllocator();
+
+  SlabAllocator(const SlabAllocator&) = delete;
+  SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+  const Stats& stats() const { return stats_; }
+  const Stats& size_class_stats(std::size_t size_class_index) const {
+    return size_classes_.at(size_class_index).stats;
+  }
+  int64_t slab_count() const { return int64_t(slabs_.size()); }
+
+  int64_t Allocate(int64_t size);
+  void Free(int64_t address);
+
+  std::string ToDebuggerString() const;
+
+ private:
+  struct FreeObject {
+    FreeObject* next;
+  };
+  struct SizeClass {
+    FreeObject* free_list = nullptr;
+    Stats stats;
+  };
+
+  static constexpr std::size_t kNoSizeClass = kSizeClasses.size();
+  static std::size_t SizeClassIndexFor(int64_t size);
+
+  void AllocateSlab(std::size_t size_class_index);
+  static void RecordAllocation(Stats& stats, int64_t size);
+  static void RecordFree(Stats& stats, int64_t size);
+
+  std::array<SizeClass, kSizeClasses.size()> size_classes_;
+  // Maps the start address of each slab (aligned to kSlabSize) to its size class index.
+  std::unordered_map<int64_t, std::size_t> slabs_;
+  // Maps the address of each allocation forwarded to malloc to its size.
+  std::unordered_map<int64_t, int64_t> large_allocations_;
+  Stats stats_;
+};
+
+}  // namespace ir_interpreter
+
+#endif /* ir_interpreter_slab_allocator_h */
@@ -0,0 +1,110 @@
+//
+//  slab_allocator_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/interpreter/slab_allocator.h"
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace ir_interpreter {
+namespace {
+
+TEST(SlabAllocatorTest, RoundsUpToSizeClass) {
+  SlabAllocator allocator;
+
+  int64_t addr_a = allocator.Allocate(1);
+  int64_t addr_b = allocator.Allocate(20);
+  int64_t addr_c = allocator.Allocate(24);
+
+  EXPECT_EQ(allocator.stats().allocation_count, 3);
+  EXPECT_EQ(allocator.stats().bytes, 8 + 24 + 24);
+  EXPECT_EQ(allocator.size_class_stats(0).allocation_count, 1);
+  EXPECT_EQ(allocator.size_class_stats(2).allocation_count, 2);
+  EXPECT_EQ(allocator.slab_count(), 2);
+
+  allocator.Free(addr_a);
+  allocator.Free(addr_b);
+  allocator.Free(addr_c);
+  EXPECT_EQ(allocator.stats().free_count, 3);
+  EXPECT_EQ(allocator.stats().bytes, 0);
+  EXPECT_EQ(allocator.stats().peak_bytes, 8 + 24 + 24);
+}
+
+TEST(SlabAllocatorTest, ReusesFreedObjects) {
+  SlabAllocator allocator;
+
+  int64_t addr_a = allocator.Allocate(40);
+  allocator.Free(addr_a);
+  int64_t addr_b = allocator.Allocate(48);
+
+  EXPECT_EQ(addr_a, addr_b);
+  EXPECT_EQ(allocator.slab_count(), 1);
+  allocator.Free(addr_b);
+}
+
+TEST(SlabAllocatorTest, HandsOutDistinctWritableObjectsAcrossSlabs) {
+  SlabAllocator allocator;
+  std::vector<int64_t> addresses;
+  for (int64_t i = 0; i < 10000; i++) {
+    int64_t addr = allocator.Allocate(32);
+    *(int64_t*)(addr) = i;
+    *(int64_t*)(addr + 24) = -i;
+    addresses.push_back(addr);
+  }
+  EXPECT_EQ(std::set<int64_t>(addresses.begin(), addresses.end()).size(), addresses.size());
+  EXPECT_GT(allocator.slab_count(), 1);
+  for (int64_t i = 0; i < 10000; i++) {
+    EXPECT_EQ(*(int64_t*)(addresses.at(i)), i);
+    EXPECT_EQ(*(int64_t*)(addresses.at(i) + 24), -i);
+  }
+  for (int64_t addr : addresses) {
+    allocator.Free(addr);
+  }
+  EXPECT_EQ(allocator.stats().bytes, 0);
+  EXPECT_EQ(allocator.stats().peak_bytes, 10000 * 32);
+}
+
+TEST(SlabAllocatorTest, ForwardsLargeAllocations) {
+  SlabAllocator allocator;
+
+  int64_t addr = allocator.Allocate(4096);
+  *(int64_t*)(addr + 4088) = 42;
+
+  EXPECT_EQ(allocator.slab_count(), 0);
+  EXPECT_EQ(allocator.stats().bytes, 4096);
+  allocator.Free(addr);
+  EXPECT_EQ(allocator.stats().bytes, 0);
+}
+
+TEST(SlabAllocatorTest, ReportsStats) {
+  SlabAllocator allocator;
+  int64_t addr_a = allocator.Allocate(24);
+  int64_t addr_b = allocator.Allocate(24);
+  allocator.Free(addr_a);
+
+  EXPECT_EQ(allocator.ToDebuggerString(),
+            "Slab allocator (1 slabs, 0 large allocations):\n"
+            "     total: 2 allocs, 1 frees, 24 bytes, 48 peak bytes\n"
+            "  24 bytes: 2 allocs, 1 frees, 24 bytes, 48 peak bytes\n");
+  allocator.Free(addr_b);
+}
+
+TEST(SlabAllocatorDeathTest, CatchesFreeOfUnknownAddress) {
+  EXPECT_DEATH(
+      [] {
+        SlabAllocator allocator;
+        allocator.Free(0x12345);
+      }(),
+      "attempted to free memory not allocated by slab allocator");
+}
+
+}  // namespace
+}  // namespace ir_interpreter
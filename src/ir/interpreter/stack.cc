@@ -66,13 +66,13 @@ void Stack::WriteFrameFunc(std::size_t frame_index, std::stringstream& ss) const
   ss << " (";
   bool first = true;
   for (auto& arg : frame->func()->args()) {
-    std::shared_ptr<ir::Constant> arg_value = frame->computed_values().at(arg->number());
+    TaggedValue arg_value = frame->GetComputedValue(arg->number());
     if (first) {
       first = false;
     } else {
       ss << ", ";
     }
-    ss << "%" << arg->number() << " = " << arg_value->RefStringWithType();
+    ss << "%" << arg->number() << " = " << arg_value.RefStringWithType();
   }
   ss << ")";
 }
@@ -91,7 +91,7 @@ void Stack::WriteFrameInstr(std::size_t frame_index, std::stringstream& ss) cons
         } else {
           ss << ", ";
         }
-        ss << result->RefStringWithType();
+        ss << result.RefStringWithType();
       }
       ss << ")";
     }
@@ -104,10 +104,14 @@ void Stack::WriteFrameInstr(std::size_t frame_index, std::stringstream& ss) cons
 
 void Stack::WriteFrameValues(std::size_t frame_index, std::stringstream& ss) const {
   const StackFrame* frame = frames_.at(frame_index).get();
-  for (const auto& [value_num, value] : frame->computed_values()) {
+  for (std::size_t value_num = 0; value_num < frame->computed_values().size(); value_num++) {
+    const TaggedValue& value = frame->computed_values().at(value_num);
+    if (!value.has_value()) {
+      continue;
+    }
     ss << "  "
        << "%" << std::left << std::setw(3) << std::setfill(' ') << value_num << " = "
-       << value->RefStringWithType() << "\n";
+       << value.RefStringWithType() << "\n";
   }
 }
 
@@ -8,10 +8,10 @@
 
 #include <memory>
 #include <sstream>
-#include <unordered_map>
 #include <vector>
 
 #include "src/ir/interpreter/execution_point.h"
+#include "src/ir/interpreter/tagged_value.h"
 #include "src/ir/representation/func.h"
 #include "src/ir/representation/values.h"
 
@@ -29,23 +29,31 @@ class StackFrame {
   const ExecutionPoint& exec_point() const { return exec_point_; }
   ExecutionPoint& exec_point() { return exec_point_; }
   void set_exec_point(ExecutionPoint exec_point) { exec_point_ = exec_point; }
-  const std::unordered_map<ir::value_num_t, std::shared_ptr<ir::Constant>>& computed_values()
-      const {
-    return computed_values_;
+  const std::vector<TaggedValue>& computed_values() const { return computed_values_; }
+  bool HasComputedValue(ir::value_num_t value_num) const {
+    return value_num >= 0 && std::size_t(value_num) < computed_values_.size() &&
+           computed_values_[value_num].has_value();
   }
-  std::unordered_map<ir::value_num_t, std::shared_ptr<ir::Constant>>& computed_values() {
-    return computed_values_;
+  TaggedValue GetComputedValue(ir::value_num_t value_num) const {
+    return computed_values_[value_num];
+  }
+  void SetComputedValue(ir::value_num_t value_num, TaggedValue value) {
+    computed_values_[value_num] = value;
   }
 
  private:
   StackFrame(StackFrame* parent, ir::Func* func)
-      : parent_(parent), func_(func), exec_point_(ExecutionPoint::AtFuncEntry(func)) {}
+      : parent_(parent),
+        func_(func),
+        exec_point_(ExecutionPoint::AtFuncEntry(func)),
+        computed_values_(func->computed_count()) {}
 
   StackFrame* parent_;
   ir::Func* func_;
 
   ExecutionPoint exec_point_;
-  std::unordered_map<ir::value_num_t, std::shared_ptr<ir::Constant>> computed_values_;
+  // Indexed by value number; slots of values that have not been computed yet have no value.
+  std::vector<TaggedValue> computed_values_;
 
   friend class Stack;
 };
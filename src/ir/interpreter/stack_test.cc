@@ -8,6 +8,8 @@
 
 #include "src/ir/interpreter/stack.h"
 
+#include <algorithm>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "src/ir/check/check_test_util.h"
@@ -20,15 +22,25 @@
 #include "src/ir/serialization/parse.h"
 
 using ::common::atomics::Int;
+using ::ir_interpreter::TaggedValue;
 using ::testing::IsEmpty;
 using ::testing::SizeIs;
 
+namespace {
+
+std::size_t CountComputedValues(const ir_interpreter::StackFrame* frame) {
+  return std::count_if(frame->computed_values().begin(), frame->computed_values().end(),
+                       [](const TaggedValue& value) { return value.has_value(); });
+}
+
+}  // namespace
+
 TEST(StackTest, HandlesStackFramesCorrectly) {
   std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
 @0 (%0:u8, %1:u8) => (u8) {
 {0}
-  %2:u8 = iadd %0, %1
-  ret %2
+  %5:u8 = iadd %0, %1
+  ret %5
 }
 
 @1 (%0:u8) => (u8) {
@@ -65,17 +77,17 @@ TEST(StackTest, HandlesStackFramesCorrectly) {
   EXPECT_EQ(frame_a->func(), func_a);
   EXPECT_TRUE(frame_a->exec_point().is_at_block_entry());
   EXPECT_FALSE(frame_a->exec_point().is_at_func_exit());
-  EXPECT_THAT(frame_a->computed_values(), IsEmpty());
+  EXPECT_EQ(CountComputedValues(frame_a), 0);
 
-  frame_a->computed_values().insert({0, ir::ToIntConstant(Int(40))});
-  frame_a->computed_values().insert({1, ir::ToIntConstant(Int(39))});
+  frame_a->SetComputedValue(0, TaggedValue::ForInt(Int(40)));
+  frame_a->SetComputedValue(1, TaggedValue::ForInt(Int(39)));
   frame_a->exec_point().AdvanceToNextInstr();
-  frame_a->computed_values().insert({2, ir::ToIntConstant(Int(38))});
+  frame_a->SetComputedValue(2, TaggedValue::ForInt(Int(38)));
   frame_a->exec_point().AdvanceToNextInstr();
 
   EXPECT_FALSE(frame_a->exec_point().is_at_block_entry());
   EXPECT_TRUE(frame_a->exec_point().is_at_func_exit());
-  EXPECT_THAT(frame_a->computed_values(), SizeIs(3));
+  EXPECT_EQ(CountComputedValues(frame_a), 3);
 
   stack.PushFrame(func_a);
 
@@ -90,24 +102,24 @@ TEST(StackTest, HandlesStackFramesCorrectly) {
   EXPECT_EQ(frame_b->func(), func_a);
   EXPECT_TRUE(frame_b->exec_point().is_at_block_entry());
   EXPECT_FALSE(frame_b->exec_point().is_at_func_exit());
-  EXPECT_THAT(frame_b->computed_values(), IsEmpty());
+  EXPECT_EQ(CountComputedValues(frame_b), 0);
 
   EXPECT_EQ(frame_a->parent(), nullptr);
   EXPECT_FALSE(frame_a->exec_point().is_at_block_entry());
   EXPECT_TRUE(frame_a->exec_point().is_at_func_exit());
-  EXPECT_THAT(frame_a->computed_values(), SizeIs(3));
+  EXPECT_EQ(CountComputedValues(frame_a), 3);
 
-  frame_b->computed_values().insert({0, ir::ToIntConstant(Int(25))});
-  frame_b->computed_values().insert({5, ir::ToIntConstant(Int(17))});
-  frame_b->exec_point().AdvanceToFuncExit({frame_b->computed_values().at(5)});
+  frame_b->SetComputedValue(0, TaggedValue::ForInt(Int(25)));
+  frame_b->SetComputedValue(5, TaggedValue::ForInt(Int(17)));
+  frame_b->exec_point().AdvanceToFuncExit({frame_b->GetComputedValue(5)});
 
   EXPECT_FALSE(frame_b->exec_point().is_at_block_entry());
   EXPECT_TRUE(frame_b->exec_point().is_at_func_exit());
-  EXPECT_THAT(frame_b->computed_values(), SizeIs(2));
+  EXPECT_EQ(CountComputedValues(frame_b), 2);
 
   EXPECT_FALSE(frame_a->exec_point().is_at_block_entry());
   EXPECT_TRUE(frame_a->exec_point().is_at_func_exit());
-  EXPECT_THAT(frame_a->computed_values(), SizeIs(3));
+  EXPECT_EQ(CountComputedValues(frame_a), 3);
 
   stack.PopCurrentFrame();
 
@@ -119,12 +131,12 @@ TEST(StackTest, HandlesStackFramesCorrectly) {
   EXPECT_EQ(frame_a->func(), func_a);
   EXPECT_FALSE(frame_a->exec_point().is_at_block_entry());
   EXPECT_TRUE(frame_a->exec_point().is_at_func_exit());
-  EXPECT_THAT(frame_a->computed_values(), SizeIs(3));
+  EXPECT_EQ(CountComputedValues(frame_a), 3);
 
   frame_a->exec_point().AdvanceToNextInstr();
-  frame_a->computed_values().insert({3, ir::ToIntConstant(Int(37))});
+  frame_a->SetComputedValue(3, TaggedValue::ForInt(Int(37)));
   frame_a->exec_point().AdvanceToNextInstr();
-  frame_a->computed_values().insert({4, ir::ToIntConstant(Int(36))});
+  frame_a->SetComputedValue(4, TaggedValue::ForInt(Int(36)));
   frame_a->exec_point().AdvanceToNextInstr();
 
   stack.PushFrame(func_b);
@@ -140,26 +152,26 @@ TEST(StackTest, HandlesStackFramesCorrectly) {
   EXPECT_EQ(frame_c->func(), func_b);
   EXPECT_TRUE(frame_c->exec_point().is_at_block_entry());
   EXPECT_FALSE(frame_c->exec_point().is_at_func_exit());
-  EXPECT_THAT(frame_c->computed_values(), IsEmpty());
+  EXPECT_EQ(CountComputedValues(frame_c), 0);
 
   EXPECT_EQ(frame_a->parent(), nullptr);
   EXPECT_FALSE(frame_a->exec_point().is_at_block_entry());
   EXPECT_FALSE(frame_a->exec_point().is_at_func_exit());
-  EXPECT_THAT(frame_a->computed_values(), SizeIs(5));
+  EXPECT_EQ(CountComputedValues(frame_a), 5);
 
-  frame_c->computed_values().insert({0, ir::ToIntConstant(Int(111))});
-  frame_c->computed_values().insert({1, ir::ToIntConstant(Int(222))});
+  frame_c->SetComputedValue(0, TaggedValue::ForInt(Int(111)));
+  frame_c->SetComputedValue(1, TaggedValue::ForInt(Int(222)));
   frame_c->exec_point().AdvanceToNextInstr();
-  frame_c->computed_values().insert({2, ir::ToIntConstant(Int(77))});
-  frame_c->exec_point().AdvanceToFuncExit({frame_c->computed_values().at(2)});
+  frame_c->SetComputedValue(2, TaggedValue::ForInt(Int(77)));
+  frame_c->exec_point().AdvanceToFuncExit({frame_c->GetComputedValue(2)});
 
   EXPECT_FALSE(frame_c->exec_point().is_at_block_entry());
   EXPECT_TRUE(frame_c->exec_point().is_at_func_exit());
-  EXPECT_THAT(frame_c->computed_values(), SizeIs(3));
+  EXPECT_EQ(CountComputedValues(frame_c), 3);
 
   EXPECT_FALSE(frame_a->exec_point().is_at_block_entry());
   EXPECT_FALSE(frame_a->exec_point().is_at_func_exit());
-  EXPECT_THAT(frame_a->computed_values(), SizeIs(5));
+  EXPECT_EQ(CountComputedValues(frame_a), 5);
 
   stack.PopCurrentFrame();
 
@@ -171,11 +183,11 @@ TEST(StackTest, HandlesStackFramesCorrectly) {
   EXPECT_EQ(frame_a->func(), func_a);
   EXPECT_FALSE(frame_a->exec_point().is_at_block_entry());
   EXPECT_FALSE(frame_a->exec_point().is_at_func_exit());
-  EXPECT_THAT(frame_a->computed_values(), SizeIs(5));
+  EXPECT_EQ(CountComputedValues(frame_a), 5);
 
   frame_a->exec_point().AdvanceToNextInstr();
-  frame_a->computed_values().insert({5, ir::ToIntConstant(Int(35))});
-  frame_a->exec_point().AdvanceToFuncExit({frame_a->computed_values().at(5)});
+  frame_a->SetComputedValue(5, TaggedValue::ForInt(Int(35)));
+  frame_a->exec_point().AdvanceToFuncExit({frame_a->GetComputedValue(5)});
 
   stack.PopCurrentFrame();
 
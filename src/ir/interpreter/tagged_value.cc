@@ -0,0 +1,49 @@
+//
+//  tagged_value.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "tagged_value.h"
+
+#include "src/common/logging/logging.h"
+
+namespace ir_interpreter {
+
+using ::common::logging::fail;
+
+TaggedValue TaggedValue::ForConstant(const ir::Constant* constant) {
+  switch (constant->type()->type_kind()) {
+    case ir::TypeKind::kBool:
+      return ForBool(static_cast<const ir::BoolConstant*>(constant)->value());
+    case ir::TypeKind::kInt:
+      return ForInt(static_cast<const ir::IntConstant*>(constant)->value());
+    case ir::TypeKind::kPointer:
+      return ForPointer(static_cast<const ir::PointerConstant*>(constant)->value());
+    case ir::TypeKind::kFunc:
+      return ForFunc(static_cast<const ir::FuncConstant*>(constant)->value());
+    default:
+      fail("interpreter does not support constant: " + constant->RefStringWithType());
+  }
+}
+
+std::shared_ptr<ir::Constant> TaggedValue::ToConstant() const {
+  switch (tag_) {
+    case Tag::kNone:
+      fail("tagged value has no value");
+    case Tag::kBool:
+      return ir::ToBoolConstant(AsBool());
+    case Tag::kInt:
+      return ir::ToIntConstant(AsInt());
+    case Tag::kPointer:
+      return ir::ToPointerConstant(AsPointer());
+    case Tag::kFunc:
+      return ir::ToFuncConstant(AsFunc());
+  }
+}
+
+std::string TaggedValue::RefStringWithType() const { return ToConstant()->RefStringWithType(); }
+
+}  // namespace ir_interpreter
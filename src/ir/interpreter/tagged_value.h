@@ -0,0 +1,73 @@
+//
+//  tagged_value.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_interpreter_tagged_value_h
+#define ir_interpreter_tagged_value_h
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "src/common/atomics/atomics.h"
+#include "src/ir/representation/num_types.h"
+#include "src/ir/representation/values.h"
+
+namespace ir_interpreter {
+
+// A value computed during interpretation, stored unboxed in a single 64 bit slot. The tag records
+// how to read the slot, which allows the Debugger to render values without the interpreter
+// allocating an ir::Constant for every intermediate result.
+class TaggedValue {
+ public:
+  enum class Tag : uint8_t {
+    kNone,
+    kBool,
+    kInt,
+    kPointer,
+    kFunc,
+  };
+
+  static TaggedValue ForBool(bool value) { return TaggedValue(Tag::kBool, value ? 1 : 0); }
+  static TaggedValue ForInt(common::atomics::Int value) {
+    return TaggedValue(Tag::kInt, value.AsInt64(), value.type());
+  }
+  static TaggedValue ForPointer(int64_t value) { return TaggedValue(Tag::kPointer, value); }
+  static TaggedValue ForFunc(ir::func_num_t value) { return TaggedValue(Tag::kFunc, value); }
+  static TaggedValue ForConstant(const ir::Constant* constant);
+
+  constexpr TaggedValue() : slot_(0), tag_(Tag::kNone), int_type_(common::atomics::IntType::kI64) {}
+
+  Tag tag() const { return tag_; }
+  bool has_value() const { return tag_ != Tag::kNone; }
+
+  bool AsBool() const { return slot_ != 0; }
+  common::atomics::Int AsInt() const { return common::atomics::IntFromInt64(int_type_, slot_); }
+  int64_t AsPointer() const { return slot_; }
+  ir::func_num_t AsFunc() const { return slot_; }
+
+  std::shared_ptr<ir::Constant> ToConstant() const;
+  std::string RefStringWithType() const;
+
+  bool operator==(const TaggedValue& that) const {
+    return tag_ == that.tag_ && slot_ == that.slot_ &&
+           (tag_ != Tag::kInt || int_type_ == that.int_type_);
+  }
+
+ private:
+  TaggedValue(Tag tag, int64_t slot,
+              common::atomics::IntType int_type = common::atomics::IntType::kI64)
+      : slot_(slot), tag_(tag), int_type_(int_type) {}
+
+  int64_t slot_;
+  Tag tag_;
+  common::atomics::IntType int_type_;
+};
+
+}  // namespace ir_interpreter
+
+#endif /* ir_interpreter_tagged_value_h */
@@ -0,0 +1,68 @@
+//
+//  tagged_value_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/interpreter/tagged_value.h"
+
+#include "gtest/gtest.h"
+#include "src/common/atomics/atomics.h"
+#include "src/ir/representation/values.h"
+
+namespace ir_interpreter {
+namespace {
+
+using ::common::atomics::Int;
+using ::common::atomics::IntType;
+
+TEST(TaggedValueTest, DefaultConstructedHasNoValue) {
+  TaggedValue value;
+
+  EXPECT_EQ(value.tag(), TaggedValue::Tag::kNone);
+  EXPECT_FALSE(value.has_value());
+}
+
+TEST(TaggedValueTest, RoundTripsInts) {
+  for (Int int_value : {Int(int8_t{-128}), Int(int16_t{-2}), Int(int32_t{123456}),
+                        Int(int64_t{-42}), Int(uint8_t{255}), Int(uint16_t{65535}),
+                        Int(uint32_t{4000000000}), Int(uint64_t{18446744073709551615u})}) {
+    TaggedValue value = TaggedValue::ForInt(int_value);
+
+    EXPECT_EQ(value.tag(), TaggedValue::Tag::kInt);
+    EXPECT_EQ(value.AsInt().type(), int_value.type());
+    EXPECT_EQ(value.AsInt().ToString(), int_value.ToString());
+  }
+}
+
+TEST(TaggedValueTest, DistinguishesIntTypes) {
+  EXPECT_EQ(TaggedValue::ForInt(Int(int64_t{7})), TaggedValue::ForInt(Int(int64_t{7})));
+  EXPECT_FALSE(TaggedValue::ForInt(Int(int64_t{7})) == TaggedValue::ForInt(Int(uint64_t{7})));
+  EXPECT_FALSE(TaggedValue::ForInt(Int(int64_t{7})) == TaggedValue::ForPointer(7));
+}
+
+TEST(TaggedValueTest, ConvertsFromAndToConstants) {
+  EXPECT_EQ(TaggedValue::ForConstant(ir::True().get()), TaggedValue::ForBool(true));
+  EXPECT_EQ(TaggedValue::ForConstant(ir::ToIntConstant(Int(int16_t{-5})).get()),
+            TaggedValue::ForInt(Int(int16_t{-5})));
+  EXPECT_EQ(TaggedValue::ForConstant(ir::ToPointerConstant(0x1234).get()),
+            TaggedValue::ForPointer(0x1234));
+  EXPECT_EQ(TaggedValue::ForConstant(ir::ToFuncConstant(3).get()), TaggedValue::ForFunc(3));
+
+  EXPECT_TRUE(ir::IsEqual(TaggedValue::ForBool(false).ToConstant().get(), ir::False().get()));
+  EXPECT_TRUE(ir::IsEqual(TaggedValue::ForInt(Int(uint8_t{9})).ToConstant().get(),
+                          ir::ToIntConstant(Int(uint8_t{9})).get()));
+  EXPECT_EQ(TaggedValue::ForInt(Int(uint8_t{9})).AsInt().type(), IntType::kU8);
+}
+
+TEST(TaggedValueTest, RendersLikeConstants) {
+  EXPECT_EQ(TaggedValue::ForBool(true).RefStringWithType(), "#t");
+  EXPECT_EQ(TaggedValue::ForInt(Int(int32_t{-3})).RefStringWithType(),
+            ir::ToIntConstant(Int(int32_t{-3}))->RefStringWithType());
+  EXPECT_EQ(TaggedValue::ForFunc(2).RefStringWithType(), "@2");
+}
+
+}  // namespace
+}  // namespace ir_interpreter
@@ -0,0 +1,489 @@
+//
+//  constant_propagation_optimizer.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "constant_propagation_optimizer.h"
+
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "src/common/atomics/atomics.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/instrs.h"
+#include "src/ir/representation/num_types.h"
+#include "src/ir/representation/types.h"
+#include "src/ir/representation/values.h"
+
+namespace ir_optimizers {
+namespace {
+
+using ::common::atomics::Bool;
+using ::common::atomics::Int;
+
+// The lattice value of a computed value: undefined while no definition reaching it was evaluated,
+// then constant, and finally overdefined if it can hold different values at run time.
+class LatticeValue {
+ public:
+  enum class State {
+    kUndefined,
+    kConstant,
+    kOverdefined,
+  };
+
+  static LatticeValue Undefined() { return LatticeValue(State::kUndefined, nullptr); }
+  static LatticeValue Overdefined() { return LatticeValue(State::kOverdefined, nullptr); }
+  static LatticeValue ForConstant(std::shared_ptr<ir::Constant> constant) {
+    return LatticeValue(State::kConstant, constant);
+  }
+
+  State state() const { return state_; }
+  bool is_undefined() const { return state_ == State::kUndefined; }
+  bool is_constant() const { return state_ == State::kConstant; }
+  bool is_overdefined() const { return state_ == State::kOverdefined; }
+  std::shared_ptr<ir::Constant> constant() const { return constant_; }
+
+  bool operator==(const LatticeValue& that) const {
+    return state_ == that.state_ && ir::IsEqual(constant_.get(), that.constant_.get());
+  }
+
+ private:
+  LatticeValue(State state, std::shared_ptr<ir::Constant> constant)
+      : state_(state), constant_(constant) {}
+
+  State state_;
+  std::shared_ptr<ir::Constant> constant_;
+};
+
+LatticeValue Meet(const LatticeValue& a, const LatticeValue& b) {
+  if (a.is_undefined()) {
+    return b;
+  } else if (b.is_undefined() || a == b) {
+    return a;
+  } else {
+    return LatticeValue::Overdefined();
+  }
+}
+
+bool BoolOf(const LatticeValue& value) {
+  return static_cast<ir::BoolConstant*>(value.constant().get())->value();
+}
+
+Int IntOf(const LatticeValue& value) {
+  return static_cast<ir::IntConstant*>(value.constant().get())->value();
+}
+
+bool IsFoldable(ir::InstrKind instr_kind) {
+  switch (instr_kind) {
+    case ir::InstrKind::kMov:
+    case ir::InstrKind::kConversion:
+    case ir::InstrKind::kBoolNot:
+    case ir::InstrKind::kBoolBinary:
+    case ir::InstrKind::kIntUnary:
+    case ir::InstrKind::kIntCompare:
+    case ir::InstrKind::kIntBinary:
+    case ir::InstrKind::kIntShift:
+    case ir::InstrKind::kNilTest:
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::shared_ptr<ir::Constant> FoldConversion(ir::Conversion* instr, const LatticeValue& operand) {
+  const ir::Type* result_type = instr->result()->type();
+  ir::TypeKind operand_type_kind = operand.constant()->type()->type_kind();
+  if (result_type->type_kind() == ir::TypeKind::kBool &&
+      operand_type_kind == ir::TypeKind::kInt) {
+    return ir::ToBoolConstant(IntOf(operand).ConvertToBool());
+  } else if (result_type->type_kind() == ir::TypeKind::kInt) {
+    common::atomics::IntType result_int_type =
+        static_cast<const ir::IntType*>(result_type)->int_type();
+    if (operand_type_kind == ir::TypeKind::kBool) {
+      return ir::ToIntConstant(Bool::ConvertTo(result_int_type, BoolOf(operand)));
+    } else if (operand_type_kind == ir::TypeKind::kInt &&
+               IntOf(operand).CanConvertTo(result_int_type)) {
+      return ir::ToIntConstant(IntOf(operand).ConvertTo(result_int_type));
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<ir::Constant> FoldIntBinaryInstr(ir::IntBinaryInstr* instr, const LatticeValue& a,
+                                                 const LatticeValue& b) {
+  Int int_a = IntOf(a);
+  Int int_b = IntOf(b);
+  if (!Int::CanCompute(int_a, int_b)) {
+    return nullptr;
+  }
+  if (instr->operation() == Int::BinaryOp::kDiv || instr->operation() == Int::BinaryOp::kRem) {
+    // Leave traps and overflows to run time.
+    if (int_b.IsZero() ||
+        (common::atomics::IsSigned(int_a.type()) && int_a.IsMin() && int_b.IsMinusOne())) {
+      return nullptr;
+    }
+  }
+  return ir::ToIntConstant(Int::Compute(int_a, instr->operation(), int_b));
+}
+
+std::shared_ptr<ir::Constant> FoldIntShiftInstr(ir::IntShiftInstr* instr,
+                                                const LatticeValue& shifted,
+                                                const LatticeValue& offset) {
+  Int int_shifted = IntOf(shifted);
+  Int int_offset = IntOf(offset);
+  if (int_offset.IsLessThanZero() ||
+      int_offset.AsUint64() >= uint64_t(common::atomics::BitSizeOf(int_shifted.type()))) {
+    return nullptr;
+  }
+  return ir::ToIntConstant(Int::Shift(int_shifted, instr->operation(), int_offset));
+}
+
+std::shared_ptr<ir::Constant> FoldNilTestInstr(const LatticeValue& tested) {
+  switch (tested.constant()->type()->type_kind()) {
+    case ir::TypeKind::kPointer:
+      return ir::ToBoolConstant(
+          static_cast<ir::PointerConstant*>(tested.constant().get())->value() == 0);
+    case ir::TypeKind::kFunc:
+      return ir::ToBoolConstant(static_cast<ir::FuncConstant*>(tested.constant().get())->value() ==
+                                ir::kNoFuncNum);
+    default:
+      return nullptr;
+  }
+}
+
+// Returns the result of a foldable instr with only constant operands, or nullptr if the result is
+// not known at compile time.
+std::shared_ptr<ir::Constant> Fold(ir::Instr* instr, const std::vector<LatticeValue>& operands) {
+  switch (instr->instr_kind()) {
+    case ir::InstrKind::kMov:
+      return operands.at(0).constant();
+    case ir::InstrKind::kConversion:
+      return FoldConversion(static_cast<ir::Conversion*>(instr), operands.at(0));
+    case ir::InstrKind::kBoolNot:
+      return ir::ToBoolConstant(!BoolOf(operands.at(0)));
+    case ir::InstrKind::kBoolBinary:
+      return ir::ToBoolConstant(Bool::Compute(BoolOf(operands.at(0)),
+                                              static_cast<ir::BoolBinaryInstr*>(instr)->operation(),
+                                              BoolOf(operands.at(1))));
+    case ir::InstrKind::kIntUnary: {
+      Int::UnaryOp op = static_cast<ir::IntUnaryInstr*>(instr)->operation();
+      Int operand = IntOf(operands.at(0));
+      if (!Int::CanCompute(op, operand)) {
+        return nullptr;
+      }
+      return ir::ToIntConstant(Int::Compute(op, operand));
+    }
+    case ir::InstrKind::kIntCompare: {
+      Int a = IntOf(operands.at(0));
+      Int b = IntOf(operands.at(1));
+      if (!Int::CanCompare(a, b)) {
+        return nullptr;
+      }
+      return ir::ToBoolConstant(
+          Int::Compare(a, static_cast<ir::IntCompareInstr*>(instr)->operation(), b));
+    }
+    case ir::InstrKind::kIntBinary:
+      return FoldIntBinaryInstr(static_cast<ir::IntBinaryInstr*>(instr), operands.at(0),
+                                operands.at(1));
+    case ir::InstrKind::kIntShift:
+      return FoldIntShiftInstr(static_cast<ir::IntShiftInstr*>(instr), operands.at(0),
+                               operands.at(1));
+    case ir::InstrKind::kNilTest:
+      return FoldNilTestInstr(operands.at(0));
+    default:
+      return nullptr;
+  }
+}
+
+void RemovePhiArgsFrom(ir::Block* block, ir::block_num_t origin) {
+  block->ForEachPhiInstr([origin](ir::PhiInstr* phi_instr) {
+    std::erase_if(phi_instr->args(), [origin](const std::shared_ptr<ir::InheritedValue>& arg) {
+      return arg->origin() == origin;
+    });
+  });
+}
+
+class ConstantPropagation {
+ public:
+  explicit ConstantPropagation(ir::Func* func)
+      : func_(func),
+        values_(func->computed_count(), LatticeValue::Undefined()),
+        uses_(func->computed_count()),
+        executable_blocks_(func->block_count(), false) {}
+
+  void Run();
+
+ private:
+  void Analyze();
+  void VisitInstr(ir::Instr* instr, ir::Block* block);
+  void VisitPhiInstr(ir::PhiInstr* instr, ir::Block* block);
+  void VisitJumpCondInstr(ir::JumpCondInstr* instr, ir::Block* block);
+  LatticeValue Evaluate(ir::Instr* instr) const;
+  LatticeValue ValueOf(const std::shared_ptr<ir::Value>& value) const;
+  void SetValue(ir::value_num_t value_num, LatticeValue value);
+
+  void RemoveUnreachableBlocks();
+  void ReplaceKnownJumpCondInstr(ir::Block* block);
+  void ReplaceConstantComputations(ir::Block* block);
+
+  ir::Func* func_;
+  std::vector<LatticeValue> values_;                                  // value_num_t -> value
+  std::vector<std::vector<std::pair<ir::Instr*, ir::Block*>>> uses_;  // value_num_t -> uses
+  std::vector<bool> executable_blocks_;                               // block_num_t -> bool
+  std::set<std::pair<ir::block_num_t, ir::block_num_t>> executable_edges_;
+
+  std::vector<std::pair<ir::block_num_t, ir::block_num_t>> edge_worklist_;
+  std::vector<std::pair<ir::Instr*, ir::Block*>> instr_worklist_;
+};
+
+void ConstantPropagation::Run() {
+  if (func_->entry_block() == nullptr) {
+    return;
+  }
+  Analyze();
+  RemoveUnreachableBlocks();
+  for (auto& block : func_->blocks()) {
+    ReplaceKnownJumpCondInstr(block.get());
+  }
+  for (auto& block : func_->blocks()) {
+    ReplaceConstantComputations(block.get());
+  }
+}
+
+void ConstantPropagation::Analyze() {
+  for (auto& block : func_->blocks()) {
+    for (auto& instr : block->instrs()) {
+      for (auto& used_value : instr->UsedValues()) {
+        if (used_value->kind() == ir::Value::Kind::kComputed) {
+          ir::value_num_t value_num = static_cast<ir::Computed*>(used_value.get())->number();
+          uses_.at(value_num).push_back({instr.get(), block.get()});
+        }
+      }
+    }
+  }
+  for (auto& arg : func_->args()) {
+    values_.at(arg->number()) = LatticeValue::Overdefined();
+  }
+
+  edge_worklist_.push_back({ir::kNoBlockNum, func_->entry_block_num()});
+  while (!edge_worklist_.empty() || !instr_worklist_.empty()) {
+    if (!edge_worklist_.empty()) {
+      auto [parent_num, child_num] = edge_worklist_.back();
+      edge_worklist_.pop_back();
+      if (parent_num != ir::kNoBlockNum && !executable_edges_.insert({parent_num, child_num}).second) {
+        continue;
+      }
+      ir::Block* child = func_->GetBlock(child_num);
+      if (executable_blocks_.at(child_num)) {
+        // Only phis depend on which incoming edges are executable.
+        child->ForEachPhiInstr([&](ir::PhiInstr* phi_instr) { VisitPhiInstr(phi_instr, child); });
+      } else {
+        executable_blocks_.at(child_num) = true;
+        for (auto& instr : child->instrs()) {
+          VisitInstr(instr.get(), child);
+        }
+      }
+    } else {
+      auto [instr, block] = instr_worklist_.back();
+      instr_worklist_.pop_back();
+      if (executable_blocks_.at(block->number())) {
+        VisitInstr(instr, block);
+      }
+    }
+  }
+}
+
+void ConstantPropagation::VisitInstr(ir::Instr* instr, ir::Block* block) {
+  switch (instr->instr_kind()) {
+    case ir::InstrKind::kPhi:
+      VisitPhiInstr(static_cast<ir::PhiInstr*>(instr), block);
+      break;
+    case ir::InstrKind::kJump:
+      edge_worklist_.push_back(
+          {block->number(), static_cast<ir::JumpInstr*>(instr)->destination()});
+      break;
+    case ir::InstrKind::kJumpCond:
+      VisitJumpCondInstr(static_cast<ir::JumpCondInstr*>(instr), block);
+      break;
+    default:
+      for (auto& defined_value : instr->DefinedValues()) {
+        SetValue(defined_value->number(), Evaluate(instr));
+      }
+      break;
+  }
+}
+
+void ConstantPropagation::VisitPhiInstr(ir::PhiInstr* instr, ir::Block* block) {
+  LatticeValue value = LatticeValue::Undefined();
+  for (auto& arg : instr->args()) {
+    if (executable_edges_.contains({arg->origin(), block->number()})) {
+      value = Meet(value, ValueOf(arg->value()));
+    }
+  }
+  SetValue(instr->result()->number(), value);
+}
+
+void ConstantPropagation::VisitJumpCondInstr(ir::JumpCondInstr* instr, ir::Block* block) {
+  LatticeValue condition = ValueOf(instr->condition());
+  if (condition.is_undefined()) {
+    return;
+  }
+  if (!condition.is_constant() || BoolOf(condition)) {
+    edge_worklist_.push_back({block->number(), instr->destination_true()});
+  }
+  if (!condition.is_constant() || !BoolOf(condition)) {
+    edge_worklist_.push_back({block->number(), instr->destination_false()});
+  }
+}
+
+LatticeValue ConstantPropagation::Evaluate(ir::Instr* instr) const {
+  if (!IsFoldable(instr->instr_kind())) {
+    return LatticeValue::Overdefined();
+  }
+  std::vector<LatticeValue> operands;
+  for (auto& used_value : instr->UsedValues()) {
+    operands.push_back(ValueOf(used_value));
+  }
+  if (instr->instr_kind() == ir::InstrKind::kBoolBinary) {
+    // The result of and (or) is known if either operand is known to be false (true).
+    Bool::BinaryOp op = static_cast<ir::BoolBinaryInstr*>(instr)->operation();
+    for (const LatticeValue& operand : operands) {
+      if (operand.is_constant() && op == Bool::BinaryOp::kAnd && !BoolOf(operand)) {
+        return LatticeValue::ForConstant(ir::False());
+      } else if (operand.is_constant() && op == Bool::BinaryOp::kOr && BoolOf(operand)) {
+        return LatticeValue::ForConstant(ir::True());
+      }
+    }
+  }
+  bool has_undefined_operand = false;
+  for (const LatticeValue& operand : operands) {
+    if (operand.is_overdefined()) {
+      return LatticeValue::Overdefined();
+    } else if (operand.is_undefined()) {
+      has_undefined_operand = true;
+    }
+  }
+  if (has_undefined_operand) {
+    return LatticeValue::Undefined();
+  }
+  std::shared_ptr<ir::Constant> result = Fold(instr, operands);
+  return (result != nullptr) ? LatticeValue::ForConstant(result) : LatticeValue::Overdefined();
+}
+
+LatticeValue ConstantPropagation::ValueOf(const std::shared_ptr<ir::Value>& value) const {
+  switch (value->kind()) {
+    case ir::Value::Kind::kConstant:
+      return LatticeValue::ForConstant(std::static_pointer_cast<ir::Constant>(value));
+    case ir::Value::Kind::kComputed:
+      return values_.at(static_cast<ir::Computed*>(value.get())->number());
+    case ir::Value::Kind::kInherited:
+      return ValueOf(static_cast<ir::InheritedValue*>(value.get())->value());
+  }
+}
+
+void ConstantPropagation::SetValue(ir::value_num_t value_num, LatticeValue value) {
+  LatticeValue& old_value = values_.at(value_num);
+  LatticeValue new_value = Meet(old_value, value);
+  if (new_value == old_value) {
+    return;
+  }
+  old_value = new_value;
+  for (auto& use : uses_.at(value_num)) {
+    instr_worklist_.push_back(use);
+  }
+}
+
+void ConstantPropagation::RemoveUnreachableBlocks() {
+  std::vector<ir::block_num_t> unreachable_blocks;
+  for (auto& block : func_->blocks()) {
+    if (!executable_blocks_.at(block->number())) {
+      unreachable_blocks.push_back(block->number());
+    }
+  }
+  for (ir::block_num_t bnum : unreachable_blocks) {
+    for (ir::block_num_t child_num : func_->GetBlock(bnum)->children()) {
+      RemovePhiArgsFrom(func_->GetBlock(child_num), bnum);
+    }
+    func_->RemoveBlock(bnum);
+  }
+}
+
+void ConstantPropagation::ReplaceKnownJumpCondInstr(ir::Block* block) {
+  ir::Instr* control_flow_instr = block->ControlFlowInstr();
+  if (control_flow_instr == nullptr ||
+      control_flow_instr->instr_kind() != ir::InstrKind::kJumpCond) {
+    return;
+  }
+  auto jump_cond_instr = static_cast<ir::JumpCondInstr*>(control_flow_instr);
+  ir::block_num_t destination_true = jump_cond_instr->destination_true();
+  ir::block_num_t destination_false = jump_cond_instr->destination_false();
+  bool true_is_executable = executable_edges_.contains({block->number(), destination_true});
+  bool false_is_executable = executable_edges_.contains({block->number(), destination_false});
+  if (true_is_executable == false_is_executable) {
+    return;
+  }
+  ir::block_num_t destination = true_is_executable ? destination_true : destination_false;
+  ir::block_num_t removed_destination = true_is_executable ? destination_false : destination_true;
+  block->instrs().back() = std::make_unique<ir::JumpInstr>(destination);
+  if (removed_destination != destination && block->children().contains(removed_destination)) {
+    RemovePhiArgsFrom(func_->GetBlock(removed_destination), block->number());
+    func_->RemoveControlFlow(block->number(), removed_destination);
+  }
+}
+
+void ConstantPropagation::ReplaceConstantComputations(ir::Block* block) {
+  // Phis get replaced by movs placed after the remaining phis, since phis have to come first.
+  std::vector<std::unique_ptr<ir::Instr>> phi_replacements;
+  auto& instrs = block->instrs();
+  for (auto it = instrs.begin(); it != instrs.end();) {
+    ir::Instr* instr = it->get();
+    if (instr->instr_kind() == ir::InstrKind::kPhi) {
+      auto phi_instr = static_cast<ir::PhiInstr*>(instr);
+      const LatticeValue& value = values_.at(phi_instr->result()->number());
+      std::shared_ptr<ir::Value> replacement;
+      if (value.is_constant()) {
+        replacement = value.constant();
+      } else if (phi_instr->args().size() == 1) {
+        replacement = phi_instr->args().front()->value();
+      }
+      if (replacement != nullptr) {
+        phi_replacements.push_back(
+            std::make_unique<ir::MovInstr>(phi_instr->result(), replacement));
+        it = instrs.erase(it);
+        continue;
+      }
+    } else if (IsFoldable(instr->instr_kind())) {
+      auto computation = static_cast<ir::Computation*>(instr);
+      const LatticeValue& value = values_.at(computation->result()->number());
+      bool is_constant_mov =
+          instr->instr_kind() == ir::InstrKind::kMov &&
+          static_cast<ir::MovInstr*>(instr)->origin()->kind() == ir::Value::Kind::kConstant;
+      if (value.is_constant() && !is_constant_mov) {
+        *it = std::make_unique<ir::MovInstr>(computation->result(), value.constant());
+      }
+    }
+    ++it;
+  }
+  auto insertion_point = std::find_if(instrs.begin(), instrs.end(), [](auto& instr) {
+    return instr->instr_kind() != ir::InstrKind::kPhi;
+  });
+  instrs.insert(insertion_point, std::make_move_iterator(phi_replacements.begin()),
+                std::make_move_iterator(phi_replacements.end()));
+}
+
+}  // namespace
+
+void PropagateConstantsInProgram(ir::Program* program) {
+  for (auto& func : program->funcs()) {
+    PropagateConstantsInFunc(func.get());
+  }
+}
+
+void PropagateConstantsInFunc(ir::Func* func) { ConstantPropagation(func).Run(); }
+
+}  // namespace ir_optimizers
@@ -0,0 +1,25 @@
+//
+//  constant_propagation_optimizer.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_optimizers_constant_propagation_optimizer_h
+#define ir_optimizers_constant_propagation_optimizer_h
+
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/program.h"
+
+namespace ir_optimizers {
+
+// Performs sparse conditional constant propagation (Wegman and Zadeck): computations with constant
+// results get replaced by movs of the constant, conditional jumps with known conditions become
+// unconditional jumps and blocks that can never execute get removed.
+void PropagateConstantsInProgram(ir::Program* program);
+void PropagateConstantsInFunc(ir::Func* func);
+
+}  // namespace ir_optimizers
+
+#endif /* ir_optimizers_constant_propagation_optimizer_h */
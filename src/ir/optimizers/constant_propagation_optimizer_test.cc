@@ -0,0 +1,197 @@
+//
+//  constant_propagation_optimizer_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/optimizers/constant_propagation_optimizer.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/ir/check/check_test_util.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+#include "src/ir/serialization/print.h"
+
+namespace ir_optimizers {
+namespace {
+
+struct ConstantPropagationTestParams {
+  std::string input_program;
+  std::string expected_program;
+};
+
+class ConstantPropagationTest : public testing::TestWithParam<ConstantPropagationTestParams> {};
+
+INSTANTIATE_TEST_SUITE_P(ConstantPropagationTestInstance, ConstantPropagationTest,
+                         testing::Values(
+                             // Folds computations with constant operands.
+                             ConstantPropagationTestParams{
+                                 .input_program = R"ir(
+@0 f(%0:i64) => (i64, b) {
+{0}
+  %1:i64 = iadd #2:i64, #3:i64
+  %2:i64 = ishl %1, #2:i64
+  %3:i64 = iadd %2, %0
+  %4:b = ilss %1, %2
+  ret %3, %4
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f(%0:i64) => (i64, b) {
+{0}
+  %1:i64 = mov #5:i64
+  %2:i64 = mov #20:i64
+  %3:i64 = iadd %2, %0
+  %4:b = mov #t
+  ret %3, %4
+}
+)ir",
+                             },
+                             // Leaves division by zero and oversized shifts to run time.
+                             ConstantPropagationTestParams{
+                                 .input_program = R"ir(
+@0 f() => (i64, i64) {
+{0}
+  %0:i64 = idiv #1:i64, #0:i64
+  %1:i64 = ishl #1:i64, #64:i64
+  ret %0, %1
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f() => (i64, i64) {
+{0}
+  %0:i64 = idiv #1:i64, #0:i64
+  %1:i64 = ishl #1:i64, #64:i64
+  ret %0, %1
+}
+)ir",
+                             },
+                             // Removes the branch that can not be taken.
+                             ConstantPropagationTestParams{
+                                 .input_program = R"ir(
+@0 f(%0:i64) => (i64) {
+{0}
+  %1:b = ilss #1:i64, #2:i64
+  jcc %1, {1}, {2}
+{1}
+  %2:i64 = iadd %0, #1:i64
+  jmp {3}
+{2}
+  %3:i64 = isub %0, #1:i64
+  jmp {3}
+{3}
+  %4:i64 = phi %2{1}, %3{2}
+  ret %4
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f(%0:i64) => (i64) {
+{0}
+  %1:b = mov #t
+  jmp {1}
+{1}
+  %2:i64 = iadd %0, #1:i64
+  jmp {3}
+{3}
+  %4:i64 = mov %2
+  ret %4
+}
+)ir",
+                             },
+                             // Propagates constants through loops while they stay constant.
+                             ConstantPropagationTestParams{
+                                 .input_program = R"ir(
+@0 f(%0:b) => (i64) {
+{0}
+  jmp {1}
+{1}
+  %1:i64 = phi #7:i64{0}, %2{2}
+  %3:i64 = phi #0:i64{0}, %4{2}
+  jcc %0, {2}, {3}
+{2}
+  %2:i64 = imul %1, #1:i64
+  %4:i64 = iadd %3, #1:i64
+  jmp {1}
+{3}
+  %5:i64 = iadd %1, %3
+  ret %5
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f(%0:b) => (i64) {
+{0}
+  jmp {1}
+{1}
+  %3:i64 = phi #0:i64{0}, %4{2}
+  %1:i64 = mov #7:i64
+  jcc %0, {2}, {3}
+{2}
+  %2:i64 = mov #7:i64
+  %4:i64 = iadd %3, #1:i64
+  jmp {1}
+{3}
+  %5:i64 = iadd %1, %3
+  ret %5
+}
+)ir",
+                             },
+                             // Ignores values flowing in from branches that can not be taken.
+                             ConstantPropagationTestParams{
+                                 .input_program = R"ir(
+@0 f() => (i8) {
+{0}
+  %0:i64 = mov #0:i64
+  jmp {1}
+{1}
+  %1:i64 = phi %0{0}, %3{2}
+  %2:b = ilss %1, #0:i64
+  jcc %2, {2}, {3}
+{2}
+  %3:i64 = iadd %1, #1:i64
+  jmp {1}
+{3}
+  %4:i8 = conv %1
+  ret %4
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f() => (i8) {
+{0}
+  %0:i64 = mov #0:i64
+  jmp {1}
+{1}
+  %1:i64 = mov #0:i64
+  %2:b = mov #f
+  jmp {3}
+{3}
+  %4:i8 = mov #0:i8
+  ret %4
+}
+)ir",
+                             }));
+
+TEST_P(ConstantPropagationTest, PropagatesConstants) {
+  std::unique_ptr<ir::Program> input_program =
+      ir_serialization::ParseProgramOrDie(GetParam().input_program);
+  std::unique_ptr<ir::Program> expected_program =
+      ir_serialization::ParseProgramOrDie(GetParam().expected_program);
+  ir_check::CheckProgramOrDie(input_program.get());
+  ir_check::CheckProgramOrDie(expected_program.get());
+
+  PropagateConstantsInProgram(input_program.get());
+
+  ir_check::CheckProgramOrDie(input_program.get());
+  EXPECT_TRUE(ir::IsEqual(input_program.get(), expected_program.get()))
+      << "Expected program:\n"
+      << ir_serialization::PrintProgram(expected_program.get()) << "\ngot:\n"
+      << ir_serialization::PrintProgram(input_program.get());
+}
+
+}  // namespace
+}  // namespace ir_optimizers
@@ -0,0 +1,455 @@
+//
+//  inlining_optimizer.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "inlining_optimizer.h"
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "src/common/logging/logging.h"
+#include "src/ir/analyzers/func_call_graph_builder.h"
+#include "src/ir/info/func_call_graph.h"
+#include "src/ir/processors/func_cloner.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/instrs.h"
+#include "src/ir/representation/num_types.h"
+#include "src/ir/representation/values.h"
+
+namespace ir_optimizers {
+namespace {
+
+using ::common::logging::fail;
+
+// Callees costing at most this much get inlined.
+constexpr int64_t kMaxInlinedFuncCost = 12;
+// Callers stop growing through inlining once they reach this cost.
+constexpr int64_t kMaxCallerCost = 1000;
+
+// Estimates the size of the code generated for the function. Phis and jumps mostly disappear
+// during code generation and do not count.
+int64_t CostOfFunc(const ir::Func* func) {
+  int64_t cost = 0;
+  for (auto& block : func->blocks()) {
+    for (auto& instr : block->instrs()) {
+      if (instr->instr_kind() != ir::InstrKind::kPhi &&
+          instr->instr_kind() != ir::InstrKind::kJump) {
+        cost++;
+      }
+    }
+  }
+  return cost;
+}
+
+bool CanInlineFunc(const ir::Func* callee) {
+  ir::Block* entry_block = callee->entry_block();
+  if (entry_block == nullptr || !entry_block->parents().empty()) {
+    return false;
+  }
+  bool has_return = false;
+  for (auto& block : callee->blocks()) {
+    for (auto& instr : block->instrs()) {
+      if (!ir_processors::CanCloneInstr(instr.get())) {
+        return false;
+      }
+      has_return |= instr->instr_kind() == ir::InstrKind::kReturn;
+    }
+  }
+  return has_return;
+}
+
+bool IsRecursive(const ir_info::FuncCallGraph& fcg, const ir_info::Component* component) {
+  if (component->members().size() > 1) {
+    return true;
+  }
+  ir::func_num_t func_num = *component->members().begin();
+  return fcg.CalleesOfFunc(func_num).contains(func_num);
+}
+
+void AddComponentsInBottomUpOrder(ir_info::Component* component,
+                                  std::unordered_set<ir_info::Component*>& visited,
+                                  std::vector<ir_info::Component*>& order) {
+  if (!visited.insert(component).second) {
+    return;
+  }
+  for (ir_info::Component* callee : component->callees()) {
+    AddComponentsInBottomUpOrder(callee, visited, order);
+  }
+  order.push_back(component);
+}
+
+// Returns the components of the call graph such that each component comes after all components it
+// calls.
+std::vector<ir_info::Component*> ComponentsInBottomUpOrder(const ir::Program* program,
+                                                           const ir_info::FuncCallGraph& fcg) {
+  std::unordered_set<ir_info::Component*> visited;
+  std::vector<ir_info::Component*> order;
+  for (auto& func : program->funcs()) {
+    AddComponentsInBottomUpOrder(fcg.ComponentOfFunc(func->number()), visited, order);
+  }
+  return order;
+}
+
+void ReplacePhiOrigins(ir::Block* block, ir::block_num_t old_origin, ir::block_num_t new_origin) {
+  block->ForEachPhiInstr([=](ir::PhiInstr* phi_instr) {
+    for (auto& arg : phi_instr->args()) {
+      if (arg->origin() == old_origin) {
+        arg = std::make_shared<ir::InheritedValue>(arg->value(), new_origin);
+      }
+    }
+  });
+}
+
+// Maps values and blocks of the callee to their clones in the caller.
+class CalleeClone {
+ public:
+  explicit CalleeClone(ir::Func* caller) : caller_(caller) {}
+
+  void AddValue(const ir::Computed* callee_value, std::shared_ptr<ir::Computed> caller_value) {
+    values_.insert({callee_value->number(), caller_value});
+  }
+  void AddBlock(ir::block_num_t callee_block, ir::block_num_t caller_block) {
+    blocks_.insert({callee_block, caller_block});
+  }
+
+  std::shared_ptr<ir::Computed> NewValueFor(const ir::Computed* callee_value);
+
+  std::shared_ptr<ir::Computed> MapComputed(const std::shared_ptr<ir::Computed>& value) const {
+    return values_.at(value->number());
+  }
+  std::shared_ptr<ir::Value> MapValue(const std::shared_ptr<ir::Value>& value) const;
+  ir::block_num_t MapBlock(ir::block_num_t bnum) const { return blocks_.at(bnum); }
+
+  std::unique_ptr<ir::Instr> CloneInstr(const ir::Instr* instr) const;
+
+ private:
+  std::vector<std::shared_ptr<ir::Value>> MapValues(
+      const std::vector<std::shared_ptr<ir::Value>>& values) const;
+  std::vector<std::shared_ptr<ir::Computed>> MapComputeds(
+      const std::vector<std::shared_ptr<ir::Computed>>& values) const;
+
+  ir::Func* caller_;
+  std::unordered_map<ir::value_num_t, std::shared_ptr<ir::Computed>> values_;
+  std::unordered_map<ir::block_num_t, ir::block_num_t> blocks_;
+};
+
+std::shared_ptr<ir::Computed> CalleeClone::NewValueFor(const ir::Computed* callee_value) {
+  auto caller_value =
+      std::make_shared<ir::Computed>(callee_value->type(), caller_->next_computed_number());
+  AddValue(callee_value, caller_value);
+  return caller_value;
+}
+
+std::shared_ptr<ir::Value> CalleeClone::MapValue(const std::shared_ptr<ir::Value>& value) const {
+  if (value->kind() == ir::Value::Kind::kComputed) {
+    return values_.at(static_cast<ir::Computed*>(value.get())->number());
+  }
+  return value;
+}
+
+std::vector<std::shared_ptr<ir::Value>> CalleeClone::MapValues(
+    const std::vector<std::shared_ptr<ir::Value>>& values) const {
+  std::vector<std::shared_ptr<ir::Value>> mapped_values;
+  mapped_values.reserve(values.size());
+  for (auto& value : values) {
+    mapped_values.push_back(MapValue(value));
+  }
+  return mapped_values;
+}
+
+std::vector<std::shared_ptr<ir::Computed>> CalleeClone::MapComputeds(
+    const std::vector<std::shared_ptr<ir::Computed>>& values) const {
+  std::vector<std::shared_ptr<ir::Computed>> mapped_values;
+  mapped_values.reserve(values.size());
+  for (auto& value : values) {
+    mapped_values.push_back(MapComputed(value));
+  }
+  return mapped_values;
+}
+
+std::unique_ptr<ir::Instr> CalleeClone::CloneInstr(const ir::Instr* instr) const {
+  switch (instr->instr_kind()) {
+    case ir::InstrKind::kMov: {
+      auto mov_instr = static_cast<const ir::MovInstr*>(instr);
+      return std::make_unique<ir::MovInstr>(MapComputed(mov_instr->result()),
+                                            MapValue(mov_instr->origin()));
+    }
+    case ir::InstrKind::kPhi: {
+      auto phi_instr = static_cast<const ir::PhiInstr*>(instr);
+      std::vector<std::shared_ptr<ir::InheritedValue>> args;
+      for (auto& arg : phi_instr->args()) {
+        args.push_back(
+            std::make_shared<ir::InheritedValue>(MapValue(arg->value()), MapBlock(arg->origin())));
+      }
+      return std::make_unique<ir::PhiInstr>(MapComputed(phi_instr->result()), args);
+    }
+    case ir::InstrKind::kConversion: {
+      auto conversion = static_cast<const ir::Conversion*>(instr);
+      return std::make_unique<ir::Conversion>(MapComputed(conversion->result()),
+                                              MapValue(conversion->operand()));
+    }
+    case ir::InstrKind::kBoolNot: {
+      auto not_instr = static_cast<const ir::BoolNotInstr*>(instr);
+      return std::make_unique<ir::BoolNotInstr>(MapComputed(not_instr->result()),
+                                                MapValue(not_instr->operand()));
+    }
+    case ir::InstrKind::kBoolBinary: {
+      auto binary_instr = static_cast<const ir::BoolBinaryInstr*>(instr);
+      return std::make_unique<ir::BoolBinaryInstr>(
+          MapComputed(binary_instr->result()), binary_instr->operation(),
+          MapValue(binary_instr->operand_a()), MapValue(binary_instr->operand_b()));
+    }
+    case ir::InstrKind::kIntUnary: {
+      auto unary_instr = static_cast<const ir::IntUnaryInstr*>(instr);
+      return std::make_unique<ir::IntUnaryInstr>(MapComputed(unary_instr->result()),
+                                                 unary_instr->operation(),
+                                                 MapValue(unary_instr->operand()));
+    }
+    case ir::InstrKind::kIntCompare: {
+      auto compare_instr = static_cast<const ir::IntCompareInstr*>(instr);
+      return std::make_unique<ir::IntCompareInstr>(
+          MapComputed(compare_instr->result()), compare_instr->operation(),
+          MapValue(compare_instr->operand_a()), MapValue(compare_instr->operand_b()));
+    }
+    case ir::InstrKind::kIntBinary: {
+      auto binary_instr = static_cast<const ir::IntBinaryInstr*>(instr);
+      return std::make_unique<ir::IntBinaryInstr>(
+          MapComputed(binary_instr->result()), binary_instr->operation(),
+          MapValue(binary_instr->operand_a()), MapValue(binary_instr->operand_b()));
+    }
+    case ir::InstrKind::kIntShift: {
+      auto shift_instr = static_cast<const ir::IntShiftInstr*>(instr);
+      return std::make_unique<ir::IntShiftInstr>(
+          MapComputed(shift_instr->result()), shift_instr->operation(),
+          MapValue(shift_instr->shifted()), MapValue(shift_instr->offset()));
+    }
+    case ir::InstrKind::kPointerOffset: {
+      auto pointer_offset_instr = static_cast<const ir::PointerOffsetInstr*>(instr);
+      return std::make_unique<ir::PointerOffsetInstr>(
+          MapComputed(pointer_offset_instr->result()),
+          MapComputed(pointer_offset_instr->pointer()),
+          MapValue(pointer_offset_instr->offset()));
+    }
+    case ir::InstrKind::kNilTest: {
+      auto nil_test_instr = static_cast<const ir::NilTestInstr*>(instr);
+      return std::make_unique<ir::NilTestInstr>(MapComputed(nil_test_instr->result()),
+                                                MapValue(nil_test_instr->tested()));
+    }
+    case ir::InstrKind::kMalloc: {
+      auto malloc_instr = static_cast<const ir::MallocInstr*>(instr);
+      return std::make_unique<ir::MallocInstr>(MapComputed(malloc_instr->result()),
+                                               MapValue(malloc_instr->size()));
+    }
+    case ir::InstrKind::kLoad: {
+      auto load_instr = static_cast<const ir::LoadInstr*>(instr);
+      return std::make_unique<ir::LoadInstr>(MapComputed(load_instr->result()),
+                                             MapValue(load_instr->address()));
+    }
+    case ir::InstrKind::kStore: {
+      auto store_instr = static_cast<const ir::StoreInstr*>(instr);
+      return std::make_unique<ir::StoreInstr>(MapValue(store_instr->address()),
+                                              MapValue(store_instr->value()));
+    }
+    case ir::InstrKind::kFree: {
+      auto free_instr = static_cast<const ir::FreeInstr*>(instr);
+      return std::make_unique<ir::FreeInstr>(MapValue(free_instr->address()));
+    }
+    case ir::InstrKind::kJump: {
+      auto jump_instr = static_cast<const ir::JumpInstr*>(instr);
+      return std::make_unique<ir::JumpInstr>(MapBlock(jump_instr->destination()));
+    }
+    case ir::InstrKind::kJumpCond: {
+      auto jump_cond_instr = static_cast<const ir::JumpCondInstr*>(instr);
+      return std::make_unique<ir::JumpCondInstr>(MapValue(jump_cond_instr->condition()),
+                                                 MapBlock(jump_cond_instr->destination_true()),
+                                                 MapBlock(jump_cond_instr->destination_false()));
+    }
+    case ir::InstrKind::kSyscall: {
+      auto syscall_instr = static_cast<const ir::SyscallInstr*>(instr);
+      return std::make_unique<ir::SyscallInstr>(MapComputed(syscall_instr->result()),
+                                                MapValue(syscall_instr->syscall_num()),
+                                                MapValues(syscall_instr->args()));
+    }
+    case ir::InstrKind::kCall: {
+      auto call_instr = static_cast<const ir::CallInstr*>(instr);
+      return std::make_unique<ir::CallInstr>(MapValue(call_instr->func()),
+                                             MapComputeds(call_instr->results()),
+                                             MapValues(call_instr->args()));
+    }
+    default:
+      fail("unexpected instr in inlined func");
+  }
+}
+
+// Replaces the call instr at the given index of the block with the blocks of the callee.
+void InlineFuncCall(ir::Func* caller, ir::Block* call_block, std::size_t call_index,
+                    const ir::Func* callee) {
+  auto& call_block_instrs = call_block->instrs();
+  auto call_instr = static_cast<ir::CallInstr*>(call_block_instrs.at(call_index).get());
+  std::vector<std::shared_ptr<ir::Computed>> results = call_instr->results();
+  std::vector<std::shared_ptr<ir::Value>> args = call_instr->args();
+
+  // Move all instrs after the call and all outgoing control flow to a continuation block.
+  ir::Block* continuation_block = caller->AddBlock();
+  continuation_block->instrs().insert(
+      continuation_block->instrs().end(),
+      std::make_move_iterator(call_block_instrs.begin() + call_index + 1),
+      std::make_move_iterator(call_block_instrs.end()));
+  call_block_instrs.erase(call_block_instrs.begin() + call_index, call_block_instrs.end());
+  std::unordered_set<ir::block_num_t> children = call_block->children();
+  for (ir::block_num_t child_num : children) {
+    caller->RemoveControlFlow(call_block->number(), child_num);
+    caller->AddControlFlow(continuation_block->number(), child_num);
+    ReplacePhiOrigins(caller->GetBlock(child_num), call_block->number(),
+                      continuation_block->number());
+  }
+
+  // Callee args become movs of the call args, since the call args can be constants but some instrs
+  // require computed operands.
+  CalleeClone clone(caller);
+  for (std::size_t i = 0; i < args.size(); i++) {
+    std::shared_ptr<ir::Computed> arg = clone.NewValueFor(callee->args().at(i).get());
+    call_block_instrs.push_back(std::make_unique<ir::MovInstr>(arg, args.at(i)));
+  }
+  for (auto& callee_block : callee->blocks()) {
+    for (auto& instr : callee_block->instrs()) {
+      for (auto& defined_value : instr->DefinedValues()) {
+        clone.NewValueFor(defined_value.get());
+      }
+    }
+  }
+  for (auto& callee_block : callee->blocks()) {
+    clone.AddBlock(callee_block->number(), caller->AddBlock()->number());
+  }
+
+  std::vector<ir::block_num_t> return_blocks;
+  std::vector<std::vector<std::shared_ptr<ir::Value>>> return_values;
+  for (auto& callee_block : callee->blocks()) {
+    ir::Block* block = caller->GetBlock(clone.MapBlock(callee_block->number()));
+    for (auto& instr : callee_block->instrs()) {
+      if (instr->instr_kind() != ir::InstrKind::kReturn) {
+        block->instrs().push_back(clone.CloneInstr(instr.get()));
+        continue;
+      }
+      std::vector<std::shared_ptr<ir::Value>> values;
+      for (auto& value : static_cast<ir::ReturnInstr*>(instr.get())->args()) {
+        values.push_back(clone.MapValue(value));
+      }
+      return_blocks.push_back(block->number());
+      return_values.push_back(values);
+      block->instrs().push_back(std::make_unique<ir::JumpInstr>(continuation_block->number()));
+      caller->AddControlFlow(block->number(), continuation_block->number());
+    }
+    for (ir::block_num_t child_num : callee_block->children()) {
+      caller->AddControlFlow(block->number(), clone.MapBlock(child_num));
+    }
+  }
+
+  ir::block_num_t inlined_entry_block_num = clone.MapBlock(callee->entry_block_num());
+  call_block_instrs.push_back(std::make_unique<ir::JumpInstr>(inlined_entry_block_num));
+  caller->AddControlFlow(call_block->number(), inlined_entry_block_num);
+
+  if (return_blocks.size() == 1) {
+    auto& return_block_instrs = caller->GetBlock(return_blocks.front())->instrs();
+    for (std::size_t i = 0; i < results.size(); i++) {
+      return_block_instrs.insert(
+          return_block_instrs.end() - 1,
+          std::make_unique<ir::MovInstr>(results.at(i), return_values.front().at(i)));
+    }
+  } else {
+    auto& continuation_instrs = continuation_block->instrs();
+    for (std::size_t i = 0; i < results.size(); i++) {
+      std::vector<std::shared_ptr<ir::InheritedValue>> phi_args;
+      for (std::size_t j = 0; j < return_blocks.size(); j++) {
+        phi_args.push_back(
+            std::make_shared<ir::InheritedValue>(return_values.at(j).at(i), return_blocks.at(j)));
+      }
+      continuation_instrs.insert(continuation_instrs.begin() + i,
+                                 std::make_unique<ir::PhiInstr>(results.at(i), phi_args));
+    }
+  }
+}
+
+class Inliner {
+ public:
+  explicit Inliner(ir::Program* program)
+      : program_(program), fcg_(ir_analyzers::BuildFuncCallGraphForProgram(program)) {}
+
+  void Run();
+
+ private:
+  void InlineFuncCallsInFunc(ir::Func* caller);
+  const ir::Func* InlinableCalleeOf(const ir::Func* caller, const ir::CallInstr* call_instr) const;
+
+  ir::Program* program_;
+  const ir_info::FuncCallGraph fcg_;
+  std::unordered_map<ir::func_num_t, bool> can_inline_;
+};
+
+void Inliner::Run() {
+  for (ir_info::Component* component : ComponentsInBottomUpOrder(program_, fcg_)) {
+    for (ir::func_num_t func_num : component->members()) {
+      InlineFuncCallsInFunc(program_->GetFunc(func_num));
+    }
+    // Callees are final once all their callers are being visited.
+    bool is_recursive = IsRecursive(fcg_, component);
+    for (ir::func_num_t func_num : component->members()) {
+      can_inline_[func_num] = !is_recursive && CanInlineFunc(program_->GetFunc(func_num)) &&
+                              CostOfFunc(program_->GetFunc(func_num)) <= kMaxInlinedFuncCost;
+    }
+  }
+}
+
+void Inliner::InlineFuncCallsInFunc(ir::Func* caller) {
+  int64_t caller_cost = CostOfFunc(caller);
+  // Inlining appends blocks to the caller, which get visited as well. This includes the
+  // continuation blocks holding the instrs following inlined calls.
+  for (std::size_t block_index = 0; block_index < caller->blocks().size(); block_index++) {
+    ir::Block* block = caller->blocks().at(block_index).get();
+    for (std::size_t instr_index = 0; instr_index < block->instrs().size(); instr_index++) {
+      ir::Instr* instr = block->instrs().at(instr_index).get();
+      if (instr->instr_kind() != ir::InstrKind::kCall || caller_cost >= kMaxCallerCost) {
+        continue;
+      }
+      const ir::Func* callee = InlinableCalleeOf(caller, static_cast<ir::CallInstr*>(instr));
+      if (callee == nullptr) {
+        continue;
+      }
+      caller_cost += CostOfFunc(callee);
+      InlineFuncCall(caller, block, instr_index, callee);
+      break;
+    }
+  }
+}
+
+const ir::Func* Inliner::InlinableCalleeOf(const ir::Func* caller,
+                                           const ir::CallInstr* call_instr) const {
+  if (call_instr->func()->kind() != ir::Value::Kind::kConstant) {
+    return nullptr;
+  }
+  ir::func_num_t callee_num = static_cast<ir::FuncConstant*>(call_instr->func().get())->value();
+  auto it = can_inline_.find(callee_num);
+  if (callee_num == caller->number() || it == can_inline_.end() || !it->second) {
+    return nullptr;
+  }
+  const ir::Func* callee = program_->GetFunc(callee_num);
+  if (callee->args().size() != call_instr->args().size() ||
+      callee->result_types().size() != call_instr->results().size()) {
+    return nullptr;
+  }
+  return callee;
+}
+
+}  // namespace
+
+void InlineFuncCallsInProgram(ir::Program* program) { Inliner(program).Run(); }
+
+}  // namespace ir_optimizers
@@ -0,0 +1,25 @@
+//
+//  inlining_optimizer.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_optimizers_inlining_optimizer_h
+#define ir_optimizers_inlining_optimizer_h
+
+#include "src/ir/representation/program.h"
+
+namespace ir_optimizers {
+
+// Inlines static calls to small functions. Functions get visited bottom-up over the components of
+// the call graph, such that callees are final before they get inlined. Callees in recursive
+// components never get inlined. The calling block gets split at the call, the callee blocks get
+// cloned with fresh block and value numbers, and returns become jumps to the continuation block,
+// which receives the results through phis (or movs if there is a single return).
+void InlineFuncCallsInProgram(ir::Program* program);
+
+}  // namespace ir_optimizers
+
+#endif /* ir_optimizers_inlining_optimizer_h */
@@ -0,0 +1,250 @@
+//
+//  inlining_optimizer_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/optimizers/inlining_optimizer.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/ir/check/check_test_util.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+#include "src/ir/serialization/print.h"
+
+namespace ir_optimizers {
+namespace {
+
+struct InliningTestParams {
+  std::string input_program;
+  std::string expected_program;
+};
+
+class InliningTest : public testing::TestWithParam<InliningTestParams> {};
+
+INSTANTIATE_TEST_SUITE_P(InliningTestInstance, InliningTest,
+                         testing::Values(
+                             // Inlines small functions with a single return.
+                             InliningTestParams{
+                                 .input_program = R"ir(
+@0 main(%0:ptr, %1:ptr) => (ptr) {
+{0}
+  %2:ptr = call @1, %0, %1, #8:i64
+  ret %2
+}
+
+@1 strong_copy_shared(%0:ptr, %1:ptr, %2:i64) => (ptr) {
+{0}
+  %3:i64 = load %0
+  %4:i64 = iadd %3, #1:i64
+  store %0, %4
+  %5:ptr = poff %1, %2
+  ret %5
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 main(%0:ptr, %1:ptr) => (ptr) {
+{0}
+  %3:ptr = mov %0
+  %4:ptr = mov %1
+  %5:i64 = mov #8:i64
+  jmp {2}
+{1}
+  ret %2:ptr
+{2}
+  %6:i64 = load %3
+  %7:i64 = iadd %6, #1:i64
+  store %3, %7
+  %8:ptr = poff %4, %5
+  %2:ptr = mov %8
+  jmp {1}
+}
+
+@1 strong_copy_shared(%0:ptr, %1:ptr, %2:i64) => (ptr) {
+{0}
+  %3:i64 = load %0
+  %4:i64 = iadd %3, #1:i64
+  store %0, %4
+  %5:ptr = poff %1, %2
+  ret %5
+}
+)ir",
+                             },
+                             // Merges results of multiple returns with phis.
+                             InliningTestParams{
+                                 .input_program = R"ir(
+@0 main(%0:i64) => (i64) {
+{0}
+  %1:i64 = call @1, %0
+  %2:i64 = iadd %1, #1:i64
+  ret %2
+}
+
+@1 abs(%0:i64) => (i64) {
+{0}
+  %1:b = ilss %0, #0:i64
+  jcc %1, {1}, {2}
+{1}
+  %2:i64 = ineg %0
+  ret %2
+{2}
+  ret %0
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 main(%0:i64) => (i64) {
+{0}
+  %3:i64 = mov %0
+  jmp {2}
+{1}
+  %1:i64 = phi %5:i64{3}, %3{4}
+  %2:i64 = iadd %1, #1:i64
+  ret %2
+{2}
+  %4:b = ilss %3, #0:i64
+  jcc %4, {3}, {4}
+{3}
+  %5:i64 = ineg %3
+  jmp {1}
+{4}
+  jmp {1}
+}
+
+@1 abs(%0:i64) => (i64) {
+{0}
+  %1:b = ilss %0, #0:i64
+  jcc %1, {1}, {2}
+{1}
+  %2:i64 = ineg %0
+  ret %2
+{2}
+  ret %0
+}
+)ir",
+                             },
+                             // Inlines bottom-up, such that inlined functions already had their callees inlined.
+                             InliningTestParams{
+                                 .input_program = R"ir(
+@0 main(%0:i64) => (i64) {
+{0}
+  %1:i64 = call @1, %0
+  ret %1
+}
+
+@1 f(%0:i64) => (i64) {
+{0}
+  %1:i64 = call @2, %0
+  ret %1
+}
+
+@2 g(%0:i64) => (i64) {
+{0}
+  %1:i64 = imul %0, #2:i64
+  ret %1
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 main(%0:i64) => (i64) {
+{0}
+  %2:i64 = mov %0
+  jmp {2}
+{1}
+  ret %1:i64
+{2}
+  %3:i64 = mov %2
+  jmp {4}
+{3}
+  %1:i64 = mov %5:i64
+  jmp {1}
+{4}
+  %4:i64 = imul %3, #2:i64
+  %5:i64 = mov %4
+  jmp {3}
+}
+
+@1 f(%0:i64) => (i64) {
+{0}
+  %2:i64 = mov %0
+  jmp {2}
+{1}
+  ret %1:i64
+{2}
+  %3:i64 = imul %2, #2:i64
+  %1:i64 = mov %3
+  jmp {1}
+}
+
+@2 g(%0:i64) => (i64) {
+{0}
+  %1:i64 = imul %0, #2:i64
+  ret %1
+}
+)ir",
+                             },
+                             // Does not inline recursive functions.
+                             InliningTestParams{
+                                 .input_program = R"ir(
+@0 main(%0:i64) => (i64) {
+{0}
+  %1:i64 = call @1, %0
+  ret %1
+}
+
+@1 f(%0:i64) => (i64) {
+{0}
+  %1:b = ieq %0, #0:i64
+  jcc %1, {1}, {2}
+{1}
+  ret #0:i64
+{2}
+  %2:i64 = isub %0, #1:i64
+  %3:i64 = call @1, %2
+  ret %3
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 main(%0:i64) => (i64) {
+{0}
+  %1:i64 = call @1, %0
+  ret %1
+}
+
+@1 f(%0:i64) => (i64) {
+{0}
+  %1:b = ieq %0, #0:i64
+  jcc %1, {1}, {2}
+{1}
+  ret #0:i64
+{2}
+  %2:i64 = isub %0, #1:i64
+  %3:i64 = call @1, %2
+  ret %3
+}
+)ir",
+                             }));
+
+TEST_P(InliningTest, InlinesFuncCalls) {
+  std::unique_ptr<ir::Program> input_program =
+      ir_serialization::ParseProgramOrDie(GetParam().input_program);
+  std::unique_ptr<ir::Program> expected_program =
+      ir_serialization::ParseProgramOrDie(GetParam().expected_program);
+  ir_check::CheckProgramOrDie(input_program.get());
+  ir_check::CheckProgramOrDie(expected_program.get());
+
+  InlineFuncCallsInProgram(input_program.get());
+
+  ir_check::CheckProgramOrDie(input_program.get());
+  EXPECT_TRUE(ir::IsEqual(input_program.get(), expected_program.get()))
+      << "Expected program:\n"
+      << ir_serialization::PrintProgram(expected_program.get()) << "\ngot:\n"
+      << ir_serialization::PrintProgram(input_program.get());
+}
+
+}  // namespace
+}  // namespace ir_optimizers
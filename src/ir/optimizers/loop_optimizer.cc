@@ -0,0 +1,408 @@
+//
+//  loop_optimizer.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "loop_optimizer.h"
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "src/common/atomics/atomics.h"
+#include "src/ir/info/dominator_tree.h"
+#include "src/ir/info/loop_nest.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/instrs.h"
+#include "src/ir/representation/num_types.h"
+#include "src/ir/representation/values.h"
+
+namespace ir_optimizers {
+namespace {
+
+using ::common::atomics::Int;
+
+void ReplacePhiOrigins(ir::Block* block, ir::block_num_t old_origin, ir::block_num_t new_origin) {
+  block->ForEachPhiInstr([=](ir::PhiInstr* phi_instr) {
+    for (auto& arg : phi_instr->args()) {
+      if (arg->origin() == old_origin) {
+        arg = std::make_shared<ir::InheritedValue>(arg->value(), new_origin);
+      }
+    }
+  });
+}
+
+void InsertBeforeControlFlowInstr(ir::Block* block, std::unique_ptr<ir::Instr> instr) {
+  block->instrs().insert(block->instrs().end() - 1, std::move(instr));
+}
+
+// Returns the only block outside the loop that jumps to the loop header, or kNoBlockNum if there
+// are several.
+ir::block_num_t FindLoopEntry(const ir::Func* func, const ir_info::Loop* loop) {
+  ir::block_num_t entry = ir::kNoBlockNum;
+  for (ir::block_num_t parent : func->GetBlock(loop->header())->parents()) {
+    if (loop->Contains(parent)) {
+      continue;
+    } else if (entry != ir::kNoBlockNum) {
+      return ir::kNoBlockNum;
+    }
+    entry = parent;
+  }
+  return entry;
+}
+
+// Returns the loop entry if the loop header is its only child, or kNoBlockNum otherwise.
+ir::block_num_t FindPreheader(const ir::Func* func, const ir_info::Loop* loop) {
+  ir::block_num_t entry = FindLoopEntry(func, loop);
+  if (entry == ir::kNoBlockNum || func->GetBlock(entry)->children().size() != 1) {
+    return ir::kNoBlockNum;
+  }
+  return entry;
+}
+
+// Inserts a preheader for each loop whose single entry block also jumps elsewhere. Returns if the
+// control flow graph changed.
+bool InsertPreheaders(ir::Func* func, const ir_info::LoopNest& loop_nest) {
+  bool inserted_preheader = false;
+  for (auto& loop : loop_nest.loops()) {
+    ir::block_num_t entry_num = FindLoopEntry(func, loop.get());
+    if (entry_num == ir::kNoBlockNum || func->GetBlock(entry_num)->children().size() == 1) {
+      continue;
+    }
+    ir::block_num_t header_num = loop->header();
+    ir::Block* preheader = func->AddBlock();
+    preheader->instrs().push_back(std::make_unique<ir::JumpInstr>(header_num));
+
+    // Blocks with multiple children end with a conditional jump.
+    auto jump_cond_instr =
+        static_cast<ir::JumpCondInstr*>(func->GetBlock(entry_num)->ControlFlowInstr());
+    if (jump_cond_instr->destination_true() == header_num) {
+      jump_cond_instr->set_destination_true(preheader->number());
+    }
+    if (jump_cond_instr->destination_false() == header_num) {
+      jump_cond_instr->set_destination_false(preheader->number());
+    }
+    func->RemoveControlFlow(entry_num, header_num);
+    func->AddControlFlow(entry_num, preheader->number());
+    func->AddControlFlow(preheader->number(), header_num);
+    ReplacePhiOrigins(func->GetBlock(header_num), entry_num, preheader->number());
+    inserted_preheader = true;
+  }
+  return inserted_preheader;
+}
+
+// A header phi that gets incremented by a loop-invariant step on the only back edge.
+struct InductionVariable {
+  std::shared_ptr<ir::Value> start;
+  std::shared_ptr<ir::Value> step;
+};
+
+class LoopOptimizer {
+ public:
+  LoopOptimizer(ir::Func* func, const ir_info::DominatorTree& dominator_tree,
+                const ir_info::LoopNest& loop_nest);
+
+  void Run();
+
+ private:
+  bool IsInvariant(const std::shared_ptr<ir::Value>& value, const ir_info::Loop* loop) const;
+  bool CanHoist(const ir::Instr* instr, const ir_info::Loop* loop) const;
+  void HoistInvariantComputations(const ir_info::Loop* loop, ir::Block* preheader);
+
+  std::unordered_map<ir::value_num_t, InductionVariable> FindInductionVariables(
+      const ir_info::Loop* loop, ir::Block* preheader) const;
+  void ReduceStrength(const ir_info::Loop* loop, ir::Block* preheader);
+  std::shared_ptr<ir::Value> Multiply(std::shared_ptr<ir::Value> a, std::shared_ptr<ir::Value> b,
+                                      ir::Block* block);
+
+  void SetDefinition(ir::value_num_t value_num, ir::Instr* instr, ir::block_num_t bnum);
+
+  ir::Func* func_;
+  const ir_info::DominatorTree& dominator_tree_;
+  const ir_info::LoopNest& loop_nest_;
+  std::vector<ir::Instr*> defining_instrs_;       // value_num_t -> Instr* or nullptr for args
+  std::vector<ir::block_num_t> defining_blocks_;  // value_num_t -> block_num_t
+};
+
+LoopOptimizer::LoopOptimizer(ir::Func* func, const ir_info::DominatorTree& dominator_tree,
+                             const ir_info::LoopNest& loop_nest)
+    : func_(func),
+      dominator_tree_(dominator_tree),
+      loop_nest_(loop_nest),
+      defining_instrs_(func->computed_count(), nullptr),
+      defining_blocks_(func->computed_count(), ir::kNoBlockNum) {
+  for (auto& block : func->blocks()) {
+    for (auto& instr : block->instrs()) {
+      for (auto& defined_value : instr->DefinedValues()) {
+        SetDefinition(defined_value->number(), instr.get(), block->number());
+      }
+    }
+  }
+}
+
+void LoopOptimizer::Run() {
+  // Inner loops come after the loops containing them. Optimizing them first allows hoisting
+  // computations out of multiple loops.
+  for (auto it = loop_nest_.loops().rbegin(); it != loop_nest_.loops().rend(); ++it) {
+    const ir_info::Loop* loop = it->get();
+    ir::block_num_t preheader_num = FindPreheader(func_, loop);
+    if (preheader_num == ir::kNoBlockNum) {
+      continue;
+    }
+    ir::Block* preheader = func_->GetBlock(preheader_num);
+    HoistInvariantComputations(loop, preheader);
+    ReduceStrength(loop, preheader);
+  }
+}
+
+bool LoopOptimizer::IsInvariant(const std::shared_ptr<ir::Value>& value,
+                                const ir_info::Loop* loop) const {
+  switch (value->kind()) {
+    case ir::Value::Kind::kConstant:
+      return true;
+    case ir::Value::Kind::kComputed:
+      return !loop->Contains(
+          defining_blocks_.at(static_cast<ir::Computed*>(value.get())->number()));
+    case ir::Value::Kind::kInherited:
+      return false;
+  }
+}
+
+bool LoopOptimizer::CanHoist(const ir::Instr* instr, const ir_info::Loop* loop) const {
+  switch (instr->instr_kind()) {
+    case ir::InstrKind::kMov:
+    case ir::InstrKind::kConversion:
+    case ir::InstrKind::kBoolNot:
+    case ir::InstrKind::kBoolBinary:
+    case ir::InstrKind::kIntUnary:
+    case ir::InstrKind::kIntCompare:
+    case ir::InstrKind::kIntShift:
+    case ir::InstrKind::kPointerOffset:
+    case ir::InstrKind::kNilTest:
+      break;
+    case ir::InstrKind::kIntBinary: {
+      // Hoisted computations execute even if the loop body does not, so they must not trap.
+      auto binary_instr = static_cast<const ir::IntBinaryInstr*>(instr);
+      if (binary_instr->operation() == Int::BinaryOp::kDiv ||
+          binary_instr->operation() == Int::BinaryOp::kRem) {
+        if (binary_instr->operand_b()->kind() != ir::Value::Kind::kConstant) {
+          return false;
+        }
+        Int divisor = static_cast<ir::IntConstant*>(binary_instr->operand_b().get())->value();
+        if (divisor.IsZero() || divisor.IsMinusOne()) {
+          return false;
+        }
+      }
+      break;
+    }
+    default:
+      return false;
+  }
+  for (auto& used_value : instr->UsedValues()) {
+    if (!IsInvariant(used_value, loop)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void LoopOptimizer::HoistInvariantComputations(const ir_info::Loop* loop, ir::Block* preheader) {
+  // Visiting blocks in dominance order ensures that computations get visited after the
+  // computations they depend on.
+  for (ir::block_num_t bnum : dominator_tree_.blocks_in_preorder()) {
+    if (!loop->Contains(bnum)) {
+      continue;
+    }
+    auto& instrs = func_->GetBlock(bnum)->instrs();
+    for (auto it = instrs.begin(); it != instrs.end();) {
+      if (!CanHoist(it->get(), loop)) {
+        ++it;
+        continue;
+      }
+      std::unique_ptr<ir::Instr> instr = std::move(*it);
+      it = instrs.erase(it);
+      for (auto& defined_value : instr->DefinedValues()) {
+        SetDefinition(defined_value->number(), instr.get(), preheader->number());
+      }
+      InsertBeforeControlFlowInstr(preheader, std::move(instr));
+    }
+  }
+}
+
+std::unordered_map<ir::value_num_t, InductionVariable> LoopOptimizer::FindInductionVariables(
+    const ir_info::Loop* loop, ir::Block* preheader) const {
+  std::unordered_map<ir::value_num_t, InductionVariable> induction_variables;
+  ir::block_num_t latch = loop->latches().front();
+  func_->GetBlock(loop->header())->ForEachPhiInstr([&](ir::PhiInstr* phi_instr) {
+    if (phi_instr->args().size() != 2 ||
+        phi_instr->result()->type()->type_kind() != ir::TypeKind::kInt) {
+      return;
+    }
+    std::shared_ptr<ir::Value> start;
+    std::shared_ptr<ir::Value> next;
+    for (auto& arg : phi_instr->args()) {
+      if (arg->origin() == preheader->number()) {
+        start = arg->value();
+      } else if (arg->origin() == latch) {
+        next = arg->value();
+      }
+    }
+    if (start == nullptr || next == nullptr || next->kind() != ir::Value::Kind::kComputed) {
+      return;
+    }
+    ir::Instr* next_instr =
+        defining_instrs_.at(static_cast<ir::Computed*>(next.get())->number());
+    if (next_instr == nullptr || next_instr->instr_kind() != ir::InstrKind::kIntBinary) {
+      return;
+    }
+    auto add_instr = static_cast<ir::IntBinaryInstr*>(next_instr);
+    if (add_instr->operation() != Int::BinaryOp::kAdd) {
+      return;
+    }
+    std::shared_ptr<ir::Value> step;
+    if (ir::IsEqual(add_instr->operand_a().get(), phi_instr->result().get())) {
+      step = add_instr->operand_b();
+    } else if (ir::IsEqual(add_instr->operand_b().get(), phi_instr->result().get())) {
+      step = add_instr->operand_a();
+    }
+    if (step == nullptr || !IsInvariant(step, loop)) {
+      return;
+    }
+    induction_variables.insert({phi_instr->result()->number(), InductionVariable{
+                                                                   .start = start,
+                                                                   .step = step,
+                                                               }});
+  });
+  return induction_variables;
+}
+
+void LoopOptimizer::ReduceStrength(const ir_info::Loop* loop, ir::Block* preheader) {
+  if (loop->latches().size() != 1) {
+    return;
+  }
+  std::unordered_map<ir::value_num_t, InductionVariable> induction_variables =
+      FindInductionVariables(loop, preheader);
+  if (induction_variables.empty()) {
+    return;
+  }
+  auto induction_variable_of = [&](const std::shared_ptr<ir::Value>& value) -> InductionVariable* {
+    if (value->kind() != ir::Value::Kind::kComputed) {
+      return nullptr;
+    }
+    auto it = induction_variables.find(static_cast<ir::Computed*>(value.get())->number());
+    return (it != induction_variables.end()) ? &it->second : nullptr;
+  };
+
+  std::vector<std::pair<ir::Block*, ir::IntBinaryInstr*>> multiplications;
+  for (ir::block_num_t bnum : loop->blocks()) {
+    ir::Block* block = func_->GetBlock(bnum);
+    for (auto& instr : block->instrs()) {
+      if (instr->instr_kind() == ir::InstrKind::kIntBinary &&
+          static_cast<ir::IntBinaryInstr*>(instr.get())->operation() == Int::BinaryOp::kMul) {
+        multiplications.push_back({block, static_cast<ir::IntBinaryInstr*>(instr.get())});
+      }
+    }
+  }
+
+  ir::Block* header = func_->GetBlock(loop->header());
+  ir::Block* latch = func_->GetBlock(loop->latches().front());
+  for (auto [block, mul_instr] : multiplications) {
+    InductionVariable* induction_variable = induction_variable_of(mul_instr->operand_a());
+    std::shared_ptr<ir::Value> factor = mul_instr->operand_b();
+    if (induction_variable == nullptr) {
+      induction_variable = induction_variable_of(mul_instr->operand_b());
+      factor = mul_instr->operand_a();
+    }
+    if (induction_variable == nullptr || !IsInvariant(factor, loop)) {
+      continue;
+    }
+
+    // The product gets tracked by a new induction variable: it starts at start * factor and
+    // increases by step * factor on each iteration.
+    const ir::Type* type = mul_instr->result()->type();
+    std::shared_ptr<ir::Value> start = Multiply(induction_variable->start, factor, preheader);
+    std::shared_ptr<ir::Value> stride = Multiply(induction_variable->step, factor, preheader);
+    auto product = std::make_shared<ir::Computed>(type, func_->next_computed_number());
+    auto next_product = std::make_shared<ir::Computed>(type, func_->next_computed_number());
+    auto phi_instr = std::make_unique<ir::PhiInstr>(
+        product, std::vector<std::shared_ptr<ir::InheritedValue>>{
+                     std::make_shared<ir::InheritedValue>(start, preheader->number()),
+                     std::make_shared<ir::InheritedValue>(next_product, latch->number()),
+                 });
+    auto add_instr =
+        std::make_unique<ir::IntBinaryInstr>(next_product, Int::BinaryOp::kAdd, product, stride);
+    SetDefinition(product->number(), phi_instr.get(), header->number());
+    SetDefinition(next_product->number(), add_instr.get(), latch->number());
+
+    auto mul_it = std::find_if(block->instrs().begin(), block->instrs().end(),
+                               [mul_instr](auto& instr) { return instr.get() == mul_instr; });
+    std::shared_ptr<ir::Computed> result = mul_instr->result();
+    *mul_it = std::make_unique<ir::MovInstr>(result, product);
+    SetDefinition(result->number(), mul_it->get(), block->number());
+
+    header->instrs().insert(header->instrs().begin(), std::move(phi_instr));
+    InsertBeforeControlFlowInstr(latch, std::move(add_instr));
+  }
+}
+
+std::shared_ptr<ir::Value> LoopOptimizer::Multiply(std::shared_ptr<ir::Value> a,
+                                                   std::shared_ptr<ir::Value> b,
+                                                   ir::Block* block) {
+  if (a->kind() == ir::Value::Kind::kConstant) {
+    std::swap(a, b);
+  }
+  if (b->kind() == ir::Value::Kind::kConstant) {
+    Int int_b = static_cast<ir::IntConstant*>(b.get())->value();
+    if (a->kind() == ir::Value::Kind::kConstant) {
+      Int int_a = static_cast<ir::IntConstant*>(a.get())->value();
+      return ir::ToIntConstant(Int::Compute(int_a, Int::BinaryOp::kMul, int_b));
+    } else if (int_b.IsOne()) {
+      return a;
+    }
+  }
+  auto result = std::make_shared<ir::Computed>(a->type(), func_->next_computed_number());
+  auto mul_instr = std::make_unique<ir::IntBinaryInstr>(result, Int::BinaryOp::kMul, a, b);
+  SetDefinition(result->number(), mul_instr.get(), block->number());
+  InsertBeforeControlFlowInstr(block, std::move(mul_instr));
+  return result;
+}
+
+void LoopOptimizer::SetDefinition(ir::value_num_t value_num, ir::Instr* instr,
+                                  ir::block_num_t bnum) {
+  if (value_num >= int64_t(defining_instrs_.size())) {
+    defining_instrs_.resize(func_->computed_count(), nullptr);
+    defining_blocks_.resize(func_->computed_count(), ir::kNoBlockNum);
+  }
+  defining_instrs_.at(value_num) = instr;
+  defining_blocks_.at(value_num) = bnum;
+}
+
+}  // namespace
+
+void OptimizeLoopsInProgram(ir::Program* program) {
+  ir_analyzers::FuncAnalysisManager analysis_manager;
+  for (auto& func : program->funcs()) {
+    OptimizeLoopsInFunc(func.get(), analysis_manager);
+  }
+}
+
+void OptimizeLoopsInFunc(ir::Func* func, ir_analyzers::FuncAnalysisManager& analysis_manager) {
+  if (func->entry_block() == nullptr || analysis_manager.GetLoopNest(func).loops().empty()) {
+    return;
+  }
+  if (InsertPreheaders(func, analysis_manager.GetLoopNest(func))) {
+    analysis_manager.Invalidate(func, "insert_preheaders",
+                                ir_analyzers::PreservedFuncAnalyses::None());
+  }
+  // Hoisting computations and reducing strength does not change control flow, so the analyses
+  // stay valid.
+  LoopOptimizer(func, analysis_manager.GetDominatorTree(func), analysis_manager.GetLoopNest(func))
+      .Run();
+}
+
+}  // namespace ir_optimizers
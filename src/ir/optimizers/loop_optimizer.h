@@ -0,0 +1,32 @@
+//
+//  loop_optimizer.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_optimizers_loop_optimizer_h
+#define ir_optimizers_loop_optimizer_h
+
+#include "src/ir/analyzers/func_analysis_manager.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/program.h"
+
+namespace ir_optimizers {
+
+// Optimizes the natural loops of all functions in the program, innermost loops first:
+//
+// Loop-invariant code motion moves computations whose operands are defined outside the loop to the
+// loop preheader, which gets inserted if the single block entering the loop has other children.
+// Loops with multiple entering blocks are left untouched.
+//
+// Strength reduction replaces multiplications of a basic induction variable (a header phi
+// incremented by a loop-invariant step on the single back edge) with a loop-invariant factor by an
+// additional induction variable, which gets incremented by step * factor on each iteration.
+void OptimizeLoopsInProgram(ir::Program* program);
+void OptimizeLoopsInFunc(ir::Func* func, ir_analyzers::FuncAnalysisManager& analysis_manager);
+
+}  // namespace ir_optimizers
+
+#endif /* ir_optimizers_loop_optimizer_h */
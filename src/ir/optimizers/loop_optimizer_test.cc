@@ -0,0 +1,216 @@
+//
+//  loop_optimizer_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/optimizers/loop_optimizer.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/ir/check/check_test_util.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+#include "src/ir/serialization/print.h"
+
+namespace ir_optimizers {
+namespace {
+
+struct LoopOptimizerTestParams {
+  std::string input_program;
+  std::string expected_program;
+};
+
+class LoopOptimizerTest : public testing::TestWithParam<LoopOptimizerTestParams> {};
+
+INSTANTIATE_TEST_SUITE_P(LoopOptimizerTestInstance, LoopOptimizerTest,
+                         testing::Values(
+                             // Hoists invariant computations, except for possibly trapping ones.
+                             LoopOptimizerTestParams{
+                                 .input_program = R"ir(
+@0 f(%0:ptr, %1:i64) => () {
+{0}
+  jmp {1}
+{1}
+  %2:i64 = phi #0:i64{0}, %5:i64{2}
+  %3:b = ilss %2, %1
+  jcc %3, {2}, {3}
+{2}
+  %4:ptr = poff %0, #8:i64
+  %6:i64 = idiv #100:i64, %1
+  %7:i64 = iadd %6, %2
+  store %4, %7
+  %5:i64 = iadd %2, #1:i64
+  jmp {1}
+{3}
+  ret
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f(%0:ptr, %1:i64) => () {
+{0}
+  %4:ptr = poff %0, #8:i64
+  jmp {1}
+{1}
+  %2:i64 = phi #0:i64{0}, %5:i64{2}
+  %3:b = ilss %2, %1
+  jcc %3, {2}, {3}
+{2}
+  %6:i64 = idiv #100:i64, %1
+  %7:i64 = iadd %6, %2
+  store %4, %7
+  %5:i64 = iadd %2, #1:i64
+  jmp {1}
+{3}
+  ret
+}
+)ir",
+                             },
+                             // Inserts a preheader if the loop entry has other children.
+                             LoopOptimizerTestParams{
+                                 .input_program = R"ir(
+@0 f(%0:b, %1:i64) => (i64) {
+{0}
+  jcc %0, {1}, {3}
+{1}
+  %2:i64 = phi #0:i64{0}, %5:i64{2}
+  %3:b = ilss %2, %1
+  jcc %3, {2}, {3}
+{2}
+  %4:i64 = imul %1, #3:i64
+  %5:i64 = iadd %2, %4
+  jmp {1}
+{3}
+  %6:i64 = phi #0:i64{0}, %2{1}
+  ret %6
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f(%0:b, %1:i64) => (i64) {
+{0}
+  jcc %0, {4}, {3}
+{1}
+  %2:i64 = phi #0:i64{4}, %5:i64{2}
+  %3:b = ilss %2, %1
+  jcc %3, {2}, {3}
+{2}
+  %5:i64 = iadd %2, %4:i64
+  jmp {1}
+{3}
+  %6:i64 = phi #0:i64{0}, %2{1}
+  ret %6
+{4}
+  %4:i64 = imul %1, #3:i64
+  jmp {1}
+}
+)ir",
+                             },
+                             // Replaces multiplications of induction variables by additions.
+                             LoopOptimizerTestParams{
+                                 .input_program = R"ir(
+@0 f(%0:ptr, %1:i64) => () {
+{0}
+  jmp {1}
+{1}
+  %2:i64 = phi #0:i64{0}, %6:i64{2}
+  %3:b = ilss %2, %1
+  jcc %3, {2}, {3}
+{2}
+  %4:i64 = imul %2, #8:i64
+  %5:ptr = poff %0, %4
+  store %5, %2
+  %6:i64 = iadd %2, #1:i64
+  jmp {1}
+{3}
+  ret
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f(%0:ptr, %1:i64) => () {
+{0}
+  jmp {1}
+{1}
+  %7:i64 = phi #0:i64{0}, %8:i64{2}
+  %2:i64 = phi #0:i64{0}, %6:i64{2}
+  %3:b = ilss %2, %1
+  jcc %3, {2}, {3}
+{2}
+  %4:i64 = mov %7
+  %5:ptr = poff %0, %4
+  store %5, %2
+  %6:i64 = iadd %2, #1:i64
+  %8:i64 = iadd %7, #8:i64
+  jmp {1}
+{3}
+  ret
+}
+)ir",
+                             },
+                             // Computes start and stride of new induction variables up front.
+                             LoopOptimizerTestParams{
+                                 .input_program = R"ir(
+@0 f(%0:i64, %1:i64, %2:i64) => (i64) {
+{0}
+  jmp {1}
+{1}
+  %3:i64 = phi %0{0}, %6:i64{2}
+  %7:i64 = phi #0:i64{0}, %8:i64{2}
+  %4:b = ilss %3, #100:i64
+  jcc %4, {2}, {3}
+{2}
+  %5:i64 = imul %2, %3
+  %8:i64 = iadd %7, %5
+  %6:i64 = iadd %3, #2:i64
+  jmp {1}
+{3}
+  ret %7
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f(%0:i64, %1:i64, %2:i64) => (i64) {
+{0}
+  %9:i64 = imul %0, %2
+  %10:i64 = imul %2, #2:i64
+  jmp {1}
+{1}
+  %11:i64 = phi %9{0}, %12:i64{2}
+  %3:i64 = phi %0{0}, %6:i64{2}
+  %7:i64 = phi #0:i64{0}, %8:i64{2}
+  %4:b = ilss %3, #100:i64
+  jcc %4, {2}, {3}
+{2}
+  %5:i64 = mov %11
+  %8:i64 = iadd %7, %5
+  %6:i64 = iadd %3, #2:i64
+  %12:i64 = iadd %11, %10
+  jmp {1}
+{3}
+  ret %7
+}
+)ir",
+                             }));
+
+TEST_P(LoopOptimizerTest, OptimizesLoops) {
+  std::unique_ptr<ir::Program> input_program =
+      ir_serialization::ParseProgramOrDie(GetParam().input_program);
+  std::unique_ptr<ir::Program> expected_program =
+      ir_serialization::ParseProgramOrDie(GetParam().expected_program);
+  ir_check::CheckProgramOrDie(input_program.get());
+  ir_check::CheckProgramOrDie(expected_program.get());
+
+  OptimizeLoopsInProgram(input_program.get());
+
+  ir_check::CheckProgramOrDie(input_program.get());
+  EXPECT_TRUE(ir::IsEqual(input_program.get(), expected_program.get()))
+      << "Expected program:\n"
+      << ir_serialization::PrintProgram(expected_program.get()) << "\ngot:\n"
+      << ir_serialization::PrintProgram(input_program.get());
+}
+
+}  // namespace
+}  // namespace ir_optimizers
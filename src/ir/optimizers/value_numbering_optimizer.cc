@@ -0,0 +1,260 @@
+//
+//  value_numbering_optimizer.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "value_numbering_optimizer.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "src/common/atomics/atomics.h"
+#include "src/ir/info/dominator_tree.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/instrs.h"
+#include "src/ir/representation/num_types.h"
+#include "src/ir/representation/types.h"
+#include "src/ir/representation/values.h"
+
+namespace ir_optimizers {
+namespace {
+
+using ::common::atomics::Int;
+
+// The computation performed by an instr, with computed operands replaced by their leaders.
+struct Expression {
+  ir::InstrKind instr_kind;
+  int64_t operation;
+  const ir::Type* result_type;
+  std::shared_ptr<ir::Value> operand_a;
+  std::shared_ptr<ir::Value> operand_b;
+
+  bool operator==(const Expression& that) const {
+    return instr_kind == that.instr_kind && operation == that.operation &&
+           ir::IsEqual(result_type, that.result_type) &&
+           ir::IsEqual(operand_a.get(), that.operand_a.get()) &&
+           ir::IsEqual(operand_b.get(), that.operand_b.get());
+  }
+};
+
+std::size_t HashValue(const ir::Value* value) {
+  if (value == nullptr) {
+    return 0;
+  } else if (value->kind() == ir::Value::Kind::kComputed) {
+    return std::hash<ir::value_num_t>()(static_cast<const ir::Computed*>(value)->number());
+  } else {
+    return std::hash<std::string>()(value->RefStringWithType());
+  }
+}
+
+std::size_t CombineHashes(std::size_t a, std::size_t b) {
+  return a ^ (b + 0x9e3779b9 + (a << 6) + (a >> 2));
+}
+
+struct ExpressionHash {
+  std::size_t operator()(const Expression& expression) const {
+    std::size_t hash = std::hash<int64_t>()(static_cast<int64_t>(expression.instr_kind));
+    hash = CombineHashes(hash, std::hash<int64_t>()(expression.operation));
+    hash = CombineHashes(hash, HashValue(expression.operand_a.get()));
+    hash = CombineHashes(hash, HashValue(expression.operand_b.get()));
+    return hash;
+  }
+};
+
+bool IsCommutative(Int::BinaryOp op) {
+  switch (op) {
+    case Int::BinaryOp::kAdd:
+    case Int::BinaryOp::kMul:
+    case Int::BinaryOp::kAnd:
+    case Int::BinaryOp::kOr:
+    case Int::BinaryOp::kXor:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsCommutative(Int::CompareOp op) {
+  return op == Int::CompareOp::kEq || op == Int::CompareOp::kNeq;
+}
+
+// Orders operands of commutative operations such that computed values come before constants and
+// computed values with lower numbers come first.
+void OrderCommutativeOperands(std::shared_ptr<ir::Value>& a, std::shared_ptr<ir::Value>& b) {
+  if (b->kind() != ir::Value::Kind::kComputed) {
+    return;
+  }
+  if (a->kind() != ir::Value::Kind::kComputed ||
+      static_cast<ir::Computed*>(a.get())->number() >
+          static_cast<ir::Computed*>(b.get())->number()) {
+    std::swap(a, b);
+  }
+}
+
+class ValueNumbering {
+ public:
+  ValueNumbering(ir::Func* func, const ir_info::DominatorTree& dominator_tree)
+      : func_(func), dominator_tree_(dominator_tree), leaders_(func->computed_count()) {}
+
+  void Run();
+
+ private:
+  void VisitBlock(ir::Block* block);
+  std::optional<Expression> ExpressionOf(ir::Instr* instr) const;
+  std::shared_ptr<ir::Value> LeaderOf(std::shared_ptr<ir::Value> value) const;
+
+  ir::Func* func_;
+  const ir_info::DominatorTree& dominator_tree_;
+  std::vector<std::shared_ptr<ir::Computed>> leaders_;  // value_num_t -> leader or nullptr
+  std::unordered_map<Expression, std::shared_ptr<ir::Computed>, ExpressionHash> available_;
+  std::vector<Expression> available_log_;
+};
+
+void ValueNumbering::Run() {
+  // An expression is available in all blocks dominated by the block computing it. Blocks get
+  // visited in dominator tree preorder and expressions of blocks that do not dominate the next
+  // block get removed again.
+  std::vector<std::pair<ir::block_num_t, std::size_t>> scopes;  // block, available_log_ size
+  for (ir::block_num_t bnum : dominator_tree_.blocks_in_preorder()) {
+    while (!scopes.empty() && !dominator_tree_.Dominates(scopes.back().first, bnum)) {
+      while (available_log_.size() > scopes.back().second) {
+        available_.erase(available_log_.back());
+        available_log_.pop_back();
+      }
+      scopes.pop_back();
+    }
+    scopes.push_back({bnum, available_log_.size()});
+    VisitBlock(func_->GetBlock(bnum));
+  }
+}
+
+void ValueNumbering::VisitBlock(ir::Block* block) {
+  for (auto& instr : block->instrs()) {
+    if (instr->instr_kind() == ir::InstrKind::kMov) {
+      auto mov_instr = static_cast<ir::MovInstr*>(instr.get());
+      std::shared_ptr<ir::Value> origin = LeaderOf(mov_instr->origin());
+      if (origin->kind() == ir::Value::Kind::kComputed) {
+        leaders_.at(mov_instr->result()->number()) = std::static_pointer_cast<ir::Computed>(origin);
+      }
+      continue;
+    }
+    std::optional<Expression> expression = ExpressionOf(instr.get());
+    if (!expression.has_value()) {
+      continue;
+    }
+    std::shared_ptr<ir::Computed> result = static_cast<ir::Computation*>(instr.get())->result();
+    auto it = available_.find(*expression);
+    if (it == available_.end()) {
+      available_.insert({*expression, result});
+      available_log_.push_back(*expression);
+    } else {
+      leaders_.at(result->number()) = it->second;
+      instr = std::make_unique<ir::MovInstr>(result, it->second);
+    }
+  }
+}
+
+std::optional<Expression> ValueNumbering::ExpressionOf(ir::Instr* instr) const {
+  switch (instr->instr_kind()) {
+    case ir::InstrKind::kConversion: {
+      auto conversion = static_cast<ir::Conversion*>(instr);
+      return Expression{
+          .instr_kind = instr->instr_kind(),
+          .operation = 0,
+          .result_type = conversion->result()->type(),
+          .operand_a = LeaderOf(conversion->operand()),
+          .operand_b = nullptr,
+      };
+    }
+    case ir::InstrKind::kIntCompare: {
+      auto compare_instr = static_cast<ir::IntCompareInstr*>(instr);
+      std::shared_ptr<ir::Value> a = LeaderOf(compare_instr->operand_a());
+      std::shared_ptr<ir::Value> b = LeaderOf(compare_instr->operand_b());
+      if (IsCommutative(compare_instr->operation())) {
+        OrderCommutativeOperands(a, b);
+      }
+      return Expression{
+          .instr_kind = instr->instr_kind(),
+          .operation = static_cast<int64_t>(compare_instr->operation()),
+          .result_type = compare_instr->result()->type(),
+          .operand_a = a,
+          .operand_b = b,
+      };
+    }
+    case ir::InstrKind::kIntBinary: {
+      auto binary_instr = static_cast<ir::IntBinaryInstr*>(instr);
+      std::shared_ptr<ir::Value> a = LeaderOf(binary_instr->operand_a());
+      std::shared_ptr<ir::Value> b = LeaderOf(binary_instr->operand_b());
+      if (IsCommutative(binary_instr->operation())) {
+        OrderCommutativeOperands(a, b);
+      }
+      return Expression{
+          .instr_kind = instr->instr_kind(),
+          .operation = static_cast<int64_t>(binary_instr->operation()),
+          .result_type = binary_instr->result()->type(),
+          .operand_a = a,
+          .operand_b = b,
+      };
+    }
+    case ir::InstrKind::kIntShift: {
+      auto shift_instr = static_cast<ir::IntShiftInstr*>(instr);
+      return Expression{
+          .instr_kind = instr->instr_kind(),
+          .operation = static_cast<int64_t>(shift_instr->operation()),
+          .result_type = shift_instr->result()->type(),
+          .operand_a = LeaderOf(shift_instr->shifted()),
+          .operand_b = LeaderOf(shift_instr->offset()),
+      };
+    }
+    case ir::InstrKind::kPointerOffset: {
+      auto pointer_offset_instr = static_cast<ir::PointerOffsetInstr*>(instr);
+      return Expression{
+          .instr_kind = instr->instr_kind(),
+          .operation = 0,
+          .result_type = pointer_offset_instr->result()->type(),
+          .operand_a = LeaderOf(pointer_offset_instr->pointer()),
+          .operand_b = LeaderOf(pointer_offset_instr->offset()),
+      };
+    }
+    default:
+      return std::nullopt;
+  }
+}
+
+std::shared_ptr<ir::Value> ValueNumbering::LeaderOf(std::shared_ptr<ir::Value> value) const {
+  if (value->kind() != ir::Value::Kind::kComputed) {
+    return value;
+  }
+  std::shared_ptr<ir::Computed> leader =
+      leaders_.at(static_cast<ir::Computed*>(value.get())->number());
+  return (leader != nullptr) ? leader : value;
+}
+
+}  // namespace
+
+void EliminateRedundantComputationsInProgram(ir::Program* program) {
+  ir_analyzers::FuncAnalysisManager analysis_manager;
+  for (auto& func : program->funcs()) {
+    EliminateRedundantComputationsInFunc(func.get(), analysis_manager);
+  }
+}
+
+void EliminateRedundantComputationsInFunc(ir::Func* func,
+                                          ir_analyzers::FuncAnalysisManager& analysis_manager) {
+  if (func->entry_block() == nullptr) {
+    return;
+  }
+  // Only instrs within blocks get replaced, so all control flow analyses stay valid.
+  ValueNumbering(func, analysis_manager.GetDominatorTree(func)).Run();
+}
+
+}  // namespace ir_optimizers
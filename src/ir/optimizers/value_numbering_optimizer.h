@@ -0,0 +1,28 @@
+//
+//  value_numbering_optimizer.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_optimizers_value_numbering_optimizer_h
+#define ir_optimizers_value_numbering_optimizer_h
+
+#include "src/ir/analyzers/func_analysis_manager.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/program.h"
+
+namespace ir_optimizers {
+
+// Performs dominator based global value numbering: an int binary, int compare, int shift, pointer
+// offset or conversion instr that computes the same value as an instr in a dominating position gets
+// replaced by a mov of the earlier result. Movs between computed values are looked through, and
+// operands of commutative operations are ordered canonically.
+void EliminateRedundantComputationsInProgram(ir::Program* program);
+void EliminateRedundantComputationsInFunc(ir::Func* func,
+                                          ir_analyzers::FuncAnalysisManager& analysis_manager);
+
+}  // namespace ir_optimizers
+
+#endif /* ir_optimizers_value_numbering_optimizer_h */
@@ -0,0 +1,168 @@
+//
+//  value_numbering_optimizer_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/optimizers/value_numbering_optimizer.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/ir/check/check_test_util.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+#include "src/ir/serialization/print.h"
+
+namespace ir_optimizers {
+namespace {
+
+struct ValueNumberingTestParams {
+  std::string input_program;
+  std::string expected_program;
+};
+
+class ValueNumberingTest : public testing::TestWithParam<ValueNumberingTestParams> {};
+
+INSTANTIATE_TEST_SUITE_P(ValueNumberingTestInstance, ValueNumberingTest,
+                         testing::Values(
+                             // Replaces repeated pointer offsets within a block.
+                             ValueNumberingTestParams{
+                                 .input_program = R"ir(
+@0 f(%0:ptr) => (i64) {
+{0}
+  %1:ptr = poff %0, #8:i64
+  %2:i64 = load %1
+  %3:ptr = poff %0, #8:i64
+  %4:i64 = load %3
+  %5:i64 = iadd %2, %4
+  ret %5
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f(%0:ptr) => (i64) {
+{0}
+  %1:ptr = poff %0, #8:i64
+  %2:i64 = load %1
+  %3:ptr = mov %1
+  %4:i64 = load %3
+  %5:i64 = iadd %2, %4
+  ret %5
+}
+)ir",
+                             },
+                             // Only replaces computations dominated by an equal computation.
+                             ValueNumberingTestParams{
+                                 .input_program = R"ir(
+@0 f(%0:i64, %1:b) => (i64) {
+{0}
+  %2:i64 = imul %0, #3:i64
+  jcc %1, {1}, {2}
+{1}
+  %3:i64 = imul %0, #3:i64
+  %4:i64 = isub %0, #1:i64
+  jmp {3}
+{2}
+  %5:i64 = isub %0, #1:i64
+  jmp {3}
+{3}
+  %6:i64 = phi %3{1}, %5{2}
+  %7:i64 = isub %0, #1:i64
+  %8:i64 = iadd %6, %7
+  ret %8
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f(%0:i64, %1:b) => (i64) {
+{0}
+  %2:i64 = imul %0, #3:i64
+  jcc %1, {1}, {2}
+{1}
+  %3:i64 = mov %2
+  %4:i64 = isub %0, #1:i64
+  jmp {3}
+{2}
+  %5:i64 = isub %0, #1:i64
+  jmp {3}
+{3}
+  %6:i64 = phi %3{1}, %5{2}
+  %7:i64 = isub %0, #1:i64
+  %8:i64 = iadd %6, %7
+  ret %8
+}
+)ir",
+                             },
+                             // Orders operands of commutative operations and looks through movs.
+                             ValueNumberingTestParams{
+                                 .input_program = R"ir(
+@0 f(%0:i64, %1:i64) => (i64, i64, b, b) {
+{0}
+  %2:i64 = iadd %0, %1
+  %3:i64 = mov %1
+  %4:i64 = iadd %3, %0
+  %5:i64 = isub %0, %1
+  %6:i64 = isub %1, %0
+  %7:b = ieq %0, #0:i64
+  %8:b = ieq #0:i64, %0
+  ret %4, %6, %7, %8
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f(%0:i64, %1:i64) => (i64, i64, b, b) {
+{0}
+  %2:i64 = iadd %0, %1
+  %3:i64 = mov %1
+  %4:i64 = mov %2
+  %5:i64 = isub %0, %1
+  %6:i64 = isub %1, %0
+  %7:b = ieq %0, #0:i64
+  %8:b = mov %7
+  ret %4, %6, %7, %8
+}
+)ir",
+                             },
+                             // Distinguishes conversions to different types.
+                             ValueNumberingTestParams{
+                                 .input_program = R"ir(
+@0 f(%0:i64) => (i8, i16, i8) {
+{0}
+  %1:i8 = conv %0
+  %2:i16 = conv %0
+  %3:i8 = conv %0
+  ret %1, %2, %3
+}
+)ir",
+                                 .expected_program = R"ir(
+@0 f(%0:i64) => (i8, i16, i8) {
+{0}
+  %1:i8 = conv %0
+  %2:i16 = conv %0
+  %3:i8 = mov %1
+  ret %1, %2, %3
+}
+)ir",
+                             }));
+
+TEST_P(ValueNumberingTest, EliminatesRedundantComputations) {
+  std::unique_ptr<ir::Program> input_program =
+      ir_serialization::ParseProgramOrDie(GetParam().input_program);
+  std::unique_ptr<ir::Program> expected_program =
+      ir_serialization::ParseProgramOrDie(GetParam().expected_program);
+  ir_check::CheckProgramOrDie(input_program.get());
+  ir_check::CheckProgramOrDie(expected_program.get());
+
+  EliminateRedundantComputationsInProgram(input_program.get());
+
+  ir_check::CheckProgramOrDie(input_program.get());
+  EXPECT_TRUE(ir::IsEqual(input_program.get(), expected_program.get()))
+      << "Expected program:\n"
+      << ir_serialization::PrintProgram(expected_program.get()) << "\ngot:\n"
+      << ir_serialization::PrintProgram(input_program.get());
+}
+
+}  // namespace
+}  // namespace ir_optimizers
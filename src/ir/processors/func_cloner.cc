@@ -0,0 +1,140 @@
+//
+//  func_cloner.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/17/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "func_cloner.h"
+
+#include <memory>
+
+#include "src/common/logging/logging.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/instrs.h"
+
+namespace ir_processors {
+namespace {
+
+using ::common::logging::fail;
+
+template <class T>
+std::unique_ptr<ir::Instr> CopyInstr(const ir::Instr* instr) {
+  return std::make_unique<T>(*static_cast<const T*>(instr));
+}
+
+std::unique_ptr<ir::Instr> CloneInstr(const ir::Instr* instr) {
+  switch (instr->instr_kind()) {
+    case ir::InstrKind::kMov:
+      return CopyInstr<ir::MovInstr>(instr);
+    case ir::InstrKind::kPhi:
+      return CopyInstr<ir::PhiInstr>(instr);
+    case ir::InstrKind::kConversion:
+      return CopyInstr<ir::Conversion>(instr);
+    case ir::InstrKind::kBoolNot:
+      return CopyInstr<ir::BoolNotInstr>(instr);
+    case ir::InstrKind::kBoolBinary:
+      return CopyInstr<ir::BoolBinaryInstr>(instr);
+    case ir::InstrKind::kIntUnary:
+      return CopyInstr<ir::IntUnaryInstr>(instr);
+    case ir::InstrKind::kIntCompare:
+      return CopyInstr<ir::IntCompareInstr>(instr);
+    case ir::InstrKind::kIntBinary:
+      return CopyInstr<ir::IntBinaryInstr>(instr);
+    case ir::InstrKind::kIntShift:
+      return CopyInstr<ir::IntShiftInstr>(instr);
+    case ir::InstrKind::kPointerOffset:
+      return CopyInstr<ir::PointerOffsetInstr>(instr);
+    case ir::InstrKind::kNilTest:
+      return CopyInstr<ir::NilTestInstr>(instr);
+    case ir::InstrKind::kMalloc:
+      return CopyInstr<ir::MallocInstr>(instr);
+    case ir::InstrKind::kLoad:
+      return CopyInstr<ir::LoadInstr>(instr);
+    case ir::InstrKind::kStore:
+      return CopyInstr<ir::StoreInstr>(instr);
+    case ir::InstrKind::kFree:
+      return CopyInstr<ir::FreeInstr>(instr);
+    case ir::InstrKind::kJump:
+      return CopyInstr<ir::JumpInstr>(instr);
+    case ir::InstrKind::kJumpCond:
+      return CopyInstr<ir::JumpCondInstr>(instr);
+    case ir::InstrKind::kSyscall:
+      return CopyInstr<ir::SyscallInstr>(instr);
+    case ir::InstrKind::kCall:
+      return CopyInstr<ir::CallInstr>(instr);
+    case ir::InstrKind::kReturn:
+      return CopyInstr<ir::ReturnInstr>(instr);
+    default:
+      fail("unexpected instr in cloned func");
+  }
+}
+
+}  // namespace
+
+bool CanCloneInstr(const ir::Instr* instr) {
+  switch (instr->instr_kind()) {
+    case ir::InstrKind::kMov:
+    case ir::InstrKind::kPhi:
+    case ir::InstrKind::kConversion:
+    case ir::InstrKind::kBoolNot:
+    case ir::InstrKind::kBoolBinary:
+    case ir::InstrKind::kIntUnary:
+    case ir::InstrKind::kIntCompare:
+    case ir::InstrKind::kIntBinary:
+    case ir::InstrKind::kIntShift:
+    case ir::InstrKind::kPointerOffset:
+    case ir::InstrKind::kNilTest:
+    case ir::InstrKind::kMalloc:
+    case ir::InstrKind::kLoad:
+    case ir::InstrKind::kStore:
+    case ir::InstrKind::kFree:
+    case ir::InstrKind::kJump:
+    case ir::InstrKind::kJumpCond:
+    case ir::InstrKind::kSyscall:
+    case ir::InstrKind::kCall:
+    case ir::InstrKind::kReturn:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool CanCloneFunc(const ir::Func* func) {
+  for (const auto& block : func->blocks()) {
+    for (const auto& instr : block->instrs()) {
+      if (!CanCloneInstr(instr.get())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+ir::Func* CloneFuncIntoProgram(const ir::Func* func, ir::Program* program) {
+  ir::Func* clone = program->AddFunc(func->number());
+  clone->set_name(func->name());
+  clone->args() = func->args();
+  clone->result_types() = func->result_types();
+  for (const auto& block : func->blocks()) {
+    ir::Block* block_clone = clone->AddBlock(block->number());
+    block_clone->set_name(block->name());
+    block_clone->instrs().reserve(block->instrs().size());
+    for (const auto& instr : block->instrs()) {
+      block_clone->instrs().push_back(CloneInstr(instr.get()));
+    }
+  }
+  for (const auto& block : func->blocks()) {
+    for (ir::block_num_t child : block->children()) {
+      clone->AddControlFlow(block->number(), child);
+    }
+  }
+  clone->set_entry_block_num(func->entry_block_num());
+  if (func->computed_count() > 0) {
+    clone->register_computed_number(func->computed_count() - 1);
+  }
+  return clone;
+}
+
+}  // namespace ir_processors
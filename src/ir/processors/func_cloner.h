@@ -0,0 +1,32 @@
+//
+//  func_cloner.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/17/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef ir_proc_func_cloner_h
+#define ir_proc_func_cloner_h
+
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/instrs.h"
+#include "src/ir/representation/program.h"
+
+namespace ir_processors {
+
+// Returns if the instr is part of the core IR and can get cloned. Language extension instrs are
+// unknown to the IR processors and optimizers and can not get cloned.
+bool CanCloneInstr(const ir::Instr* instr);
+
+// Returns if all instrs of the given func are part of the core IR and can get cloned.
+bool CanCloneFunc(const ir::Func* func);
+
+// Adds a copy of the given func to the given program. The copy keeps the func, block, and value
+// numbers of the original. Its blocks and instrs can get modified independently of the original,
+// but it shares values and types with the original, whose program has to outlive the copy.
+ir::Func* CloneFuncIntoProgram(const ir::Func* func, ir::Program* program);
+
+}  // namespace ir_processors
+
+#endif /* ir_proc_func_cloner_h */
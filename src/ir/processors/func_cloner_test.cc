@@ -0,0 +1,86 @@
+//
+//  func_cloner_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/17/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/ir/processors/func_cloner.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+#include "src/ir/processors/phi_resolver.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+#include "src/ir/serialization/print.h"
+
+namespace {
+
+constexpr std::string_view kProgram = R"ir(
+@0 main(%0:i64, %1:ptr) => (i64) {
+{0}
+  %2:i64 = mov #0:i64
+  jmp {1}
+{1}
+  %3:i64 = phi %2{0}, %5{2}
+  %4:b = ilss %3, %0
+  jcc %4, {2}, {3}
+{2}
+  %5:i64 = iadd %3, #1:i64
+  store %1, %5
+  jmp {1}
+{3}
+  %6:i64 = call @1, %3
+  ret %6
+}
+
+@1 inc(%0:i64) => (i64) {
+{0}
+  %1:i64 = iadd %0, #1:i64
+  ret %1
+}
+)ir";
+
+TEST(FuncClonerTest, ClonesFuncWithSameNumbers) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(std::string(kProgram));
+  const ir::Func* func = program->GetFunc(0);
+  ASSERT_TRUE(ir_processors::CanCloneFunc(func));
+
+  ir::Program clone_program;
+  ir::Func* clone = ir_processors::CloneFuncIntoProgram(func, &clone_program);
+
+  EXPECT_EQ(clone_program.GetFunc(0), clone);
+  EXPECT_TRUE(ir::IsEqual(func, clone));
+  EXPECT_EQ(ir_serialization::PrintFunc(clone), ir_serialization::PrintFunc(func));
+  EXPECT_EQ(clone->computed_count(), func->computed_count());
+  EXPECT_EQ(clone->block_count(), func->block_count());
+  for (const auto& block : func->blocks()) {
+    const ir::Block* block_clone = clone->GetBlock(block->number());
+    ASSERT_NE(block_clone, nullptr);
+    EXPECT_NE(block_clone, block.get());
+    EXPECT_EQ(block_clone->parents(), block->parents());
+    EXPECT_EQ(block_clone->children(), block->children());
+  }
+  EXPECT_EQ(clone->DominatorOf(3), 1);
+}
+
+TEST(FuncClonerTest, ModifyingCloneLeavesOriginalUnchanged) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(std::string(kProgram));
+  const ir::Func* func = program->GetFunc(0);
+  std::string original_text = ir_serialization::PrintFunc(func);
+
+  ir::Program clone_program;
+  ir::Func* clone = ir_processors::CloneFuncIntoProgram(func, &clone_program);
+  ir_processors::ResolvePhisInFunc(clone);
+
+  EXPECT_EQ(clone->GetBlock(1)->instrs().front()->instr_kind(), ir::InstrKind::kIntCompare);
+  EXPECT_EQ(func->GetBlock(1)->instrs().front()->instr_kind(), ir::InstrKind::kPhi);
+  EXPECT_EQ(ir_serialization::PrintFunc(func), original_text);
+}
+
+}  // namespace
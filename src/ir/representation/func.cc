@@ -17,9 +17,8 @@ namespace ir {
 using ::common::logging::fail;
 
 Block* Func::GetBlock(block_num_t bnum) const {
-  auto it = std::find_if(blocks_.begin(), blocks_.end(),
-                         [=](auto& block) { return block->number() == bnum; });
-  return (it != blocks_.end()) ? it->get() : nullptr;
+  auto it = blocks_by_number_.find(bnum);
+  return (it != blocks_by_number_.end()) ? it->second : nullptr;
 }
 
 Block* Func::AddBlock(block_num_t bnum) {
@@ -31,7 +30,9 @@ Block* Func::AddBlock(block_num_t bnum) {
     block_count_ = std::max(block_count_, bnum + 1);
   }
   auto& block = blocks_.emplace_back(new Block(bnum));
+  blocks_by_number_.insert({bnum, block.get()});
   dominator_tree_ok_ = false;
+  cfg_version_++;
   return block.get();
 }
 
@@ -49,8 +50,10 @@ void Func::RemoveBlock(block_num_t bnum) {
     Block* child = GetBlock(child_num);
     child->parents_.erase(bnum);
   }
+  blocks_by_number_.erase(bnum);
   blocks_.erase(it);
   dominator_tree_ok_ = false;
+  cfg_version_++;
 }
 
 void Func::AddControlFlow(block_num_t parent_num, block_num_t child_num) {
@@ -61,6 +64,7 @@ void Func::AddControlFlow(block_num_t parent_num, block_num_t child_num) {
   parent->children_.insert(child_num);
   child->parents_.insert(parent_num);
   dominator_tree_ok_ = false;
+  cfg_version_++;
 }
 
 void Func::RemoveControlFlow(block_num_t parent_num, block_num_t child_num) {
@@ -71,6 +75,7 @@ void Func::RemoveControlFlow(block_num_t parent_num, block_num_t child_num) {
   parent->children_.erase(child_num);
   child->parents_.erase(parent_num);
   dominator_tree_ok_ = false;
+  cfg_version_++;
 }
 
 block_num_t Func::DominatorOf(block_num_t dominee_num) const {
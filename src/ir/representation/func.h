@@ -39,10 +39,20 @@ class Func : public Object {
   const std::vector<const Type*>& result_types() const { return result_types_; }
 
   const std::vector<std::unique_ptr<Block>>& blocks() const { return blocks_; }
+  // Returns an upper bound for all block numbers in the function.
+  int64_t block_count() const { return block_count_; }
+
+  // Returns a number that changes whenever blocks or control flow edges get added or removed, such
+  // that cached control flow analyses can detect that they are stale.
+  int64_t cfg_version() const { return cfg_version_; }
 
   Block* entry_block() const { return GetBlock(entry_block_num_); }
   block_num_t entry_block_num() const { return entry_block_num_; }
-  void set_entry_block_num(block_num_t entry_block_num) { entry_block_num_ = entry_block_num; }
+  void set_entry_block_num(block_num_t entry_block_num) {
+    entry_block_num_ = entry_block_num;
+    dominator_tree_ok_ = false;
+    cfg_version_++;
+  }
 
   bool HasBlock(block_num_t bnum) const { return GetBlock(bnum) != nullptr; }
   Block* GetBlock(block_num_t bnum) const;
@@ -100,8 +110,10 @@ class Func : public Object {
 
   int64_t block_count_ = 0;
   std::vector<std::unique_ptr<Block>> blocks_;
+  std::unordered_map<block_num_t, Block*> blocks_by_number_;
 
   block_num_t entry_block_num_ = kNoBlockNum;
+  int64_t cfg_version_ = 0;
 
   mutable bool dominator_tree_ok_ = false;
   mutable std::unordered_map<block_num_t, block_num_t> dominators_;
@@ -21,6 +21,27 @@ using ::testing::IsEmpty;
 using ::testing::SizeIs;
 using ::testing::UnorderedElementsAre;
 
+TEST(FuncTest, GetsBlocksByNumber) {
+  ir::Func func(/*fnum=*/0);
+  ir::Block* block_a = func.AddBlock();
+  ir::Block* block_b = func.AddBlock(/*bnum=*/7);
+  ir::Block* block_c = func.AddBlock();
+
+  EXPECT_EQ(func.GetBlock(block_a->number()), block_a);
+  EXPECT_EQ(func.GetBlock(7), block_b);
+  EXPECT_EQ(func.GetBlock(block_c->number()), block_c);
+  EXPECT_EQ(func.GetBlock(3), nullptr);
+  EXPECT_EQ(func.GetBlock(ir::kNoBlockNum), nullptr);
+
+  func.RemoveBlock(7);
+
+  EXPECT_EQ(func.GetBlock(7), nullptr);
+  EXPECT_FALSE(func.HasBlock(7));
+  EXPECT_THAT(func.blocks(), SizeIs(2));
+  EXPECT_EQ(func.blocks().at(0).get(), block_a);
+  EXPECT_EQ(func.blocks().at(1).get(), block_c);
+}
+
 TEST(FuncTest, CreatesDominatorTreeForSingleBlock) {
   ir::Func func(/*fnum=*/0);
   ir::Block* block = func.AddBlock();
@@ -17,9 +17,8 @@ namespace ir {
 using ::common::logging::fail;
 
 Func* Program::GetFunc(func_num_t fnum) const {
-  auto it = std::find_if(funcs_.begin(), funcs_.end(),
-                         [=](auto& func) { return func->number() == fnum; });
-  return (it != funcs_.end()) ? it->get() : nullptr;
+  auto it = funcs_by_number_.find(fnum);
+  return (it != funcs_by_number_.end()) ? it->second : nullptr;
 }
 
 Func* Program::AddFunc(func_num_t fnum) {
@@ -33,6 +32,7 @@ Func* Program::AddFunc(func_num_t fnum) {
   auto func = std::make_unique<Func>(fnum);
   auto func_ptr = func.get();
   funcs_.push_back(std::move(func));
+  funcs_by_number_.insert({fnum, func_ptr});
   return func_ptr;
 }
 
@@ -41,6 +41,7 @@ void Program::RemoveFunc(func_num_t fnum) {
                          [=](auto& func) { return func->number() == fnum; });
   if (it == funcs_.end()) fail("tried to remove func not owned by program");
   if (entry_func_num_ == fnum) entry_func_num_ = kNoFuncNum;
+  funcs_by_number_.erase(fnum);
   funcs_.erase(it);
 }
 
@@ -19,6 +19,7 @@
 #include "src/ir/representation/program.h"
 #include "src/ir/representation/types.h"
 #include "src/ir/representation/values.h"
+#include "src/ir/serialization/print.h"
 
 namespace {
 
@@ -468,6 +469,25 @@ TEST(ParseTest, ParsesFuncWithIfStatement) {
   EXPECT_EQ(phi_instr->result(), return_instr->args().at(0));
 }
 
+TEST(ParseTest, ParsesPrintedPhiInstrs) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
+@0 (%0:i64, %1:b) => (i64) {
+{0}
+  jcc %1, {1}, {2}
+{1}
+  jmp {2}
+{2}
+  %2:i64 = phi %0{0}, #7:i64{1}
+  ret %2
+}
+)ir");
+  std::unique_ptr<ir::Program> reparsed_program =
+      ir_serialization::ParseProgramOrDie(ir_serialization::PrintProgram(program.get()));
+
+  ir_check::CheckProgramOrDie(reparsed_program.get());
+  EXPECT_EQ(*reparsed_program, *program);
+}
+
 TEST(ParseTest, ParsesFuncWithForLoop) {
   std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(R"ir(
 @0 (%0:i64) => (i64) {
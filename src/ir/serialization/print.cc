@@ -57,6 +57,14 @@ range_t PrintUsedValue(ir::Value* used_value, Printer& printer) {
   }
 }
 
+range_t PrintBlockValue(ir::block_num_t block_num, Printer& printer) {
+  return printer.WriteWithFunc([block_num, &printer] {
+    printer.Write("{");
+    printer.Write(std::to_string(block_num));
+    printer.Write("}");
+  });
+}
+
 std::vector<range_t> PrintUsedValuesList(const ir::Instr* instr, Printer& printer) {
   std::vector<range_t> used_value_ranges;
   used_value_ranges.reserve(instr->DefinedValues().size());
@@ -65,18 +73,14 @@ std::vector<range_t> PrintUsedValuesList(const ir::Instr* instr, Printer& printe
       printer.Write(", ");
     }
     used_value_ranges.push_back(PrintUsedValue(instr->UsedValues().at(i).get(), printer));
+    if (instr->instr_kind() == ir::InstrKind::kPhi) {
+      auto phi_instr = static_cast<const ir::PhiInstr*>(instr);
+      PrintBlockValue(phi_instr->args().at(i)->origin(), printer);
+    }
   }
   return used_value_ranges;
 }
 
-range_t PrintBlockValue(ir::block_num_t block_num, Printer& printer) {
-  return printer.WriteWithFunc([block_num, &printer] {
-    printer.Write("{");
-    printer.Write(std::to_string(block_num));
-    printer.Write("}");
-  });
-}
-
 void PrintJumpInstr(const ir::JumpInstr* jump_instr, Printer& printer,
                     ProgramPositions& program_positions) {
   InstrPositions jump_instr_positions;
@@ -10,6 +10,7 @@
 #define lang_packages_package_h
 
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -46,6 +47,8 @@ class Package {
   std::filesystem::path directory_;
 
   std::vector<common::positions::File*> pos_files_;
+  // Owns the nodes of the AST package, such that they get freed when the package gets parsed again.
+  std::unique_ptr<ast::AST> ast_;
   ast::Package* ast_package_;
   types::Package* types_package_;
 
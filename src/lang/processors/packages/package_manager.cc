@@ -9,11 +9,23 @@
 #include "package_manager.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
+#include "src/common/concurrency/thread_pool.h"
 #include "src/common/logging/logging.h"
 #include "src/lang/processors/parser/parser.h"
+#include "src/lang/processors/summaries/summary.h"
 #include "src/lang/processors/type_checker/type_checker.h"
+#include "src/lang/representation/ast/ast_builder.h"
 #include "src/lang/representation/ast/ast_util.h"
+#include "src/lang/representation/tokens/tokens.h"
+#include "src/lang/representation/types/info_builder.h"
 
 namespace lang {
 namespace packages {
@@ -39,17 +51,16 @@ Package* PackageManager::GetPackage(std::string pkg_path) const {
 
 Package* PackageManager::LoadPackage(std::string pkg_path) {
   if (Package* pkg = GetPackage(pkg_path); pkg != nullptr) {
+    if (packages_to_reload_.contains(pkg)) {
+      ReloadPackage(pkg);
+    }
     return pkg;
   }
-  if (filesystem_->Exists(src_path_ / pkg_path) && filesystem_->IsDirectory(src_path_ / pkg_path)) {
-    return LoadPackage(pkg_path, src_path_ / pkg_path);
-  } else if (filesystem_->Exists(stdlib_path_ / pkg_path) &&
-             filesystem_->IsDirectory(stdlib_path_ / pkg_path)) {
-    return LoadPackage(pkg_path, stdlib_path_ / pkg_path);
+  std::optional<std::filesystem::path> pkg_directory = FindPackageDirectory(pkg_path);
+  if (!pkg_directory.has_value()) {
+    return nullptr;
   }
-  issue_tracker_.Add(issues::kPackageDirectoryNotFound, std::vector<pos_t>{},
-                     "package directory not found for: " + pkg_path);
-  return nullptr;
+  return LoadPackage(pkg_path, *pkg_directory);
 }
 
 Package* PackageManager::LoadMainPackage(std::filesystem::path main_directory) {
@@ -72,6 +83,7 @@ Package* PackageManager::LoadMainPackage(std::vector<std::filesystem::path> main
       !CheckAllFilesInMainPackageExist(main_file_paths)) {
     return nullptr;
   }
+  main_file_paths_ = main_file_paths;
   return LoadPackage("main", filesystem_->Absolute(main_file_paths.front().parent_path()),
                      main_file_paths);
 }
@@ -114,20 +126,112 @@ std::string NameFromPackagePath(std::string pkg_path) {
   }
 }
 
+std::vector<std::string> ImportPathsOf(ast::Package* ast_package) {
+  std::vector<std::string> import_paths;
+  for (auto [_, ast_file] : ast_package->files()) {
+    for (ast::Decl* decl : ast_file->decls()) {
+      if (decl->node_kind() != ast::NodeKind::kGenDecl) {
+        continue;
+      }
+      ast::GenDecl* gen_decl = static_cast<ast::GenDecl*>(decl);
+      if (gen_decl->tok() != tokens::kImport) {
+        continue;
+      }
+      for (ast::Spec* spec : gen_decl->specs()) {
+        std::string path = static_cast<ast::ImportSpec*>(spec)->path()->value();
+        path = path.substr(1, path.length() - 2);
+        if (std::find(import_paths.begin(), import_paths.end(), path) == import_paths.end()) {
+          import_paths.push_back(path);
+        }
+      }
+    }
+  }
+  return import_paths;
+}
+
+std::map<std::string, std::string> ReadSourceFiles(
+    common::filesystem::Filesystem* filesystem, std::vector<std::filesystem::path> file_paths) {
+  std::map<std::string, std::string> sources;
+  for (std::filesystem::path file_path : file_paths) {
+    sources.insert({file_path.filename(), filesystem->ReadContentsOfFile(file_path)});
+  }
+  return sources;
+}
+
+// Returns the 64-bit FNV-1a hash of the package path and the names and contents of the source files
+// as a hexadecimal string.
+std::string HashPackageSources(std::string pkg_path,
+                               const std::map<std::string, std::string>& sources) {
+  uint64_t hash = 0xcbf29ce484222325;
+  auto add = [&hash](std::string_view str) {
+    std::string data = std::to_string(str.size()) + ":" + std::string(str);
+    for (char c : data) {
+      hash ^= uint8_t(c);
+      hash *= 0x100000001b3;
+    }
+  };
+  add(pkg_path);
+  for (auto& [file_name, file_contents] : sources) {
+    add(file_name);
+    add(file_contents);
+  }
+  char hash_str[17];
+  std::snprintf(hash_str, sizeof(hash_str), "%016llx", static_cast<unsigned long long>(hash));
+  return hash_str;
+}
+
 }  // namespace
 
-Package* PackageManager::LoadPackage(std::string pkg_path, std::filesystem::path pkg_directory) {
+std::optional<std::filesystem::path> PackageManager::FindPackageDirectory(std::string pkg_path) {
+  std::optional<std::filesystem::path> pkg_directory = LookupPackageDirectory(pkg_path);
+  if (!pkg_directory.has_value()) {
+    issue_tracker_.Add(issues::kPackageDirectoryNotFound, std::vector<pos_t>{},
+                       "package directory not found for: " + pkg_path);
+  }
+  return pkg_directory;
+}
+
+std::optional<std::filesystem::path> PackageManager::LookupPackageDirectory(
+    std::string pkg_path) const {
+  if (filesystem_->Exists(src_path_ / pkg_path) && filesystem_->IsDirectory(src_path_ / pkg_path)) {
+    return src_path_ / pkg_path;
+  } else if (filesystem_->Exists(stdlib_path_ / pkg_path) &&
+             filesystem_->IsDirectory(stdlib_path_ / pkg_path)) {
+    return stdlib_path_ / pkg_path;
+  }
+  return std::nullopt;
+}
+
+std::vector<std::filesystem::path> PackageManager::FindSourceFiles(
+    std::filesystem::path pkg_directory) {
   std::vector<std::filesystem::path> file_paths;
   filesystem_->ForEntriesInDirectory(pkg_directory, [&](std::filesystem::path entry) {
     if (entry.extension() == ".kat" && !filesystem_->IsDirectory(entry)) {
       file_paths.push_back(entry);
     }
   });
-  return LoadPackage(pkg_path, pkg_directory, file_paths);
+  return file_paths;
+}
+
+Package* PackageManager::LoadPackage(std::string pkg_path, std::filesystem::path pkg_directory) {
+  return LoadPackage(pkg_path, pkg_directory, FindSourceFiles(pkg_directory));
 }
 
 Package* PackageManager::LoadPackage(std::string pkg_path, std::filesystem::path pkg_directory,
                                      std::vector<std::filesystem::path> file_paths) {
+  if (Package* pkg = LoadPackageFromSummary(pkg_path, pkg_directory, file_paths); pkg != nullptr) {
+    return pkg;
+  }
+  switch (load_mode_) {
+    case LoadMode::kSequential:
+      return LoadPackageSequentially(pkg_path, pkg_directory, file_paths);
+    case LoadMode::kConcurrent:
+      return LoadPackagesConcurrently(pkg_path, pkg_directory, file_paths);
+  }
+}
+
+Package* PackageManager::CreatePackage(std::string pkg_path, std::filesystem::path pkg_directory,
+                                       std::vector<std::filesystem::path> file_paths) {
   Package* pkg;
   if (auto [it, insert_ok] =
           packages_.insert({pkg_path, std::unique_ptr<Package>(new Package(&file_set_))});
@@ -139,44 +243,416 @@ Package* PackageManager::LoadPackage(std::string pkg_path, std::filesystem::path
   pkg->name_ = NameFromPackagePath(pkg_path);
   pkg->path_ = pkg_path;
   pkg->directory_ = pkg_directory;
+  AddSourceFilesToPackage(pkg, file_paths);
+  return pkg;
+}
+
+void PackageManager::AddSourceFilesToPackage(Package* pkg,
+                                             std::vector<std::filesystem::path> file_paths) {
   if (file_paths.empty()) {
     pkg->issue_tracker_.Add(
         issues::kPackageDirectoryWithoutSourceFiles, std::vector<pos_t>{},
-        "package directory does not contain source files: " + pkg_directory.string());
-    return pkg;
+        "package directory does not contain source files: " + pkg->directory_.string());
+    return;
   }
   for (std::filesystem::path file_path : file_paths) {
     std::string file_name = file_path.filename();
     std::string file_contents = filesystem_->ReadContentsOfFile(file_path);
     pkg->pos_files_.push_back(file_set_.AddFile(file_name, file_contents));
   }
+}
 
-  ast::ASTBuilder ast_builder = ast_.builder();
-  std::map<std::string, ast::File*> ast_files;
+// A source file parsed independently of the other files in its package. Its nodes and issues get
+// added to the package once all files of the package are parsed.
+struct PackageManager::ParsedFile {
+  common::positions::File* pos_file;
+  ast::AST ast;
+  issues::IssueTracker issue_tracker;
+  ast::File* ast_file = nullptr;
+};
+
+std::vector<std::unique_ptr<PackageManager::ParsedFile>> PackageManager::ScheduleParsingPackage(
+    Package* pkg, common::concurrency::ThreadPool& thread_pool) {
+  std::vector<std::unique_ptr<ParsedFile>> parsed_files;
   for (common::positions::File* pos_file : pkg->pos_files_) {
-    ast::File* ast_file = parser::Parser::ParseFile(pos_file, ast_builder, pkg->issue_tracker_);
-    ast_files.insert({pos_file->name(), ast_file});
+    ParsedFile* parsed_file = parsed_files
+                                  .emplace_back(new ParsedFile{
+                                      .pos_file = pos_file,
+                                      .issue_tracker = issues::IssueTracker(&file_set_),
+                                  })
+                                  .get();
+    thread_pool.Schedule([parsed_file] {
+      ast::ASTBuilder ast_builder = parsed_file->ast.builder();
+      parsed_file->ast_file =
+          parser::Parser::ParseFile(parsed_file->pos_file, ast_builder, parsed_file->issue_tracker);
+    });
   }
-  pkg->ast_package_ = ast_builder.CreatePackage(pkg->name_, ast_files);
-  if (pkg->issue_tracker().has_fatal_errors()) {
-    return pkg;
+  return parsed_files;
+}
+
+void PackageManager::AddParsedFilesToPackage(
+    Package* pkg, std::vector<std::unique_ptr<ParsedFile>> parsed_files) {
+  if (parsed_files.empty()) {
+    return;
+  }
+  std::map<std::string, ast::File*> ast_files;
+  pkg->ast_ = std::make_unique<ast::AST>();
+  for (std::unique_ptr<ParsedFile>& parsed_file : parsed_files) {
+    pkg->ast_->Merge(std::move(parsed_file->ast));
+    pkg->issue_tracker_.Merge(std::move(parsed_file->issue_tracker));
+    ast_files.insert({parsed_file->pos_file->name(), parsed_file->ast_file});
+  }
+  pkg->ast_package_ = pkg->ast_->builder().CreatePackage(pkg->name_, ast_files);
+}
+
+std::string PackageManager::KeyOfPackage(std::string pkg_path,
+                                         std::vector<std::filesystem::path> file_paths) {
+  if (auto it = package_keys_.find(pkg_path); it != package_keys_.end()) {
+    return it->second;
+  }
+  std::string key = HashPackageSources(pkg_path, ReadSourceFiles(filesystem_, file_paths));
+  package_keys_.insert({pkg_path, key});
+  return key;
+}
+
+Package* PackageManager::LoadPackageFromSummary(std::string pkg_path,
+                                                std::filesystem::path pkg_directory,
+                                                std::vector<std::filesystem::path> file_paths) {
+  if (summary_cache_path_.empty() || pkg_path == "main" || file_paths.empty()) {
+    return nullptr;
   }
+  std::filesystem::path summary_path =
+      summary_cache_path_ / (KeyOfPackage(pkg_path, file_paths) + ".summary");
+  if (!filesystem_->Exists(summary_path)) {
+    return nullptr;
+  }
+  type_info_.builder().CreateUniverse();
+  packages_loading_from_summaries_.insert(pkg_path);
+  types::Package* types_package = summaries::ReadSummary(
+      filesystem_->ReadContentsOfFile(summary_path), pkg_path,
+      [this](std::string import_path, std::string key) {
+        return ImportPackageForSummary(import_path, key);
+      },
+      &type_info_);
+  packages_loading_from_summaries_.erase(pkg_path);
+  if (types_package == nullptr) {
+    return nullptr;
+  }
+  Package* pkg = packages_.insert({pkg_path, std::unique_ptr<Package>(new Package(&file_set_))})
+                     .first->second.get();
+  pkg->name_ = NameFromPackagePath(pkg_path);
+  pkg->path_ = pkg_path;
+  pkg->directory_ = pkg_directory;
+  pkg->types_package_ = types_package;
+  return pkg;
+}
 
+types::Package* PackageManager::ImportPackageForSummary(std::string pkg_path, std::string key) {
+  if (packages_loading_from_summaries_.contains(pkg_path)) {
+    return nullptr;
+  }
+  Package* pkg = GetPackage(pkg_path);
+  if (pkg == nullptr) {
+    // Imports only get loaded from their summaries, since packages loaded from source in the middle
+    // of a concurrent load could import packages that are not checked yet.
+    std::optional<std::filesystem::path> pkg_directory = LookupPackageDirectory(pkg_path);
+    if (!pkg_directory.has_value()) {
+      return nullptr;
+    }
+    pkg = LoadPackageFromSummary(pkg_path, *pkg_directory, FindSourceFiles(*pkg_directory));
+  }
+  if (pkg == nullptr || pkg->issue_tracker().has_errors() || pkg->types_package_ == nullptr) {
+    return nullptr;
+  }
+  if (auto it = package_keys_.find(pkg_path); it == package_keys_.end() || it->second != key) {
+    return nullptr;
+  }
+  return pkg->types_package_;
+}
+
+void PackageManager::WriteSummaryOfPackage(Package* pkg) {
+  if (summary_cache_path_.empty() || pkg->path_ == "main" || pkg->types_package_ == nullptr ||
+      pkg->issue_tracker().has_errors()) {
+    return;
+  }
+  auto it = package_keys_.find(pkg->path_);
+  if (it == package_keys_.end()) {
+    return;
+  }
+  std::string summary = summaries::WriteSummary(pkg->types_package_, [this](std::string pkg_path) {
+    auto key_it = package_keys_.find(pkg_path);
+    return key_it != package_keys_.end() ? key_it->second : "";
+  });
+  filesystem_->CreateDirectories(summary_cache_path_);
+  filesystem_->WriteContentsOfFile(summary_cache_path_ / (it->second + ".summary"), summary);
+}
+
+Package* PackageManager::LoadPackageSequentially(std::string pkg_path,
+                                                 std::filesystem::path pkg_directory,
+                                                 std::vector<std::filesystem::path> file_paths) {
+  Package* pkg = CreatePackage(pkg_path, pkg_directory, file_paths);
+  ParsePackage(pkg);
+  CheckPackage(pkg);
+  return pkg;
+}
+
+void PackageManager::ParsePackage(Package* pkg) {
+  if (pkg->pos_files_.empty()) {
+    return;
+  }
+  common::concurrency::ThreadPool thread_pool(std::min(
+      int64_t(pkg->pos_files_.size()), common::concurrency::ThreadPool::DefaultThreadCount()));
+  std::vector<std::unique_ptr<ParsedFile>> parsed_files = ScheduleParsingPackage(pkg, thread_pool);
+  thread_pool.Wait();
+  AddParsedFilesToPackage(pkg, std::move(parsed_files));
+}
+
+void PackageManager::CheckPackage(Package* pkg) {
+  if (pkg->ast_package_ == nullptr || pkg->issue_tracker().has_fatal_errors()) {
+    return;
+  }
   auto importer = [&](std::string import_path) -> types::Package* {
     Package* package = LoadPackage(import_path);
-    if (package->issue_tracker().has_errors()) {
+    if (package == nullptr || package->issue_tracker().has_errors()) {
       return nullptr;
     }
     return package->types_package_;
   };
-  types::Package* types_package =
-      type_checker::Check(pkg_path, pkg->ast_package_, importer, type_info(), pkg->issue_tracker_);
-  pkg->types_package_ = types_package;
+  pkg->types_package_ = type_checker::Check(pkg->path_, pkg->ast_package_, importer, type_info(),
+                                            pkg->issue_tracker_);
   if (pkg->issue_tracker().has_fatal_errors()) {
-    return pkg;
+    return;
   }
+  WriteSummaryOfPackage(pkg);
+}
 
-  return pkg;
+// A package that is being loaded concurrently with the AST and type info built for it separately.
+// Both get merged into the package manager once all packages in the import graph are processed.
+struct PackageManager::PendingPackage {
+  Package* package;
+  std::vector<std::unique_ptr<ParsedFile>> parsed_files;
+  types::Info type_info;
+
+  // Pending packages importing this package.
+  std::vector<PendingPackage*> importers;
+  // Number of pending packages imported by this package that are not checked yet.
+  int64_t unchecked_import_count = 0;
+  bool checked = false;
+};
+
+Package* PackageManager::LoadPackagesConcurrently(std::string pkg_path,
+                                                  std::filesystem::path pkg_directory,
+                                                  std::vector<std::filesystem::path> file_paths) {
+  common::concurrency::ThreadPool thread_pool;
+  std::vector<std::unique_ptr<PendingPackage>> pending_pkgs;
+  std::unordered_map<std::string, PendingPackage*> pending_pkgs_by_path;
+  auto add_pending_pkg = [&](Package* pkg) -> PendingPackage* {
+    PendingPackage* pending_pkg =
+        pending_pkgs.emplace_back(new PendingPackage{.package = pkg}).get();
+    pending_pkgs_by_path.insert({pkg->path(), pending_pkg});
+    return pending_pkg;
+  };
+
+  // Find all packages in the import graph layer by layer. All files of a layer get parsed
+  // concurrently, while reading files and adding them to the file set happens sequentially.
+  Package* root_pkg = CreatePackage(pkg_path, pkg_directory, file_paths);
+  std::vector<PendingPackage*> layer{add_pending_pkg(root_pkg)};
+  while (!layer.empty()) {
+    for (PendingPackage* pending_pkg : layer) {
+      pending_pkg->parsed_files = ScheduleParsingPackage(pending_pkg->package, thread_pool);
+    }
+    thread_pool.Wait();
+
+    std::vector<PendingPackage*> next_layer;
+    for (PendingPackage* pending_pkg : layer) {
+      Package* pkg = pending_pkg->package;
+      AddParsedFilesToPackage(pkg, std::move(pending_pkg->parsed_files));
+      if (pkg->ast_package_ == nullptr || pkg->issue_tracker().has_fatal_errors()) {
+        continue;
+      }
+      for (std::string import_path : ImportPathsOf(pkg->ast_package_)) {
+        PendingPackage* imported_pending_pkg;
+        if (auto it = pending_pkgs_by_path.find(import_path); it != pending_pkgs_by_path.end()) {
+          imported_pending_pkg = it->second;
+        } else if (GetPackage(import_path) != nullptr) {
+          // Packages loaded before are already checked.
+          continue;
+        } else if (std::optional<std::filesystem::path> imported_pkg_directory =
+                       FindPackageDirectory(import_path);
+                   imported_pkg_directory.has_value()) {
+          std::vector<std::filesystem::path> imported_file_paths =
+              FindSourceFiles(*imported_pkg_directory);
+          if (LoadPackageFromSummary(import_path, *imported_pkg_directory, imported_file_paths) !=
+              nullptr) {
+            continue;
+          }
+          Package* imported_pkg =
+              CreatePackage(import_path, *imported_pkg_directory, imported_file_paths);
+          imported_pending_pkg = add_pending_pkg(imported_pkg);
+          next_layer.push_back(imported_pending_pkg);
+        } else {
+          continue;
+        }
+        imported_pending_pkg->importers.push_back(pending_pkg);
+        pending_pkg->unchecked_import_count++;
+      }
+    }
+    layer = next_layer;
+  }
+
+  // Type check each package once all its imports are checked. All packages share the universe of
+  // the package manager's type info.
+  type_info_.builder().CreateUniverse();
+  for (auto& pending_pkg : pending_pkgs) {
+    pending_pkg->type_info.builder().ShareUniverseOf(&type_info_);
+  }
+  auto importer = [this](std::string import_path) -> types::Package* {
+    Package* imported_pkg = GetPackage(import_path);
+    if (imported_pkg == nullptr || imported_pkg->issue_tracker().has_errors()) {
+      return nullptr;
+    }
+    return imported_pkg->types_package_;
+  };
+  std::mutex mutex;
+  std::vector<PendingPackage*> checked_pending_pkgs;
+  std::function<void(PendingPackage*)> check = [&](PendingPackage* pending_pkg) {
+    Package* pkg = pending_pkg->package;
+    if (pkg->ast_package_ != nullptr && !pkg->issue_tracker().has_fatal_errors()) {
+      pkg->types_package_ = type_checker::Check(pkg->path_, pkg->ast_package_, importer,
+                                                &pending_pkg->type_info, pkg->issue_tracker_);
+    }
+    std::scoped_lock lock(mutex);
+    pending_pkg->checked = true;
+    checked_pending_pkgs.push_back(pending_pkg);
+    for (PendingPackage* importer_pending_pkg : pending_pkg->importers) {
+      if (--importer_pending_pkg->unchecked_import_count == 0 && !importer_pending_pkg->checked) {
+        thread_pool.Schedule([&check, importer_pending_pkg] { check(importer_pending_pkg); });
+      }
+    }
+  };
+  for (auto& pending_pkg : pending_pkgs) {
+    if (pending_pkg->unchecked_import_count == 0) {
+      thread_pool.Schedule([&check, &pending_pkg] { check(pending_pkg.get()); });
+    }
+  }
+  thread_pool.Wait();
+  // Packages in import cycles never become ready. As in sequential mode, they get checked one after
+  // the other and fail to import packages that are not checked yet.
+  for (auto& pending_pkg : pending_pkgs) {
+    if (!pending_pkg->checked) {
+      check(pending_pkg.get());
+      thread_pool.Wait();
+    }
+  }
+
+  // Packages are checked after their imports, so initializers stay in a valid order.
+  for (PendingPackage* pending_pkg : checked_pending_pkgs) {
+    type_info_.Merge(std::move(pending_pkg->type_info));
+  }
+  for (PendingPackage* pending_pkg : checked_pending_pkgs) {
+    WriteSummaryOfPackage(pending_pkg->package);
+  }
+  return root_pkg;
+}
+
+std::vector<Package*> PackageManager::ReloadChangedPackages() {
+  std::vector<Package*> reloaded_pkgs;
+  for (auto& [_, pkg] : packages_) {
+    if (HaveSourceFilesChanged(pkg.get())) {
+      reloaded_pkgs.push_back(pkg.get());
+    }
+  }
+  std::unordered_set<Package*> changed_pkgs(reloaded_pkgs.begin(), reloaded_pkgs.end());
+  for (size_t i = 0; i < reloaded_pkgs.size(); i++) {
+    for (auto& [_, pkg] : packages_) {
+      if (!changed_pkgs.contains(pkg.get()) && ImportsPackage(pkg.get(), reloaded_pkgs.at(i))) {
+        changed_pkgs.insert(pkg.get());
+        reloaded_pkgs.push_back(pkg.get());
+      }
+    }
+  }
+  std::sort(reloaded_pkgs.begin(), reloaded_pkgs.end(),
+            [](Package* a, Package* b) { return a->path_ < b->path_; });
+
+  // Remove the type information of all reloaded packages first, since it refers to the type
+  // information of the packages they import. This includes packages that failed type checking.
+  std::unordered_map<std::string, types::Package*> types_pkgs;
+  for (types::Package* types_pkg : type_info_.packages()) {
+    types_pkgs.insert({types_pkg->path(), types_pkg});
+  }
+  for (Package* pkg : reloaded_pkgs) {
+    if (auto it = types_pkgs.find(pkg->path_); it != types_pkgs.end()) {
+      type_info_.builder().RemovePackage(it->second, pkg->ast_package_);
+    }
+  }
+  type_info_.builder().RemoveUnreachableTypesAndObjects();
+  for (Package* pkg : reloaded_pkgs) {
+    packages_to_reload_.insert(pkg);
+  }
+  for (Package* pkg : reloaded_pkgs) {
+    if (packages_to_reload_.contains(pkg)) {
+      ReloadPackage(pkg);
+    }
+  }
+  return reloaded_pkgs;
+}
+
+std::vector<std::filesystem::path> PackageManager::SourceFilesOfPackage(Package* pkg) {
+  if (pkg->path_ == "main" && !main_file_paths_.empty()) {
+    return main_file_paths_;
+  } else if (!filesystem_->IsDirectory(pkg->directory_)) {
+    return {};
+  }
+  return FindSourceFiles(pkg->directory_);
+}
+
+bool PackageManager::HaveSourceFilesChanged(Package* pkg) {
+  std::map<std::string, std::string> sources =
+      ReadSourceFiles(filesystem_, SourceFilesOfPackage(pkg));
+  if (pkg->pos_files_.empty() && pkg->types_package_ != nullptr) {
+    // The package was loaded from its summary.
+    auto it = package_keys_.find(pkg->path_);
+    return it == package_keys_.end() || it->second != HashPackageSources(pkg->path_, sources);
+  }
+  std::map<std::string, std::string> loaded_sources;
+  for (common::positions::File* pos_file : pkg->pos_files_) {
+    loaded_sources.insert({pos_file->name(), pos_file->contents()});
+  }
+  return sources != loaded_sources;
+}
+
+bool PackageManager::ImportsPackage(Package* importer, Package* imported) {
+  if (importer->ast_package_ != nullptr) {
+    std::vector<std::string> import_paths = ImportPathsOf(importer->ast_package_);
+    return std::find(import_paths.begin(), import_paths.end(), imported->path_) !=
+           import_paths.end();
+  } else if (importer->types_package_ != nullptr) {
+    return std::any_of(importer->types_package_->imports().begin(),
+                       importer->types_package_->imports().end(),
+                       [imported](types::Package* import) {
+                         return import->path() == imported->path_;
+                       });
+  }
+  return false;
+}
+
+void PackageManager::ReloadPackage(Package* pkg) {
+  packages_to_reload_.erase(pkg);
+  pkg->issue_tracker_ = issues::IssueTracker(&file_set_);
+  pkg->types_package_ = nullptr;
+  if (pkg->ast_package_ == nullptr || HaveSourceFilesChanged(pkg)) {
+    std::vector<std::filesystem::path> file_paths = SourceFilesOfPackage(pkg);
+    pkg->pos_files_.clear();
+    pkg->ast_package_ = nullptr;
+    pkg->ast_ = nullptr;
+    package_keys_.erase(pkg->path_);
+    if (!summary_cache_path_.empty() && !file_paths.empty()) {
+      KeyOfPackage(pkg->path_, file_paths);
+    }
+    AddSourceFilesToPackage(pkg, file_paths);
+    ParsePackage(pkg);
+  }
+  CheckPackage(pkg);
 }
 
 }  // namespace packages
@@ -11,10 +11,13 @@
 
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "src/common/concurrency/thread_pool.h"
 #include "src/common/filesystem/filesystem.h"
 #include "src/common/positions/positions.h"
 #include "src/lang/processors/issues/issues.h"
@@ -27,6 +30,15 @@ namespace packages {
 
 class PackageManager {
  public:
+  // Determines how a package and the packages it imports get loaded.
+  enum class LoadMode {
+    // Parses and type checks each package when it gets imported by another package.
+    kSequential,
+    // Finds all packages in the import graph first. Then parses the files of the found packages and
+    // type checks packages whose imports are already checked concurrently.
+    kConcurrent,
+  };
+
   PackageManager(common::filesystem::Filesystem* filesystem, std::filesystem::path stdlib_path,
                  std::filesystem::path src_path)
       : filesystem_(filesystem),
@@ -37,9 +49,20 @@ class PackageManager {
   std::filesystem::path stdlib_path() const { return stdlib_path_; }
   std::filesystem::path src_path() const { return src_path_; }
 
+  LoadMode load_mode() const { return load_mode_; }
+  void set_load_mode(LoadMode load_mode) { load_mode_ = load_mode; }
+
+  // Directory storing summaries of type checked packages. Packages other than the main package get
+  // recreated from their summary without parsing and type checking them if neither their source
+  // files nor the packages they depend on changed. Such packages have no AST package. Summaries get
+  // written for packages without errors. An empty path disables the cache.
+  std::filesystem::path summary_cache_path() const { return summary_cache_path_; }
+  void set_summary_cache_path(std::filesystem::path summary_cache_path) {
+    summary_cache_path_ = summary_cache_path;
+  }
+
   const common::positions::FileSet* file_set() const { return &file_set_; }
   const issues::IssueTracker* issue_tracker() const { return &issue_tracker_; }
-  const ast::AST* ast() const { return &ast_; }
   const types::Info* type_info() const { return &type_info_; }
   types::Info* type_info() { return &type_info_; }
 
@@ -63,23 +86,81 @@ class PackageManager {
   // issue tracker.
   Package* LoadMainPackage(std::vector<std::filesystem::path> main_file_paths);
 
+  // Reloads all loaded packages whose source files changed since they were loaded, together with
+  // all packages importing them. Changed packages get parsed and type checked again. Packages that
+  // only import changed packages keep their AST and only get type checked again. All other packages
+  // keep their AST and type information. Pointers to reloaded packages stay valid. Returns the
+  // reloaded packages.
+  //
+  // The previous ASTs of changed packages and all types and objects no longer referenced by the
+  // remaining packages get freed. The file set keeps the previous contents of changed source files,
+  // since positions can refer to them, so memory grows by the size of each changed file per reload.
+  std::vector<Package*> ReloadChangedPackages();
+
  private:
+  struct ParsedFile;
+  struct PendingPackage;
+
   bool CheckAllFilesAreInMainDirectory(std::vector<std::filesystem::path>& file_paths);
   bool CheckAllFilesInMainPackageExist(std::vector<std::filesystem::path>& file_paths);
 
   Package* LoadPackage(std::string pkg_path, std::filesystem::path pkg_directory);
   Package* LoadPackage(std::string pkg_path, std::filesystem::path pkg_directory,
                        std::vector<std::filesystem::path> file_paths);
+  Package* LoadPackageSequentially(std::string pkg_path, std::filesystem::path pkg_directory,
+                                   std::vector<std::filesystem::path> file_paths);
+  Package* LoadPackagesConcurrently(std::string pkg_path, std::filesystem::path pkg_directory,
+                                    std::vector<std::filesystem::path> file_paths);
+
+  // Returns the directory of the package with the given package path. If the directory does not
+  // exist, an issue gets added to the package manager's issue tracker and nullopt gets returned.
+  std::optional<std::filesystem::path> FindPackageDirectory(std::string pkg_path);
+  std::optional<std::filesystem::path> LookupPackageDirectory(std::string pkg_path) const;
+  std::vector<std::filesystem::path> FindSourceFiles(std::filesystem::path pkg_directory);
+  // Adds a new package and its source files to the file set, without parsing them.
+  Package* CreatePackage(std::string pkg_path, std::filesystem::path pkg_directory,
+                         std::vector<std::filesystem::path> file_paths);
+  void AddSourceFilesToPackage(Package* pkg, std::vector<std::filesystem::path> file_paths);
+  // Schedules parsing each source file of the package into its own AST and issue tracker.
+  std::vector<std::unique_ptr<ParsedFile>> ScheduleParsingPackage(
+      Package* pkg, common::concurrency::ThreadPool& thread_pool);
+  // Moves the parsed files into the package manager's AST and their issues into the package's issue
+  // tracker, both in file order, and creates the AST package.
+  void AddParsedFilesToPackage(Package* pkg,
+                               std::vector<std::unique_ptr<ParsedFile>> parsed_files);
+  void ParsePackage(Package* pkg);
+  void CheckPackage(Package* pkg);
+
+  std::vector<std::filesystem::path> SourceFilesOfPackage(Package* pkg);
+  bool HaveSourceFilesChanged(Package* pkg);
+  bool ImportsPackage(Package* importer, Package* imported);
+  void ReloadPackage(Package* pkg);
+
+  // Returns the key identifying the given source files of the package.
+  std::string KeyOfPackage(std::string pkg_path, std::vector<std::filesystem::path> file_paths);
+  // Recreates the package from its cached summary. Returns nullptr if the cache is disabled or has
+  // no up-to-date summary for the package.
+  Package* LoadPackageFromSummary(std::string pkg_path, std::filesystem::path pkg_directory,
+                                  std::vector<std::filesystem::path> file_paths);
+  // Returns the package with the given package path if it is loaded or can be loaded without
+  // errors and has the given key.
+  types::Package* ImportPackageForSummary(std::string pkg_path, std::string key);
+  void WriteSummaryOfPackage(Package* pkg);
 
   common::filesystem::Filesystem* filesystem_;
   std::filesystem::path stdlib_path_;
   std::filesystem::path src_path_;
+  LoadMode load_mode_ = LoadMode::kSequential;
+  std::filesystem::path summary_cache_path_;
 
   common::positions::FileSet file_set_;
   issues::IssueTracker issue_tracker_;
-  ast::AST ast_;
   types::Info type_info_;
   std::unordered_map<std::string, std::unique_ptr<Package>> packages_;
+  std::unordered_map<std::string, std::string> package_keys_;
+  std::unordered_set<std::string> packages_loading_from_summaries_;
+  std::vector<std::filesystem::path> main_file_paths_;
+  std::unordered_set<Package*> packages_to_reload_;
 };
 
 }  // namespace packages
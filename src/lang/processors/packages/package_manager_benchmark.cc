@@ -0,0 +1,119 @@
+//
+//  package_manager_benchmark.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/17/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "src/common/filesystem/test_filesystem.h"
+#include "src/lang/processors/packages/package.h"
+#include "src/lang/processors/packages/package_manager.h"
+
+namespace {
+
+using ::common::filesystem::TestFilesystem;
+using ::lang::packages::Package;
+using ::lang::packages::PackageManager;
+
+constexpr int64_t kFuncsPerFile = 16;
+constexpr int64_t kFilesPerBasePackage = 16;
+
+// Generates a source file of the given package with functions calling each other and the
+// functions of the imported package, if any. The version changes a constant in the first function,
+// as an edit in an editor would.
+std::string GenerateFile(std::string pkg_name, std::string import_name, int64_t file,
+                         int64_t version) {
+  std::stringstream code;
+  code << "package " << pkg_name << "\n\n";
+  if (!import_name.empty()) {
+    code << "import \"" << import_name << "\"\n\n";
+  }
+  code << "type S" << file << " struct {\n  x, y int\n}\n\n";
+  for (int64_t func = 0; func < kFuncsPerFile; func++) {
+    code << "func F" << file << "_" << func << "(a, b int) int {\n";
+    code << "  s := S" << file << "{x: a, y: b + " << (func == 0 ? version : func) << "}\n";
+    code << "  if s.x < s.y {\n    return s.y - s.x\n  }\n";
+    if (func > 0) {
+      code << "  c := F" << file << "_" << (func - 1) << "(s.x, s.y)\n";
+    } else {
+      code << "  c := s.x * s.y\n";
+    }
+    if (!import_name.empty()) {
+      code << "  c += " << import_name << ".F0_" << func << "(a, c)\n";
+    }
+    code << "  return c\n}\n\n";
+  }
+  return code.str();
+}
+
+// Sets up main importing lib, which has the given number of files and imports base.
+void WritePackages(TestFilesystem& filesystem, int64_t lib_files) {
+  filesystem.CreateDirectory("stdlib");
+  filesystem.CreateDirectory("stdlib/base");
+  filesystem.CreateDirectory("stdlib/lib");
+  for (int64_t file = 0; file < kFilesPerBasePackage; file++) {
+    filesystem.WriteContentsOfFile("stdlib/base/base" + std::to_string(file) + ".kat",
+                                   GenerateFile("base", "", file, /*version=*/0));
+  }
+  for (int64_t file = 0; file < lib_files; file++) {
+    filesystem.WriteContentsOfFile("stdlib/lib/lib" + std::to_string(file) + ".kat",
+                                   GenerateFile("lib", "base", file, /*version=*/0));
+  }
+  filesystem.WriteContentsOfFile("main.kat", R"kat(
+package main
+
+import "lib"
+
+func main() {
+  lib.F0_0(1, 2)
+}
+  )kat");
+}
+
+bool HasIssues(PackageManager& pkg_manager) {
+  if (!pkg_manager.issue_tracker()->issues().empty()) {
+    return true;
+  }
+  for (Package* pkg : pkg_manager.Packages()) {
+    if (!pkg->issue_tracker().issues().empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Measures the latency of reloading after a single file of lib changed. This parses and checks lib
+// and main again, while base keeps its AST and type information.
+void BM_ReloadSingleChangedFile(benchmark::State& state) {
+  TestFilesystem filesystem;
+  WritePackages(filesystem, state.range(0));
+  PackageManager pkg_manager(&filesystem, /*stdlib_path=*/"stdlib", /*src_path=*/"");
+  pkg_manager.LoadMainPackage("/");
+  if (HasIssues(pkg_manager)) {
+    state.SkipWithError("generated packages have issues");
+    return;
+  }
+  int64_t version = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    filesystem.WriteContentsOfFile("stdlib/lib/lib0.kat",
+                                   GenerateFile("lib", "base", /*file=*/0, ++version));
+    state.ResumeTiming();
+    std::vector<Package*> reloaded_pkgs = pkg_manager.ReloadChangedPackages();
+    if (reloaded_pkgs.size() != 2 || HasIssues(pkg_manager)) {
+      state.SkipWithError("reload failed");
+      break;
+    }
+    benchmark::DoNotOptimize(reloaded_pkgs);
+  }
+}
+BENCHMARK(BM_ReloadSingleChangedFile)->Arg(1)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,333 @@
+//
+//  package_manager_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/lang/processors/packages/package_manager.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/common/filesystem/test_filesystem.h"
+#include "src/common/positions/positions.h"
+#include "src/lang/processors/packages/package.h"
+#include "src/lang/representation/ast/ast.h"
+#include "src/lang/representation/types/info.h"
+#include "src/lang/representation/types/objects.h"
+#include "src/lang/representation/types/package.h"
+#include "src/lang/representation/types/scope.h"
+#include "src/lang/representation/types/types.h"
+
+namespace lang {
+namespace packages {
+namespace {
+
+using ::common::filesystem::TestFilesystem;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+// Sets up main importing a and b, which both import c.
+void WriteDiamondImportGraph(TestFilesystem& filesystem) {
+  filesystem.CreateDirectory("stdlib");
+  filesystem.CreateDirectory("stdlib/a");
+  filesystem.CreateDirectory("stdlib/b");
+  filesystem.CreateDirectory("stdlib/c");
+  filesystem.WriteContentsOfFile("stdlib/c/c.kat", R"kat(
+package c
+
+type Box<T> struct {
+  Value T
+}
+
+var Count int = 1
+
+func Get() int {
+  return Count
+}
+  )kat");
+  filesystem.WriteContentsOfFile("stdlib/a/a.kat", R"kat(
+package a
+
+import "c"
+
+var X int = c.Get() + 1
+
+func Wrap(v int) c.Box<int> {
+  return c.Box<int>{Value: v}
+}
+  )kat");
+  filesystem.WriteContentsOfFile("stdlib/b/b.kat", R"kat(
+package b
+
+import "c"
+
+var Y int = c.Get() + 2
+
+func Unwrap(b c.Box<int>) int {
+  return b.Value
+}
+  )kat");
+  filesystem.WriteContentsOfFile("main.kat", R"kat(
+package main
+
+import (
+  "a"
+  "b"
+)
+
+func main() {
+  b.Unwrap(a.Wrap(a.X + b.Y))
+}
+  )kat");
+}
+
+void ExpectDiamondImportGraphLoaded(PackageManager& pkg_manager, Package* main_pkg) {
+  EXPECT_THAT(pkg_manager.issue_tracker()->issues(), IsEmpty());
+  ASSERT_NE(main_pkg, nullptr);
+  EXPECT_THAT(pkg_manager.Packages(), SizeIs(4));
+  for (Package* pkg : pkg_manager.Packages()) {
+    EXPECT_THAT(pkg->issue_tracker().issues(), IsEmpty()) << pkg->path();
+    EXPECT_NE(pkg->ast_package(), nullptr) << pkg->path();
+    EXPECT_NE(pkg->types_package(), nullptr) << pkg->path();
+  }
+  EXPECT_THAT(pkg_manager.type_info()->packages(), SizeIs(4));
+  EXPECT_THAT(pkg_manager.type_info()->init_order(), SizeIs(3));
+}
+
+TEST(PackageManagerTest, LoadsImportGraphSequentially) {
+  TestFilesystem filesystem;
+  WriteDiamondImportGraph(filesystem);
+  PackageManager pkg_manager(&filesystem, /*stdlib_path=*/"stdlib", /*src_path=*/"");
+
+  Package* main_pkg = pkg_manager.LoadMainPackage("/");
+
+  ExpectDiamondImportGraphLoaded(pkg_manager, main_pkg);
+}
+
+TEST(PackageManagerTest, LoadsImportGraphConcurrently) {
+  TestFilesystem filesystem;
+  WriteDiamondImportGraph(filesystem);
+  PackageManager pkg_manager(&filesystem, /*stdlib_path=*/"stdlib", /*src_path=*/"");
+  pkg_manager.set_load_mode(PackageManager::LoadMode::kConcurrent);
+
+  Package* main_pkg = pkg_manager.LoadMainPackage("/");
+
+  ExpectDiamondImportGraphLoaded(pkg_manager, main_pkg);
+}
+
+TEST(PackageManagerTest, ConcurrentlyLoadsPackagesMissingFromPreviousLoads) {
+  TestFilesystem filesystem;
+  WriteDiamondImportGraph(filesystem);
+  PackageManager pkg_manager(&filesystem, /*stdlib_path=*/"stdlib", /*src_path=*/"");
+  pkg_manager.set_load_mode(PackageManager::LoadMode::kConcurrent);
+
+  EXPECT_NE(pkg_manager.LoadPackage("a"), nullptr);
+  EXPECT_THAT(pkg_manager.Packages(), SizeIs(2));
+  Package* main_pkg = pkg_manager.LoadMainPackage("/");
+
+  ExpectDiamondImportGraphLoaded(pkg_manager, main_pkg);
+}
+
+void ExpectPackagesLoadedFromSummaries(PackageManager& pkg_manager, Package* main_pkg,
+                                       std::vector<std::string> summary_pkg_paths) {
+  EXPECT_THAT(pkg_manager.issue_tracker()->issues(), IsEmpty());
+  ASSERT_NE(main_pkg, nullptr);
+  EXPECT_THAT(pkg_manager.Packages(), SizeIs(4));
+  for (Package* pkg : pkg_manager.Packages()) {
+    bool from_summary = std::find(summary_pkg_paths.begin(), summary_pkg_paths.end(),
+                                  pkg->path()) != summary_pkg_paths.end();
+    EXPECT_THAT(pkg->issue_tracker().issues(), IsEmpty()) << pkg->path();
+    EXPECT_EQ(pkg->ast_package() == nullptr, from_summary) << pkg->path();
+    EXPECT_NE(pkg->types_package(), nullptr) << pkg->path();
+  }
+}
+
+TEST(PackageManagerTest, LoadsUnchangedPackagesFromSummaries) {
+  for (PackageManager::LoadMode load_mode :
+       {PackageManager::LoadMode::kSequential, PackageManager::LoadMode::kConcurrent}) {
+    TestFilesystem filesystem;
+    WriteDiamondImportGraph(filesystem);
+    PackageManager first_pkg_manager(&filesystem, /*stdlib_path=*/"stdlib", /*src_path=*/"");
+    first_pkg_manager.set_load_mode(load_mode);
+    first_pkg_manager.set_summary_cache_path("/cache");
+    ExpectDiamondImportGraphLoaded(first_pkg_manager, first_pkg_manager.LoadMainPackage("/"));
+
+    PackageManager second_pkg_manager(&filesystem, /*stdlib_path=*/"stdlib", /*src_path=*/"");
+    second_pkg_manager.set_load_mode(load_mode);
+    second_pkg_manager.set_summary_cache_path("/cache");
+    Package* main_pkg = second_pkg_manager.LoadMainPackage("/");
+
+    ExpectPackagesLoadedFromSummaries(second_pkg_manager, main_pkg, {"a", "b", "c"});
+  }
+}
+
+TEST(PackageManagerTest, ReloadsChangedPackagesAndTheirImportersFromSource) {
+  TestFilesystem filesystem;
+  WriteDiamondImportGraph(filesystem);
+  PackageManager first_pkg_manager(&filesystem, /*stdlib_path=*/"stdlib", /*src_path=*/"");
+  first_pkg_manager.set_summary_cache_path("/cache");
+  ExpectDiamondImportGraphLoaded(first_pkg_manager, first_pkg_manager.LoadMainPackage("/"));
+
+  filesystem.WriteContentsOfFile("stdlib/b/b.kat",
+                                 filesystem.ReadContentsOfFile("stdlib/b/b.kat") + "\n");
+  PackageManager second_pkg_manager(&filesystem, /*stdlib_path=*/"stdlib", /*src_path=*/"");
+  second_pkg_manager.set_summary_cache_path("/cache");
+  ExpectPackagesLoadedFromSummaries(second_pkg_manager, second_pkg_manager.LoadMainPackage("/"),
+                                    {"a", "c"});
+
+  filesystem.WriteContentsOfFile("stdlib/c/c.kat",
+                                 filesystem.ReadContentsOfFile("stdlib/c/c.kat") + R"kat(
+func Set(count int) {
+  Count = count
+}
+  )kat");
+  PackageManager third_pkg_manager(&filesystem, /*stdlib_path=*/"stdlib", /*src_path=*/"");
+  third_pkg_manager.set_summary_cache_path("/cache");
+  ExpectPackagesLoadedFromSummaries(third_pkg_manager, third_pkg_manager.LoadMainPackage("/"), {});
+}
+
+std::vector<std::string> PathsOf(std::vector<Package*> pkgs) {
+  std::vector<std::string> paths;
+  for (Package* pkg : pkgs) {
+    paths.push_back(pkg->path());
+  }
+  return paths;
+}
+
+TEST(PackageManagerTest, ReloadsChangedPackagesAndTheirImporters) {
+  TestFilesystem filesystem;
+  WriteDiamondImportGraph(filesystem);
+  PackageManager pkg_manager(&filesystem, /*stdlib_path=*/"stdlib", /*src_path=*/"");
+  Package* main_pkg = pkg_manager.LoadMainPackage("/");
+  ExpectDiamondImportGraphLoaded(pkg_manager, main_pkg);
+  Package* a_pkg = pkg_manager.GetPackage("a");
+  Package* b_pkg = pkg_manager.GetPackage("b");
+  ast::Package* a_ast_package = a_pkg->ast_package();
+  types::Package* a_types_package = a_pkg->types_package();
+  ast::Package* main_ast_package = main_pkg->ast_package();
+
+  EXPECT_THAT(pkg_manager.ReloadChangedPackages(), IsEmpty());
+
+  filesystem.WriteContentsOfFile("stdlib/b/b.kat", R"kat(
+package b
+
+import "c"
+
+var Y int = c.Get() + 3
+
+func Unwrap(b c.Box<int>) int {
+  return b.Value + 1
+}
+  )kat");
+
+  EXPECT_THAT(PathsOf(pkg_manager.ReloadChangedPackages()), ElementsAre("b", "main"));
+  ExpectDiamondImportGraphLoaded(pkg_manager, main_pkg);
+  EXPECT_EQ(a_pkg->ast_package(), a_ast_package);
+  EXPECT_EQ(a_pkg->types_package(), a_types_package);
+  types::Object* y = b_pkg->types_package()->scope()->Lookup("Y");
+  ASSERT_NE(y, nullptr);
+  EXPECT_EQ(pkg_manager.file_set()->FileAt(y->position()), b_pkg->pos_files().front());
+  EXPECT_EQ(main_pkg->ast_package(), main_ast_package);
+}
+
+TEST(PackageManagerTest, ReloadsPackagesInstantiatingGenericTypesOfImports) {
+  TestFilesystem filesystem;
+  WriteDiamondImportGraph(filesystem);
+  PackageManager pkg_manager(&filesystem, /*stdlib_path=*/"stdlib", /*src_path=*/"");
+  Package* main_pkg = pkg_manager.LoadMainPackage("/");
+  ExpectDiamondImportGraphLoaded(pkg_manager, main_pkg);
+  Package* b_pkg = pkg_manager.GetPackage("b");
+
+  // Each version of b instantiates c.Box with a new type of b, which replaces the instance of the
+  // previous version.
+  for (int version = 0; version < 3; version++) {
+    filesystem.WriteContentsOfFile("stdlib/b/b.kat", R"kat(
+package b
+
+import "c"
+
+type Count int
+
+var Y int = c.Get() + )kat" + std::to_string(version) + R"kat(
+
+func Unwrap(b c.Box<int>) int {
+  counted := c.Box<Count>{Value: Count(b.Value)}
+  return int(counted.Value)
+}
+  )kat");
+
+    EXPECT_THAT(PathsOf(pkg_manager.ReloadChangedPackages()), ElementsAre("b", "main"));
+    ExpectDiamondImportGraphLoaded(pkg_manager, main_pkg);
+    types::Object* count = b_pkg->types_package()->scope()->Lookup("Count");
+    ASSERT_NE(count, nullptr);
+    EXPECT_EQ(pkg_manager.file_set()->FileAt(count->position()), b_pkg->pos_files().front());
+  }
+}
+
+TEST(PackageManagerTest, ReloadsPackagesUntilErrorsAreFixed) {
+  TestFilesystem filesystem;
+  WriteDiamondImportGraph(filesystem);
+  PackageManager pkg_manager(&filesystem, /*stdlib_path=*/"stdlib", /*src_path=*/"");
+  Package* main_pkg = pkg_manager.LoadMainPackage("/");
+  ExpectDiamondImportGraphLoaded(pkg_manager, main_pkg);
+  std::string main_source = filesystem.ReadContentsOfFile("main.kat");
+
+  filesystem.WriteContentsOfFile("main.kat", main_source + "var broken = [}\n");
+
+  EXPECT_THAT(PathsOf(pkg_manager.ReloadChangedPackages()), ElementsAre("main"));
+  EXPECT_THAT(main_pkg->issue_tracker().issues(), Not(IsEmpty()));
+  EXPECT_EQ(main_pkg->types_package(), nullptr);
+  EXPECT_THAT(pkg_manager.type_info()->packages(), SizeIs(3));
+
+  filesystem.WriteContentsOfFile("main.kat", main_source);
+
+  EXPECT_THAT(PathsOf(pkg_manager.ReloadChangedPackages()), ElementsAre("main"));
+  ExpectDiamondImportGraphLoaded(pkg_manager, main_pkg);
+}
+
+TEST(PackageManagerTest, ReportsParserIssuesInFileOrder) {
+  TestFilesystem filesystem;
+  filesystem.WriteContentsOfFile("a.kat", R"kat(
+package main
+
+var x = [}
+  )kat");
+  filesystem.WriteContentsOfFile("b.kat", R"kat(
+package main
+
+func main() {
+}
+  )kat");
+  filesystem.WriteContentsOfFile("c.kat", R"kat(
+package main
+
+var y = (}
+  )kat");
+  PackageManager pkg_manager(&filesystem, /*stdlib_path=*/"", /*src_path=*/"");
+
+  Package* main_pkg = pkg_manager.LoadMainPackage(
+      std::vector<std::filesystem::path>{"/a.kat", "/b.kat", "/c.kat"});
+
+  ASSERT_NE(main_pkg, nullptr);
+  ASSERT_NE(main_pkg->ast_package(), nullptr);
+  EXPECT_THAT(main_pkg->ast_package()->files(), SizeIs(3));
+  std::vector<std::string> issue_file_names;
+  for (const issues::Issue& issue : main_pkg->issue_tracker().issues()) {
+    issue_file_names.push_back(
+        pkg_manager.file_set()->FileAt(issue.positions().front().start)->name());
+  }
+  EXPECT_THAT(issue_file_names, ElementsAre("a.kat", "a.kat", "c.kat", "c.kat"));
+}
+
+}  // namespace
+}  // namespace packages
+}  // namespace lang
@@ -0,0 +1,101 @@
+//
+//  parser_benchmark.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "src/common/positions/positions.h"
+#include "src/lang/processors/issues/issues.h"
+#include "src/lang/processors/parser/parser.h"
+#include "src/lang/representation/ast/ast.h"
+#include "src/lang/representation/ast/ast_builder.h"
+#include "src/lang/testing/code_generator.h"
+
+namespace {
+
+using ::lang::testing::AtomGenerator;
+using ::lang::testing::CombinationGenerator;
+using ::lang::testing::Context;
+using ::lang::testing::Generator;
+
+constexpr int kStmtsPerFunc = 8;
+
+// Generates a syntactically valid source file of at least the given size, consisting of functions
+// with assignment and if statements over generated binary expressions.
+std::string GenerateSource(int64_t min_size) {
+  std::vector<std::string> operands{"a", "b", "c", "42", "x[i]", "f(a, b)", "s.field", "(a - 1)"};
+  std::vector<std::string> operators{" + ", " - ", " * ", " < ", " == ", " && ", " << "};
+  AtomGenerator operand_generator(operands);
+  AtomGenerator operator_generator(operators);
+  std::vector<Generator*> expr_items{&operand_generator, &operator_generator, &operand_generator,
+                                     &operator_generator, &operand_generator};
+  CombinationGenerator expr_generator(expr_items);
+
+  std::vector<std::string> assign_prefixes{"\tv := ", "\ta = ", "\tx[i] += "};
+  std::vector<std::string> line_end{"\n"};
+  AtomGenerator assign_prefix_generator(assign_prefixes);
+  AtomGenerator line_end_generator(line_end);
+  std::vector<Generator*> assign_items{&assign_prefix_generator, &expr_generator,
+                                       &line_end_generator};
+  CombinationGenerator assign_generator(assign_items);
+
+  std::vector<std::string> if_start{"\tif "};
+  std::vector<std::string> if_middle{" {\n\t\treturn "};
+  std::vector<std::string> if_end{"\n\t}\n"};
+  AtomGenerator if_start_generator(if_start);
+  AtomGenerator if_middle_generator(if_middle);
+  AtomGenerator if_end_generator(if_end);
+  std::vector<Generator*> if_items{&if_start_generator, &expr_generator, &if_middle_generator,
+                                   &expr_generator, &if_end_generator};
+  CombinationGenerator if_generator(if_items);
+
+  Context ctx(3);
+  int num_assign_options = assign_generator.NumOptions(ctx);
+  int num_if_options = if_generator.NumOptions(ctx);
+
+  std::stringstream code;
+  code << "package main\n\n";
+  for (int64_t func = 0; code.tellp() < min_size; func++) {
+    code << "func f" << func << "(a, b, c int) int {\n";
+    for (int64_t stmt = 0; stmt < kStmtsPerFunc; stmt++) {
+      // Spread the indices so consecutive statements differ in all of their parts.
+      int64_t index = (func * kStmtsPerFunc + stmt) * 7919;
+      if (stmt % 2 == 0) {
+        assign_generator.GenerateOption(int(index % num_assign_options), ctx, code);
+      } else {
+        if_generator.GenerateOption(int(index % num_if_options), ctx, code);
+      }
+    }
+    code << "\treturn a\n}\n\n";
+  }
+  return code.str();
+}
+
+void BM_ParseFile(benchmark::State& state) {
+  std::string source = GenerateSource(state.range(0));
+  common::positions::FileSet pos_file_set;
+  common::positions::File* pos_file = pos_file_set.AddFile("generated.kat", source);
+  for (auto _ : state) {
+    lang::ast::AST ast;
+    lang::ast::ASTBuilder ast_builder = ast.builder();
+    lang::issues::IssueTracker issues(&pos_file_set);
+    lang::ast::File* ast_file = lang::parser::Parser::ParseFile(pos_file, ast_builder, issues);
+    if (!issues.issues().empty()) {
+      state.SkipWithError("generated source has parse issues");
+      break;
+    }
+    benchmark::DoNotOptimize(ast_file);
+  }
+  state.SetBytesProcessed(state.iterations() * int64_t(source.size()));
+}
+BENCHMARK(BM_ParseFile)->Arg(64 << 10)->Arg(1 << 20)->Arg(8 << 20);
+
+}  // namespace
@@ -0,0 +1,1056 @@
+//
+//  summary.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "summary.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "src/common/atomics/atomics.h"
+#include "src/common/logging/logging.h"
+#include "src/lang/representation/constants/constants.h"
+#include "src/lang/representation/types/info_builder.h"
+#include "src/lang/representation/types/objects.h"
+#include "src/lang/representation/types/scope.h"
+#include "src/lang/representation/types/types.h"
+
+namespace lang {
+namespace summaries {
+namespace {
+
+using ::common::atomics::Int;
+using ::common::atomics::IntType;
+using ::common::logging::fail;
+using ::common::positions::kNoPos;
+
+// A summary is a sequence of whitespace separated records:
+//
+//   katara-summary-1
+//   package <path> <name>
+//   import <path> <key> <is direct import>    (for each package the summary depends on)
+//   <node record>                              (one for each type or object, numbered from 0)
+//   <fill record>                              (completes nodes that can be part of cycles)
+//   scope <name> <node>                        (for each object in the package scope)
+//   end
+//
+// Node records only refer to previous nodes. Named types, type parameters, interfaces, and objects
+// get created without their contents, which get completed by fill records after all nodes exist.
+// Strings are written as <length>:<bytes>.
+constexpr std::string_view kSummaryFormat = "katara-summary-1";
+
+enum class ReceiverKind : int64_t {
+  kNone,
+  kExpr,
+  kType,
+};
+
+class SummaryWriter {
+ public:
+  SummaryWriter(types::Package* package, PackageKeyFunc key_of_package)
+      : package_(package), key_of_package_(key_of_package) {}
+
+  std::string Write();
+
+ private:
+  void FindExternalNamedTypes();
+
+  int64_t NodeOf(types::Type* type);
+  int64_t NodeOf(types::Object* object);
+  int64_t AddNode(const void* ptr, std::string record);
+
+  void WriteFills(types::Type* type);
+  void WriteFills(types::Object* object);
+
+  types::Package* package_;
+  PackageKeyFunc key_of_package_;
+
+  std::unordered_map<types::NamedType*, std::pair<std::string, std::string>> external_names_;
+  std::set<std::string> referenced_packages_;
+
+  std::unordered_map<const void*, int64_t> nodes_;
+  std::vector<std::variant<types::Type*, types::Object*>> incomplete_nodes_;
+  std::stringstream node_records_;
+  std::stringstream fill_records_;
+  std::stringstream type_parameter_instance_records_;
+};
+
+std::string String(std::string_view str) {
+  return " " + std::to_string(str.size()) + ":" + std::string(str);
+}
+
+std::string Ref(int64_t node) { return " " + std::to_string(node); }
+
+std::string Refs(const std::vector<int64_t>& nodes) {
+  std::string refs = Ref(int64_t(nodes.size()));
+  for (int64_t node : nodes) {
+    refs += Ref(node);
+  }
+  return refs;
+}
+
+std::string SummaryWriter::Write() {
+  FindExternalNamedTypes();
+
+  std::map<std::string, types::Object*> scope_objects;
+  for (auto& [name, object] : package_->scope()->named_objects()) {
+    if (object->is_typed()) {
+      scope_objects.insert({name, object});
+    }
+  }
+  std::map<std::string, int64_t> scope_nodes;
+  for (auto& [name, object] : scope_objects) {
+    scope_nodes.insert({name, NodeOf(object)});
+  }
+  for (size_t i = 0; i < incomplete_nodes_.size(); i++) {
+    std::visit([this](auto node) { WriteFills(node); }, incomplete_nodes_.at(i));
+  }
+
+  std::set<std::string> dependencies = referenced_packages_;
+  std::set<std::string> direct_imports;
+  for (types::Package* imported : package_->imports()) {
+    dependencies.insert(imported->path());
+    direct_imports.insert(imported->path());
+  }
+
+  std::stringstream summary;
+  summary << kSummaryFormat << "\n";
+  summary << "package" << String(package_->path()) << String(package_->name()) << "\n";
+  for (const std::string& path : dependencies) {
+    summary << "import" << String(path) << String(key_of_package_(path))
+            << Ref(direct_imports.contains(path)) << "\n";
+  }
+  summary << node_records_.str() << fill_records_.str() << type_parameter_instance_records_.str();
+  for (auto& [name, node] : scope_nodes) {
+    summary << "scope" << String(name) << Ref(node) << "\n";
+  }
+  summary << "end\n";
+  return summary.str();
+}
+
+void SummaryWriter::FindExternalNamedTypes() {
+  std::vector<types::Package*> packages(package_->imports().begin(), package_->imports().end());
+  std::unordered_set<types::Package*> visited(packages.begin(), packages.end());
+  while (!packages.empty()) {
+    types::Package* package = packages.back();
+    packages.pop_back();
+    for (auto& [name, object] : package->scope()->named_objects()) {
+      if (object->object_kind() != types::ObjectKind::kTypeName) {
+        continue;
+      }
+      types::Type* type = static_cast<types::TypeName*>(object)->type();
+      if (type->type_kind() == types::TypeKind::kNamedType) {
+        external_names_.insert({static_cast<types::NamedType*>(type), {package->path(), name}});
+      }
+    }
+    for (types::Package* imported : package->imports()) {
+      if (imported != package_ && visited.insert(imported).second) {
+        packages.push_back(imported);
+      }
+    }
+  }
+}
+
+int64_t SummaryWriter::NodeOf(types::Type* type) {
+  if (auto it = nodes_.find(type); it != nodes_.end()) {
+    return it->second;
+  }
+  switch (type->type_kind()) {
+    case types::TypeKind::kBasic:
+      return AddNode(type, "basic" + Ref(static_cast<types::Basic*>(type)->kind()));
+    case types::TypeKind::kPointer: {
+      types::Pointer* pointer = static_cast<types::Pointer*>(type);
+      int64_t element_type = NodeOf(pointer->element_type());
+      return AddNode(type, "pointer" + Ref(int64_t(pointer->kind())) + Ref(element_type));
+    }
+    case types::TypeKind::kArray: {
+      types::Array* array = static_cast<types::Array*>(type);
+      int64_t element_type = NodeOf(array->element_type());
+      return AddNode(type, "array" + Ref(element_type) + " " + std::to_string(array->length()));
+    }
+    case types::TypeKind::kSlice: {
+      int64_t element_type = NodeOf(static_cast<types::Slice*>(type)->element_type());
+      return AddNode(type, "slice" + Ref(element_type));
+    }
+    case types::TypeKind::kTypeParameter: {
+      int64_t node =
+          AddNode(type, "typeparam" + String(static_cast<types::TypeParameter*>(type)->name()));
+      incomplete_nodes_.push_back(type);
+      return node;
+    }
+    case types::TypeKind::kNamedType: {
+      types::NamedType* named_type = static_cast<types::NamedType*>(type);
+      if (auto it = external_names_.find(named_type); it != external_names_.end()) {
+        auto& [package_path, name] = it->second;
+        referenced_packages_.insert(package_path);
+        return AddNode(type, "extern" + String(package_path) + String(name));
+      }
+      std::vector<int64_t> type_parameters;
+      for (types::TypeParameter* type_parameter : named_type->type_parameters()) {
+        type_parameters.push_back(NodeOf(type_parameter));
+      }
+      int64_t node = AddNode(type, "named" + Ref(named_type->is_alias()) +
+                                       String(named_type->name()) + Refs(type_parameters));
+      incomplete_nodes_.push_back(type);
+      return node;
+    }
+    case types::TypeKind::kTypeInstance: {
+      types::TypeInstance* type_instance = static_cast<types::TypeInstance*>(type);
+      int64_t instantiated_type = NodeOf(type_instance->instantiated_type());
+      std::vector<int64_t> type_args;
+      for (types::Type* type_arg : type_instance->type_args()) {
+        type_args.push_back(NodeOf(type_arg));
+      }
+      return AddNode(type, "instance" + Ref(instantiated_type) + Refs(type_args));
+    }
+    case types::TypeKind::kTuple: {
+      std::vector<int64_t> variables;
+      for (types::Variable* variable : static_cast<types::Tuple*>(type)->variables()) {
+        variables.push_back(NodeOf(variable));
+      }
+      return AddNode(type, "tuple" + Refs(variables));
+    }
+    case types::TypeKind::kSignature: {
+      types::Signature* signature = static_cast<types::Signature*>(type);
+      std::string receiver = Ref(int64_t(ReceiverKind::kNone));
+      if (signature->has_expr_receiver()) {
+        receiver = Ref(int64_t(ReceiverKind::kExpr)) + Ref(NodeOf(signature->expr_receiver()));
+      } else if (signature->has_type_receiver()) {
+        receiver = Ref(int64_t(ReceiverKind::kType)) + Ref(NodeOf(signature->type_receiver()));
+      }
+      std::vector<int64_t> type_parameters;
+      for (types::TypeParameter* type_parameter : signature->type_parameters()) {
+        type_parameters.push_back(NodeOf(type_parameter));
+      }
+      int64_t parameters = -1;
+      if (signature->parameters() != nullptr) {
+        parameters = NodeOf(signature->parameters());
+      }
+      int64_t results = -1;
+      if (signature->results() != nullptr) {
+        results = NodeOf(signature->results());
+      }
+      return AddNode(type, "signature" + receiver + Refs(type_parameters) + Ref(parameters) +
+                               Ref(results));
+    }
+    case types::TypeKind::kStruct: {
+      std::vector<int64_t> fields;
+      for (types::Variable* field : static_cast<types::Struct*>(type)->fields()) {
+        fields.push_back(NodeOf(field));
+      }
+      return AddNode(type, "struct" + Refs(fields));
+    }
+    case types::TypeKind::kInterface: {
+      int64_t node = AddNode(type, "interface");
+      incomplete_nodes_.push_back(type);
+      return node;
+    }
+  }
+}
+
+int64_t SummaryWriter::NodeOf(types::Object* object) {
+  if (auto it = nodes_.find(object); it != nodes_.end()) {
+    return it->second;
+  }
+  int64_t node;
+  switch (object->object_kind()) {
+    case types::ObjectKind::kTypeName:
+      return NodeOf(static_cast<types::TypeName*>(object)->type());
+    case types::ObjectKind::kConstant:
+      node = AddNode(object, "constant" + String(object->name()));
+      break;
+    case types::ObjectKind::kVariable: {
+      types::Variable* variable = static_cast<types::Variable*>(object);
+      node = AddNode(object, "variable" + String(variable->name()) +
+                                 Ref(variable->is_embedded()) + Ref(variable->is_field()));
+      break;
+    }
+    case types::ObjectKind::kFunc:
+      node = AddNode(object, "func" + String(object->name()));
+      break;
+    default:
+      fail("unexpected object in package summary");
+  }
+  incomplete_nodes_.push_back(object);
+  return node;
+}
+
+int64_t SummaryWriter::AddNode(const void* ptr, std::string record) {
+  int64_t node = int64_t(nodes_.size());
+  nodes_.insert({ptr, node});
+  node_records_ << record << "\n";
+  return node;
+}
+
+void SummaryWriter::WriteFills(types::Type* type) {
+  int64_t node = nodes_.at(type);
+  switch (type->type_kind()) {
+    case types::TypeKind::kTypeParameter: {
+      types::TypeParameter* type_parameter = static_cast<types::TypeParameter*>(type);
+      if (type_parameter->instantiated_type_parameter() != nullptr) {
+        int64_t instantiated = NodeOf(type_parameter->instantiated_type_parameter());
+        type_parameter_instance_records_ << "instanceof" << Ref(node) << Ref(instantiated) << "\n";
+      } else if (type_parameter->interface() != nullptr) {
+        int64_t interface = NodeOf(type_parameter->interface());
+        fill_records_ << "constraint" << Ref(node) << Ref(interface) << "\n";
+      }
+      return;
+    }
+    case types::TypeKind::kNamedType: {
+      types::NamedType* named_type = static_cast<types::NamedType*>(type);
+      if (named_type->underlying() != nullptr) {
+        int64_t underlying = NodeOf(named_type->underlying());
+        fill_records_ << "underlying" << Ref(node) << Ref(underlying) << "\n";
+      }
+      std::map<std::string, types::Func*> methods(named_type->methods().begin(),
+                                                  named_type->methods().end());
+      for (auto& [name, method] : methods) {
+        int64_t method_node = NodeOf(method);
+        fill_records_ << "method" << Ref(node) << Ref(method_node) << "\n";
+      }
+      return;
+    }
+    case types::TypeKind::kInterface: {
+      types::Interface* interface = static_cast<types::Interface*>(type);
+      std::vector<int64_t> embedded_interfaces;
+      for (types::NamedType* embedded_interface : interface->embedded_interfaces()) {
+        embedded_interfaces.push_back(NodeOf(embedded_interface));
+      }
+      std::vector<int64_t> methods;
+      for (types::Func* method : interface->methods()) {
+        methods.push_back(NodeOf(method));
+      }
+      fill_records_ << "members" << Ref(node) << Refs(embedded_interfaces) << Refs(methods) << "\n";
+      return;
+    }
+    default:
+      fail("unexpected incomplete type in package summary");
+  }
+}
+
+void SummaryWriter::WriteFills(types::Object* object) {
+  int64_t node = nodes_.at(object);
+  types::TypedObject* typed_object = static_cast<types::TypedObject*>(object);
+  if (typed_object->type() != nullptr) {
+    int64_t type = NodeOf(typed_object->type());
+    fill_records_ << "type" << Ref(node) << Ref(type) << "\n";
+  }
+  if (object->object_kind() != types::ObjectKind::kConstant) {
+    return;
+  }
+  constants::Value value = static_cast<types::Constant*>(object)->value();
+  fill_records_ << "value" << Ref(node);
+  switch (value.kind()) {
+    case constants::Value::Kind::kBool:
+      fill_records_ << " bool" << Ref(value.AsBool());
+      break;
+    case constants::Value::Kind::kInt:
+      fill_records_ << " int" << Ref(int64_t(value.AsInt().type()))
+                    << String(value.AsInt().ToString());
+      break;
+    case constants::Value::Kind::kString:
+      fill_records_ << " string" << String(value.AsString());
+      break;
+  }
+  fill_records_ << "\n";
+}
+
+class SummaryReader {
+ public:
+  SummaryReader(std::string_view summary, std::string package_path, SummaryImporter importer,
+                types::Info* info)
+      : summary_(summary), package_path_(package_path), importer_(importer), info_(info) {}
+
+  types::Package* Read();
+
+ private:
+  enum class NodeKind {
+    kBasic,
+    kExternalNamedType,
+    kTypeParameter,
+    kNamedType,
+    kInterface,
+    kPointer,
+    kArray,
+    kSlice,
+    kTypeInstance,
+    kTuple,
+    kSignature,
+    kStruct,
+    kConstant,
+    kVariable,
+    kFunc,
+  };
+
+  struct Node {
+    NodeKind kind;
+    std::string name;
+    int64_t number = 0;
+    uint64_t length = 0;
+    bool is_embedded = false;
+    bool is_field = false;
+    std::vector<int64_t> refs;
+    int64_t receiver = -1;
+    int64_t parameters = -1;
+    int64_t results = -1;
+
+    types::Type* type = nullptr;
+    types::Object* object = nullptr;
+
+    // State to validate fill records before any of them get applied:
+    bool is_complete = false;
+    bool is_type_parameter_instance = false;
+    std::unordered_set<std::string> method_names;
+  };
+
+  enum class FillKind {
+    kType,
+    kValue,
+    kUnderlying,
+    kMethod,
+    kConstraint,
+    kInstanceOf,
+    kMembers,
+  };
+
+  struct Fill {
+    FillKind kind;
+    int64_t node;
+    int64_t ref = -1;
+    std::vector<int64_t> refs;
+    std::vector<int64_t> more_refs;
+    std::optional<constants::Value> value;
+  };
+
+  static bool IsType(NodeKind kind) { return kind < NodeKind::kConstant; }
+  static bool IsNamedType(NodeKind kind) {
+    return kind == NodeKind::kNamedType || kind == NodeKind::kExternalNamedType;
+  }
+
+  bool Parse();
+  bool ParseImport();
+  bool ParseNode(std::string_view word);
+  bool ParseFill(std::string_view word);
+  bool ParseScopeEntry();
+
+  bool ReadWord(std::string_view& word);
+  bool ReadInt(int64_t& value);
+  bool ReadUint(uint64_t& value);
+  bool ReadBool(bool& value);
+  bool ReadString(std::string& str);
+  bool ReadRef(int64_t& ref, std::initializer_list<NodeKind> kinds);
+  bool ReadTypeRef(int64_t& ref);
+  bool ReadOptionalRef(int64_t& ref, NodeKind kind);
+  bool ReadRefs(std::vector<int64_t>& refs, std::initializer_list<NodeKind> kinds);
+  void SkipWhitespace();
+
+  types::Package* Build();
+  void BuildNode(types::InfoBuilder& info_builder, types::Package* package, Node& node);
+  void ApplyFill(types::InfoBuilder& info_builder, Fill& fill);
+
+  std::string_view summary_;
+  size_t offset_ = 0;
+  std::string package_path_;
+  SummaryImporter importer_;
+  types::Info* info_;
+
+  std::string package_name_;
+  std::unordered_map<std::string, types::Package*> imports_;
+  std::vector<types::Package*> direct_imports_;
+  std::vector<Node> nodes_;
+  std::vector<Fill> fills_;
+  std::map<std::string, int64_t> scope_entries_;
+};
+
+types::Package* SummaryReader::Read() {
+  if (!Parse()) {
+    return nullptr;
+  }
+  return Build();
+}
+
+bool SummaryReader::Parse() {
+  std::string_view word;
+  if (!ReadWord(word) || word != kSummaryFormat) {
+    return false;
+  }
+  std::string package_path;
+  if (!ReadWord(word) || word != "package" || !ReadString(package_path) ||
+      package_path != package_path_ || !ReadString(package_name_) || package_name_.empty()) {
+    return false;
+  }
+  while (ReadWord(word)) {
+    if (word == "end") {
+      SkipWhitespace();
+      return offset_ == summary_.size();
+    } else if (word == "import") {
+      if (!nodes_.empty() || !ParseImport()) {
+        return false;
+      }
+    } else if (word == "scope") {
+      if (!ParseScopeEntry()) {
+        return false;
+      }
+    } else if (!scope_entries_.empty()) {
+      return false;
+    } else if (fills_.empty() && ParseNode(word)) {
+      continue;
+    } else if (!ParseFill(word)) {
+      return false;
+    }
+  }
+  return false;
+}
+
+bool SummaryReader::ParseImport() {
+  std::string path;
+  std::string key;
+  bool is_direct;
+  if (!ReadString(path) || !ReadString(key) || !ReadBool(is_direct) || imports_.contains(path)) {
+    return false;
+  }
+  types::Package* imported = importer_(path, key);
+  if (imported == nullptr) {
+    return false;
+  }
+  imports_.insert({path, imported});
+  if (is_direct) {
+    direct_imports_.push_back(imported);
+  }
+  return true;
+}
+
+bool SummaryReader::ParseNode(std::string_view word) {
+  Node node;
+  if (word == "basic") {
+    node.kind = NodeKind::kBasic;
+    if (!ReadInt(node.number) || node.number < types::Basic::kBool ||
+        node.number > types::Basic::kUntypedNil) {
+      return false;
+    }
+    node.type = info_->basic_type(types::Basic::Kind(node.number));
+  } else if (word == "extern") {
+    node.kind = NodeKind::kExternalNamedType;
+    std::string package_path;
+    if (!ReadString(package_path) || !ReadString(node.name) || !imports_.contains(package_path)) {
+      return false;
+    }
+    const types::Scope* scope = imports_.at(package_path)->scope();
+    auto it = scope->named_objects().find(node.name);
+    if (it == scope->named_objects().end() ||
+        it->second->object_kind() != types::ObjectKind::kTypeName) {
+      return false;
+    }
+    node.type = static_cast<types::TypeName*>(it->second)->type();
+    if (node.type->type_kind() != types::TypeKind::kNamedType) {
+      return false;
+    }
+    node.number = int64_t(static_cast<types::NamedType*>(node.type)->type_parameters().size());
+  } else if (word == "typeparam") {
+    node.kind = NodeKind::kTypeParameter;
+    if (!ReadString(node.name)) {
+      return false;
+    }
+  } else if (word == "named") {
+    node.kind = NodeKind::kNamedType;
+    if (!ReadBool(node.is_field) || !ReadString(node.name) ||
+        !ReadRefs(node.refs, {NodeKind::kTypeParameter})) {
+      return false;
+    }
+    node.number = int64_t(node.refs.size());
+  } else if (word == "interface") {
+    node.kind = NodeKind::kInterface;
+  } else if (word == "pointer") {
+    node.kind = NodeKind::kPointer;
+    node.refs.resize(1);
+    if (!ReadInt(node.number) || node.number < int64_t(types::Pointer::Kind::kStrong) ||
+        node.number > int64_t(types::Pointer::Kind::kWeak) || !ReadTypeRef(node.refs.at(0))) {
+      return false;
+    }
+  } else if (word == "array") {
+    node.kind = NodeKind::kArray;
+    node.refs.resize(1);
+    if (!ReadTypeRef(node.refs.at(0)) || !ReadUint(node.length)) {
+      return false;
+    }
+  } else if (word == "slice") {
+    node.kind = NodeKind::kSlice;
+    node.refs.resize(1);
+    if (!ReadTypeRef(node.refs.at(0))) {
+      return false;
+    }
+  } else if (word == "instance") {
+    node.kind = NodeKind::kTypeInstance;
+    int64_t instantiated_type;
+    std::vector<int64_t> type_args;
+    if (!ReadRef(instantiated_type, {NodeKind::kNamedType, NodeKind::kExternalNamedType}) ||
+        !ReadRefs(type_args, {})) {
+      return false;
+    }
+    if (type_args.empty() || int64_t(type_args.size()) != nodes_.at(instantiated_type).number) {
+      return false;
+    }
+    node.refs.push_back(instantiated_type);
+    node.refs.insert(node.refs.end(), type_args.begin(), type_args.end());
+  } else if (word == "tuple") {
+    node.kind = NodeKind::kTuple;
+    if (!ReadRefs(node.refs, {NodeKind::kVariable})) {
+      return false;
+    }
+  } else if (word == "signature") {
+    node.kind = NodeKind::kSignature;
+    if (!ReadInt(node.number)) {
+      return false;
+    }
+    switch (ReceiverKind(node.number)) {
+      case ReceiverKind::kNone:
+        break;
+      case ReceiverKind::kExpr:
+        if (!ReadRef(node.receiver, {NodeKind::kVariable})) {
+          return false;
+        }
+        break;
+      case ReceiverKind::kType:
+        if (!ReadTypeRef(node.receiver)) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+    if (!ReadRefs(node.refs, {NodeKind::kTypeParameter}) ||
+        (!node.refs.empty() && ReceiverKind(node.number) != ReceiverKind::kNone) ||
+        !ReadOptionalRef(node.parameters, NodeKind::kTuple) ||
+        !ReadOptionalRef(node.results, NodeKind::kTuple)) {
+      return false;
+    }
+  } else if (word == "struct") {
+    node.kind = NodeKind::kStruct;
+    if (!ReadRefs(node.refs, {NodeKind::kVariable})) {
+      return false;
+    }
+  } else if (word == "constant") {
+    node.kind = NodeKind::kConstant;
+    if (!ReadString(node.name)) {
+      return false;
+    }
+  } else if (word == "variable") {
+    node.kind = NodeKind::kVariable;
+    if (!ReadString(node.name) || !ReadBool(node.is_embedded) || !ReadBool(node.is_field)) {
+      return false;
+    }
+  } else if (word == "func") {
+    node.kind = NodeKind::kFunc;
+    if (!ReadString(node.name)) {
+      return false;
+    }
+  } else {
+    return false;
+  }
+  nodes_.push_back(std::move(node));
+  return true;
+}
+
+bool SummaryReader::ParseFill(std::string_view word) {
+  Fill fill;
+  if (word == "type") {
+    fill.kind = FillKind::kType;
+    if (!ReadRef(fill.node, {NodeKind::kConstant, NodeKind::kVariable, NodeKind::kFunc}) ||
+        !ReadTypeRef(fill.ref)) {
+      return false;
+    }
+    Node& node = nodes_.at(fill.node);
+    if (node.is_complete ||
+        (node.kind == NodeKind::kFunc && nodes_.at(fill.ref).kind != NodeKind::kSignature)) {
+      return false;
+    }
+    node.is_complete = true;
+  } else if (word == "value") {
+    fill.kind = FillKind::kValue;
+    std::string_view kind;
+    if (!ReadRef(fill.node, {NodeKind::kConstant}) || !ReadWord(kind)) {
+      return false;
+    }
+    if (kind == "bool") {
+      bool value;
+      if (!ReadBool(value)) {
+        return false;
+      }
+      fill.value = constants::Value(value);
+    } else if (kind == "int") {
+      int64_t type;
+      std::string str;
+      if (!ReadInt(type) || type < int64_t(IntType::kI8) || type > int64_t(IntType::kU64) ||
+          !ReadString(str)) {
+        return false;
+      }
+      std::optional<Int> value = common::atomics::IsSigned(IntType(type))
+                                     ? common::atomics::ToI64(str, /*base=*/10)
+                                     : common::atomics::ToU64(str, /*base=*/10);
+      if (!value.has_value() || !value->CanConvertTo(IntType(type))) {
+        return false;
+      }
+      fill.value = constants::Value(value->ConvertTo(IntType(type)));
+    } else if (kind == "string") {
+      std::string value;
+      if (!ReadString(value)) {
+        return false;
+      }
+      fill.value = constants::Value(value);
+    } else {
+      return false;
+    }
+  } else if (word == "underlying") {
+    fill.kind = FillKind::kUnderlying;
+    if (!ReadRef(fill.node, {NodeKind::kNamedType}) || !ReadTypeRef(fill.ref) ||
+        nodes_.at(fill.node).is_complete) {
+      return false;
+    }
+    nodes_.at(fill.node).is_complete = true;
+  } else if (word == "method") {
+    fill.kind = FillKind::kMethod;
+    if (!ReadRef(fill.node, {NodeKind::kNamedType}) || !ReadRef(fill.ref, {NodeKind::kFunc}) ||
+        !nodes_.at(fill.node).method_names.insert(nodes_.at(fill.ref).name).second) {
+      return false;
+    }
+  } else if (word == "constraint") {
+    fill.kind = FillKind::kConstraint;
+    if (!ReadRef(fill.node, {NodeKind::kTypeParameter}) ||
+        !ReadRef(fill.ref, {NodeKind::kInterface}) || nodes_.at(fill.node).is_complete) {
+      return false;
+    }
+    nodes_.at(fill.node).is_complete = true;
+  } else if (word == "instanceof") {
+    fill.kind = FillKind::kInstanceOf;
+    if (!ReadRef(fill.node, {NodeKind::kTypeParameter}) ||
+        !ReadRef(fill.ref, {NodeKind::kTypeParameter}) || fill.node == fill.ref) {
+      return false;
+    }
+    Node& instance = nodes_.at(fill.node);
+    Node& instantiated = nodes_.at(fill.ref);
+    if (instance.is_complete || !instantiated.is_complete ||
+        instantiated.is_type_parameter_instance) {
+      return false;
+    }
+    instance.is_complete = true;
+    instance.is_type_parameter_instance = true;
+  } else if (word == "members") {
+    fill.kind = FillKind::kMembers;
+    if (!ReadRef(fill.node, {NodeKind::kInterface}) ||
+        !ReadRefs(fill.refs, {NodeKind::kNamedType, NodeKind::kExternalNamedType}) ||
+        !ReadRefs(fill.more_refs, {NodeKind::kFunc}) || nodes_.at(fill.node).is_complete) {
+      return false;
+    }
+    nodes_.at(fill.node).is_complete = true;
+  } else {
+    return false;
+  }
+  fills_.push_back(std::move(fill));
+  return true;
+}
+
+bool SummaryReader::ParseScopeEntry() {
+  std::string name;
+  int64_t ref;
+  if (!ReadString(name) ||
+      !ReadRef(ref, {NodeKind::kNamedType, NodeKind::kConstant, NodeKind::kVariable,
+                     NodeKind::kFunc}) ||
+      name.empty() || nodes_.at(ref).name != name) {
+    return false;
+  }
+  return scope_entries_.insert({name, ref}).second;
+}
+
+void SummaryReader::SkipWhitespace() {
+  while (offset_ < summary_.size() && std::isspace(summary_.at(offset_))) {
+    offset_++;
+  }
+}
+
+bool SummaryReader::ReadWord(std::string_view& word) {
+  SkipWhitespace();
+  size_t start = offset_;
+  while (offset_ < summary_.size() && !std::isspace(summary_.at(offset_))) {
+    offset_++;
+  }
+  word = summary_.substr(start, offset_ - start);
+  return !word.empty();
+}
+
+bool SummaryReader::ReadInt(int64_t& value) {
+  std::string_view word;
+  if (!ReadWord(word)) {
+    return false;
+  }
+  auto [end, error] = std::from_chars(word.data(), word.data() + word.size(), value);
+  return error == std::errc() && end == word.data() + word.size();
+}
+
+bool SummaryReader::ReadUint(uint64_t& value) {
+  std::string_view word;
+  if (!ReadWord(word)) {
+    return false;
+  }
+  auto [end, error] = std::from_chars(word.data(), word.data() + word.size(), value);
+  return error == std::errc() && end == word.data() + word.size();
+}
+
+bool SummaryReader::ReadBool(bool& value) {
+  int64_t number;
+  if (!ReadInt(number) || (number != 0 && number != 1)) {
+    return false;
+  }
+  value = (number == 1);
+  return true;
+}
+
+bool SummaryReader::ReadString(std::string& str) {
+  SkipWhitespace();
+  size_t colon = summary_.find(':', offset_);
+  if (colon == std::string_view::npos) {
+    return false;
+  }
+  uint64_t length;
+  std::string_view length_str = summary_.substr(offset_, colon - offset_);
+  auto [end, error] = std::from_chars(length_str.data(), length_str.data() + length_str.size(),
+                                      length);
+  if (length_str.empty() || error != std::errc() ||
+      end != length_str.data() + length_str.size() || summary_.size() - colon - 1 < length) {
+    return false;
+  }
+  str = std::string(summary_.substr(colon + 1, length));
+  offset_ = colon + 1 + length;
+  return true;
+}
+
+bool SummaryReader::ReadRef(int64_t& ref, std::initializer_list<NodeKind> kinds) {
+  if (!ReadInt(ref) || ref < 0 || ref >= int64_t(nodes_.size())) {
+    return false;
+  }
+  NodeKind kind = nodes_.at(ref).kind;
+  return std::find(kinds.begin(), kinds.end(), kind) != kinds.end();
+}
+
+bool SummaryReader::ReadTypeRef(int64_t& ref) {
+  return ReadInt(ref) && ref >= 0 && ref < int64_t(nodes_.size()) && IsType(nodes_.at(ref).kind);
+}
+
+bool SummaryReader::ReadOptionalRef(int64_t& ref, NodeKind kind) {
+  if (!ReadInt(ref)) {
+    return false;
+  }
+  return ref == -1 || (ref >= 0 && ref < int64_t(nodes_.size()) && nodes_.at(ref).kind == kind);
+}
+
+bool SummaryReader::ReadRefs(std::vector<int64_t>& refs, std::initializer_list<NodeKind> kinds) {
+  int64_t count;
+  if (!ReadInt(count) || count < 0 || count > int64_t(nodes_.size())) {
+    return false;
+  }
+  refs.resize(count);
+  for (int64_t& ref : refs) {
+    if (kinds.size() == 0 ? !ReadTypeRef(ref) : !ReadRef(ref, kinds)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+types::Package* SummaryReader::Build() {
+  types::InfoBuilder info_builder = info_->builder();
+  types::Package* package = info_builder.CreatePackage(package_path_, package_name_);
+  for (types::Package* imported : direct_imports_) {
+    info_builder.AddImportToPackage(package, imported);
+  }
+  for (Node& node : nodes_) {
+    BuildNode(info_builder, package, node);
+  }
+  for (Fill& fill : fills_) {
+    ApplyFill(info_builder, fill);
+  }
+  for (auto& [name, ref] : scope_entries_) {
+    info_builder.AddObjectToScope(package->scope(), nodes_.at(ref).object);
+  }
+  return package;
+}
+
+void SummaryReader::BuildNode(types::InfoBuilder& info_builder, types::Package* package,
+                              Node& node) {
+  types::Scope* scope = package->scope();
+  auto type_of = [this](int64_t ref) { return nodes_.at(ref).type; };
+  auto variables_of = [this](const std::vector<int64_t>& refs) {
+    std::vector<types::Variable*> variables;
+    for (int64_t ref : refs) {
+      variables.push_back(static_cast<types::Variable*>(nodes_.at(ref).object));
+    }
+    return variables;
+  };
+  switch (node.kind) {
+    case NodeKind::kBasic:
+    case NodeKind::kExternalNamedType:
+      return;
+    case NodeKind::kTypeParameter: {
+      types::TypeName* type_name =
+          info_builder.CreateTypeNameForTypeParameter(scope, package, kNoPos, node.name);
+      node.object = type_name;
+      node.type = type_name->type();
+      return;
+    }
+    case NodeKind::kNamedType: {
+      types::TypeName* type_name = info_builder.CreateTypeNameForNamedType(
+          scope, package, kNoPos, node.name, /*is_alias=*/node.is_field);
+      node.object = type_name;
+      node.type = type_name->type();
+      if (!node.refs.empty()) {
+        std::vector<types::TypeParameter*> type_parameters;
+        for (int64_t ref : node.refs) {
+          type_parameters.push_back(static_cast<types::TypeParameter*>(type_of(ref)));
+        }
+        info_builder.SetTypeParametersOfNamedType(static_cast<types::NamedType*>(node.type),
+                                                  type_parameters);
+      }
+      return;
+    }
+    case NodeKind::kInterface:
+      node.type = info_builder.CreateInterface();
+      return;
+    case NodeKind::kPointer:
+      node.type =
+          info_builder.CreatePointer(types::Pointer::Kind(node.number), type_of(node.refs.at(0)));
+      return;
+    case NodeKind::kArray:
+      node.type = info_builder.CreateArray(type_of(node.refs.at(0)), node.length);
+      return;
+    case NodeKind::kSlice:
+      node.type = info_builder.CreateSlice(type_of(node.refs.at(0)));
+      return;
+    case NodeKind::kTypeInstance: {
+      std::vector<types::Type*> type_args;
+      for (size_t i = 1; i < node.refs.size(); i++) {
+        type_args.push_back(type_of(node.refs.at(i)));
+      }
+      node.type = info_builder.CreateTypeInstance(
+          static_cast<types::NamedType*>(type_of(node.refs.at(0))), type_args);
+      return;
+    }
+    case NodeKind::kTuple:
+      node.type = info_builder.CreateTuple(variables_of(node.refs));
+      return;
+    case NodeKind::kSignature: {
+      types::Tuple* parameters = nullptr;
+      if (node.parameters != -1) {
+        parameters = static_cast<types::Tuple*>(type_of(node.parameters));
+      }
+      types::Tuple* results = nullptr;
+      if (node.results != -1) {
+        results = static_cast<types::Tuple*>(type_of(node.results));
+      }
+      switch (ReceiverKind(node.number)) {
+        case ReceiverKind::kNone: {
+          std::vector<types::TypeParameter*> type_parameters;
+          for (int64_t ref : node.refs) {
+            type_parameters.push_back(static_cast<types::TypeParameter*>(type_of(ref)));
+          }
+          node.type = info_builder.CreateSignature(type_parameters, parameters, results);
+          return;
+        }
+        case ReceiverKind::kExpr:
+          node.type = info_builder.CreateSignature(
+              static_cast<types::Variable*>(nodes_.at(node.receiver).object), parameters,
+              results);
+          return;
+        case ReceiverKind::kType:
+          node.type = info_builder.CreateSignature(type_of(node.receiver), parameters, results);
+          return;
+      }
+      break;
+    }
+    case NodeKind::kStruct:
+      node.type = info_builder.CreateStruct(variables_of(node.refs));
+      return;
+    case NodeKind::kConstant:
+      node.object = info_builder.CreateConstant(scope, package, kNoPos, node.name);
+      return;
+    case NodeKind::kVariable:
+      node.object = info_builder.CreateVariable(scope, package, kNoPos, node.name,
+                                                node.is_embedded, node.is_field);
+      return;
+    case NodeKind::kFunc:
+      node.object = info_builder.CreateFunc(scope, package, kNoPos, node.name);
+      return;
+  }
+}
+
+void SummaryReader::ApplyFill(types::InfoBuilder& info_builder, Fill& fill) {
+  Node& node = nodes_.at(fill.node);
+  switch (fill.kind) {
+    case FillKind::kType:
+      info_builder.SetObjectType(static_cast<types::TypedObject*>(node.object),
+                                 nodes_.at(fill.ref).type);
+      return;
+    case FillKind::kValue:
+      info_builder.SetConstantValue(static_cast<types::Constant*>(node.object), *fill.value);
+      return;
+    case FillKind::kUnderlying:
+      info_builder.SetUnderlyingTypeOfNamedType(static_cast<types::NamedType*>(node.type),
+                                                nodes_.at(fill.ref).type);
+      return;
+    case FillKind::kMethod:
+      info_builder.AddMethodToNamedType(static_cast<types::NamedType*>(node.type),
+                                        static_cast<types::Func*>(nodes_.at(fill.ref).object));
+      return;
+    case FillKind::kConstraint:
+      info_builder.SetTypeParameterInterface(
+          static_cast<types::TypeParameter*>(node.type),
+          static_cast<types::Interface*>(nodes_.at(fill.ref).type));
+      return;
+    case FillKind::kInstanceOf:
+      info_builder.SetTypeParameterInstance(
+          static_cast<types::TypeParameter*>(nodes_.at(fill.ref).type),
+          static_cast<types::TypeParameter*>(node.type));
+      return;
+    case FillKind::kMembers: {
+      std::vector<types::NamedType*> embedded_interfaces;
+      for (int64_t ref : fill.refs) {
+        embedded_interfaces.push_back(static_cast<types::NamedType*>(nodes_.at(ref).type));
+      }
+      std::vector<types::Func*> methods;
+      for (int64_t ref : fill.more_refs) {
+        methods.push_back(static_cast<types::Func*>(nodes_.at(ref).object));
+      }
+      info_builder.SetInterfaceMembers(static_cast<types::Interface*>(node.type),
+                                       embedded_interfaces, methods);
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+std::string WriteSummary(types::Package* package, PackageKeyFunc key_of_package) {
+  return SummaryWriter(package, key_of_package).Write();
+}
+
+types::Package* ReadSummary(std::string_view summary, std::string package_path,
+                            SummaryImporter importer, types::Info* info) {
+  return SummaryReader(summary, package_path, importer, info).Read();
+}
+
+}  // namespace summaries
+}  // namespace lang
@@ -0,0 +1,45 @@
+//
+//  summary.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef lang_summaries_summary_h
+#define lang_summaries_summary_h
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "src/lang/representation/types/info.h"
+#include "src/lang/representation/types/package.h"
+
+namespace lang {
+namespace summaries {
+
+// Returns the key identifying the version of the package with the given path. Summaries record the
+// key of each package they depend on.
+typedef std::function<std::string(std::string)> PackageKeyFunc;
+
+// Returns the imported package with the given path if its key matches the given key, otherwise
+// nullptr.
+typedef std::function<types::Package*(std::string, std::string)> SummaryImporter;
+
+// Serializes the objects in the scope of the given type checked package together with all types
+// and objects reachable from them. Named types of other packages get referenced by package path and
+// name. Positions and information about the package's AST are not part of the summary.
+std::string WriteSummary(types::Package* package, PackageKeyFunc key_of_package);
+
+// Recreates the package from the given summary in the given info, which already has to have a
+// universe. Returns nullptr without modifying the info if the summary is malformed, does not
+// describe the package with the given path, or refers to packages or named types the importer can
+// not provide.
+types::Package* ReadSummary(std::string_view summary, std::string package_path,
+                            SummaryImporter importer, types::Info* info);
+
+}  // namespace summaries
+}  // namespace lang
+
+#endif /* lang_summaries_summary_h */
@@ -0,0 +1,214 @@
+//
+//  summary_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/lang/processors/summaries/summary.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/common/filesystem/test_filesystem.h"
+#include "src/lang/processors/packages/package.h"
+#include "src/lang/processors/packages/package_manager.h"
+#include "src/lang/representation/types/info.h"
+#include "src/lang/representation/types/info_builder.h"
+#include "src/lang/representation/types/objects.h"
+#include "src/lang/representation/types/package.h"
+#include "src/lang/representation/types/scope.h"
+#include "src/lang/representation/types/types.h"
+
+namespace lang {
+namespace summaries {
+namespace {
+
+using ::common::filesystem::TestFilesystem;
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+
+std::string KeyOfPackage(std::string path) { return "key-of-" + path; }
+
+class SummaryTest : public ::testing::Test {
+ protected:
+  SummaryTest() : pkg_manager_(&filesystem_, /*stdlib_path=*/"stdlib", /*src_path=*/"") {
+    filesystem_.CreateDirectory("stdlib");
+    filesystem_.CreateDirectory("stdlib/lib");
+    filesystem_.CreateDirectory("stdlib/user");
+    filesystem_.WriteContentsOfFile("stdlib/lib/lib.kat", R"kat(
+package lib
+
+const (
+  Answer = 42
+  Small int8 = -3
+  Big uint32 = 4000000000
+  Greeting = "hello world"
+  Flag = true
+)
+
+type List<T> interface {
+  () Get(index int) T
+  () Len() int
+  () SubList(start, end int) List<T>
+}
+
+type ArrayList<T> struct {
+  data []T
+  length int
+}
+
+func (l *ArrayList<T>) Get(index int) T {
+  return l.data[index]
+}
+
+type HashValue int64
+type Hashable interface {
+  () Hash() HashValue
+}
+
+type HashMap<K Hashable, V> struct {
+  data []struct{K; V;}
+  buckets [16]int
+}
+
+type Node<T> struct {
+  value T
+  neighbors []%Node<T>
+}
+
+type String = string
+
+func (s String) Hash() HashValue {
+  return HashValue(len(s))
+}
+
+var Default *ArrayList<int>
+
+func Max<T>(a, b T, less func(x, y T) bool) T {
+  if less(a, b) {
+    return b
+  }
+  return a
+}
+  )kat");
+    filesystem_.WriteContentsOfFile("stdlib/user/user.kat", R"kat(
+package user
+
+import "lib"
+
+type Index lib.HashMap<lib.String, lib.List<int>>
+
+func Lookup(index *Index, key lib.String) lib.HashValue {
+  return key.Hash()
+}
+  )kat");
+  }
+
+  types::Package* LoadTypesPackage(std::string path) {
+    packages::Package* package = pkg_manager_.LoadPackage(path);
+    EXPECT_THAT(pkg_manager_.issue_tracker()->issues(), IsEmpty());
+    EXPECT_NE(package, nullptr);
+    if (package == nullptr) {
+      return nullptr;
+    }
+    EXPECT_THAT(package->issue_tracker().issues(), IsEmpty());
+    return package->types_package();
+  }
+
+  SummaryImporter ImporterFor(types::Package* imported) {
+    return [imported](std::string path, std::string key) -> types::Package* {
+      if (imported == nullptr || path != imported->path() || key != KeyOfPackage(path)) {
+        return nullptr;
+      }
+      return imported;
+    };
+  }
+
+  TestFilesystem filesystem_;
+  packages::PackageManager pkg_manager_;
+};
+
+TEST_F(SummaryTest, RoundTripsPackageWithoutImports) {
+  types::Package* lib = LoadTypesPackage("lib");
+  ASSERT_NE(lib, nullptr);
+  std::string summary = WriteSummary(lib, KeyOfPackage);
+
+  types::Info info;
+  info.builder().ShareUniverseOf(pkg_manager_.type_info());
+  types::Package* read_lib = ReadSummary(summary, "lib", ImporterFor(nullptr), &info);
+
+  ASSERT_NE(read_lib, nullptr);
+  EXPECT_EQ(read_lib->name(), "lib");
+  EXPECT_THAT(read_lib->scope()->named_objects(), SizeIs(lib->scope()->named_objects().size()));
+  EXPECT_EQ(WriteSummary(read_lib, KeyOfPackage), summary);
+
+  types::Constant* big =
+      static_cast<types::Constant*>(read_lib->scope()->named_objects().at("Big"));
+  EXPECT_EQ(big->value().ToString(), "4000000000");
+  types::NamedType* array_list = static_cast<types::NamedType*>(
+      static_cast<types::TypeName*>(read_lib->scope()->named_objects().at("ArrayList"))->type());
+  EXPECT_THAT(array_list->type_parameters(), SizeIs(1));
+  EXPECT_TRUE(array_list->methods().contains("Get"));
+}
+
+TEST_F(SummaryTest, RoundTripsPackageWithImports) {
+  types::Package* user = LoadTypesPackage("user");
+  ASSERT_NE(user, nullptr);
+  types::Package* lib = *user->imports().begin();
+  std::string summary = WriteSummary(user, KeyOfPackage);
+
+  types::Info info;
+  info.builder().ShareUniverseOf(pkg_manager_.type_info());
+  types::Package* read_user = ReadSummary(summary, "user", ImporterFor(lib), &info);
+
+  ASSERT_NE(read_user, nullptr);
+  EXPECT_THAT(read_user->imports(), SizeIs(1));
+  EXPECT_EQ(WriteSummary(read_user, KeyOfPackage), summary);
+
+  types::NamedType* index = static_cast<types::NamedType*>(
+      static_cast<types::TypeName*>(read_user->scope()->named_objects().at("Index"))->type());
+  ASSERT_EQ(index->underlying()->type_kind(), types::TypeKind::kTypeInstance);
+  EXPECT_EQ(static_cast<types::TypeInstance*>(index->underlying())->instantiated_type(),
+            static_cast<types::TypeName*>(lib->scope()->named_objects().at("HashMap"))->type());
+}
+
+TEST_F(SummaryTest, RejectsSummaryWithMismatchedImportKey) {
+  types::Package* user = LoadTypesPackage("user");
+  ASSERT_NE(user, nullptr);
+  types::Package* lib = *user->imports().begin();
+  std::string summary =
+      WriteSummary(user, [](std::string path) { return "outdated-" + KeyOfPackage(path); });
+
+  types::Info info;
+  info.builder().ShareUniverseOf(pkg_manager_.type_info());
+
+  EXPECT_EQ(ReadSummary(summary, "user", ImporterFor(lib), &info), nullptr);
+  EXPECT_THAT(info.packages(), IsEmpty());
+}
+
+TEST_F(SummaryTest, RejectsMalformedSummaries) {
+  types::Package* lib = LoadTypesPackage("lib");
+  ASSERT_NE(lib, nullptr);
+  std::string summary = WriteSummary(lib, KeyOfPackage);
+
+  types::Info info;
+  info.builder().ShareUniverseOf(pkg_manager_.type_info());
+
+  EXPECT_EQ(ReadSummary("", "lib", ImporterFor(nullptr), &info), nullptr);
+  EXPECT_EQ(ReadSummary(summary, "other", ImporterFor(nullptr), &info), nullptr);
+  for (size_t length : {summary.size() / 4, summary.size() / 2, summary.size() - 5}) {
+    EXPECT_EQ(ReadSummary(summary.substr(0, length), "lib", ImporterFor(nullptr), &info), nullptr)
+        << length;
+  }
+  std::string corrupted = summary;
+  corrupted.replace(corrupted.find("\nslice "), 7, "\nslice 9999");
+  EXPECT_EQ(ReadSummary(corrupted, "lib", ImporterFor(nullptr), &info), nullptr);
+  EXPECT_THAT(info.packages(), IsEmpty());
+}
+
+}  // namespace
+}  // namespace summaries
+}  // namespace lang
@@ -8,12 +8,60 @@
 
 #include "ast.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
 #include "src/lang/representation/ast/ast_builder.h"
 
 namespace lang {
 namespace ast {
 
+AST::~AST() {
+  for (Node* node : nodes_) {
+    node->~Node();
+  }
+}
+
 ASTBuilder AST::builder() { return ASTBuilder(this); }
 
+void AST::Merge(AST&& other) {
+  std::move(other.package_unique_ptrs_.begin(), other.package_unique_ptrs_.end(),
+            std::back_inserter(package_unique_ptrs_));
+  // Only the blocks move, so this AST keeps allocating from its own current block.
+  std::move(other.node_blocks_.begin(), other.node_blocks_.end(),
+            std::back_inserter(node_blocks_));
+  nodes_.insert(nodes_.end(), other.nodes_.begin(), other.nodes_.end());
+  packages_.insert(packages_.end(), other.packages_.begin(), other.packages_.end());
+  other.package_unique_ptrs_.clear();
+  other.node_blocks_.clear();
+  other.node_block_next_ = nullptr;
+  other.node_block_end_ = nullptr;
+  other.nodes_.clear();
+  other.packages_.clear();
+}
+
+void* AST::AllocateNode(std::size_t size, std::size_t alignment) {
+  std::uintptr_t next = reinterpret_cast<std::uintptr_t>(node_block_next_);
+  std::uintptr_t aligned = (next + alignment - 1) & ~(std::uintptr_t{alignment} - 1);
+  if (node_block_next_ != nullptr &&
+      aligned + size <= reinterpret_cast<std::uintptr_t>(node_block_end_)) {
+    node_block_next_ = reinterpret_cast<std::byte*>(aligned + size);
+    return reinterpret_cast<void*>(aligned);
+  }
+  // Blocks returned by new[] are suitably aligned for all node types.
+  if (size > kNodeBlockSize / 4) {
+    // Large nodes get their own block, so the current block can still be used for small nodes.
+    node_blocks_.push_back(std::make_unique<std::byte[]>(size));
+    return node_blocks_.back().get();
+  }
+  node_blocks_.push_back(std::make_unique<std::byte[]>(kNodeBlockSize));
+  std::byte* block = node_blocks_.back().get();
+  node_block_next_ = block + size;
+  node_block_end_ = block + kNodeBlockSize;
+  return block;
+}
+
 }  // namespace ast
 }  // namespace lang
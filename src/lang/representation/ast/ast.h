@@ -9,6 +9,7 @@
 #ifndef lang_ast_ast_h
 #define lang_ast_ast_h
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -31,15 +32,34 @@ class Package {
 
 class ASTBuilder;
 
+// AST owns all packages and nodes created through its builders. Nodes get allocated from large
+// memory blocks instead of individually on the heap and get destroyed together with the AST.
 class AST {
  public:
+  AST() = default;
+  AST(const AST&) = delete;
+  AST& operator=(const AST&) = delete;
+  ~AST();
+
   std::vector<Package*> packages() const { return packages_; }
 
   ASTBuilder builder();
 
+  // Moves all packages and nodes of the other AST into this AST. Pointers to them stay valid. This
+  // allows building ASTs for separate packages concurrently.
+  void Merge(AST&& other);
+
  private:
   std::vector<std::unique_ptr<Package>> package_unique_ptrs_;
-  std::vector<std::unique_ptr<Node>> node_unique_ptrs_;
+  static constexpr std::size_t kNodeBlockSize = 64 * 1024;
+
+  // Returns uninitialized memory for a node with the given size and alignment.
+  void* AllocateNode(std::size_t size, std::size_t alignment);
+
+  std::vector<std::unique_ptr<std::byte[]>> node_blocks_;
+  std::byte* node_block_next_ = nullptr;
+  std::byte* node_block_end_ = nullptr;
+  std::vector<Node*> nodes_;
 
   std::vector<Package*> packages_;
 
@@ -10,6 +10,8 @@
 #define lang_ast_ast_builder_h
 
 #include <memory>
+#include <new>
+#include <utility>
 
 #include "src/lang/representation/ast/ast.h"
 #include "src/lang/representation/ast/nodes.h"
@@ -23,9 +25,9 @@ class ASTBuilder {
 
   template <class T, class... Args>
   T* Create(Args&&... args) {
-    return static_cast<T*>(
-        ast_->node_unique_ptrs_.emplace_back(std::unique_ptr<T>(new T(std::forward<Args>(args)...)))
-            .get());
+    T* node = new (ast_->AllocateNode(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    ast_->nodes_.push_back(node);
+    return node;
   }
 
  private:
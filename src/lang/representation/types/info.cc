@@ -8,11 +8,17 @@
 
 #include "info.h"
 
+#include <iterator>
+#include <utility>
+
+#include "src/common/logging/logging.h"
 #include "src/lang/representation/types/info_builder.h"
 
 namespace lang {
 namespace types {
 
+using ::common::logging::fail;
+
 Object* Info::ObjectOf(ast::Ident* ident) const {
   auto defs_it = definitions_.find(ident);
   if (defs_it != definitions_.end()) {
@@ -79,6 +85,33 @@ Type* Info::TypeOf(ast::Expr* expr) const {
   return nullptr;
 }
 
+void Info::Merge(Info&& other) {
+  if (other.universe_ != universe_) {
+    fail("attempted to merge info with different universe");
+  }
+  std::move(other.type_unique_ptrs_.begin(), other.type_unique_ptrs_.end(),
+            std::back_inserter(type_unique_ptrs_));
+  std::move(other.object_unique_ptrs_.begin(), other.object_unique_ptrs_.end(),
+            std::back_inserter(object_unique_ptrs_));
+  std::move(other.scope_unique_ptrs_.begin(), other.scope_unique_ptrs_.end(),
+            std::back_inserter(scope_unique_ptrs_));
+  std::move(other.package_unique_ptrs_.begin(), other.package_unique_ptrs_.end(),
+            std::back_inserter(package_unique_ptrs_));
+  expr_infos_.merge(other.expr_infos_);
+  definitions_.merge(other.definitions_);
+  uses_.merge(other.uses_);
+  implicits_.merge(other.implicits_);
+  selections_.merge(other.selections_);
+  scopes_.merge(other.scopes_);
+  packages_.merge(other.packages_);
+  init_order_.insert(init_order_.end(), other.init_order_.begin(), other.init_order_.end());
+  other.type_unique_ptrs_.clear();
+  other.object_unique_ptrs_.clear();
+  other.scope_unique_ptrs_.clear();
+  other.package_unique_ptrs_.clear();
+  other.init_order_.clear();
+}
+
 InfoBuilder Info::builder() { return InfoBuilder(this); }
 
 }  // namespace types
@@ -10,6 +10,7 @@
 #define lang_types_type_info_h
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <unordered_map>
 #include <unordered_set>
@@ -62,6 +63,11 @@ class Info {
 
   InfoBuilder builder();
 
+  // Moves all types, objects, scopes, packages and their mappings to AST nodes of the other info
+  // into this info. Pointers to them stay valid. The other info has to share the universe of this
+  // info. This allows checking separate packages concurrently.
+  void Merge(Info&& other);
+
  private:
   std::vector<std::unique_ptr<Type>> type_unique_ptrs_;
   std::vector<std::unique_ptr<Object>> object_unique_ptrs_;
@@ -84,6 +90,10 @@ class Info {
   Scope* universe_ = nullptr;
   std::unordered_map<Basic::Kind, Basic*> basic_types_;
 
+  // Guards objects that can be shared between infos with the same universe while they get built
+  // concurrently: the children of the universe and instances of named types.
+  std::shared_ptr<std::mutex> shared_objects_mutex_ = std::make_shared<std::mutex>();
+
   friend InfoBuilder;
 };
 
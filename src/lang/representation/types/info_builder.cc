@@ -9,9 +9,12 @@
 #include "info_builder.h"
 
 #include <algorithm>
+#include <mutex>
+#include <unordered_set>
 
 #include "src/common/atomics/atomics.h"
 #include "src/common/logging/logging.h"
+#include "src/lang/representation/ast/ast_util.h"
 
 namespace lang {
 namespace types {
@@ -42,6 +45,17 @@ void InfoBuilder::CreateUniverse() {
   CreatePredeclaredFuncs();
 }
 
+void InfoBuilder::ShareUniverseOf(const Info* other) {
+  if (info_->universe_ != nullptr) {
+    fail("attempted to share universe with info that already has a universe");
+  } else if (other->universe_ == nullptr) {
+    fail("attempted to share universe of info without universe");
+  }
+  info_->universe_ = other->universe_;
+  info_->basic_types_ = other->basic_types_;
+  info_->shared_objects_mutex_ = other->shared_objects_mutex_;
+}
+
 void InfoBuilder::CreatePredeclaredTypes() {
   typedef struct {
     types::Basic::Kind kind;
@@ -341,6 +355,28 @@ Type* InfoBuilder::InstantiateType(Type* type, TypeParamsToArgsMap& type_params_
   }
 }
 
+Type* InfoBuilder::InstantiateUnderlyingType(TypeInstance* type_instance) {
+  NamedType* instantiated_type = type_instance->instantiated_type();
+  const std::vector<Type*>& type_args = type_instance->type_args();
+  // The instantiated type might belong to an imported package that also gets instantiated by other
+  // packages checked concurrently.
+  std::scoped_lock lock(*info_->shared_objects_mutex_);
+  Type* underlying = instantiated_type->InstanceForTypeArgs(type_args);
+  if (underlying != nullptr) {
+    return underlying;
+  }
+  TypeParamsToArgsMap type_params_to_args;
+  type_params_to_args.reserve(type_args.size());
+  for (size_t i = 0; i < type_args.size(); i++) {
+    TypeParameter* type_param = instantiated_type->type_parameters().at(i);
+    Type* type_arg = type_args.at(i);
+    type_params_to_args.insert({type_param, type_arg});
+  }
+  underlying = InstantiateType(instantiated_type->underlying(), type_params_to_args);
+  AddInstanceToNamedType(instantiated_type, type_args, underlying);
+  return underlying;
+}
+
 Pointer* InfoBuilder::InstantiatePointer(Pointer* pointer,
                                          TypeParamsToArgsMap& type_params_to_args) {
   Type* element_type = pointer->element_type();
@@ -729,7 +765,10 @@ Package* InfoBuilder::CreatePackage(std::string path, std::string name) {
 
   Scope* package_scope_ptr = package_scope.get();
   info_->scope_unique_ptrs_.push_back(std::move(package_scope));
-  info_->universe_->children_.push_back(package_scope_ptr);
+  {
+    std::scoped_lock lock(*info_->shared_objects_mutex_);
+    info_->universe_->children_.push_back(package_scope_ptr);
+  }
 
   std::unique_ptr<Package> package = std::unique_ptr<Package>(new Package());
   package->path_ = path;
@@ -747,6 +786,230 @@ void InfoBuilder::AddImportToPackage(Package* importer, Package* imported) {
   importer->imports_.insert(imported);
 }
 
+void InfoBuilder::RemovePackage(Package* package, ast::Package* ast_package) {
+  if (!info_->packages_.contains(package)) {
+    fail("attempted to remove package not in info");
+  }
+  info_->packages_.erase(package);
+  {
+    std::scoped_lock lock(*info_->shared_objects_mutex_);
+    std::erase(info_->universe_->children_, package->scope());
+  }
+  std::erase_if(info_->init_order_, [package](const Initializer& initializer) {
+    return std::any_of(initializer.lhs().begin(), initializer.lhs().end(),
+                       [package](Variable* variable) { return variable->package() == package; });
+  });
+  if (ast_package == nullptr) {
+    return;
+  }
+  std::unordered_set<ast::Node*> nodes;
+  ast::WalkFunction collector = ast::WalkFunction([&](ast::Node* node) -> ast::WalkFunction {
+    if (node != nullptr) {
+      nodes.insert(node);
+    }
+    return collector;
+  });
+  for (auto [name, ast_file] : ast_package->files()) {
+    ast::Walk(ast_file, collector);
+  }
+  auto has_removed_node = [&nodes](const auto& entry) { return nodes.contains(entry.first); };
+  std::erase_if(info_->expr_infos_, has_removed_node);
+  std::erase_if(info_->definitions_, has_removed_node);
+  std::erase_if(info_->uses_, has_removed_node);
+  std::erase_if(info_->implicits_, has_removed_node);
+  std::erase_if(info_->selections_, has_removed_node);
+  std::erase_if(info_->scopes_, has_removed_node);
+}
+
+void InfoBuilder::RemoveUnreachableTypesAndObjects() {
+  Reachable reachable;
+  MarkScopeReachable(info_->universe_, reachable);
+  for (auto [kind, basic] : info_->basic_types_) {
+    MarkTypeReachable(basic, reachable);
+  }
+  for (Package* package : info_->packages_) {
+    MarkPackageReachable(package, reachable);
+  }
+  for (auto& [expr, expr_info] : info_->expr_infos_) {
+    MarkTypeReachable(expr_info.type(), reachable);
+  }
+  for (auto& [ident, object] : info_->definitions_) {
+    MarkObjectReachable(object, reachable);
+  }
+  for (auto& [ident, object] : info_->uses_) {
+    MarkObjectReachable(object, reachable);
+  }
+  for (auto& [node, object] : info_->implicits_) {
+    MarkObjectReachable(object, reachable);
+  }
+  for (auto& [selection_expr, selection] : info_->selections_) {
+    MarkTypeReachable(selection.receiver_type(), reachable);
+    MarkTypeReachable(selection.type(), reachable);
+    MarkObjectReachable(selection.object(), reachable);
+  }
+  for (auto& [node, scope] : info_->scopes_) {
+    MarkScopeReachable(scope, reachable);
+  }
+  for (const Initializer& initializer : info_->init_order_) {
+    for (Variable* variable : initializer.lhs()) {
+      MarkObjectReachable(variable, reachable);
+    }
+  }
+  MarkInstancesReachable(reachable);
+
+  auto is_reachable = [&reachable](Type* type) { return reachable.types.contains(type); };
+  for (NamedType* named_type : reachable.named_types) {
+    std::erase_if(named_type->instances_, [&is_reachable](const auto& instance) {
+      auto& [type_args, instance_type] = instance;
+      return !is_reachable(instance_type) ||
+             !std::all_of(type_args.begin(), type_args.end(), is_reachable);
+    });
+  }
+  std::erase_if(info_->type_unique_ptrs_, [&reachable](const std::unique_ptr<Type>& type) {
+    return !reachable.types.contains(type.get());
+  });
+  std::erase_if(info_->object_unique_ptrs_, [&reachable](const std::unique_ptr<Object>& object) {
+    return !reachable.objects.contains(object.get());
+  });
+  std::erase_if(info_->scope_unique_ptrs_, [&reachable](const std::unique_ptr<Scope>& scope) {
+    return !reachable.scopes.contains(scope.get());
+  });
+  std::erase_if(info_->package_unique_ptrs_, [&reachable](const std::unique_ptr<Package>& package) {
+    return !reachable.packages.contains(package.get());
+  });
+}
+
+void InfoBuilder::MarkTypeReachable(Type* type, Reachable& reachable) const {
+  if (type == nullptr || !reachable.types.insert(type).second) {
+    return;
+  }
+  switch (type->type_kind()) {
+    case TypeKind::kBasic:
+      return;
+    case TypeKind::kPointer:
+    case TypeKind::kArray:
+    case TypeKind::kSlice:
+      MarkTypeReachable(static_cast<Wrapper*>(type)->element_type(), reachable);
+      return;
+    case TypeKind::kTypeParameter: {
+      auto type_parameter = static_cast<TypeParameter*>(type);
+      MarkTypeReachable(type_parameter->instantiated_type_parameter(), reachable);
+      MarkTypeReachable(type_parameter->interface(), reachable);
+      return;
+    }
+    case TypeKind::kNamedType: {
+      // Instances are only reachable through their named type if their type arguments are
+      // reachable otherwise, see MarkInstancesReachable.
+      auto named_type = static_cast<NamedType*>(type);
+      reachable.named_types.push_back(named_type);
+      MarkTypeReachable(named_type->underlying(), reachable);
+      for (TypeParameter* type_parameter : named_type->type_parameters()) {
+        MarkTypeReachable(type_parameter, reachable);
+      }
+      for (auto& [name, method] : named_type->methods()) {
+        MarkObjectReachable(method, reachable);
+      }
+      return;
+    }
+    case TypeKind::kTypeInstance: {
+      auto type_instance = static_cast<TypeInstance*>(type);
+      MarkTypeReachable(type_instance->instantiated_type(), reachable);
+      for (Type* type_arg : type_instance->type_args()) {
+        MarkTypeReachable(type_arg, reachable);
+      }
+      return;
+    }
+    case TypeKind::kTuple:
+      for (Variable* variable : static_cast<Tuple*>(type)->variables()) {
+        MarkObjectReachable(variable, reachable);
+      }
+      return;
+    case TypeKind::kSignature: {
+      auto signature = static_cast<Signature*>(type);
+      MarkObjectReachable(signature->expr_receiver(), reachable);
+      MarkTypeReachable(signature->type_receiver(), reachable);
+      for (TypeParameter* type_parameter : signature->type_parameters()) {
+        MarkTypeReachable(type_parameter, reachable);
+      }
+      MarkTypeReachable(signature->parameters(), reachable);
+      MarkTypeReachable(signature->results(), reachable);
+      return;
+    }
+    case TypeKind::kStruct:
+      for (Variable* field : static_cast<Struct*>(type)->fields()) {
+        MarkObjectReachable(field, reachable);
+      }
+      return;
+    case TypeKind::kInterface: {
+      auto interface = static_cast<Interface*>(type);
+      for (NamedType* embedded_interface : interface->embedded_interfaces()) {
+        MarkTypeReachable(embedded_interface, reachable);
+      }
+      for (Func* method : interface->methods()) {
+        MarkObjectReachable(method, reachable);
+      }
+      return;
+    }
+  }
+}
+
+void InfoBuilder::MarkObjectReachable(Object* object, Reachable& reachable) const {
+  if (object == nullptr || !reachable.objects.insert(object).second) {
+    return;
+  }
+  MarkScopeReachable(object->parent(), reachable);
+  MarkPackageReachable(object->package(), reachable);
+  if (object->is_typed()) {
+    MarkTypeReachable(static_cast<TypedObject*>(object)->type(), reachable);
+  }
+  if (object->object_kind() == ObjectKind::kPackageName) {
+    MarkPackageReachable(static_cast<PackageName*>(object)->referenced_package(), reachable);
+  }
+}
+
+void InfoBuilder::MarkScopeReachable(Scope* scope, Reachable& reachable) const {
+  if (scope == nullptr || !reachable.scopes.insert(scope).second) {
+    return;
+  }
+  MarkScopeReachable(scope->parent(), reachable);
+  for (Scope* child : scope->children()) {
+    MarkScopeReachable(child, reachable);
+  }
+  for (auto& [name, object] : scope->named_objects()) {
+    MarkObjectReachable(object, reachable);
+  }
+  for (Object* object : scope->unnamed_objects()) {
+    MarkObjectReachable(object, reachable);
+  }
+}
+
+void InfoBuilder::MarkPackageReachable(Package* package, Reachable& reachable) const {
+  if (package == nullptr || !reachable.packages.insert(package).second) {
+    return;
+  }
+  MarkScopeReachable(package->scope(), reachable);
+  for (Package* import : package->imports()) {
+    MarkPackageReachable(import, reachable);
+  }
+}
+
+void InfoBuilder::MarkInstancesReachable(Reachable& reachable) const {
+  // Marking an instance can make the type arguments of other instances reachable, so this repeats
+  // until no more types become reachable.
+  auto is_reachable = [&reachable](Type* type) { return reachable.types.contains(type); };
+  std::size_t reachable_types_count;
+  do {
+    reachable_types_count = reachable.types.size();
+    for (std::size_t i = 0; i < reachable.named_types.size(); i++) {
+      for (auto& [type_args, instance] : reachable.named_types.at(i)->instances_) {
+        if (std::all_of(type_args.begin(), type_args.end(), is_reachable)) {
+          MarkTypeReachable(instance, reachable);
+        }
+      }
+    }
+  } while (reachable.types.size() != reachable_types_count);
+}
+
 void InfoBuilder::SetSelection(ast::SelectionExpr* selection_expr, types::Selection selection) {
   if (info_->selections_.contains(selection_expr)) {
     fail("attempted to set selection of selection expr twice");
@@ -11,6 +11,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "src/common/positions/positions.h"
@@ -35,6 +36,9 @@ class InfoBuilder {
   Info* info() const;
 
   void CreateUniverse();
+  // Makes the info use the universe of the other info instead of creating its own, such that the
+  // infos can later get merged.
+  void ShareUniverseOf(const Info* other);
 
   Pointer* CreatePointer(Pointer::Kind kind, Type* element_type);
   Array* CreateArray(Type* element_type, uint64_t length);
@@ -55,6 +59,9 @@ class InfoBuilder {
                                         TypeParamsToArgsMap& type_params_to_args,
                                         bool receiver_to_arg);
   Type* InstantiateType(Type* parameterized_type, TypeParamsToArgsMap& type_params_to_args);
+  // Returns the underlying type of the type instance, instantiating the underlying type of the named
+  // type with the type arguments if that did not happen before.
+  Type* InstantiateUnderlyingType(TypeInstance* type_instance);
 
   void SetTypeParameterInstance(TypeParameter* instantiated, TypeParameter* instance);
   void SetTypeParameterInterface(TypeParameter* type_parameter, Interface* interface);
@@ -97,6 +104,16 @@ class InfoBuilder {
 
   Package* CreatePackage(std::string path, std::string name);
   void AddImportToPackage(Package* importer, Package* imported);
+  // Removes the package, its initializers, and all information about the nodes of the given AST
+  // package (if any) from the info, such that the package can get checked again. Packages importing
+  // the package have to get removed as well. Types and objects of the package stay allocated until
+  // RemoveUnreachableTypesAndObjects gets called.
+  void RemovePackage(Package* package, ast::Package* ast_package);
+  // Deletes all types, objects, scopes, and packages that can no longer be reached from the
+  // universe, the packages of the info, or the information about AST nodes, e.g. after packages got
+  // removed. Cached instances of named types get dropped if their type arguments can not be reached
+  // otherwise. Must not be called while other infos sharing the universe get built.
+  void RemoveUnreachableTypesAndObjects();
 
   void SetSelection(ast::SelectionExpr* selection_expr, types::Selection selection);
 
@@ -128,6 +145,19 @@ class InfoBuilder {
 
   void CheckObjectArgs(Scope* parent, Package* package) const;
 
+  struct Reachable {
+    std::unordered_set<Type*> types;
+    std::unordered_set<Object*> objects;
+    std::unordered_set<Scope*> scopes;
+    std::unordered_set<Package*> packages;
+    std::vector<NamedType*> named_types;
+  };
+  void MarkTypeReachable(Type* type, Reachable& reachable) const;
+  void MarkObjectReachable(Object* object, Reachable& reachable) const;
+  void MarkScopeReachable(Scope* scope, Reachable& reachable) const;
+  void MarkPackageReachable(Package* package, Reachable& reachable) const;
+  void MarkInstancesReachable(Reachable& reachable) const;
+
   Info* info_;
 
   friend Info;
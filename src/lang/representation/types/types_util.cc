@@ -109,21 +109,7 @@ Type* UnderlyingOf(Type* type, InfoBuilder& info_builder) {
       if (instantiated_type->type_parameters().empty()) {
         return instantiated_type->underlying();
       }
-      const std::vector<Type*>& type_args = type_instance->type_args();
-      Type* underlying = instantiated_type->InstanceForTypeArgs(type_args);
-      if (underlying == nullptr) {
-        InfoBuilder::TypeParamsToArgsMap type_params_to_args;
-        type_params_to_args.reserve(type_args.size());
-        for (size_t i = 0; i < type_args.size(); i++) {
-          TypeParameter* type_param = instantiated_type->type_parameters().at(i);
-          Type* type_arg = type_args.at(i);
-          type_params_to_args.insert({type_param, type_arg});
-        }
-        underlying =
-            info_builder.InstantiateType(instantiated_type->underlying(), type_params_to_args);
-        info_builder.AddInstanceToNamedType(instantiated_type, type_args, underlying);
-      }
-      return underlying;
+      return info_builder.InstantiateUnderlyingType(type_instance);
     }
     default:
       fail("unexpected lang type");
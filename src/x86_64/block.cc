@@ -19,6 +19,8 @@ using ::common::data::DataView;
 
 Program* Block::program() const { return func_->program(); }
 
+int64_t Block::MaxEncodedSize() const { return int64_t(instrs_.size()) * kMaxInstrSize; }
+
 int64_t Block::Encode(Linker& linker, DataView code) const {
   linker.AddBlockAddr(block_id_, code.base());
 
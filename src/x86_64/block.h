@@ -32,6 +32,7 @@ class Block {
   BlockRef GetBlockRef() const { return BlockRef(block_id_); }
 
   const std::vector<std::unique_ptr<Instr>>& instrs() const { return instrs_; }
+  std::vector<std::unique_ptr<Instr>>& instrs() { return instrs_; }
 
   template <class T, class... Args>
   void AddInstr(Args&&... args) {
@@ -44,6 +45,8 @@ class Block {
     return instrs_.insert(it, std::make_unique<T>(args...));
   }
 
+  // Returns an upper bound for the number of bytes written by Encode.
+  int64_t MaxEncodedSize() const;
   int64_t Encode(Linker& linker, common::data::DataView code) const;
   std::string ToString() const;
 
@@ -21,6 +21,14 @@ Block* Func::AddBlock() {
   return blocks_.emplace_back(new Block(this, block_num)).get();
 }
 
+int64_t Func::MaxEncodedSize() const {
+  int64_t size = 0;
+  for (auto& block : blocks_) {
+    size += block->MaxEncodedSize();
+  }
+  return size;
+}
+
 int64_t Func::Encode(Linker& linker, DataView code) const {
   linker.AddFuncAddr(func_num_, code.base());
 
@@ -34,6 +34,8 @@ class Func {
 
   Block* AddBlock();
 
+  // Returns an upper bound for the number of bytes written by Encode.
+  int64_t MaxEncodedSize() const;
   int64_t Encode(Linker& linker, common::data::DataView code) const;
   std::string ToString() const;
 
@@ -71,6 +71,7 @@ class Not final : public UnaryALInstr {
  public:
   using UnaryALInstr::UnaryALInstr;
 
+  InstrKind instr_kind() const override { return InstrKind::kNot; }
   std::string ToString() const override;
 
  private:
@@ -82,6 +83,7 @@ class And final : public BinaryALInstr {
  public:
   using BinaryALInstr::BinaryALInstr;
 
+  InstrKind instr_kind() const override { return InstrKind::kAnd; }
   std::string ToString() const override;
 
  private:
@@ -93,6 +95,7 @@ class Or final : public BinaryALInstr {
  public:
   using BinaryALInstr::BinaryALInstr;
 
+  InstrKind instr_kind() const override { return InstrKind::kOr; }
   std::string ToString() const override;
 
  private:
@@ -104,6 +107,7 @@ class Xor final : public BinaryALInstr {
  public:
   using BinaryALInstr::BinaryALInstr;
 
+  InstrKind instr_kind() const override { return InstrKind::kXor; }
   std::string ToString() const override;
 
  private:
@@ -115,6 +119,7 @@ class Neg final : public UnaryALInstr {
  public:
   using UnaryALInstr::UnaryALInstr;
 
+  InstrKind instr_kind() const override { return InstrKind::kNeg; }
   std::string ToString() const override;
 
  private:
@@ -126,6 +131,7 @@ class Add final : public BinaryALInstr {
  public:
   using BinaryALInstr::BinaryALInstr;
 
+  InstrKind instr_kind() const override { return InstrKind::kAdd; }
   std::string ToString() const override;
 
  private:
@@ -137,6 +143,7 @@ class Adc final : public BinaryALInstr {
  public:
   using BinaryALInstr::BinaryALInstr;
 
+  InstrKind instr_kind() const override { return InstrKind::kAdc; }
   std::string ToString() const override;
 
  private:
@@ -148,6 +155,7 @@ class Sub final : public BinaryALInstr {
  public:
   using BinaryALInstr::BinaryALInstr;
 
+  InstrKind instr_kind() const override { return InstrKind::kSub; }
   std::string ToString() const override;
 
  private:
@@ -159,6 +167,7 @@ class Sbb final : public BinaryALInstr {
  public:
   using BinaryALInstr::BinaryALInstr;
 
+  InstrKind instr_kind() const override { return InstrKind::kSbb; }
   std::string ToString() const override;
 
  private:
@@ -170,6 +179,7 @@ class Cmp final : public BinaryALInstr {
  public:
   using BinaryALInstr::BinaryALInstr;
 
+  InstrKind instr_kind() const override { return InstrKind::kCmp; }
   std::string ToString() const override;
 
  private:
@@ -183,6 +193,7 @@ class Mul final : public Instr {
 
   RM factor() const { return factor_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kMul; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -200,6 +211,7 @@ class Imul final : public Instr {
   RM factor_b() const { return factor_b_; }
   Imm factor_c() const { return factor_c_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kImul; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -225,6 +237,7 @@ class Div final : public Instr {
 
   RM divisor() const { return divisor_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kDiv; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -238,6 +251,7 @@ class Idiv final : public Instr {
 
   RM divisor() const { return divisor_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kIdiv; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -251,6 +265,7 @@ class SignExtendRegA final : public Instr {
 
   Size op_size() const { return op_size_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kSignExtendRegA; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -263,6 +278,7 @@ class SignExtendRegAD final : public Instr {
 
   Size op_size() const { return op_size_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kSignExtendRegAD; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -278,6 +294,7 @@ class Test final : public Instr {
   RM op_a() const { return op_a_; }
   Operand op_b() const { return op_b_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kTest; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
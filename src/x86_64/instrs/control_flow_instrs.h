@@ -27,6 +27,7 @@ class Jcc final : public Instr {
   InstrCond cond() const { return cond_; }
   BlockRef dst() const { return dst_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kJcc; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -40,6 +41,9 @@ class Jmp final : public Instr {
   Jmp(RM rm);
   Jmp(BlockRef block_ref) : dst_(block_ref) {}
 
+  Operand dst() const { return dst_; }
+
+  InstrKind instr_kind() const override { return InstrKind::kJmp; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -52,6 +56,7 @@ class Call final : public Instr {
   Call(RM rm);
   Call(FuncRef func_ref) : callee_(func_ref) {}
 
+  InstrKind instr_kind() const override { return InstrKind::kCall; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -61,12 +66,14 @@ class Call final : public Instr {
 
 class Syscall final : public Instr {
  public:
+  InstrKind instr_kind() const override { return InstrKind::kSyscall; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 };
 
 class Ret final : public Instr {
  public:
+  InstrKind instr_kind() const override { return InstrKind::kRet; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 };
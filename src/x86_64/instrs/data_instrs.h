@@ -27,6 +27,7 @@ class Mov final : public Instr {
   RM dst() const { return dst_; }
   Operand src() const { return src_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kMov; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -45,6 +46,7 @@ class Xchg final : public Instr {
   RM op_a() const { return op_a_; }
   Reg op_b() const { return op_b_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kXchg; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -62,6 +64,7 @@ class Push final : public Instr {
 
   Operand op() const { return op_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kPush; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -75,6 +78,7 @@ class Pop final : public Instr {
 
   RM op() const { return op_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kPop; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -89,6 +93,7 @@ class Setcc final : public Instr {
   InstrCond cond() const { return cond_; }
   RM op() const { return op_; }
 
+  InstrKind instr_kind() const override { return InstrKind::kSetcc; }
   int8_t Encode(Linker& linker, common::data::DataView code) const override;
   std::string ToString() const override;
 
@@ -21,10 +21,49 @@ namespace x86_64 {
 // SAL/SAR/SHL/SHR      (shift)
 // RCL/RCR/ROL/ROR      (rotate)
 
+// The maximum length of an encoded x86_64 instruction in bytes.
+constexpr int64_t kMaxInstrSize = 15;
+
+enum class InstrKind {
+  // Data instrs:
+  kMov,
+  kXchg,
+  kPush,
+  kPop,
+  kSetcc,
+
+  // Arithmetic and logic instrs:
+  kNot,
+  kAnd,
+  kOr,
+  kXor,
+  kNeg,
+  kAdd,
+  kAdc,
+  kSub,
+  kSbb,
+  kCmp,
+  kMul,
+  kImul,
+  kDiv,
+  kIdiv,
+  kSignExtendRegA,
+  kSignExtendRegAD,
+  kTest,
+
+  // Control flow instrs:
+  kJcc,
+  kJmp,
+  kCall,
+  kSyscall,
+  kRet,
+};
+
 class Instr {
  public:
   virtual ~Instr() {}
 
+  virtual InstrKind instr_kind() const = 0;
   virtual int8_t Encode(Linker& linker, common::data::DataView code) const = 0;
   virtual std::string ToString() const = 0;
 };
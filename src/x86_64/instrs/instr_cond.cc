@@ -10,6 +10,9 @@
 
 namespace x86_64 {
 
+// Conditions come in pairs that only differ in the lowest bit of their encoding.
+InstrCond Invert(InstrCond cond) { return InstrCond(cond ^ 0x01); }
+
 std::string to_suffix_string(InstrCond cond) {
   switch (cond) {
     case InstrCond::kOverflow:
@@ -46,6 +46,9 @@ typedef enum : int8_t {
   kLess = 0x0c
 } InstrCond;
 
+// Returns the condition that holds exactly when the given condition does not hold.
+extern InstrCond Invert(InstrCond cond);
+
 extern std::string to_suffix_string(InstrCond cond);
 
 }  // namespace x86_64
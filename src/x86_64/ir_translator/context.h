@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 #include "src/ir/info/block_live_ranges.h"
 #include "src/ir/info/func_live_ranges.h"
@@ -60,13 +61,14 @@ class FuncContext {
               const ir_info::FuncLiveRanges& live_ranges,
               const ir_info::InterferenceGraph& interference_graph,
               const ir_info::InterferenceGraphColors& interference_graph_colors)
-      : program_ctx_(program_ctx),
-        ir_func_(ir_func),
-        x86_64_func_(x86_64_func),
-        live_ranges_(live_ranges),
-        interference_graph_(interference_graph),
-        interference_graph_colors_(interference_graph_colors),
-        used_colors_(interference_graph_colors.GetColors(interference_graph.values())) {}
+      : FuncContext(program_ctx, ir_func, x86_64_func, live_ranges, interference_graph_colors,
+                    interference_graph_colors.GetColors(interference_graph.values())) {}
+  // For colors assigned without an interference graph, e.g. by linear scan.
+  FuncContext(ProgramContext& program_ctx, const ir::Func* ir_func, x86_64::Func* x86_64_func,
+              const ir_info::FuncLiveRanges& live_ranges,
+              const ir_info::InterferenceGraphColors& interference_graph_colors)
+      : FuncContext(program_ctx, ir_func, x86_64_func, live_ranges, interference_graph_colors,
+                    interference_graph_colors.GetColors()) {}
 
   ProgramContext& program_ctx() const { return program_ctx_; }
 
@@ -77,7 +79,6 @@ class FuncContext {
   x86_64::Func* x86_64_func() const { return x86_64_func_; }
 
   const ir_info::FuncLiveRanges& live_ranges() const { return live_ranges_; }
-  const ir_info::InterferenceGraph& interference_graph() const { return interference_graph_; }
   const ir_info::InterferenceGraphColors& interference_graph_colors() const {
     return interference_graph_colors_;
   }
@@ -90,13 +91,23 @@ class FuncContext {
                                              x86_64::block_num_t x86_64_block_num);
 
  private:
+  FuncContext(ProgramContext& program_ctx, const ir::Func* ir_func, x86_64::Func* x86_64_func,
+              const ir_info::FuncLiveRanges& live_ranges,
+              const ir_info::InterferenceGraphColors& interference_graph_colors,
+              std::unordered_set<ir_info::color_t> used_colors)
+      : program_ctx_(program_ctx),
+        ir_func_(ir_func),
+        x86_64_func_(x86_64_func),
+        live_ranges_(live_ranges),
+        interference_graph_colors_(interference_graph_colors),
+        used_colors_(std::move(used_colors)) {}
+
   ProgramContext& program_ctx_;
 
   const ir::Func* ir_func_;
   x86_64::Func* x86_64_func_;
 
   const ir_info::FuncLiveRanges& live_ranges_;
-  const ir_info::InterferenceGraph& interference_graph_;
   const ir_info::InterferenceGraphColors& interference_graph_colors_;
   std::unordered_set<ir_info::color_t> used_colors_;
 
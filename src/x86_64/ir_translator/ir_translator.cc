@@ -36,12 +36,12 @@ std::vector<x86_64::Func*> PrepareFuncs(ProgramContext& ctx) {
   return x86_64_funcs;
 }
 
-}  // namespace
-
-TranslationResults Translate(
+TranslationResults TranslateWithColors(
     const ir::Program* ir_program,
     const std::unordered_map<ir::func_num_t, const ir_info::FuncLiveRanges>& live_ranges,
-    const std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraph>& interference_graphs,
+    const std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraph>* interference_graphs,
+    std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraphColors>
+        interference_graph_colors,
     bool generate_debug_info) {
   auto x86_64_program = std::make_unique<x86_64::Program>();
 
@@ -51,18 +51,22 @@ TranslationResults Translate(
   std::vector<x86_64::Func*> x86_64_funcs = PrepareFuncs(program_ctx);
 
   std::unordered_map<ir::func_num_t, x86_64::func_num_t> ir_to_x86_64_func_nums;
-  std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraphColors>
-      interference_graph_colors = AllocateRegisters(ir_program, interference_graphs);
 
   for (std::size_t i = 0; i < ir_program->funcs().size(); i++) {
     ir::Func* ir_func = ir_program->funcs().at(i).get();
     ir::func_num_t ir_func_num = ir_func->number();
     x86_64::Func* x86_64_func = x86_64_funcs.at(i);
 
-    FuncContext func_ctx(program_ctx, ir_func, x86_64_func, live_ranges.at(ir_func_num),
-                         interference_graphs.at(ir_func_num),
-                         interference_graph_colors.at(ir_func_num));
-    TranslateFunc(func_ctx);
+    if (interference_graphs != nullptr) {
+      FuncContext func_ctx(program_ctx, ir_func, x86_64_func, live_ranges.at(ir_func_num),
+                           interference_graphs->at(ir_func_num),
+                           interference_graph_colors.at(ir_func_num));
+      TranslateFunc(func_ctx);
+    } else {
+      FuncContext func_ctx(program_ctx, ir_func, x86_64_func, live_ranges.at(ir_func_num),
+                           interference_graph_colors.at(ir_func_num));
+      TranslateFunc(func_ctx);
+    }
 
     if (generate_debug_info) {
       ir_to_x86_64_func_nums.insert({ir_func_num, x86_64_func->func_num()});
@@ -80,4 +84,25 @@ TranslationResults Translate(
   return results;
 }
 
+}  // namespace
+
+TranslationResults Translate(
+    const ir::Program* ir_program,
+    const std::unordered_map<ir::func_num_t, const ir_info::FuncLiveRanges>& live_ranges,
+    const std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraph>& interference_graphs,
+    bool generate_debug_info) {
+  return TranslateWithColors(ir_program, live_ranges, &interference_graphs,
+                             AllocateRegisters(ir_program, interference_graphs),
+                             generate_debug_info);
+}
+
+TranslationResults TranslateWithLinearScan(
+    const ir::Program* ir_program,
+    const std::unordered_map<ir::func_num_t, const ir_info::FuncLiveRanges>& live_ranges,
+    bool generate_debug_info) {
+  return TranslateWithColors(ir_program, live_ranges, /*interference_graphs=*/nullptr,
+                             AllocateRegistersWithLinearScan(ir_program, live_ranges),
+                             generate_debug_info);
+}
+
 }  // namespace ir_to_x86_64_translator
@@ -35,6 +35,13 @@ TranslationResults Translate(
     const std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraph>& interference_graphs,
     bool generate_debug_info = false);
 
+// Translates the program with registers allocated by linear scan instead of interference graph
+// coloring. This does not require interference graphs and is intended for fast compilation.
+TranslationResults TranslateWithLinearScan(
+    const ir::Program* program,
+    const std::unordered_map<ir::func_num_t, const ir_info::FuncLiveRanges>& live_ranges,
+    bool generate_debug_info = false);
+
 }  // namespace ir_to_x86_64_translator
 
 #endif /* ir_to_x86_64_translator_h */
@@ -9,7 +9,10 @@
 #include "register_allocator.h"
 
 #include "src/common/logging/logging.h"
-#include "src/ir/analyzers/interference_graph_colorer.h"
+#include "src/ir/analyzers/coalescing_graph_colorer.h"
+#include "src/ir/analyzers/live_interval_builder.h"
+#include "src/ir/analyzers/live_interval_colorer.h"
+#include "src/ir/info/live_intervals.h"
 #include "src/ir/representation/block.h"
 #include "src/ir/representation/func.h"
 #include "src/ir/representation/instrs.h"
@@ -126,8 +129,10 @@ void AddPreferredColorsForFuncResults(const ir::ReturnInstr* return_instr,
   }
 }
 
-const ir_info::InterferenceGraphColors AllocateRegistersInFunc(
-    const ir::Func* func, const ir_info::InterferenceGraph& graph) {
+// Colors 0 to 13 represent registers, see ColorAndSizeToOperand.
+constexpr ir_info::color_t kRegisterColorCount = 14;
+
+const ir_info::InterferenceGraphColors PreferredColorsForFunc(const ir::Func* func) {
   ir_info::InterferenceGraphColors preferred_colors;
 
   AddPreferredColorsForFuncArgs(func, preferred_colors);
@@ -142,7 +147,21 @@ const ir_info::InterferenceGraphColors AllocateRegistersInFunc(
     AddPreferredColorsForFuncResults(return_instr, preferred_colors);
   }
 
-  return ir_analyzers::ColorInterferenceGraph(graph, preferred_colors);
+  return preferred_colors;
+}
+
+const ir_info::InterferenceGraphColors AllocateRegistersInFunc(
+    const ir::Func* func, const ir_info::InterferenceGraph& graph) {
+  return ir_analyzers::ColorInterferenceGraphWithCoalescing(
+      func, graph, PreferredColorsForFunc(func), kRegisterColorCount);
+}
+
+const ir_info::InterferenceGraphColors AllocateRegistersInFuncWithLinearScan(
+    const ir::Func* func, const ir_info::FuncLiveRanges& func_live_ranges) {
+  const ir_info::FuncLiveIntervals func_live_intervals =
+      ir_analyzers::BuildLiveIntervalsForFunc(func, func_live_ranges);
+  return ir_analyzers::ColorLiveIntervals(func_live_intervals, PreferredColorsForFunc(func),
+                                          kRegisterColorCount);
 }
 
 }  // namespace
@@ -162,4 +181,19 @@ std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraphColors> Alloc
   return interference_graph_colors;
 }
 
+std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraphColors>
+AllocateRegistersWithLinearScan(
+    const ir::Program* program,
+    const std::unordered_map<ir::func_num_t, const ir_info::FuncLiveRanges>& live_ranges) {
+  std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraphColors>
+      interference_graph_colors;
+  interference_graph_colors.reserve(live_ranges.size());
+  for (auto& ir_func : program->funcs()) {
+    interference_graph_colors.emplace(
+        ir_func->number(),
+        AllocateRegistersInFuncWithLinearScan(ir_func.get(), live_ranges.at(ir_func->number())));
+  }
+  return interference_graph_colors;
+}
+
 }  // namespace ir_to_x86_64_translator
@@ -11,6 +11,7 @@
 
 #include <unordered_map>
 
+#include "src/ir/info/func_live_ranges.h"
 #include "src/ir/info/interference_graph.h"
 #include "src/ir/representation/num_types.h"
 #include "src/ir/representation/program.h"
@@ -36,6 +37,13 @@ std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraphColors> Alloc
     const std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraph>&
         interference_graphs);
 
+// Allocates registers with a linear scan over live intervals derived from the live ranges. This
+// is faster than coloring interference graphs for large functions, at the cost of more spills.
+std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraphColors>
+AllocateRegistersWithLinearScan(
+    const ir::Program* program,
+    const std::unordered_map<ir::func_num_t, const ir_info::FuncLiveRanges>& live_ranges);
+
 }  // namespace ir_to_x86_64_translator
 
 #endif /* ir_to_x86_64_translator_register_allocator_h */
@@ -0,0 +1,299 @@
+//
+//  tiered_interpreter.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "tiered_interpreter.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "src/common/atomics/atomics.h"
+#include "src/common/data/data_view.h"
+#include "src/common/logging/logging.h"
+#include "src/ir/analyzers/func_call_graph_builder.h"
+#include "src/ir/analyzers/interference_graph_builder.h"
+#include "src/ir/analyzers/live_range_analyzer.h"
+#include "src/ir/info/func_call_graph.h"
+#include "src/ir/info/func_live_ranges.h"
+#include "src/ir/info/interference_graph.h"
+#include "src/ir/processors/func_cloner.h"
+#include "src/ir/processors/phi_resolver.h"
+#include "src/ir/representation/instrs.h"
+#include "src/ir/representation/types.h"
+#include "src/ir/representation/values.h"
+#include "src/x86_64/ir_translator/ir_translator.h"
+#include "src/x86_64/machine_code/linker.h"
+
+namespace x86_64_jit {
+
+using ::common::atomics::Int;
+using ::common::atomics::IntType;
+using ::common::data::DataView;
+using ::common::logging::fail;
+using ::common::memory::Permissions;
+using ::ir_interpreter::TaggedValue;
+
+namespace {
+
+// Maximum number of arguments and results passed in registers by compiled functions.
+constexpr std::size_t kMaxArgs = 6;
+constexpr std::size_t kMaxResults = 2;
+
+// Compiled functions return up to two results in rax and rdx, which matches the System V calling
+// convention for a struct of two integers.
+struct CompiledFuncResults {
+  int64_t rax;
+  int64_t rdx;
+};
+typedef CompiledFuncResults (*CompiledFunc)(int64_t, int64_t, int64_t, int64_t, int64_t,
+                                            int64_t);
+
+bool IsFuncValue(const ir::Value* value) { return value->type() == ir::func_type(); }
+
+int64_t ToRegisterValue(TaggedValue value) {
+  switch (value.tag()) {
+    case TaggedValue::Tag::kBool:
+      return value.AsBool() ? 1 : 0;
+    case TaggedValue::Tag::kInt:
+      return value.AsInt().AsInt64();
+    case TaggedValue::Tag::kPointer:
+      return value.AsPointer();
+    default:
+      fail("can not pass value to compiled function: " + value.RefStringWithType());
+  }
+}
+
+TaggedValue FromRegisterValue(const ir::Type* type, int64_t raw) {
+  switch (type->type_kind()) {
+    case ir::TypeKind::kBool:
+      return TaggedValue::ForBool((raw & 0xff) != 0);
+    case ir::TypeKind::kInt: {
+      IntType int_type = static_cast<const ir::IntType*>(type)->int_type();
+      return TaggedValue::ForInt(common::atomics::VisitIntType(int_type, [raw](auto t) {
+        return Int(static_cast<common::atomics::raw_int_t<decltype(t)::value>>(raw));
+      }));
+    }
+    case ir::TypeKind::kPointer:
+      return TaggedValue::ForPointer(raw);
+    default:
+      fail("can not receive result of type from compiled function: " + type->RefString());
+  }
+}
+
+}  // namespace
+
+TieredInterpreter::TieredInterpreter(ir::Program* program, TieringOptions options)
+    : ir_interpreter::Interpreter(program, ir_interpreter::HeapOptions{}),
+      options_(options),
+      malloc_and_free_stubs_(code_space_.AllocateChunk(x86_64::Linker::kMallocAndFreeStubsSize)) {
+  // The stubs calling into the C library are shared by all compiled functions.
+  x86_64::Linker::EncodeMallocAndFreeStubs(malloc_and_free_stubs_);
+  code_space_.ChangePermissions(malloc_and_free_stubs_, Permissions::kExecute);
+}
+
+int64_t TieredInterpreter::HotnessOfFunc(ir::func_num_t func_num) const {
+  auto it = func_infos_.find(func_num);
+  return (it != func_infos_.end()) ? it->second.hotness : 0;
+}
+
+bool TieredInterpreter::IsFuncCompiled(ir::func_num_t func_num) const {
+  auto it = func_infos_.find(func_num);
+  return it != func_infos_.end() && it->second.state == FuncState::kCompiled;
+}
+
+bool TieredInterpreter::InterceptCall(ir::Func* callee, const std::vector<TaggedValue>& args,
+                                      std::vector<TaggedValue>& results) {
+  FuncInfo& info = func_infos_[callee->number()];
+  if (info.state == FuncState::kInterpreted && ++info.hotness >= options_.tier_up_threshold) {
+    TierUp(callee);
+  }
+  if (info.state != FuncState::kCompiled) {
+    return false;
+  }
+  results = CallCompiledFunc(callee, info.code, args);
+  compiled_call_count_++;
+  return true;
+}
+
+void TieredInterpreter::OnBlockTransition(ir::Func* func, ir::Block* from, ir::Block* to) {
+  if (!IsBackEdge(func, from, to)) {
+    return;
+  }
+  FuncInfo& info = func_infos_[func->number()];
+  if (info.state == FuncState::kInterpreted) {
+    // The function only switches to machine code at its next call.
+    info.hotness++;
+  }
+}
+
+bool TieredInterpreter::IsBackEdge(ir::Func* func, ir::Block* from, ir::Block* to) {
+  auto key = std::make_tuple(func->number(), from->number(), to->number());
+  if (auto it = back_edges_.find(key); it != back_edges_.end()) {
+    return it->second;
+  }
+  // A jump is a back edge if its destination dominates its origin.
+  bool is_back_edge = false;
+  for (ir::block_num_t dominator = from->number(); dominator != ir::kNoBlockNum;
+       dominator = func->DominatorOf(dominator)) {
+    if (dominator == to->number()) {
+      is_back_edge = true;
+      break;
+    }
+  }
+  back_edges_.insert({key, is_back_edge});
+  return is_back_edge;
+}
+
+void TieredInterpreter::TierUp(ir::Func* func) {
+  std::unordered_set<ir::func_num_t> func_nums = FindFuncsToCompile(func);
+  if (!CanCallFromInterpreter(func) || !CanCompile(func_nums)) {
+    func_infos_[func->number()].state = FuncState::kNotCompilable;
+    return;
+  }
+
+  // Translation resolves phis in place, so it operates on a copy of the compiled functions.
+  std::vector<ir::func_num_t> sorted_func_nums(func_nums.begin(), func_nums.end());
+  std::sort(sorted_func_nums.begin(), sorted_func_nums.end());
+  auto ir_program = std::make_unique<ir::Program>();
+  for (ir::func_num_t func_num : sorted_func_nums) {
+    ir_processors::CloneFuncIntoProgram(program()->GetFunc(func_num), ir_program.get());
+  }
+
+  std::unordered_map<ir::func_num_t, const ir_info::FuncLiveRanges> live_ranges;
+  std::unordered_map<ir::func_num_t, const ir_info::InterferenceGraph> interference_graphs;
+  for (auto& ir_func : ir_program->funcs()) {
+    const ir_info::FuncLiveRanges func_live_ranges =
+        ir_analyzers::FindLiveRangesForFunc(ir_func.get());
+    if (!options_.linear_scan_register_allocation) {
+      const ir_info::InterferenceGraph func_interference_graph =
+          ir_analyzers::BuildInterferenceGraphForFunc(ir_func.get(), func_live_ranges);
+      interference_graphs.insert({ir_func->number(), func_interference_graph});
+    }
+    live_ranges.insert({ir_func->number(), func_live_ranges});
+  }
+  for (auto& ir_func : ir_program->funcs()) {
+    ir_processors::ResolvePhisInFunc(ir_func.get());
+  }
+  ir_to_x86_64_translator::TranslationResults translation_results =
+      options_.linear_scan_register_allocation
+          ? ir_to_x86_64_translator::TranslateWithLinearScan(ir_program.get(), live_ranges,
+                                                             /*generate_debug_info=*/true)
+          : ir_to_x86_64_translator::Translate(ir_program.get(), live_ranges, interference_graphs,
+                                               /*generate_debug_info=*/true);
+  x86_64::Program* x86_64_program = translation_results.program.get();
+
+  // Each compilation gets its own chunk of the code space, which only becomes executable once
+  // all references in it are patched.
+  x86_64::Linker linker;
+  linker.AddMallocAndFreeStubs(x86_64_program->declared_funcs().at("malloc"),
+                               x86_64_program->declared_funcs().at("free"), malloc_and_free_stubs_);
+  DataView code = x86_64_program->Encode(linker, code_space_);
+  linker.ApplyPatches();
+  code_space_.ChangePermissions(code, Permissions::kExecute);
+
+  for (ir::func_num_t func_num : func_nums) {
+    FuncInfo& info = func_infos_[func_num];
+    if (info.state == FuncState::kCompiled ||
+        !CanCallFromInterpreter(program()->GetFunc(func_num))) {
+      continue;
+    }
+    x86_64::func_num_t x86_64_func_num = translation_results.ir_to_x86_64_func_nums.at(func_num);
+    info.state = FuncState::kCompiled;
+    info.code = linker.func_addrs().at(x86_64_func_num);
+  }
+}
+
+std::unordered_set<ir::func_num_t> TieredInterpreter::FindFuncsToCompile(ir::Func* func) const {
+  const ir_info::FuncCallGraph call_graph = ir_analyzers::BuildFuncCallGraphForProgram(program());
+  std::unordered_set<ir::func_num_t> func_nums{func->number()};
+  std::vector<ir::func_num_t> queue{func->number()};
+  while (!queue.empty()) {
+    ir::func_num_t caller_num = queue.back();
+    queue.pop_back();
+    for (ir::func_num_t callee_num : call_graph.CalleesOfFunc(caller_num)) {
+      if (func_nums.insert(callee_num).second) {
+        queue.push_back(callee_num);
+      }
+    }
+  }
+  return func_nums;
+}
+
+bool TieredInterpreter::CanCompile(const std::unordered_set<ir::func_num_t>& func_nums) const {
+  for (ir::func_num_t func_num : func_nums) {
+    const ir::Func* func = program()->GetFunc(func_num);
+    if (func->args().size() > kMaxArgs || func->result_types().size() > kMaxResults ||
+        !ir_processors::CanCloneFunc(func)) {
+      return false;
+    }
+    for (const auto& block : func->blocks()) {
+      for (const auto& instr : block->instrs()) {
+        std::vector<std::shared_ptr<ir::Value>> used_values = instr->UsedValues();
+        if (instr->instr_kind() == ir::InstrKind::kCall) {
+          // Only direct calls are supported; the callee itself is not a function value passed
+          // around.
+          auto call_instr = static_cast<ir::CallInstr*>(instr.get());
+          if (call_instr->func()->kind() != ir::Value::Kind::kConstant) {
+            return false;
+          }
+          used_values = std::vector<std::shared_ptr<ir::Value>>(call_instr->args().begin(),
+                                                                call_instr->args().end());
+        }
+        for (const auto& value : used_values) {
+          if (IsFuncValue(value.get())) {
+            return false;
+          }
+        }
+        for (const auto& value : instr->DefinedValues()) {
+          if (IsFuncValue(value.get())) {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool TieredInterpreter::CanCallFromInterpreter(const ir::Func* func) {
+  if (func->args().size() > kMaxArgs || func->result_types().size() > kMaxResults) {
+    return false;
+  }
+  for (const auto& arg : func->args()) {
+    if (IsFuncValue(arg.get())) {
+      return false;
+    }
+  }
+  for (const ir::Type* result_type : func->result_types()) {
+    if (result_type == ir::func_type()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<TaggedValue> TieredInterpreter::CallCompiledFunc(const ir::Func* func, uint8_t* code,
+                                                             const std::vector<TaggedValue>& args) {
+  // Unused argument registers are simply ignored by the compiled function.
+  int64_t regs[kMaxArgs] = {0, 0, 0, 0, 0, 0};
+  for (std::size_t i = 0; i < args.size(); i++) {
+    regs[i] = ToRegisterValue(args.at(i));
+  }
+  CompiledFuncResults raw_results =
+      CompiledFunc(code)(regs[0], regs[1], regs[2], regs[3], regs[4], regs[5]);
+
+  std::vector<TaggedValue> results;
+  results.reserve(func->result_types().size());
+  for (std::size_t i = 0; i < func->result_types().size(); i++) {
+    int64_t raw = (i == 0) ? raw_results.rax : raw_results.rdx;
+    results.push_back(FromRegisterValue(func->result_types().at(i), raw));
+  }
+  return results;
+}
+
+}  // namespace x86_64_jit
@@ -0,0 +1,95 @@
+//
+//  tiered_interpreter.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef x86_64_jit_tiered_interpreter_h
+#define x86_64_jit_tiered_interpreter_h
+
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "src/common/data/data_view.h"
+#include "src/common/memory/code_space.h"
+#include "src/ir/interpreter/interpreter.h"
+#include "src/ir/interpreter/tagged_value.h"
+#include "src/ir/representation/block.h"
+#include "src/ir/representation/func.h"
+#include "src/ir/representation/num_types.h"
+#include "src/ir/representation/program.h"
+
+namespace x86_64_jit {
+
+struct TieringOptions {
+  static constexpr int64_t kDefaultTierUpThreshold = 1000;
+
+  // Number of entries plus loop back edges after which a function gets compiled to x86_64.
+  int64_t tier_up_threshold = kDefaultTierUpThreshold;
+  // If true, compilation allocates registers by linear scan instead of interference graph
+  // coloring, which compiles large functions faster.
+  bool linear_scan_register_allocation = false;
+};
+
+// Interprets a program, but compiles functions to x86_64 machine code once they become hot and
+// calls the machine code for all further calls to them. Functions that are already executing when
+// they get compiled finish in the interpreter.
+//
+// Machine code allocates memory with malloc directly, which is why the interpreter heap always
+// uses the system backend without sanitization. Compiled functions can only call other compiled
+// functions, so a function gets compiled together with all functions it can call. Functions that
+// use function values are never compiled, since the interpreter and machine code represent them
+// differently.
+class TieredInterpreter : public ir_interpreter::Interpreter {
+ public:
+  TieredInterpreter(ir::Program* program, TieringOptions options = TieringOptions{});
+
+  int64_t HotnessOfFunc(ir::func_num_t func_num) const;
+  bool IsFuncCompiled(ir::func_num_t func_num) const;
+  int64_t compiled_call_count() const { return compiled_call_count_; }
+
+ protected:
+  bool InterceptCall(ir::Func* callee, const std::vector<ir_interpreter::TaggedValue>& args,
+                     std::vector<ir_interpreter::TaggedValue>& results) override;
+  void OnBlockTransition(ir::Func* func, ir::Block* from, ir::Block* to) override;
+
+ private:
+  enum class FuncState {
+    kInterpreted,
+    kCompiled,
+    kNotCompilable,
+  };
+
+  struct FuncInfo {
+    int64_t hotness = 0;
+    FuncState state = FuncState::kInterpreted;
+    uint8_t* code = nullptr;
+  };
+
+  bool IsBackEdge(ir::Func* func, ir::Block* from, ir::Block* to);
+
+  void TierUp(ir::Func* func);
+  std::unordered_set<ir::func_num_t> FindFuncsToCompile(ir::Func* func) const;
+  bool CanCompile(const std::unordered_set<ir::func_num_t>& func_nums) const;
+  static bool CanCallFromInterpreter(const ir::Func* func);
+
+  std::vector<ir_interpreter::TaggedValue> CallCompiledFunc(
+      const ir::Func* func, uint8_t* code, const std::vector<ir_interpreter::TaggedValue>& args);
+
+  TieringOptions options_;
+  std::unordered_map<ir::func_num_t, FuncInfo> func_infos_;
+  std::map<std::tuple<ir::func_num_t, ir::block_num_t, ir::block_num_t>, bool> back_edges_;
+  common::memory::CodeSpace code_space_;
+  common::data::DataView malloc_and_free_stubs_;
+  int64_t compiled_call_count_ = 0;
+};
+
+}  // namespace x86_64_jit
+
+#endif /* x86_64_jit_tiered_interpreter_h */
@@ -0,0 +1,212 @@
+//
+//  tiered_interpreter_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/x86_64/jit/tiered_interpreter.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "src/ir/check/check_test_util.h"
+#include "src/ir/representation/program.h"
+#include "src/ir/serialization/parse.h"
+
+namespace x86_64_jit {
+namespace {
+
+std::unique_ptr<ir::Program> ParseAndCheck(std::string text) {
+  std::unique_ptr<ir::Program> program = ir_serialization::ParseProgramOrDie(text);
+  program->set_entry_func_num(0);
+  ir_check::CheckProgramOrDie(program.get());
+  return program;
+}
+
+TEST(TieredInterpreterTest, CompilesHotRecursiveFunc) {
+  std::unique_ptr<ir::Program> program = ParseAndCheck(R"ir(
+@0 main() => (i64) {
+  {0}
+    %0:i64 = call @1, #15:i64
+    ret %0
+}
+
+@1 fib(%0:i64) => (i64) {
+  {0}
+    %1:b = ilss %0, #2:i64
+    jcc %1, {1}, {2}
+  {1}
+    ret #1:i64
+  {2}
+    %2:i64 = isub %0, #1:i64
+    %3:i64 = call @1, %2
+    %4:i64 = isub %0, #2:i64
+    %5:i64 = call @1, %4
+    %6:i64 = iadd %3, %5
+    ret %6
+}
+)ir");
+
+  TieredInterpreter interpreter(program.get(), TieringOptions{.tier_up_threshold = 10});
+  interpreter.Run();
+
+  EXPECT_EQ(interpreter.exit_code(), 987);
+  EXPECT_FALSE(interpreter.IsFuncCompiled(0));
+  EXPECT_TRUE(interpreter.IsFuncCompiled(1));
+  EXPECT_EQ(interpreter.HotnessOfFunc(1), 10);
+  EXPECT_GT(interpreter.compiled_call_count(), 0);
+}
+
+TEST(TieredInterpreterTest, CountsLoopBackEdges) {
+  std::unique_ptr<ir::Program> program = ParseAndCheck(R"ir(
+@0 main() => (i64) {
+  {0}
+    %0:i64 = call @1, #100:i64
+    %1:i64 = call @1, #100:i64
+    %2:i64 = call @1, #10:i64
+    %3:i64 = iadd %0, %1
+    %4:i64 = iadd %3, %2
+    ret %4
+}
+
+@1 sum(%0:i64) => (i64) {
+  {0}
+    jmp {1}
+  {1}
+    %1:i64 = phi #0:i64{0}, %4{2}
+    %2:i64 = phi #0:i64{0}, %5{2}
+    %3:b = ilss %1, %0
+    jcc %3, {2}, {3}
+  {2}
+    %4:i64 = iadd %1, #1:i64
+    %5:i64 = iadd %2, %1
+    jmp {1}
+  {3}
+    ret %2
+}
+)ir");
+
+  TieredInterpreter interpreter(program.get(), TieringOptions{.tier_up_threshold = 50});
+  interpreter.Run();
+
+  EXPECT_EQ(interpreter.exit_code(), 4950 + 4950 + 45);
+  EXPECT_TRUE(interpreter.IsFuncCompiled(1));
+  EXPECT_EQ(interpreter.compiled_call_count(), 2);
+}
+
+TEST(TieredInterpreterTest, CompilesWithLinearScanRegisterAllocation) {
+  std::unique_ptr<ir::Program> program = ParseAndCheck(R"ir(
+@0 main() => (i64) {
+  {0}
+    %0:i64 = call @1, #12:i64
+    %1:i64 = call @2, #100:i64
+    %2:i64 = call @2, #10:i64
+    %3:i64 = iadd %0, %1
+    %4:i64 = iadd %3, %2
+    ret %4
+}
+
+@1 fib(%0:i64) => (i64) {
+  {0}
+    %1:b = ilss %0, #2:i64
+    jcc %1, {1}, {2}
+  {1}
+    ret #1:i64
+  {2}
+    %2:i64 = isub %0, #1:i64
+    %3:i64 = call @1, %2
+    %4:i64 = isub %0, #2:i64
+    %5:i64 = call @1, %4
+    %6:i64 = iadd %3, %5
+    ret %6
+}
+
+@2 sum(%0:i64) => (i64) {
+  {0}
+    jmp {1}
+  {1}
+    %1:i64 = phi #0:i64{0}, %4{2}
+    %2:i64 = phi #0:i64{0}, %5{2}
+    %3:b = ilss %1, %0
+    jcc %3, {2}, {3}
+  {2}
+    %4:i64 = iadd %1, #1:i64
+    %5:i64 = iadd %2, %1
+    jmp {1}
+  {3}
+    ret %2
+}
+)ir");
+
+  TieredInterpreter interpreter(
+      program.get(),
+      TieringOptions{.tier_up_threshold = 5, .linear_scan_register_allocation = true});
+  interpreter.Run();
+
+  EXPECT_EQ(interpreter.exit_code(), 233 + 4950 + 45);
+  EXPECT_TRUE(interpreter.IsFuncCompiled(1));
+  EXPECT_TRUE(interpreter.IsFuncCompiled(2));
+}
+
+TEST(TieredInterpreterTest, KeepsInterpretingFuncsUsingFuncValues) {
+  std::unique_ptr<ir::Program> program = ParseAndCheck(R"ir(
+@0 main() => (i64) {
+  {0}
+    %0:i64 = call @1, @2, #3:i64
+    %1:i64 = call @1, @2, #4:i64
+    %2:i64 = iadd %0, %1
+    ret %2
+}
+
+@1 apply(%0:func, %1:i64) => (i64) {
+  {0}
+    %2:i64 = call %0, %1
+    ret %2
+}
+
+@2 square(%0:i64) => (i64) {
+  {0}
+    %1:i64 = imul %0, %0
+    ret %1
+}
+)ir");
+
+  TieredInterpreter interpreter(program.get(), TieringOptions{.tier_up_threshold = 1});
+  interpreter.Run();
+
+  EXPECT_EQ(interpreter.exit_code(), 25);
+  EXPECT_FALSE(interpreter.IsFuncCompiled(1));
+}
+
+TEST(TieredInterpreterTest, CompilesFuncsUsingHeap) {
+  std::unique_ptr<ir::Program> program = ParseAndCheck(R"ir(
+@0 main() => (i64) {
+  {0}
+    %0:i64 = call @1, #3:i64
+    %1:i64 = call @1, #4:i64
+    %2:i64 = iadd %0, %1
+    ret %2
+}
+
+@1 square(%0:i64) => (i64) {
+  {0}
+    %1:ptr = malloc #8:i64
+    store %1, %0
+    %2:i64 = load %1
+    %3:i64 = imul %2, %0
+    free %1
+    ret %3
+}
+)ir");
+
+  TieredInterpreter interpreter(program.get(), TieringOptions{.tier_up_threshold = 1});
+  interpreter.Run();
+
+  EXPECT_EQ(interpreter.exit_code(), 25);
+  EXPECT_TRUE(interpreter.IsFuncCompiled(1));
+}
+
+}  // namespace
+}  // namespace x86_64_jit
@@ -8,12 +8,55 @@
 
 #include "linker.h"
 
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+#include "src/common/logging/logging.h"
+
 namespace x86_64 {
 
 using ::common::data::DataView;
+using ::common::logging::fail;
+
+namespace {
+
+// Each stub consists of a 10 byte mov rax,imm64 and a 2 byte jmp rax.
+constexpr int64_t kFarJumpStubSize = Linker::kMallocAndFreeStubsSize / 2;
+
+// Generated code does not keep the stack 16 byte aligned at calls, so the jumps into the C library
+// realign it on entry.
+__attribute__((force_align_arg_pointer)) void* MallocJump(int64_t size) { return malloc(size); }
+
+__attribute__((force_align_arg_pointer)) void FreeJump(void* ptr) { free(ptr); }
+
+void EncodeFarJumpStub(uint8_t* func_addr, DataView stub) {
+  uint64_t addr = reinterpret_cast<uint64_t>(func_addr);
+  // mov rax,imm64
+  stub[0x00] = 0x48;
+  stub[0x01] = 0xb8;
+  for (int i = 0; i < 8; i++) {
+    stub[0x02 + i] = (addr >> (8 * i)) & 0xff;
+  }
+  // jmp rax
+  stub[0x0a] = 0xff;
+  stub[0x0b] = 0xe0;
+}
+
+}  // namespace
+
+void Linker::EncodeMallocAndFreeStubs(DataView stubs) {
+  EncodeFarJumpStub((uint8_t*)&MallocJump, stubs.SubView(0, kFarJumpStubSize));
+  EncodeFarJumpStub((uint8_t*)&FreeJump, stubs.SubView(kFarJumpStubSize, 2 * kFarJumpStubSize));
+}
 
 void Linker::AddFuncAddr(int64_t func_id, uint8_t* func_addr) { func_addrs_[func_id] = func_addr; }
 
+void Linker::AddMallocAndFreeStubs(int64_t malloc_func_id, int64_t free_func_id, DataView stubs) {
+  func_addrs_[malloc_func_id] = stubs.base();
+  func_addrs_[free_func_id] = stubs.base() + kFarJumpStubSize;
+}
+
 void Linker::AddBlockAddr(int64_t block_id, uint8_t* block_addr) {
   block_addrs_[block_id] = block_addr;
 }
@@ -32,6 +75,10 @@ void Linker::ApplyPatches() const {
     DataView patch_data_view = func_patch.patch_data_view;
     uint8_t* dest_func_addr = func_addrs_.at(func_ref.func_id());
     int64_t offset = dest_func_addr - (patch_data_view.base() + 0x04);
+    if (offset < std::numeric_limits<int32_t>::min() ||
+        offset > std::numeric_limits<int32_t>::max()) {
+      fail("func reference out of range for 32 bit offset");
+    }
 
     patch_data_view[0x00] = (offset >> 0) & 0x000000FF;
     patch_data_view[0x01] = (offset >> 8) & 0x000000FF;
@@ -44,6 +91,10 @@ void Linker::ApplyPatches() const {
     DataView patch_data_view = block_patch.patch_data_view;
     uint8_t* dest_block_addr = block_addrs_.at(block_ref.block_id());
     int64_t offset = dest_block_addr - (patch_data_view.base() + 0x04);
+    if (offset < std::numeric_limits<int32_t>::min() ||
+        offset > std::numeric_limits<int32_t>::max()) {
+      fail("block reference out of range for 32 bit offset");
+    }
 
     patch_data_view[0x00] = (offset >> 0) & 0x000000FF;
     patch_data_view[0x01] = (offset >> 8) & 0x000000FF;
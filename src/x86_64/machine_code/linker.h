@@ -21,9 +21,21 @@ namespace x86_64 {
 
 class Linker {
  public:
+  // Size of the stubs written by EncodeMallocAndFreeStubs.
+  static constexpr int64_t kMallocAndFreeStubsSize = 24;
+
+  // Writes jumps to malloc and free of the host binary into the given stubs. Generated calls use 32
+  // bit offsets, which cannot reach the host binary, so they go through the stubs instead. The
+  // stubs have to be in range of the linked code, can get shared between linkers, and clobber rax.
+  static void EncodeMallocAndFreeStubs(common::data::DataView stubs);
+
   const std::unordered_map<int64_t, uint8_t*>& func_addrs() const { return func_addrs_; }
 
   void AddFuncAddr(int64_t func_id, uint8_t* func_addr);
+  // Links all references to the given malloc and free funcs against the stubs written by
+  // EncodeMallocAndFreeStubs.
+  void AddMallocAndFreeStubs(int64_t malloc_func_id, int64_t free_func_id,
+                             common::data::DataView stubs);
   void AddBlockAddr(int64_t block_id, uint8_t* block_addr);
 
   void AddFuncRef(const FuncRef& func_ref, common::data::DataView patch_data_view);
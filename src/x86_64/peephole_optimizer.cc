@@ -0,0 +1,313 @@
+//
+//  peephole_optimizer.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "peephole_optimizer.h"
+
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "src/x86_64/block.h"
+#include "src/x86_64/instrs/arithmetic_logic_instrs.h"
+#include "src/x86_64/instrs/control_flow_instrs.h"
+#include "src/x86_64/instrs/data_instrs.h"
+#include "src/x86_64/instrs/instr.h"
+#include "src/x86_64/instrs/instr_cond.h"
+#include "src/x86_64/ops.h"
+
+namespace x86_64 {
+namespace {
+
+enum class FlagsEffect {
+  kNone,
+  kRead,   // The instr reads the flags (and might also write them afterwards).
+  kWrite,  // The instr overwrites the flags without reading them.
+};
+
+FlagsEffect FlagsEffectOf(const Instr* instr) {
+  switch (instr->instr_kind()) {
+    case InstrKind::kMov:
+    case InstrKind::kXchg:
+    case InstrKind::kPush:
+    case InstrKind::kPop:
+    case InstrKind::kNot:
+    case InstrKind::kSignExtendRegA:
+    case InstrKind::kSignExtendRegAD:
+    case InstrKind::kJmp:
+      return FlagsEffect::kNone;
+    case InstrKind::kSetcc:
+    case InstrKind::kAdc:
+    case InstrKind::kSbb:
+    case InstrKind::kJcc:
+      return FlagsEffect::kRead;
+    case InstrKind::kAnd:
+    case InstrKind::kOr:
+    case InstrKind::kXor:
+    case InstrKind::kNeg:
+    case InstrKind::kAdd:
+    case InstrKind::kSub:
+    case InstrKind::kCmp:
+    case InstrKind::kMul:
+    case InstrKind::kImul:
+    case InstrKind::kDiv:
+    case InstrKind::kIdiv:
+    case InstrKind::kTest:
+      return FlagsEffect::kWrite;
+    case InstrKind::kCall:
+    case InstrKind::kSyscall:
+    case InstrKind::kRet:
+      // The flags are not preserved across calls and not part of return values.
+      return FlagsEffect::kWrite;
+  }
+}
+
+// Determines where the flags register might still get read. Blocks jumped to indirectly are
+// unknown, so the flags are conservatively live at indirect jumps.
+class FlagsLiveness {
+ public:
+  explicit FlagsLiveness(const Func* func);
+
+  bool AreLiveAtEntryOf(BlockRef block_ref) const;
+  // Returns if the flags might get read after the instr at the given index in the block, before
+  // they get overwritten.
+  bool AreLiveAfter(const Block* block, std::size_t instr_index) const;
+
+ private:
+  std::unordered_map<block_num_t, bool> live_in_;
+  std::unordered_map<block_num_t, bool> live_out_;
+};
+
+FlagsLiveness::FlagsLiveness(const Func* func) {
+  struct BlockSummary {
+    FlagsEffect first_effect = FlagsEffect::kNone;
+    bool has_indirect_successor = false;
+    std::vector<block_num_t> successors;
+  };
+  const std::vector<std::unique_ptr<Block>>& blocks = func->blocks();
+  std::vector<BlockSummary> summaries(blocks.size());
+  for (std::size_t i = 0; i < blocks.size(); i++) {
+    const Block* block = blocks.at(i).get();
+    BlockSummary& summary = summaries.at(i);
+    bool falls_through = true;
+    for (const std::unique_ptr<Instr>& instr : block->instrs()) {
+      if (summary.first_effect == FlagsEffect::kNone) {
+        summary.first_effect = FlagsEffectOf(instr.get());
+      }
+      if (instr->instr_kind() == InstrKind::kJcc) {
+        summary.successors.push_back(static_cast<Jcc*>(instr.get())->dst().block_id());
+      } else if (instr->instr_kind() == InstrKind::kJmp) {
+        Operand dst = static_cast<Jmp*>(instr.get())->dst();
+        if (dst.is_block_ref()) {
+          summary.successors.push_back(dst.block_ref().block_id());
+        } else {
+          summary.has_indirect_successor = true;
+        }
+        falls_through = false;
+      } else if (instr->instr_kind() == InstrKind::kRet) {
+        falls_through = false;
+      }
+    }
+    if (falls_through && i + 1 < blocks.size()) {
+      summary.successors.push_back(blocks.at(i + 1)->block_num());
+    }
+    live_in_[block->block_num()] = false;
+    live_out_[block->block_num()] = summary.has_indirect_successor;
+  }
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (std::size_t i = blocks.size(); i > 0; i--) {
+      const Block* block = blocks.at(i - 1).get();
+      const BlockSummary& summary = summaries.at(i - 1);
+      bool& live_out = live_out_.at(block->block_num());
+      for (block_num_t successor : summary.successors) {
+        live_out = live_out || AreLiveAtEntryOf(successor);
+      }
+      bool live_in = summary.first_effect == FlagsEffect::kRead ||
+                     (summary.first_effect == FlagsEffect::kNone && live_out);
+      bool& old_live_in = live_in_.at(block->block_num());
+      if (live_in != old_live_in) {
+        old_live_in = live_in;
+        changed = true;
+      }
+    }
+  }
+}
+
+bool FlagsLiveness::AreLiveAtEntryOf(BlockRef block_ref) const {
+  auto it = live_in_.find(block_ref.block_id());
+  if (it == live_in_.end()) {
+    return true;
+  }
+  return it->second;
+}
+
+bool FlagsLiveness::AreLiveAfter(const Block* block, std::size_t instr_index) const {
+  for (std::size_t i = instr_index + 1; i < block->instrs().size(); i++) {
+    switch (FlagsEffectOf(block->instrs().at(i).get())) {
+      case FlagsEffect::kNone:
+        continue;
+      case FlagsEffect::kRead:
+        return true;
+      case FlagsEffect::kWrite:
+        return false;
+    }
+  }
+  return live_out_.at(block->block_num());
+}
+
+bool IsSelfMov(const Instr* instr) {
+  if (instr->instr_kind() != InstrKind::kMov) {
+    return false;
+  }
+  auto mov = static_cast<const Mov*>(instr);
+  // 32 bit movs clear the upper half of the 64 bit register and therefore have an effect.
+  return mov->dst().is_reg() && mov->src().is_reg() && mov->dst().reg() == mov->src().reg() &&
+         mov->dst().size() != Size::k32;
+}
+
+void RemoveSelfMovs(Block* block, PeepholeStats& stats) {
+  stats.removed_self_movs += std::erase_if(
+      block->instrs(), [](const std::unique_ptr<Instr>& instr) { return IsSelfMov(instr.get()); });
+}
+
+void ReplaceZeroingMovsWithXors(Block* block, const FlagsLiveness& flags_liveness,
+                                PeepholeStats& stats) {
+  std::vector<std::unique_ptr<Instr>>& instrs = block->instrs();
+  for (std::size_t i = 0; i < instrs.size(); i++) {
+    if (instrs.at(i)->instr_kind() != InstrKind::kMov) {
+      continue;
+    }
+    auto mov = static_cast<Mov*>(instrs.at(i).get());
+    if (!mov->dst().is_reg() || !mov->src().is_imm() || mov->src().imm().value() != 0 ||
+        flags_liveness.AreLiveAfter(block, i)) {
+      continue;
+    }
+    Reg reg = mov->dst().reg();
+    // Writing the 32 bit register also clears the upper half and has a shorter encoding.
+    if (reg.size() == Size::k64) {
+      reg = Resize(reg, Size::k32);
+    }
+    instrs.at(i) = std::make_unique<Xor>(reg, reg);
+    stats.zeroing_movs_to_xors++;
+  }
+}
+
+void FuseSetccJccs(Block* block, const FlagsLiveness& flags_liveness, PeepholeStats& stats) {
+  std::vector<std::unique_ptr<Instr>>& instrs = block->instrs();
+  for (std::size_t i = 0; i + 2 < instrs.size(); i++) {
+    if (instrs.at(i)->instr_kind() != InstrKind::kSetcc ||
+        instrs.at(i + 1)->instr_kind() != InstrKind::kTest ||
+        instrs.at(i + 2)->instr_kind() != InstrKind::kJcc) {
+      continue;
+    }
+    auto setcc = static_cast<Setcc*>(instrs.at(i).get());
+    auto test = static_cast<Test*>(instrs.at(i + 1).get());
+    auto jcc = static_cast<Jcc*>(instrs.at(i + 2).get());
+    // The setcc result is either 0 or 1, so the test only needs to check the lowest bit.
+    const bool tests_setcc_result =
+        test->op_a() == setcc->op() &&
+        (test->op_b() == setcc->op() || (test->op_b().is_imm() && test->op_b().imm().value() & 1));
+    if (!tests_setcc_result ||
+        (jcc->cond() != InstrCond::kZero && jcc->cond() != InstrCond::kNoZero)) {
+      continue;
+    }
+    // Without the test, the flags after the jcc are the ones read by the setcc.
+    if (flags_liveness.AreLiveAfter(block, i + 2) || flags_liveness.AreLiveAtEntryOf(jcc->dst())) {
+      continue;
+    }
+    InstrCond cond = (jcc->cond() == InstrCond::kNoZero) ? setcc->cond() : Invert(setcc->cond());
+    BlockRef dst = jcc->dst();
+    instrs.at(i + 2) = std::make_unique<Jcc>(cond, dst);
+    instrs.erase(instrs.begin() + i + 1);
+    stats.fused_setcc_jccs++;
+  }
+}
+
+bool IsJumpTo(const Instr* instr, BlockRef block_ref) {
+  switch (instr->instr_kind()) {
+    case InstrKind::kJcc:
+      return static_cast<const Jcc*>(instr)->dst() == block_ref;
+    case InstrKind::kJmp: {
+      Operand dst = static_cast<const Jmp*>(instr)->dst();
+      return dst.is_block_ref() && dst.block_ref() == block_ref;
+    }
+    default:
+      return false;
+  }
+}
+
+void RemoveFallthroughJmps(Block* block, const Block* next_block, PeepholeStats& stats) {
+  if (next_block == nullptr) {
+    return;
+  }
+  std::vector<std::unique_ptr<Instr>>& instrs = block->instrs();
+  const BlockRef next_block_ref = next_block->GetBlockRef();
+  // jcc cc, next; jmp other becomes jcc !cc, other.
+  if (instrs.size() >= 2 && instrs.back()->instr_kind() == InstrKind::kJmp &&
+      static_cast<Jmp*>(instrs.back().get())->dst().is_block_ref() &&
+      instrs.at(instrs.size() - 2)->instr_kind() == InstrKind::kJcc &&
+      IsJumpTo(instrs.at(instrs.size() - 2).get(), next_block_ref)) {
+    auto jcc = static_cast<Jcc*>(instrs.at(instrs.size() - 2).get());
+    BlockRef dst = static_cast<Jmp*>(instrs.back().get())->dst().block_ref();
+    instrs.at(instrs.size() - 2) = std::make_unique<Jcc>(Invert(jcc->cond()), dst);
+    instrs.pop_back();
+    stats.removed_fallthrough_jmps++;
+  }
+  while (!instrs.empty() && IsJumpTo(instrs.back().get(), next_block_ref)) {
+    instrs.pop_back();
+    stats.removed_fallthrough_jmps++;
+  }
+}
+
+}  // namespace
+
+PeepholeStats& PeepholeStats::operator+=(const PeepholeStats& other) {
+  removed_self_movs += other.removed_self_movs;
+  zeroing_movs_to_xors += other.zeroing_movs_to_xors;
+  removed_fallthrough_jmps += other.removed_fallthrough_jmps;
+  fused_setcc_jccs += other.fused_setcc_jccs;
+  return *this;
+}
+
+std::string PeepholeStats::ToString() const {
+  std::stringstream ss;
+  ss << "removed self movs: " << removed_self_movs << "\n";
+  ss << "zeroing movs to xors: " << zeroing_movs_to_xors << "\n";
+  ss << "removed fallthrough jmps: " << removed_fallthrough_jmps << "\n";
+  ss << "fused setcc jccs: " << fused_setcc_jccs;
+  return ss.str();
+}
+
+PeepholeStats OptimizeProgramWithPeepholes(Program* program) {
+  PeepholeStats stats;
+  for (const std::unique_ptr<Func>& func : program->defined_funcs()) {
+    stats += OptimizeFuncWithPeepholes(func.get());
+  }
+  return stats;
+}
+
+PeepholeStats OptimizeFuncWithPeepholes(Func* func) {
+  PeepholeStats stats;
+  // None of the rules make the flags live in more places, so the liveness stays conservative.
+  const FlagsLiveness flags_liveness(func);
+  const std::vector<std::unique_ptr<Block>>& blocks = func->blocks();
+  for (std::size_t i = 0; i < blocks.size(); i++) {
+    Block* block = blocks.at(i).get();
+    const Block* next_block = (i + 1 < blocks.size()) ? blocks.at(i + 1).get() : nullptr;
+    RemoveSelfMovs(block, stats);
+    ReplaceZeroingMovsWithXors(block, flags_liveness, stats);
+    FuseSetccJccs(block, flags_liveness, stats);
+    RemoveFallthroughJmps(block, next_block, stats);
+  }
+  return stats;
+}
+
+}  // namespace x86_64
@@ -0,0 +1,45 @@
+//
+//  peephole_optimizer.h
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#ifndef x86_64_peephole_optimizer_h
+#define x86_64_peephole_optimizer_h
+
+#include <cstdint>
+#include <string>
+
+#include "src/x86_64/func.h"
+#include "src/x86_64/program.h"
+
+namespace x86_64 {
+
+// Counts how often each peephole rule was applied.
+struct PeepholeStats {
+  // mov r, r (except for 32 bit registers, where the mov clears the upper half) gets removed.
+  int64_t removed_self_movs = 0;
+  // mov r, 0 becomes xor r, r if the flags are not live after the mov.
+  int64_t zeroing_movs_to_xors = 0;
+  // jmp to the next block in layout order gets removed; jcc to the next block followed by jmp
+  // becomes a single jcc with the inverted condition.
+  int64_t removed_fallthrough_jmps = 0;
+  // setcc cc, r; test r, r; jcc z/nz becomes setcc cc, r; jcc cc/!cc if the flags are not live
+  // after the jcc.
+  int64_t fused_setcc_jccs = 0;
+
+  PeepholeStats& operator+=(const PeepholeStats& other);
+
+  std::string ToString() const;
+};
+
+// Applies local rewrite rules to the instrs of the program. Runs before encoding, after register
+// allocation, and cleans up patterns the IR translator emits for simplicity.
+PeepholeStats OptimizeProgramWithPeepholes(Program* program);
+PeepholeStats OptimizeFuncWithPeepholes(Func* func);
+
+}  // namespace x86_64
+
+#endif /* x86_64_peephole_optimizer_h */
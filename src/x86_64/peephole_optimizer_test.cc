@@ -0,0 +1,163 @@
+//
+//  peephole_optimizer_test.cc
+//  Katara
+//
+//  Created by Arne Philipeit on 10/16/26.
+//  Copyright © 2026 Arne Philipeit. All rights reserved.
+//
+
+#include "src/x86_64/peephole_optimizer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "src/x86_64/block.h"
+#include "src/x86_64/func.h"
+#include "src/x86_64/instrs/arithmetic_logic_instrs.h"
+#include "src/x86_64/instrs/control_flow_instrs.h"
+#include "src/x86_64/instrs/data_instrs.h"
+#include "src/x86_64/instrs/instr_cond.h"
+#include "src/x86_64/ops.h"
+#include "src/x86_64/program.h"
+
+namespace x86_64 {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+std::vector<std::string> InstrStrings(const Block* block) {
+  std::vector<std::string> instr_strings;
+  for (const std::unique_ptr<Instr>& instr : block->instrs()) {
+    instr_strings.push_back(instr->ToString());
+  }
+  return instr_strings;
+}
+
+TEST(PeepholeOptimizerTest, RemovesSelfMovs) {
+  Program program;
+  Func* func = program.DefineFunc("f");
+  Block* block = func->AddBlock();
+  block->AddInstr<Mov>(rax, rax);
+  block->AddInstr<Mov>(eax, eax);
+  block->AddInstr<Mov>(cl, cl);
+  block->AddInstr<Mov>(rax, rbx);
+  block->AddInstr<Ret>();
+
+  PeepholeStats stats = OptimizeProgramWithPeepholes(&program);
+
+  EXPECT_EQ(stats.removed_self_movs, 2);
+  EXPECT_THAT(InstrStrings(block), ElementsAre("mov eax,eax", "mov rax,rbx", "ret"));
+}
+
+TEST(PeepholeOptimizerTest, ReplacesZeroingMovsIfFlagsAreDead) {
+  Program program;
+  Func* func = program.DefineFunc("f");
+  Block* block_a = func->AddBlock();
+  Block* block_b = func->AddBlock();
+  block_a->AddInstr<Mov>(rax, Imm(int32_t{0}));
+  block_a->AddInstr<Cmp>(rbx, rcx);
+  block_a->AddInstr<Mov>(rdx, Imm(int32_t{0}));
+  block_a->AddInstr<Jcc>(InstrCond::kEqual, block_b->GetBlockRef());
+  block_a->AddInstr<Mov>(cx, Imm(int16_t{0}));
+  block_a->AddInstr<Ret>();
+  block_b->AddInstr<Mov>(dl, Imm(int8_t{0}));
+  block_b->AddInstr<Ret>();
+
+  PeepholeStats stats = OptimizeProgramWithPeepholes(&program);
+
+  EXPECT_EQ(stats.zeroing_movs_to_xors, 3);
+  EXPECT_THAT(InstrStrings(block_a), ElementsAre("xor eax,eax", "cmp rbx,rcx", "mov rdx,0x00000000",
+                                                 "je BB1", "xor cx,cx", "ret"));
+  EXPECT_THAT(InstrStrings(block_b), ElementsAre("xor dl,dl", "ret"));
+}
+
+TEST(PeepholeOptimizerTest, KeepsZeroingMovsIfFlagsAreLiveInSuccessor) {
+  Program program;
+  Func* func = program.DefineFunc("f");
+  Block* block_a = func->AddBlock();
+  Block* block_b = func->AddBlock();
+  Block* block_c = func->AddBlock();
+  block_a->AddInstr<Cmp>(rbx, rcx);
+  block_a->AddInstr<Mov>(rax, Imm(int32_t{0}));
+  block_a->AddInstr<Jmp>(block_c->GetBlockRef());
+  block_b->AddInstr<Ret>();
+  block_c->AddInstr<Jcc>(InstrCond::kEqual, block_b->GetBlockRef());
+  block_c->AddInstr<Ret>();
+
+  PeepholeStats stats = OptimizeProgramWithPeepholes(&program);
+
+  EXPECT_EQ(stats.zeroing_movs_to_xors, 0);
+  EXPECT_THAT(InstrStrings(block_a), ElementsAre("cmp rbx,rcx", "mov rax,0x00000000", "jmp BB2"));
+}
+
+TEST(PeepholeOptimizerTest, RemovesJumpsToNextBlock) {
+  Program program;
+  Func* func = program.DefineFunc("f");
+  Block* block_a = func->AddBlock();
+  Block* block_b = func->AddBlock();
+  Block* block_c = func->AddBlock();
+  block_a->AddInstr<Cmp>(rbx, rcx);
+  block_a->AddInstr<Jcc>(InstrCond::kLess, block_b->GetBlockRef());
+  block_a->AddInstr<Jmp>(block_c->GetBlockRef());
+  block_b->AddInstr<Jmp>(block_c->GetBlockRef());
+  block_c->AddInstr<Ret>();
+
+  PeepholeStats stats = OptimizeProgramWithPeepholes(&program);
+
+  EXPECT_EQ(stats.removed_fallthrough_jmps, 2);
+  EXPECT_THAT(InstrStrings(block_a), ElementsAre("cmp rbx,rcx", "jge BB2"));
+  EXPECT_THAT(InstrStrings(block_b), IsEmpty());
+  EXPECT_THAT(InstrStrings(block_c), ElementsAre("ret"));
+}
+
+TEST(PeepholeOptimizerTest, FusesSetccWithJcc) {
+  Program program;
+  Func* func = program.DefineFunc("f");
+  Block* block_a = func->AddBlock();
+  Block* block_b = func->AddBlock();
+  Block* block_c = func->AddBlock();
+  block_a->AddInstr<Cmp>(rbx, rcx);
+  block_a->AddInstr<Setcc>(InstrCond::kLess, al);
+  block_a->AddInstr<x86_64::Test>(al, Imm(int8_t{-1}));
+  block_a->AddInstr<Jcc>(InstrCond::kZero, block_c->GetBlockRef());
+  block_a->AddInstr<Jmp>(block_b->GetBlockRef());
+  block_b->AddInstr<Ret>();
+  block_c->AddInstr<Cmp>(rbx, rdx);
+  block_c->AddInstr<Setcc>(InstrCond::kAbove, cl);
+  block_c->AddInstr<x86_64::Test>(cl, cl);
+  block_c->AddInstr<Jcc>(InstrCond::kNoZero, block_b->GetBlockRef());
+  block_c->AddInstr<Ret>();
+
+  PeepholeStats stats = OptimizeProgramWithPeepholes(&program);
+
+  EXPECT_EQ(stats.fused_setcc_jccs, 2);
+  EXPECT_THAT(InstrStrings(block_a), ElementsAre("cmp rbx,rcx", "setl al", "jge BB2"));
+  EXPECT_THAT(InstrStrings(block_c), ElementsAre("cmp rbx,rdx", "seta cl", "ja BB1", "ret"));
+}
+
+TEST(PeepholeOptimizerTest, KeepsTestIfFlagsAreLiveAfterJcc) {
+  Program program;
+  Func* func = program.DefineFunc("f");
+  Block* block_a = func->AddBlock();
+  Block* block_b = func->AddBlock();
+  block_a->AddInstr<Cmp>(rbx, rcx);
+  block_a->AddInstr<Setcc>(InstrCond::kLess, al);
+  block_a->AddInstr<x86_64::Test>(al, Imm(int8_t{-1}));
+  block_a->AddInstr<Jcc>(InstrCond::kZero, block_b->GetBlockRef());
+  block_a->AddInstr<Ret>();
+  block_b->AddInstr<Setcc>(InstrCond::kZero, dl);
+  block_b->AddInstr<Ret>();
+
+  PeepholeStats stats = OptimizeProgramWithPeepholes(&program);
+
+  EXPECT_EQ(stats.fused_setcc_jccs, 0);
+  EXPECT_THAT(InstrStrings(block_a),
+              ElementsAre("cmp rbx,rcx", "setl al", "test al,0xffffffff", "je BB1", "ret"));
+}
+
+}  // namespace
+}  // namespace x86_64
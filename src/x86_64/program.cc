@@ -8,11 +8,16 @@
 
 #include "program.h"
 
+#include <algorithm>
 #include <sstream>
 
+#include "src/common/logging/logging.h"
+
 namespace x86_64 {
 
 using ::common::data::DataView;
+using ::common::logging::fail;
+using ::common::memory::CodeSpace;
 
 func_num_t Program::DeclareFunc(std::string func_name) {
   func_num_t func_num = defined_funcs_.size() + declared_funcs_.size();
@@ -43,6 +48,14 @@ Func* Program::DefinedFuncWithName(std::string name) const {
   return nullptr;
 }
 
+int64_t Program::MaxEncodedSize() const {
+  int64_t size = 0;
+  for (auto& func : defined_funcs_) {
+    size += func->MaxEncodedSize();
+  }
+  return size;
+}
+
 int64_t Program::Encode(Linker& linker, DataView code) const {
   int64_t c = 0;
   for (auto& func : defined_funcs_) {
@@ -53,6 +66,16 @@ int64_t Program::Encode(Linker& linker, DataView code) const {
   return c;
 }
 
+DataView Program::Encode(Linker& linker, CodeSpace& code_space) const {
+  DataView chunk = code_space.AllocateChunk(std::max(MaxEncodedSize(), int64_t{1}));
+  int64_t size = Encode(linker, chunk);
+  if (size == -1) {
+    fail("could not encode program");
+  }
+  code_space.ShrinkLastChunk(std::max(size, int64_t{1}));
+  return chunk.SubView(0, size);
+}
+
 std::string Program::ToString() const {
   std::stringstream ss;
   for (size_t i = 0; i < defined_funcs_.size(); i++) {
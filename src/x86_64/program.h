@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "src/common/data/data_view.h"
+#include "src/common/memory/code_space.h"
 #include "src/x86_64/block.h"
 #include "src/x86_64/func.h"
 #include "src/x86_64/machine_code/linker.h"
@@ -32,7 +33,12 @@ class Program {
 
   int64_t block_count() const { return block_count_; }
 
+  // Returns an upper bound for the number of bytes written by Encode.
+  int64_t MaxEncodedSize() const;
   int64_t Encode(Linker& linker, common::data::DataView code) const;
+  // Encodes the program into a new chunk of the code space and returns the written bytes. The
+  // chunk is only as large as the encoded program needs.
+  common::data::DataView Encode(Linker& linker, common::memory::CodeSpace& code_space) const;
   std::string ToString() const;
 
  private: